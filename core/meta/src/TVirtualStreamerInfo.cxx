@@ -28,6 +28,7 @@ TVirtualStreamerInfo *TVirtualStreamerInfo::fgInfoFactory    = 0;
 Bool_t  TVirtualStreamerInfo::fgCanDelete        = kTRUE;
 Bool_t  TVirtualStreamerInfo::fgOptimize         = kTRUE;
 Bool_t  TVirtualStreamerInfo::fgStreamMemberWise = kTRUE;
+Bool_t  TVirtualStreamerInfo::fgGenerateKernels  = kFALSE;
 
 ClassImp(TVirtualStreamerInfo);
 
@@ -157,6 +158,16 @@ Bool_t TVirtualStreamerInfo::GetStreamMemberWise()
    return fgStreamMemberWise;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the TStreamerInfos generate, when they are compiled, a
+/// specialized function reading and writing all the data members of the
+/// class at once (see TStreamerInfo::GenerateKernels).  The default is not to.
+
+Bool_t TVirtualStreamerInfo::GetGenerateKernels()
+{
+   return fgGenerateKernels;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  This is a static function.
 ///  Set optimization option.
@@ -251,6 +262,21 @@ Bool_t TVirtualStreamerInfo::SetStreamMemberWise(Bool_t enable)
    return prev;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set whether the TStreamerInfos compiled from now on generate a specialized
+/// function reading and writing all the data members of the class at once,
+/// which is then used instead of the sequence of streaming actions.
+/// The generation uses the interpreter and has a cost of its own: it pays
+/// off for classes that are streamed many times.
+/// This function returns the previous value of fgGenerateKernels.
+
+Bool_t TVirtualStreamerInfo::SetGenerateKernels(Bool_t enable)
+{
+   Bool_t prev = fgGenerateKernels;
+   fgGenerateKernels = enable;
+   return prev;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class TVirtualStreamerInfo.
 
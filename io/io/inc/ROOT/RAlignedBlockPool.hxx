@@ -0,0 +1,80 @@
+// @(#)root/io:$Id$
+// Author: agent <agent@local>, 2020-06-16
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RAlignedBlockPool
+#define ROOT_RAlignedBlockPool
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class RAlignedBlockPool RAlignedBlockPool.hxx
+ * \ingroup IO
+ *
+ * A process-wide pool of large, page-aligned memory blocks used as the target of vectored reads.
+ *
+ * Blocks of at least kHugePageSize bytes are aligned to, and sized in multiples of, huge pages; on Linux they are
+ * marked as candidates for transparent huge pages.  Blocks are handed out as shared pointers such that consumers
+ * (e.g. baskets decompressing straight out of a TTreeCache) can keep a block alive while its producer moves on to
+ * the next one.  Released blocks are kept for reuse up to a configurable number of bytes.
+ */
+class RAlignedBlockPool {
+public:
+   /// Alignment and size granularity of large blocks
+   static constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+   /// Alignment and size granularity of small blocks
+   static constexpr std::size_t kPageSize = 4096;
+
+private:
+   struct RBlock {
+      char *fBuffer;
+      std::size_t fSize;
+   };
+
+   std::mutex fLock;                ///< Protects the free list
+   std::vector<RBlock> fFreeBlocks; ///< Released blocks ready for reuse
+   std::size_t fCachedBytes = 0;    ///< Sum of the sizes of the free blocks
+   std::size_t fMaxCachedBytes;     ///< Free blocks beyond this size are returned to the system
+
+   RAlignedBlockPool();
+   RAlignedBlockPool(const RAlignedBlockPool &) = delete;
+   RAlignedBlockPool &operator=(const RAlignedBlockPool &) = delete;
+
+   static char *Allocate(std::size_t size);
+   static void Deallocate(char *buffer, std::size_t size);
+   void Release(char *buffer, std::size_t size);
+
+public:
+   /// The pool is never destroyed, such that blocks can outlive static destruction.
+   static RAlignedBlockPool &Instance();
+
+   /// Rounds `size` up to the granularity used for blocks of that size
+   static std::size_t RoundUp(std::size_t size);
+
+   /// Returns a block of at least `size` bytes.  The block goes back to the pool when the last copy of the
+   /// returned pointer is gone.  Returns nullptr if the memory cannot be allocated.
+   std::shared_ptr<char> Acquire(std::size_t size);
+
+   std::size_t GetCachedBytes();
+   std::size_t GetMaxCachedBytes();
+   /// Set the number of bytes kept in released blocks; excess blocks are freed immediately.
+   void SetMaxCachedBytes(std::size_t maxCachedBytes);
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
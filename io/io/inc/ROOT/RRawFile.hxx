@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -50,6 +51,9 @@ public:
    /// Map() and Unmap() are implemented
    static constexpr int kFeatureHasMmap = 0x02;
 
+   /// By default, ReadV() coalesces requests that are less than 32kB apart
+   static constexpr std::size_t kDefaultReadVMaxGap = 32 * 1024;
+
    /// On construction, an ROptions parameter can customize the RRawFile behavior
    struct ROptions {
       ELineBreaks fLineBreak;
@@ -58,7 +62,13 @@ public:
        * that the protocol-dependent default block size should be used.
        */
       int fBlockSize;
-      ROptions() : fLineBreak(ELineBreaks::kAuto), fBlockSize(-1) {}
+      /**
+       * ReadV() merges requests whose byte ranges are at most fReadVMaxGap bytes apart into a single read
+       * operation. The bytes in the gaps are read and discarded, which trades a small overhead of transferred data
+       * for a smaller number of read calls. A value of zero merges only adjacent byte ranges.
+       */
+      std::size_t fReadVMaxGap;
+      ROptions() : fLineBreak(ELineBreaks::kAuto), fBlockSize(-1), fReadVMaxGap(kDefaultReadVMaxGap) {}
    };
 
    /// Used for vector reads from multiple offsets into multiple buffers. This is unlike readv(), which scatters a
@@ -74,6 +84,17 @@ public:
       std::size_t fOutBytes = 0;
    };
 
+   /// A contiguous byte range of the file that covers one or several requests of a vector read
+   struct RCoalescedRange {
+      /// The file offset of the first byte of the first request
+      std::uint64_t fOffset = 0;
+      /// The number of bytes from fOffset to the end of the last request, including the gaps
+      std::size_t fSize = 0;
+      /// The requests served by the range, given as a slice [fFirstReq, fFirstReq + fNReq) of the sorted requests
+      std::size_t fFirstReq = 0;
+      std::size_t fNReq = 0;
+   };
+
 private:
    /// Don't change without adapting ReadAt()
    static constexpr unsigned int kNumBlockBuffers = 2;
@@ -130,9 +151,18 @@ protected:
    /// Derived classes with mmap support must be able to unmap the memory area handed out by Map()
    virtual void UnmapImpl(void *region, size_t nbytes);
 
-   /// By default implemented as a loop of ReadAt calls but can be overwritten, e.g. XRootD or DAVIX implementations
+   /// By default implemented as a loop of ReadAt calls over the coalesced byte ranges but can be overwritten,
+   /// e.g. XRootD or DAVIX implementations
    virtual void ReadVImpl(RIOVec *ioVec, unsigned int nReq);
 
+   /**
+    * Helper for ReadVImpl(): sorts the requests by file offset into sortedReqs and groups them into byte ranges
+    * such that the gap between consecutive requests within a range is at most fOptions.fReadVMaxGap.
+    * Overlapping requests are put into separate ranges.
+    */
+   std::vector<RCoalescedRange>
+   CoalesceRequests(RIOVec *ioVec, unsigned int nReq, std::vector<RIOVec *> &sortedReqs) const;
+
 public:
    RRawFile(std::string_view url, ROptions options);
    RRawFile(const RRawFile &) = delete;
@@ -161,7 +191,8 @@ public:
    /// Returns the size of the file
    std::uint64_t GetSize();
 
-   /// Opens the file if necessary and calls ReadVImpl
+   /// Opens the file if necessary and calls ReadVImpl. Requests to close-by byte ranges are served by a single
+   /// read operation, see ROptions::fReadVMaxGap.
    void ReadV(RIOVec *ioVec, unsigned int nReq);
 
    /// Memory mapping according to POSIX standard; in particular, new mappings of the same range replace older ones.
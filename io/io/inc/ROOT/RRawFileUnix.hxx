@@ -26,7 +26,7 @@ namespace Internal {
  * \ingroup IO
  *
  * The RRawFileUnix class uses POSIX calls to read from a mounted file system. Thus the path name can refer,
- * for instance, to a named pipe instead of a regular file.
+ * for instance, to a named pipe instead of a regular file. Vector reads scatter close-by byte ranges with preadv().
  */
 class RRawFileUnix : public RRawFile {
 private:
@@ -38,6 +38,8 @@ protected:
    std::uint64_t GetSizeImpl() final;
    void *MapImpl(size_t nbytes, std::uint64_t offset, std::uint64_t &mapdOffset) final;
    void UnmapImpl(void *region, size_t nbytes) final;
+   /// Reads the coalesced byte ranges of the requests with preadv(), one system call per range
+   void ReadVImpl(RIOVec *ioVec, unsigned int nReq) final;
 
 public:
    RRawFileUnix(std::string_view url, RRawFile::ROptions options);
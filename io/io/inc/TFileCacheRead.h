@@ -16,6 +16,8 @@
 
 #include "TFile.h"
 
+#include <memory>
+
 class TBranch;
 class TFilePrefetch;
 
@@ -70,6 +72,9 @@ protected:
    Bool_t         fBIsSorted;
    Bool_t         fBIsTransferred;
 
+   Bool_t         fZeroCopy{kFALSE}; ///<! Read into pooled blocks that baskets decompress from directly
+   std::shared_ptr<char> fBlock;     ///<! Pooled block holding the prefetched blocks when fZeroCopy is set
+
    void SetEnablePrefetchingImpl(Bool_t setPrefetching = kFALSE); // Can not be virtual as it is called from the constructor.
 
 private:
@@ -100,6 +105,7 @@ public:
    virtual void        SetEnablePrefetching(Bool_t setPrefetching = kFALSE);
    virtual Bool_t      IsEnablePrefetching() const { return fEnablePrefetching; };
    virtual Bool_t      IsLearning() const {return kFALSE;}
+           Bool_t      IsZeroCopy() const { return fZeroCopy && !fAsyncReading && !fEnablePrefetching; }
    virtual Int_t       LearnBranch(TBranch * /*b*/, Bool_t /*subbranches*/ = kFALSE) { return 0; }
    virtual void        Prefetch(Long64_t pos, Int_t len);
    virtual void        Print(Option_t *option="") const;
@@ -107,9 +113,11 @@ public:
    virtual Int_t       ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, Int_t &loc);
    virtual Int_t       ReadBufferExtPrefetch(char *buf, Long64_t pos, Int_t len, Int_t &loc);
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
+   virtual Int_t       ReadBufferView(Long64_t pos, Int_t len, std::shared_ptr<const char> &view);
    virtual Int_t       SetBufferSize(Int_t buffersize);
    virtual void        SetFile(TFile *file, TFile::ECacheAction action = TFile::kDisconnect);
    virtual void        SetSkipZip(Bool_t /*skip*/ = kTRUE) {} // This function is only used by TTreeCacheUnzip (ignore it)
+   virtual void        SetZeroCopy(Bool_t zeroCopy = kTRUE);
    virtual void        Sort();
    virtual void        SecondSort();                          //Method used to sort and merge the chunks in the second block
    virtual void        SecondPrefetch(Long64_t, Int_t);       //Used to add chunks to the second block
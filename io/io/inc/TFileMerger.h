@@ -40,6 +40,7 @@ protected:
    TFile         *fOutputFile{nullptr};       ///< The outputfile for merging
    TString        fOutputFilename;            ///< The name of the outputfile for merging
    Bool_t         fFastMethod{kTRUE};         ///< True if using Fast merging algorithm (default)
+   Bool_t         fFastRecompress{kFALSE};    ///< True if the fast merging recompresses the baskets when the compression changes (default kFALSE)
    Bool_t         fNoTrees{kFALSE};           ///< True if Trees should not be merged (default is kFALSE)
    Bool_t         fExplicitCompLevel{kFALSE}; ///< True if the user explicitly requested a compressio level change (default kFALSE)
    Bool_t         fCompressionChange{kFALSE}; ///< True if the output and input have different compression level (default kFALSE)
@@ -114,10 +115,11 @@ public:
    virtual Bool_t Merge(Bool_t = kTRUE);
    virtual Bool_t PartialMerge(Int_t type = kAll | kIncremental);
    virtual void   SetFastMethod(Bool_t fast=kTRUE)  {fFastMethod = fast;}
+   virtual void   SetFastRecompress(Bool_t recompress=kTRUE) {fFastRecompress = recompress;}
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
    virtual void        RecursiveRemove(TObject *obj);
 
-   ClassDef(TFileMerger, 6)  // File copying and merging services
+   ClassDef(TFileMerger, 7)  // File copying and merging services
 };
 
 #endif
@@ -70,6 +70,7 @@ namespace TStreamerInfoActions {
    typedef Int_t (*TStreamerInfoAction_t)(TBuffer &buf, void *obj, const TConfiguration *conf);
    typedef Int_t (*TStreamerInfoVecPtrLoopAction_t)(TBuffer &buf, void *iter, const void *end, const TConfiguration *conf);
    typedef Int_t (*TStreamerInfoLoopAction_t)(TBuffer &buf, void *iter, const void *end, const TLoopConfiguration *loopconf, const TConfiguration *conf);
+   typedef void (*TStreamerInfoKernel_t)(TBuffer &buf, void *obj);
 
    class TConfiguredAction : public TObject {
    public:
@@ -191,6 +192,7 @@ namespace TStreamerInfoActions {
       TVirtualStreamerInfo *fStreamerInfo; ///< StreamerInfo used to derive these actions.
       TLoopConfiguration   *fLoopConfig;   ///< If this is a bundle of memberwise streaming action, this configures the looping
       ActionContainer_t     fActions;
+      TStreamerInfoKernel_t fKernel = nullptr; ///< Generated function equivalent to the whole (object-wise) sequence, if any.
 
       void AddToOffset(Int_t delta);
       void SetMissing();
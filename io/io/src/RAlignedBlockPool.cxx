@@ -0,0 +1,135 @@
+// @(#)root/io:$Id$
+// Author: agent <agent@local>, 2020-06-16
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RAlignedBlockPool.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+ROOT::Internal::RAlignedBlockPool::RAlignedBlockPool() : fMaxCachedBytes(256 * kHugePageSize) {}
+
+ROOT::Internal::RAlignedBlockPool &ROOT::Internal::RAlignedBlockPool::Instance()
+{
+   static RAlignedBlockPool *pool = new RAlignedBlockPool();
+   return *pool;
+}
+
+std::size_t ROOT::Internal::RAlignedBlockPool::RoundUp(std::size_t size)
+{
+   const std::size_t granularity = (size >= kHugePageSize) ? kHugePageSize : kPageSize;
+   return std::max(granularity, (size + granularity - 1) / granularity * granularity);
+}
+
+char *ROOT::Internal::RAlignedBlockPool::Allocate(std::size_t size)
+{
+   const std::size_t alignment = (size >= kHugePageSize) ? kHugePageSize : kPageSize;
+#ifdef _WIN32
+   return static_cast<char *>(_aligned_malloc(size, alignment));
+#else
+   void *buffer = nullptr;
+   if (posix_memalign(&buffer, alignment, size) != 0)
+      return nullptr;
+#ifdef MADV_HUGEPAGE
+   // Only a hint: the kernel may or may not back the block with huge pages
+   if (alignment == kHugePageSize)
+      madvise(buffer, size, MADV_HUGEPAGE);
+#endif
+   return static_cast<char *>(buffer);
+#endif
+}
+
+void ROOT::Internal::RAlignedBlockPool::Deallocate(char *buffer, std::size_t /* size */)
+{
+#ifdef _WIN32
+   _aligned_free(buffer);
+#else
+   free(buffer);
+#endif
+}
+
+std::shared_ptr<char> ROOT::Internal::RAlignedBlockPool::Acquire(std::size_t size)
+{
+   size = RoundUp(size);
+   char *buffer = nullptr;
+   std::size_t bufferSize = 0;
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      // Best fit among the free blocks, but do not waste more than half of a recycled block
+      auto best = fFreeBlocks.end();
+      for (auto itr = fFreeBlocks.begin(); itr != fFreeBlocks.end(); ++itr) {
+         if (itr->fSize < size || itr->fSize > 2 * size)
+            continue;
+         if (best == fFreeBlocks.end() || itr->fSize < best->fSize)
+            best = itr;
+      }
+      if (best != fFreeBlocks.end()) {
+         buffer = best->fBuffer;
+         bufferSize = best->fSize;
+         fCachedBytes -= bufferSize;
+         *best = fFreeBlocks.back();
+         fFreeBlocks.pop_back();
+      }
+   }
+   if (!buffer) {
+      buffer = Allocate(size);
+      bufferSize = size;
+      if (!buffer)
+         return nullptr;
+   }
+   return std::shared_ptr<char>(buffer, [this, bufferSize](char *b) { Release(b, bufferSize); });
+}
+
+void ROOT::Internal::RAlignedBlockPool::Release(char *buffer, std::size_t size)
+{
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      if (fCachedBytes + size <= fMaxCachedBytes) {
+         fFreeBlocks.push_back({buffer, size});
+         fCachedBytes += size;
+         return;
+      }
+   }
+   Deallocate(buffer, size);
+}
+
+std::size_t ROOT::Internal::RAlignedBlockPool::GetCachedBytes()
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   return fCachedBytes;
+}
+
+std::size_t ROOT::Internal::RAlignedBlockPool::GetMaxCachedBytes()
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   return fMaxCachedBytes;
+}
+
+void ROOT::Internal::RAlignedBlockPool::SetMaxCachedBytes(std::size_t maxCachedBytes)
+{
+   std::vector<RBlock> excess;
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      fMaxCachedBytes = maxCachedBytes;
+      while (fCachedBytes > fMaxCachedBytes) {
+         excess.push_back(fFreeBlocks.back());
+         fCachedBytes -= fFreeBlocks.back().fSize;
+         fFreeBlocks.pop_back();
+      }
+   }
+   for (const auto &block : excess)
+      Deallocate(block.fBuffer, block.fSize);
+}
@@ -29,6 +29,7 @@
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace {
 const char *kTransportSeparator = "://";
@@ -98,10 +99,60 @@ void *ROOT::Internal::RRawFile::MapImpl(size_t /* nbytes */, std::uint64_t /* of
    throw std::runtime_error("Memory mapping unsupported");
 }
 
+std::vector<ROOT::Internal::RRawFile::RCoalescedRange>
+ROOT::Internal::RRawFile::CoalesceRequests(RIOVec *ioVec, unsigned int nReq, std::vector<RIOVec *> &sortedReqs) const
+{
+   sortedReqs.clear();
+   sortedReqs.reserve(nReq);
+   for (unsigned int i = 0; i < nReq; ++i)
+      sortedReqs.emplace_back(&ioVec[i]);
+   std::stable_sort(sortedReqs.begin(), sortedReqs.end(),
+                    [](const RIOVec *a, const RIOVec *b) { return a->fOffset < b->fOffset; });
+
+   std::vector<RCoalescedRange> ranges;
+   for (std::size_t i = 0; i < sortedReqs.size(); ++i) {
+      const auto req = sortedReqs[i];
+      if (!ranges.empty()) {
+         auto &range = ranges.back();
+         const std::uint64_t rangeEnd = range.fOffset + range.fSize;
+         if ((req->fOffset >= rangeEnd) && (req->fOffset - rangeEnd <= fOptions.fReadVMaxGap)) {
+            range.fSize = req->fOffset + req->fSize - range.fOffset;
+            range.fNReq++;
+            continue;
+         }
+      }
+      RCoalescedRange range;
+      range.fOffset = req->fOffset;
+      range.fSize = req->fSize;
+      range.fFirstReq = i;
+      range.fNReq = 1;
+      ranges.emplace_back(range);
+   }
+   return ranges;
+}
+
 void ROOT::Internal::RRawFile::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
 {
-   for (unsigned i = 0; i < nReq; ++i) {
-      ioVec[i].fOutBytes = ReadAt(ioVec[i].fBuffer, ioVec[i].fSize, ioVec[i].fOffset);
+   std::vector<RIOVec *> sortedReqs;
+   const auto ranges = CoalesceRequests(ioVec, nReq, sortedReqs);
+
+   std::vector<unsigned char> rangeBuffer;
+   for (const auto &range : ranges) {
+      if (range.fNReq == 1) {
+         auto req = sortedReqs[range.fFirstReq];
+         req->fOutBytes = ReadAt(req->fBuffer, req->fSize, req->fOffset);
+         continue;
+      }
+
+      // Read the entire range in one go and scatter it into the destination buffers
+      rangeBuffer.resize(range.fSize);
+      const auto nbytes = ReadAt(rangeBuffer.data(), range.fSize, range.fOffset);
+      for (std::size_t i = range.fFirstReq; i < range.fFirstReq + range.fNReq; ++i) {
+         auto req = sortedReqs[i];
+         const std::size_t posInRange = req->fOffset - range.fOffset;
+         req->fOutBytes = (nbytes > posInRange) ? std::min(req->fSize, nbytes - posInRange) : 0;
+         memcpy(req->fBuffer, rangeBuffer.data() + posInRange, req->fOutBytes);
+      }
    }
 }
 
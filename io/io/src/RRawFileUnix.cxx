@@ -14,15 +14,18 @@
 
 #include "TError.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace {
@@ -109,6 +112,79 @@ size_t ROOT::Internal::RRawFileUnix::ReadAtImpl(void *buffer, size_t nbytes, std
    return total_bytes;
 }
 
+void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
+{
+#ifdef __APPLE__
+   // preadv() is not available on all supported macOS versions
+   RRawFile::ReadVImpl(ioVec, nReq);
+#else
+   static const int kMaxIov = std::max(1L, sysconf(_SC_IOV_MAX));
+
+   std::vector<RIOVec *> sortedReqs;
+   const auto ranges = CoalesceRequests(ioVec, nReq, sortedReqs);
+
+   // The bytes in the gaps between the requests of a range are scattered into a scratch buffer and discarded
+   std::vector<unsigned char> gapBuffer;
+   std::vector<struct iovec> iov;
+   for (const auto &range : ranges) {
+      const auto firstReq = sortedReqs.begin() + range.fFirstReq;
+      const auto lastReq = firstReq + range.fNReq;
+
+      // Size the scratch buffer before taking pointers into it
+      std::uint64_t pos = range.fOffset;
+      for (auto itr = firstReq; itr < lastReq; ++itr) {
+         if (gapBuffer.size() < (*itr)->fOffset - pos)
+            gapBuffer.resize((*itr)->fOffset - pos);
+         pos = (*itr)->fOffset + (*itr)->fSize;
+      }
+
+      iov.clear();
+      pos = range.fOffset;
+      for (auto itr = firstReq; itr < lastReq; ++itr) {
+         const auto req = *itr;
+         if (req->fOffset > pos)
+            iov.push_back({gapBuffer.data(), static_cast<std::size_t>(req->fOffset - pos)});
+         if (req->fSize > 0)
+            iov.push_back({req->fBuffer, req->fSize});
+         pos = req->fOffset + req->fSize;
+      }
+
+      std::size_t nbytes = 0;
+      struct iovec *iovPtr = iov.data();
+      int iovCnt = iov.size();
+      while (iovCnt > 0) {
+         ssize_t res = preadv(fFileDes, iovPtr, std::min(iovCnt, kMaxIov), range.fOffset + nbytes);
+         if (res < 0) {
+            if (errno == EINTR)
+               continue;
+            throw std::runtime_error("Cannot read from '" + fUrl + "', error: " + std::string(strerror(errno)));
+         } else if (res == 0) {
+            break;
+         }
+         nbytes += res;
+         // Skip the completely filled buffers and advance into a partially filled one
+         std::size_t remaining = res;
+         while ((iovCnt > 0) && (remaining >= iovPtr->iov_len)) {
+            remaining -= iovPtr->iov_len;
+            ++iovPtr;
+            --iovCnt;
+         }
+         if (remaining > 0) {
+            R__ASSERT(iovCnt > 0);
+            iovPtr->iov_base = reinterpret_cast<unsigned char *>(iovPtr->iov_base) + remaining;
+            iovPtr->iov_len -= remaining;
+         }
+      }
+
+      for (auto itr = firstReq; itr < lastReq; ++itr) {
+         const auto req = *itr;
+         const std::size_t posInRange = req->fOffset - range.fOffset;
+         req->fOutBytes = (nbytes > posInRange) ? std::min(req->fSize, nbytes - posInRange) : 0;
+      }
+   }
+#endif
+}
+
 void ROOT::Internal::RRawFileUnix::UnmapImpl(void *region, size_t nbytes)
 {
    int rv = munmap(region, nbytes);
@@ -3555,6 +3555,9 @@ Int_t TBufferFile::ApplySequence(const TStreamerInfoActions::TActionSequence &se
          (*iter)(*this,obj);
       }
 
+   } else if (sequence.fKernel) {
+      // The generated function streams all the members at once.
+      sequence.fKernel(*this,obj);
    } else {
       //loop on all active members
       TStreamerInfoActions::ActionContainer_t::const_iterator end = sequence.fActions.end();
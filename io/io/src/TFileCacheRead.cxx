@@ -23,8 +23,15 @@
  TXNetFile and TWebFile (via TFile::ReadBuffers()).
  When processing TTree, TChain, a specialized class TTreeCache that
  derives from this class is automatically created.
+
+ In zero-copy mode (see SetZeroCopy()) the prefetched blocks are read with
+ a single vectored request into a pooled, huge-page aligned memory block
+ instead of fBuffer.  Consumers can then obtain a view into that block with
+ ReadBufferView() and decompress directly from it; the view keeps the block
+ alive even once the cache has moved on to the next one.
 */
 
+#include "ROOT/RAlignedBlockPool.hxx"
 #include "TEnv.h"
 #include "TFile.h"
 #include "TFileCacheRead.h"
@@ -376,6 +383,52 @@ Int_t TFileCacheRead::ReadBuffer(char *buf, Long64_t pos, Int_t len)
    return rc;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Obtain a view of the block at pos without copying it (zero-copy mode only).
+///
+/// On success, 'view' points to the 'len' bytes of the block and shares the
+/// ownership of the cache's memory: the bytes remain valid as long as the view
+/// is held, even if the cache is refilled or deleted in the meantime.
+/// Returns -1 in case of read error, 0 in case not in cache (or if the cache
+/// is not in zero-copy mode), 1 in case the view was set.
+
+Int_t TFileCacheRead::ReadBufferView(Long64_t pos, Int_t len, std::shared_ptr<const char> &view)
+{
+   view.reset();
+   if (!IsZeroCopy())
+      return 0;
+
+   // A buffer in the write cache has not reached the file (and our block) yet; hand out a copy.
+   if (TFileCacheWrite *cachew = fFile->GetCacheWrite()) {
+      auto copy = ROOT::Internal::RAlignedBlockPool::Instance().Acquire(len);
+      if (copy && cachew->ReadBuffer(copy.get(), pos, len) == 0) {
+         fFile->SetOffset(pos+len);
+         view = copy;
+         return 1;
+      }
+   }
+
+   Long64_t fileBytesRead0 = fFile->GetBytesRead();
+   Long64_t fileBytesReadExtra0 = fFile->GetBytesReadExtra();
+   Int_t fileReadCalls0 = fFile->GetReadCalls();
+
+   Int_t loc = -1;
+   Int_t rc = ReadBufferExtNormal(nullptr, pos, len, loc);
+
+   fBytesRead += fFile->GetBytesRead() - fileBytesRead0;
+   fBytesReadExtra += fFile->GetBytesReadExtra() - fileBytesReadExtra0;
+   fReadCalls += fFile->GetReadCalls() - fileReadCalls0;
+
+   if (rc == 1) {
+      if (!fBlock || !fIsTransferred)
+         return 0;
+      // Aliasing constructor: shares the ownership of the whole block
+      view = std::shared_ptr<const char>(fBlock, fBlock.get() + fSeekPos[loc]);
+      fFile->SetOffset(pos+len);
+   }
+   return rc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t TFileCacheRead::ReadBufferExt(char *buf, Long64_t pos, Int_t len, Int_t &loc)
@@ -459,7 +512,17 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
       // If ReadBufferAsync is not supported by this implementation...
       if (!fAsyncReading) {
          // Then we use the vectored read to read everything now
-         if (fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
+         char *target = fBuffer;
+         if (fZeroCopy) {
+            // Never overwrite a block that might still be referenced by a view
+            fBlock = ROOT::Internal::RAlignedBlockPool::Instance().Acquire(fSeekPos[fNseek-1] + fSeekSortLen[fNseek-1]);
+            if (!fBlock) {
+               Error("ReadBufferExtNormal", "Unable to allocate a block of %d bytes", fNtot);
+               return -1;
+            }
+            target = fBlock.get();
+         }
+         if (fFile->ReadBuffers(target,fPos,fLen,fNb)) {
             return -1;
          }
          fIsTransferred = kTRUE;
@@ -479,7 +542,8 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
 
    // in case we are writing and reading to/from this file, we much check
    // if this buffer is in the write cache (not yet written to the file)
-   if (TFileCacheWrite *cachew = fFile->GetCacheWrite()) {
+   // (ReadBufferView checks the write cache on its own and passes no buffer)
+   if (TFileCacheWrite *cachew = buf ? fFile->GetCacheWrite() : nullptr) {
       if (cachew->ReadBuffer(buf,pos,len) == 0) {
          fFile->SetOffset(pos+len);
          return 1;
@@ -528,7 +592,8 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
 
       if (loc >= 0 && loc <fNseek && pos == fSeekSort[loc]) {
          if (buf) {
-            memcpy(buf,&fBuffer[fSeekPos[loc]],len);
+            const char *source = fZeroCopy ? fBlock.get() : fBuffer;
+            memcpy(buf,&source[fSeekPos[loc]],len);
             fFile->SetOffset(pos+len);
          }
          return 1;
@@ -550,7 +615,8 @@ void TFileCacheRead::SetFile(TFile *file, TFile::ECacheAction action)
       // we use sync primitives, hence we need the local buffer
       if (file && file->ReadBufferAsync(0, 0)) {
          fAsyncReading = kFALSE;
-         fBuffer       = new char[fBufferSize];
+         if (!fZeroCopy)
+            fBuffer    = new char[fBufferSize];
       }
    }
 
@@ -596,7 +662,8 @@ void TFileCacheRead::Sort()
       fBuffer = 0;
       // If ReadBufferAsync is not supported by this implementation
       // it means that we are using sync primitives, hence we need the local buffer
-      if (!fAsyncReading)
+      // (unless we read into pooled blocks)
+      if (!fAsyncReading && !fZeroCopy)
          fBuffer = new char[fBufferSize];
    }
    fPos[0]  = fSeekSort[0];
@@ -729,7 +796,7 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
    }
 
    char *np = 0;
-   if (!fEnablePrefetching && !fAsyncReading) {
+   if (!fEnablePrefetching && !fAsyncReading && !fZeroCopy) {
       char *pres = 0;
       if (fIsTransferred) {
          // will need to preserve buffer data
@@ -809,10 +876,37 @@ void TFileCacheRead::SetEnablePrefetchingImpl(Bool_t setPrefetching)
          if (fFile && !(fFile->ReadBufferAsync(0, 0)))
             fAsyncReading = kTRUE;
          }
-      if (!fAsyncReading && fBuffer == 0) {
+      if (!fAsyncReading && !fZeroCopy && fBuffer == 0) {
          // we use sync primitives, hence we need the local buffer
          fBuffer = new char[fBufferSize];
       }
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the zero-copy mode.
+///
+/// In zero-copy mode, the prefetched blocks are read with one vectored read into
+/// a pooled memory block (see ROOT::Internal::RAlignedBlockPool) that is aligned
+/// to huge pages if large enough.  Every refill uses a fresh block, such that
+/// baskets holding a view obtained from ReadBufferView() can decompress
+/// directly out of the block.  The mode has no effect when asynchronous reading
+/// or prefetching is enabled.
+
+void TFileCacheRead::SetZeroCopy(Bool_t zeroCopy)
+{
+   if (zeroCopy == fZeroCopy)
+      return;
+
+   // Drop the current content: it lives either in fBuffer or in fBlock
+   Prefetch(0, 0);
+   fZeroCopy = zeroCopy;
+   if (fZeroCopy) {
+      delete [] fBuffer;
+      fBuffer = 0;
+   } else {
+      fBlock.reset();
+      if (!fEnablePrefetching && !fAsyncReading && fBuffer == 0)
+         fBuffer = new char[fBufferSize];
+   }
+}
@@ -408,6 +408,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
    info.fOptions = fMergeOptions;
    if (fFastMethod && ((type&kKeepCompression) || !fCompressionChange) ) {
       info.fOptions.Append(" fast");
+   } else if (fFastMethod && fFastRecompress) {
+      // The baskets are recompressed without being unstreamed.
+      info.fOptions.Append(" fast recompress");
    }
 
    TFile      *current_file;
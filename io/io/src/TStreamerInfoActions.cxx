@@ -26,6 +26,9 @@
 #include "TProcessID.h"
 #include "TFile.h"
 
+#include <atomic>
+#include <cctype>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -3031,6 +3034,9 @@ void TStreamerInfo::Compile()
    if (fWriteText) fWriteText->fActions.clear();
    else fWriteText = new TStreamerInfoActions::TActionSequence(this,ndata);
 
+   fReadObjectWise->fKernel = nullptr;
+   fWriteObjectWise->fKernel = nullptr;
+
    if (!ndata) {
       // This may be the case for empty classes (e.g., TAtt3D).
       // We still need to properly set the size of emulated classes (i.e. add the virtual table)
@@ -3207,6 +3213,11 @@ void TStreamerInfo::Compile()
    ComputeSize();
 
    fOptimized = isOptimized;
+
+   if (GetGenerateKernels()) {
+      GenerateKernels();
+   }
+
    SetIsCompiled();
 
    if (gDebug > 0) {
@@ -3214,6 +3225,158 @@ void TStreamerInfo::Compile()
    }
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of a numerical type as used in the name of the TBufferFile
+/// functions streaming it (e.g. "Int" for ReadInt), or nullptr if 'type' is not
+/// a numerical type that can be streamed as is.
+
+const char *R__KernelTypeName(Int_t type)
+{
+   switch (type) {
+      case TStreamerInfo::kBool:    return "Bool";
+      case TStreamerInfo::kChar:    return "Char";
+      case TStreamerInfo::kShort:   return "Short";
+      case TStreamerInfo::kInt:     return "Int";
+      case TStreamerInfo::kLong:    return "Long";
+      case TStreamerInfo::kLong64:  return "Long64";
+      case TStreamerInfo::kFloat:   return "Float";
+      case TStreamerInfo::kDouble:  return "Double";
+      case TStreamerInfo::kUChar:   return "UChar";
+      case TStreamerInfo::kUShort:  return "UShort";
+      case TStreamerInfo::kUInt:    return "UInt";
+      case TStreamerInfo::kULong:   return "ULong";
+      case TStreamerInfo::kULong64: return "ULong64";
+      default:                      return nullptr;
+   }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate, with the interpreter, one function reading and one function
+/// writing all the data members described by this StreamerInfo, and attach
+/// them to the object-wise action sequences.  TBufferFile::ApplySequence then
+/// calls them instead of looping over the actions: the members are streamed
+/// by straight-line code with the TBufferFile functions inlined.
+///
+/// The functions are only generated for classes with a dictionary whose
+/// members are of numerical types, fixed size arrays of them, TString or a
+/// TObject base class, and when the on-file layout needs no conversion.
+/// Otherwise, the action sequences are left untouched.
+///
+/// Return kTRUE if the functions were generated.
+
+Bool_t TStreamerInfo::GenerateKernels()
+{
+   if (!fClass || !fClass->IsLoaded() || fClass->GetCollectionProxy() || fClass->TestBit(TClass::kIsEmulation)
+       || !fReadObjectWise || !fWriteObjectWise || !fNfulldata || !gInterpreter) {
+      return kFALSE;
+   }
+   if (fReadObjectWise->fKernel && fWriteObjectWise->fKernel) {
+      return kTRUE;
+   }
+
+   TString read, write;
+   for (Int_t i = 0; i < fNfulldata; ++i) {
+      TCompInfo *compinfo = fCompFull[i];
+      TStreamerElement *element = compinfo->fElem;
+      if (!element || element->GetType() < 0) {
+         // The TObject streamer is ignored
+         continue;
+      }
+      if (compinfo->fOffset == kMissing || element->TestBit(TStreamerElement::kCache)
+          || element->TestBit(TStreamerElement::kWrite) || element->IsA() == TStreamerArtificial::Class()) {
+         return kFALSE;
+      }
+      Int_t type = compinfo->fType;
+      Int_t length = 1;
+      if (type > kOffsetL && type < kOffsetP) {
+         type -= kOffsetL;
+         length = element->GetArrayLength();
+      } else if (element->GetArrayLength() > 1) {
+         return kFALSE;
+      }
+      TString address = TString::Format("(addr + %d)", compinfo->fOffset);
+      if (const char *name = R__KernelTypeName(type)) {
+         if (length == 1) {
+            read += TString::Format("   b.TBufferFile::Read%s(*reinterpret_cast<%s_t *>%s);\n", name, name, address.Data());
+            write += TString::Format("   b.TBufferFile::Write%s(*reinterpret_cast<%s_t *>%s);\n", name, name, address.Data());
+         } else {
+            read += TString::Format("   b.TBufferFile::ReadFastArray(reinterpret_cast<%s_t *>%s, %d);\n", name,
+                                    address.Data(), length);
+            write += TString::Format("   b.TBufferFile::WriteFastArray(reinterpret_cast<%s_t *>%s, %d);\n", name,
+                                     address.Data(), length);
+         }
+      } else if (type == kDouble32 && element->GetFactor() == 0 && element->GetXmin() == 0) {
+         // Stored as a float
+         read += TString::Format("   for (Int_t i = 0; i < %d; ++i) {\n"
+                                 "      Float_t value;\n"
+                                 "      b.TBufferFile::ReadFloat(value);\n"
+                                 "      reinterpret_cast<Double_t *>%s[i] = value;\n"
+                                 "   }\n", length, address.Data());
+         write += TString::Format("   for (Int_t i = 0; i < %d; ++i)\n"
+                                  "      b.TBufferFile::WriteFloat(Float_t(reinterpret_cast<Double_t *>%s[i]));\n",
+                                  length, address.Data());
+      } else if (type == kTString && length == 1) {
+         read += TString::Format("   reinterpret_cast<TString *>%s->TString::Streamer(b);\n", address.Data());
+         write += TString::Format("   reinterpret_cast<TString *>%s->TString::Streamer(b);\n", address.Data());
+      } else if (type == kTObject && length == 1) {
+         read += TString::Format("   reinterpret_cast<TObject *>%s->TObject::Streamer(b);\n", address.Data());
+         write += TString::Format("   reinterpret_cast<TObject *>%s->TObject::Streamer(b);\n", address.Data());
+      } else {
+         return kFALSE;
+      }
+   }
+
+   // Each (class, StreamerInfo) pair gets its own functions.
+   static std::atomic<Int_t> kernelCount(0);
+   Int_t id = kernelCount++;
+   TString name = TString::Format("%s_v%d_%d", fClass->GetName(), fClassVersion, id);
+   for (Ssiz_t c = 0; c < name.Length(); ++c) {
+      if (!isalnum(name[c])) name[c] = '_';
+   }
+   TString code = TString::Format("#include \"TBufferFile.h\"\n"
+                                  "#include \"TObject.h\"\n"
+                                  "#include \"TString.h\"\n"
+                                  "namespace ROOT { namespace Internal { namespace StreamerKernels {\n"
+                                  "void Read_%s(TBuffer &buf, void *obj)\n"
+                                  "{\n"
+                                  "   TBufferFile &b = static_cast<TBufferFile &>(buf);\n"
+                                  "   char *addr = static_cast<char *>(obj);\n"
+                                  "%s"
+                                  "}\n"
+                                  "void Write_%s(TBuffer &buf, void *obj)\n"
+                                  "{\n"
+                                  "   TBufferFile &b = static_cast<TBufferFile &>(buf);\n"
+                                  "   char *addr = static_cast<char *>(obj);\n"
+                                  "%s"
+                                  "}\n"
+                                  "}}}\n",
+                                  name.Data(), read.Data(), name.Data(), write.Data());
+
+   R__LOCKGUARD(gInterpreterMutex);
+   if (!gInterpreter->Declare(code)) {
+      Warning("GenerateKernels", "Could not compile the streaming functions of %s version %d", GetName(), fClassVersion);
+      return kFALSE;
+   }
+   TInterpreter::EErrorCode error = TInterpreter::kNoError;
+   Long_t readKernel =
+      gInterpreter->Calc(TString::Format("(long)&ROOT::Internal::StreamerKernels::Read_%s", name.Data()), &error);
+   if (error != TInterpreter::kNoError || !readKernel) {
+      return kFALSE;
+   }
+   Long_t writeKernel =
+      gInterpreter->Calc(TString::Format("(long)&ROOT::Internal::StreamerKernels::Write_%s", name.Data()), &error);
+   if (error != TInterpreter::kNoError || !writeKernel) {
+      return kFALSE;
+   }
+   fReadObjectWise->fKernel = reinterpret_cast<TStreamerInfoActions::TStreamerInfoKernel_t>(readKernel);
+   fWriteObjectWise->fKernel = reinterpret_cast<TStreamerInfoActions::TStreamerInfoKernel_t>(writeKernel);
+   return kTRUE;
+}
+
 template <typename From>
 static void AddReadConvertAction(TStreamerInfoActions::TActionSequence *sequence, Int_t newtype, TConfiguration *conf)
 {
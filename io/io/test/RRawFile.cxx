@@ -168,6 +168,47 @@ TEST(RRawFile, ReadV)
 }
 
 
+TEST(RRawFile, ReadVCoalesce)
+{
+   RRawFile::ROptions options;
+   options.fBlockSize = 0;
+   options.fReadVMaxGap = 2;
+
+   // Given out of order; "a", "c", "ef" are coalesced, "k" stands alone, "x" and the short read "yz" are coalesced
+   const std::uint64_t offsets[] = {23, 0, 4, 2, 10, 24};
+   const std::size_t sizes[] = {1, 1, 2, 1, 1, 4};
+   const std::size_t expectedOutBytes[] = {1, 1, 2, 1, 1, 2};
+   char buffer[10];
+   RRawFile::RIOVec iovec[6];
+   auto fnPrepare = [&]() {
+      std::size_t bufPos = 0;
+      for (unsigned i = 0; i < 6; ++i) {
+         iovec[i].fBuffer = &buffer[bufPos];
+         iovec[i].fOffset = offsets[i];
+         iovec[i].fSize = sizes[i];
+         iovec[i].fOutBytes = 0;
+         bufPos += sizes[i];
+      }
+   };
+
+   std::unique_ptr<RRawFileMock> m(new RRawFileMock("abcdefghijklmnopqrstuvwxyz", options));
+   fnPrepare();
+   m->ReadV(iovec, 6);
+   EXPECT_EQ(3u, m->fNumReadAt);
+   for (unsigned i = 0; i < 6; ++i)
+      EXPECT_EQ(expectedOutBytes[i], iovec[i].fOutBytes);
+   EXPECT_EQ("xaefckyz", std::string(buffer, 8));
+
+   FileRaii readvGuard("test_rawfile_readv_coalesce", "abcdefghijklmnopqrstuvwxyz");
+   auto f = RRawFile::Create("test_rawfile_readv_coalesce", options);
+   fnPrepare();
+   f->ReadV(iovec, 6);
+   for (unsigned i = 0; i < 6; ++i)
+      EXPECT_EQ(expectedOutBytes[i], iovec[i].fOutBytes);
+   EXPECT_EQ("xaefckyz", std::string(buffer, 8));
+}
+
+
 TEST(RRawFile, SplitUrl)
 {
    EXPECT_STREQ("C:\\Data\\events.root", RRawFile::GetLocation("C:\\Data\\events.root").c_str());
@@ -0,0 +1,155 @@
+#include "TAttAxis.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TNamed.h"
+#include "TStopwatch.h"
+#include "TStreamerElement.h"
+#include "TStreamerInfo.h"
+#include "TStreamerInfoActions.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+namespace {
+
+TStreamerInfo *GetCompiledInfo(TClass *cl)
+{
+   auto info = static_cast<TStreamerInfo *>(cl->GetStreamerInfo());
+   if (info && !info->IsCompiled())
+      info->Compile();
+   return info;
+}
+
+/// Serialize the object with and without the generated functions; both must produce the same bytes
+void CheckSameBytes(TClass *cl, void *obj)
+{
+   auto info = GetCompiledInfo(cl);
+   ASSERT_NE(nullptr, info);
+   TBufferFile withKernel(TBuffer::kWrite);
+   withKernel.WriteClassBuffer(cl, obj);
+
+   auto kernel = info->GetWriteObjectWiseActions()->fKernel;
+   info->GetWriteObjectWiseActions()->fKernel = nullptr;
+   TBufferFile withActions(TBuffer::kWrite);
+   withActions.WriteClassBuffer(cl, obj);
+   info->GetWriteObjectWiseActions()->fKernel = kernel;
+
+   ASSERT_EQ(withActions.Length(), withKernel.Length());
+   EXPECT_EQ(0, memcmp(withActions.Buffer(), withKernel.Buffer(), withKernel.Length()));
+}
+
+/// Register the StreamerInfo of TStopwatch as read from a file in which fTotalRealTime is a Float_t, with the given
+/// class version, and return it once built for reading into the in-memory class
+TStreamerInfo *MakeInfoWithFloatOnFile(Int_t version)
+{
+   auto cl = TStopwatch::Class();
+   auto onFile = static_cast<TStreamerInfo *>(GetCompiledInfo(cl)->Clone());
+   onFile->SetClassVersion(version);
+   auto element = static_cast<TStreamerElement *>(onFile->GetElements()->FindObject("fTotalRealTime"));
+   if (!element)
+      return nullptr;
+   element->SetType(TVirtualStreamerInfo::kFloat);
+   element->SetTypeName("Float_t");
+   element->SetSize(sizeof(Float_t));
+   // As TFile::ReadStreamerInfo does
+   onFile->BuildCheck();
+   return static_cast<TStreamerInfo *>(cl->GetStreamerInfo(version));
+}
+
+} // anonymous namespace
+
+TEST(TStreamerInfoKernels, NumericalMembers)
+{
+   auto cl = TAttAxis::Class();
+   auto info = GetCompiledInfo(cl);
+   ASSERT_NE(nullptr, info);
+   ASSERT_TRUE(info->GenerateKernels());
+   EXPECT_NE(nullptr, info->GetReadObjectWiseActions()->fKernel);
+   EXPECT_NE(nullptr, info->GetWriteObjectWiseActions()->fKernel);
+
+   TAttAxis axis;
+   axis.SetNdivisions(508);
+   axis.SetAxisColor(3);
+   axis.SetLabelFont(62);
+   axis.SetLabelSize(0.07);
+   axis.SetTitleOffset(1.4);
+   CheckSameBytes(cl, &axis);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteClassBuffer(cl, &axis);
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   TAttAxis copy;
+   buf.ReadClassBuffer(cl, &copy, nullptr);
+   EXPECT_EQ(axis.GetNdivisions(), copy.GetNdivisions());
+   EXPECT_EQ(axis.GetAxisColor(), copy.GetAxisColor());
+   EXPECT_EQ(axis.GetLabelFont(), copy.GetLabelFont());
+   EXPECT_FLOAT_EQ(axis.GetLabelSize(), copy.GetLabelSize());
+   EXPECT_FLOAT_EQ(axis.GetTitleOffset(), copy.GetTitleOffset());
+}
+
+TEST(TStreamerInfoKernels, TObjectAndTString)
+{
+   auto cl = TNamed::Class();
+   auto info = GetCompiledInfo(cl);
+   ASSERT_NE(nullptr, info);
+   ASSERT_TRUE(info->GenerateKernels());
+
+   TNamed named("name", "a somewhat longer title");
+   named.SetUniqueID(42);
+   CheckSameBytes(cl, &named);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteClassBuffer(cl, &named);
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   TNamed copy;
+   buf.ReadClassBuffer(cl, &copy, nullptr);
+   EXPECT_STREQ("name", copy.GetName());
+   EXPECT_STREQ("a somewhat longer title", copy.GetTitle());
+   EXPECT_EQ(42u, copy.GetUniqueID());
+}
+
+TEST(TStreamerInfoKernels, NotEligible)
+{
+   // Base classes other than TObject are not supported
+   auto info = GetCompiledInfo(TClass::GetClass("TList"));
+   ASSERT_NE(nullptr, info);
+   EXPECT_FALSE(info->GenerateKernels());
+   EXPECT_EQ(nullptr, info->GetReadObjectWiseActions()->fKernel);
+}
+
+TEST(TStreamerInfoKernels, Conversion)
+{
+   constexpr Int_t kVersion = 2;
+   const Bool_t generate = TVirtualStreamerInfo::SetGenerateKernels(kTRUE);
+   auto info = MakeInfoWithFloatOnFile(kVersion);
+   TVirtualStreamerInfo::SetGenerateKernels(generate);
+   ASSERT_NE(nullptr, info);
+   ASSERT_EQ(kVersion, info->GetClassVersion());
+
+   // Double_t in memory, Float_t on file: the conversion is left to the actions
+   EXPECT_FALSE(info->GenerateKernels());
+   EXPECT_EQ(nullptr, info->GetReadObjectWiseActions()->fKernel);
+
+   // The members of TStopwatch in the order of the StreamerInfo
+   TBufferFile buf(TBuffer::kWrite);
+   TObject().Streamer(buf);
+   for (Double_t value : {1., 2., 3., 4., 0.5})
+      buf << value; // fStartRealTime to fTotalCpuTime
+   buf << Float_t(1.25); // fTotalRealTime
+   buf << Int_t(1);      // fState, stopped
+   buf << Int_t(3);      // fCounter
+
+   const Int_t written = buf.Length();
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   TStopwatch watch;
+   buf.ReadClassBuffer(TStopwatch::Class(), &watch, kVersion, 0, 0, nullptr);
+   EXPECT_EQ(written, buf.Length());
+   EXPECT_DOUBLE_EQ(0.5, watch.CpuTime());
+   EXPECT_DOUBLE_EQ(1.25, watch.RealTime());
+   EXPECT_EQ(3, watch.Counter());
+}
@@ -6,7 +6,7 @@ def get_argparse():
 The target file is newly created and must not exist, or if -f (\"force\") is given, must not be one of the source files.\n
 """
 	EPILOGUE = """
-If Target and source files have different compression settings a slower method is used.
+If Target and source files have different compression settings a slower method is used, unless -recompress is given.
 For options that takes a size as argument, a decimal number of bytes is expected.
 If the number ends with a ``k'', ``m'', ``g'', etc., the number is multiplied by 1000 (1K), 1000000 (1MB), 1000000000 (1G), etc.
 If this prefix is followed by i, the number is multiplied by the traditional 1024 (1KiB), 1048576 (1MiB), 1073741824 (1GiB), etc.
@@ -18,6 +18,7 @@ The prefix can be optionally followed by B whose casing is ignored, eg. 1k, 1K,
 	parser.add_argument("-k", help="Skip corrupt or non-existent files, do not exit")
 	parser.add_argument("-T", help="Do not merge Trees")
 	parser.add_argument("-O", help="Re-optimize basket size when merging TTree")
+	parser.add_argument("-recompress", help="If the compression settings change, recompress the baskets of the TTrees without unstreaming them")
 	parser.add_argument("-v", help="Explicitly set the verbosity level: 0 request no output, 99 is the default")
 	parser.add_argument("-j", help="Parallelize the execution in multiple processes")
 	parser.add_argument("-dbg", help="Parallelize the execution in multiple processes in debug mode (Does not delete partial files stored inside working directory)")
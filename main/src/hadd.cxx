@@ -47,6 +47,9 @@
   the merge will be done without  unzipping or unstreaming the baskets
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
+  If the compression levels differ, the option -recompress keeps the merge
+  of the Trees fast: the baskets are unzipped and zipped again with the target
+  compression, but they are not unstreamed.
 
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
@@ -105,6 +108,7 @@ int main( int argc, char **argv )
    Bool_t force = kFALSE;
    Bool_t skip_errors = kFALSE;
    Bool_t reoptimize = kFALSE;
+   Bool_t recompress = kFALSE;
    Bool_t noTrees = kFALSE;
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
@@ -136,6 +140,9 @@ int main( int argc, char **argv )
       } else if ( strcmp(argv[a],"-O") == 0 ) {
          reoptimize = kTRUE;
          ++ffirst;
+      } else if ( strcmp(argv[a],"-recompress") == 0 ) {
+         recompress = kTRUE;
+         ++ffirst;
       } else if (strcmp(argv[a], "-dbg") == 0) {
          debug = kTRUE;
          verbosity = kTRUE;
@@ -422,7 +429,8 @@ int main( int argc, char **argv )
       if (reoptimize) {
          merger.SetFastMethod(kFALSE);
       } else {
-         if (!keepCompressionAsIs && merger.HasCompressionChange()) {
+         merger.SetFastRecompress(recompress);
+         if (!keepCompressionAsIs && !recompress && merger.HasCompressionChange()) {
             // Don't warn if the user any request re-optimization.
             std::cout << "hadd Sources and Target have different compression levels" << std::endl;
             std::cout << "hadd merging will be slower" << std::endl;
@@ -15,13 +15,14 @@
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
-#include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
+#include "ROOT/TTreeParallelFiller.hxx" // for SnapshotHelperMT
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "ROOT/RDF/RDisplay.hxx"
+#include "ROOT/RDiskCacheDS.hxx" // for DiskCacheHelper
 #include "RtypesCore.h"
 #include "TBranch.h"
 #include "TClassEdit.h"
@@ -35,8 +36,12 @@
 #include "TTreeReader.h" // for SnapshotHelper
 
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -1254,13 +1259,27 @@ public:
    std::string GetActionName() { return "Snapshot"; }
 };
 
-/// Helper object for a multi-thread Snapshot action
+/// Helper object for a multi-thread Snapshot action.
+/// Every slot fills its entries into the private baskets of a TTreeFillContext, which compresses them in the slot's
+/// thread and appends them to the output tree as whole clusters: no thread merges the output of the others.
 template <typename... BranchTypes>
 class SnapshotHelperMT : public RActionImpl<SnapshotHelperMT<BranchTypes...>> {
+   using TaskPosition_t = std::pair<Long64_t, Long64_t>;
+   using FillContextPtr_t = std::unique_ptr<ROOT::Experimental::TTreeFillContext>;
+
    const unsigned int fNSlots;
-   std::unique_ptr<ROOT::Experimental::TBufferMerger> fMerger; // must use a ptr because TBufferMerger is not movable
-   std::vector<std::shared_ptr<ROOT::Experimental::TBufferMergerFile>> fOutputFiles;
-   std::vector<std::unique_ptr<TTree>> fOutputTrees;
+   std::unique_ptr<TFile> fOutputFile;
+   std::unique_ptr<TTree> fOutputTree; // the tree in the output file, filled by the fill contexts
+   std::unique_ptr<ROOT::Experimental::TTreeParallelFiller> fFiller; // created once the output tree has its branches
+   std::vector<FillContextPtr_t> fFillContexts; // per slot, or per task if entry order must be kept
+   // Tasks processed but not committed yet because a task that precedes them in the dataset is still running, by
+   // position: their end position and their fill context (null if no entry of the task passed)
+   std::multimap<TaskPosition_t, std::pair<TaskPosition_t, FillContextPtr_t>> fPendingTasks;
+   TaskPosition_t fNextPosition{0ll, 0ll}; // position of the first task that was not committed yet
+   std::unique_ptr<std::mutex> fMutex; // protects fFiller and the pending tasks; a ptr keeps the helper movable
+   std::function<std::pair<TaskPosition_t, TaskPosition_t>(unsigned int)> fGetTaskRange;
+   // position in the dataset of the beginning and of the end of the current task of each slot
+   std::vector<std::pair<TaskPosition_t, TaskPosition_t>> fTaskRanges;
    std::vector<int> fIsFirstEvent;        // vector<bool> does not allow concurrent writing of different elements
    const std::string fFileName;           // name of the output file name
    const std::string fDirName;            // name of TFile subdirectory in which output must be written (possibly empty)
@@ -1273,17 +1292,21 @@ class SnapshotHelperMT : public RActionImpl<SnapshotHelperMT<BranchTypes...>> {
    // Addresses of branches in output per slot, non-null only for the ones holding C arrays
    std::vector<std::vector<TBranch *>> fBranches;
    // Addresses associated to output branches per slot, non-null only for the ones holding C arrays
-   std::vector<std::vector<void *>> fBranchAddresses; 
+   std::vector<std::vector<void *>> fBranchAddresses;
 
 public:
    using ColumnTypes_t = TypeList<BranchTypes...>;
+   /// \param[in] getTaskRange Returns the positions in the dataset of the beginning and of the end of the task that a
+   ///            slot is processing, only used if the entry order must be kept (see RLoopManager::GetTaskPosition)
    SnapshotHelperMT(const unsigned int nSlots, std::string_view filename, std::string_view dirname,
                     std::string_view treename, const ColumnNames_t &vbnames, const ColumnNames_t &bnames,
-                    const RSnapshotOptions &options)
-      : fNSlots(nSlots), fOutputFiles(fNSlots), fOutputTrees(fNSlots), fIsFirstEvent(fNSlots, 1), fFileName(filename),
-        fDirName(dirname), fTreeName(treename), fOptions(options), fInputBranchNames(vbnames),
+                    const RSnapshotOptions &options,
+                    std::function<std::pair<TaskPosition_t, TaskPosition_t>(unsigned int)> getTaskRange)
+      : fNSlots(nSlots), fFillContexts(fNSlots), fMutex(new std::mutex), fGetTaskRange(std::move(getTaskRange)),
+        fTaskRanges(fNSlots), fIsFirstEvent(fNSlots, 1), fFileName(filename), fDirName(dirname),
+        fTreeName(treename), fOptions(options), fInputBranchNames(vbnames),
         fOutputBranchNames(ReplaceDotWithUnderscore(bnames)), fInputTrees(fNSlots), fBoolArrays(fNSlots),
-        fBranches(fNSlots, std::vector<TBranch *>(vbnames.size(), nullptr)), 
+        fBranches(fNSlots, std::vector<TBranch *>(vbnames.size(), nullptr)),
         fBranchAddresses(fNSlots, std::vector<void *>(vbnames.size(), nullptr))
    {
       ValidateSnapshotOutput(fOptions, fTreeName, fFileName);
@@ -1293,45 +1316,32 @@ public:
 
    void InitTask(TTreeReader *r, unsigned int slot)
    {
-      ::TDirectory::TContext c; // do not let tasks change the thread-local gDirectory
-      if (!fOutputFiles[slot]) {
-         // first time this thread executes something, let's create a TBufferMerger output directory
-         fOutputFiles[slot] = fMerger->GetFile();
-      }
-      TDirectory *treeDirectory = fOutputFiles[slot].get();
-      if (!fDirName.empty()) {
-         // call returnExistingDirectory=true since MT can end up making this call multiple times
-         treeDirectory = fOutputFiles[slot]->mkdir(fDirName.c_str(), "", true);
-      }
-      // re-create output tree as we need to create its branches again, with new input variables
-      // TODO we could instead create the output tree and its branches, change addresses of input variables in each task
-      fOutputTrees[slot] =
-         std::make_unique<TTree>(fTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/treeDirectory);
-      fOutputTrees[slot]->SetBit(TTree::kEntriesReshuffled);
-      // TODO can be removed when RDF supports interleaved TBB task execution properly, see ROOT-10269
-      fOutputTrees[slot]->SetImplicitMT(false);
-      if (fOptions.fAutoFlush)
-         fOutputTrees[slot]->SetAutoFlush(fOptions.fAutoFlush);
-      if (r) {
-         // not an empty-source RDF
-         fInputTrees[slot] = r->GetTree();
-         // AddClone guarantees that if the input file changes the branches of the output tree are updated with the new
-         // addresses of the branch values. We need this in case of friend trees with different cluster granularity
-         // than the main tree.
-         // FIXME: AddClone might result in many many (safe) warnings printed by TTree::CopyAddresses, see ROOT-9487.
-         const auto friendsListPtr = fInputTrees[slot]->GetListOfFriends();
-         if (friendsListPtr && friendsListPtr->GetEntries() > 0)
-            fInputTrees[slot]->AddClone(fOutputTrees[slot].get());
-      }
+      fInputTrees[slot] = r ? r->GetTree() : nullptr;
+      if (fOptions.fKeepEntryOrder)
+         fTaskRanges[slot] = fGetTaskRange(slot);
       fIsFirstEvent[slot] = 1; // reset first event flag for this slot
    }
 
    void FinalizeTask(unsigned int slot)
    {
-      if (fOutputTrees[slot]->GetEntries() > 0)
-         fOutputFiles[slot]->Write();
-      // clear now to avoid concurrent destruction of output trees and input tree (which has them listed as fClones)
-      fOutputTrees[slot].reset(nullptr);
+      // the fill context outlives the input tree of this task: the input tree must not update its addresses anymore
+      if (fFillContexts[slot] && fInputTrees[slot] && fInputTrees[slot]->GetListOfClones())
+         fInputTrees[slot]->GetListOfClones()->Remove(&fFillContexts[slot]->GetTree());
+      if (!fOptions.fKeepEntryOrder)
+         return;
+      // tasks without entries are recorded too: the tasks that follow them in the dataset wait for them
+      std::lock_guard<std::mutex> lock(*fMutex);
+      fPendingTasks.emplace(fTaskRanges[slot].first,
+                            std::make_pair(fTaskRanges[slot].second, std::move(fFillContexts[slot])));
+      // commit, in the order of the dataset, the tasks that now follow the ones already committed without gaps:
+      // destroying a fill context commits its entries
+      auto next = fPendingTasks.find(fNextPosition);
+      while (next != fPendingTasks.end()) {
+         fNextPosition = next->second.first;
+         next->second.second.reset();
+         fPendingTasks.erase(next);
+         next = fPendingTasks.find(fNextPosition);
+      }
    }
 
    void Exec(unsigned int slot, BranchTypes &... values)
@@ -1340,15 +1350,16 @@ public:
       if (!fIsFirstEvent[slot]) {
          UpdateCArraysPtrs(slot, values..., ind_t{});
       } else {
+         if (!fFillContexts[slot])
+            CreateFillContext(slot, values..., ind_t{});
          SetBranches(slot, values..., ind_t{});
          fIsFirstEvent[slot] = 0;
       }
       UpdateBoolArrays(slot, values..., ind_t{});
-      fOutputTrees[slot]->Fill();
-      auto entries = fOutputTrees[slot]->GetEntries();
-      auto autoFlush = fOutputTrees[slot]->GetAutoFlush();
-      if ((autoFlush > 0) && (entries % autoFlush == 0))
-         fOutputFiles[slot]->Write();
+      if (fOptions.fKeepEntryOrder)
+         fFillContexts[slot]->GetTree().Fill(); // the entries of the task are committed in order, in FinalizeTask
+      else
+         fFillContexts[slot]->Fill(); // commits the cluster to the output tree as soon as it is complete
    }
 
    template <std::size_t... S>
@@ -1368,57 +1379,209 @@ public:
       (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
    }
 
+   /// Create the fill context of the slot. The first call also creates the branches of the output tree, which must
+   /// be complete before any fill context exists.
+   template <std::size_t... S>
+   void CreateFillContext(unsigned int slot, BranchTypes &... values, std::index_sequence<S...> /*dummy*/)
+   {
+      std::lock_guard<std::mutex> lock(*fMutex);
+      if (!fFiller) {
+         BoolArrayMap boolArrays;
+         std::vector<TBranch *> branches(sizeof...(BranchTypes));
+         std::vector<void *> branchAddresses(sizeof...(BranchTypes));
+         int expander[] = {(SetBranchesHelper(boolArrays, fInputTrees[slot], *fOutputTree, fInputBranchNames[S],
+                                              fOutputBranchNames[S], branches[S], branchAddresses[S], &values),
+                            0)...,
+                           0};
+         (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+         // the output tree is only filled through the fill contexts, which set their own addresses
+         fOutputTree->ResetBranchAddresses();
+         fFiller = std::make_unique<ROOT::Experimental::TTreeParallelFiller>(*fOutputTree);
+      }
+      fFillContexts[slot] = fFiller->CreateFillContext();
+      if (!fFillContexts[slot])
+         throw std::runtime_error("Snapshot: could not create a fill context for the tree \"" + fTreeName + "\".");
+      // TODO can be removed when RDF supports interleaved TBB task execution properly, see ROOT-10269
+      fFillContexts[slot]->GetTree().SetImplicitMT(false);
+   }
+
    template <std::size_t... S>
    void SetBranches(unsigned int slot, BranchTypes &... values, std::index_sequence<S...> /*dummy*/)
    {
-         // hack to call TTree::Branch on all variadic template arguments
-         int expander[] = {
-            (SetBranchesHelper(fBoolArrays[slot], fInputTrees[slot], *fOutputTrees[slot], fInputBranchNames[S],
-                               fOutputBranchNames[S], fBranches[slot][S], fBranchAddresses[slot][S], &values),
-             0)...,
-            0};
+      // The branches of the fill context's tree already exist: create them in a tree of the same structure that is
+      // never filled, then let the fill context's tree use the same addresses, with new input variables in each task
+      TTree addressTree(fTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/nullptr);
+      // hack to call TTree::Branch on all variadic template arguments
+      int expander[] = {(SetBranchesHelper(fBoolArrays[slot], fInputTrees[slot], addressTree, fInputBranchNames[S],
+                                           fOutputBranchNames[S], fBranches[slot][S], fBranchAddresses[slot][S],
+                                           &values),
+                         0)...,
+                        0};
       (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
-      (void)slot;     // avoid unused variable warnings in gcc6.2
+      auto &tree = fFillContexts[slot]->GetTree();
+      addressTree.CopyAddresses(&tree);
+      for (auto &branch : fBranches[slot]) {
+         if (branch)
+            branch = tree.GetBranch(branch->GetName());
+      }
+      if (fInputTrees[slot]) {
+         // AddClone guarantees that if the input file changes the branches of the output tree are updated with the new
+         // addresses of the branch values. We need this in case of friend trees with different cluster granularity
+         // than the main tree.
+         // FIXME: AddClone might result in many many (safe) warnings printed by TTree::CopyAddresses, see ROOT-9487.
+         const auto friendsListPtr = fInputTrees[slot]->GetListOfFriends();
+         if (friendsListPtr && friendsListPtr->GetEntries() > 0)
+            fInputTrees[slot]->AddClone(&tree);
+      }
    }
 
    template <std::size_t... S>
    void UpdateBoolArrays(unsigned int slot, BranchTypes &... values, std::index_sequence<S...> /*dummy*/)
    {
       (void)slot; // avoid bogus 'unused parameter' warning
-      int expander[] = {
-         (UpdateBoolArray(fBoolArrays[slot], values, fOutputBranchNames[S], *fOutputTrees[slot]), 0)..., 0};
+      int expander[] = {(UpdateBoolArray(fBoolArrays[slot], values, fOutputBranchNames[S],
+                                         fFillContexts[slot]->GetTree()),
+                         0)...,
+                        0};
       (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
    }
 
    void Initialize()
    {
-      const auto cs = ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel);
-      fMerger = std::make_unique<ROOT::Experimental::TBufferMerger>(fFileName.c_str(), fOptions.fMode.c_str(), cs);
+      ::TDirectory::TContext c; // do not change the thread-local gDirectory
+      fOutputFile.reset(
+         TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"",
+                     ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel)));
+      if (!fOutputFile)
+         throw std::runtime_error("Snapshot: could not create output file " + fFileName);
+
+      TDirectory *treeDirectory = fOutputFile.get();
+      if (!fDirName.empty()) {
+         TString checkupdate = fOptions.fMode;
+         checkupdate.ToLower();
+         if (checkupdate == "update")
+            treeDirectory = fOutputFile->mkdir(fDirName.c_str(), "", true); // do not overwrite existing directory
+         else
+            treeDirectory = fOutputFile->mkdir(fDirName.c_str());
+      }
+
+      fOutputTree =
+         std::make_unique<TTree>(fTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/treeDirectory);
+      if (!fOptions.fKeepEntryOrder)
+         fOutputTree->SetBit(TTree::kEntriesReshuffled);
+      if (fOptions.fAutoFlush)
+         fOutputTree->SetAutoFlush(fOptions.fAutoFlush);
    }
 
    void Finalize()
    {
-      auto fileWritten = false;
-      for (auto &file : fOutputFiles) {
-         if (file) {
-            file->Write();
-            file->Close();
-            fileWritten = true;
+      if (fOutputFile && fOutputTree) {
+         // commit, in the order of the dataset, the tasks that do not follow the others without gaps (e.g. because
+         // the input files in between have no entries)
+         for (auto &task : fPendingTasks)
+            task.second.second.reset();
+         fPendingTasks.clear();
+         // commit the last, possibly incomplete, cluster of each slot
+         for (auto &context : fFillContexts)
+            context.reset();
+
+         // if no entry passed, the output tree has no branches: it is not written
+         if (fFiller) {
+            fFiller.reset();
+            ::TDirectory::TContext ctxt(fOutputFile->GetDirectory(fDirName.c_str()));
+            fOutputTree->Write();
          }
-      }
-
-      if (!fileWritten) {
+         // must destroy the TTree first, otherwise TFile will delete it too leading to a double delete
+         fOutputTree.reset();
+         fOutputFile->Close();
+      } else {
          Warning("Snapshot", "A lazy Snapshot action was booked but never triggered.");
       }
-
-      // flush all buffers to disk by destroying the TBufferMerger
-      fOutputFiles.clear();
-      fMerger.reset();
    }
 
    std::string GetActionName() { return "Snapshot"; }
 };
 
+/// Helper object for the action that writes the on-disk cache of RInterface::Cache(columns, cacheDir).
+/// Every slot gathers the values of its entries in one buffer per column. The buffers are appended to the cache file
+/// as a row group whenever they hold kRowGroupSize entries, and at the end of the event loop.
+template <typename... ColumnTypes>
+class DiskCacheHelper : public RActionImpl<DiskCacheHelper<ColumnTypes...>> {
+   static constexpr ULong64_t kRowGroupSize = 65536;
+   const std::shared_ptr<ULong64_t> fNEntries;
+   const std::string fFileName;
+   const ColumnNames_t fColumnNames;
+   std::unique_ptr<RDiskCacheWriter> fWriter;
+   std::vector<std::vector<std::vector<char>>> fBuffers; ///< For each slot, the values of each column
+   std::vector<ULong64_t> fNBufferedEntries;            ///< For each slot, the number of entries in fBuffers
+   std::vector<ULong64_t> fNSlotEntries;                ///< For each slot, the number of entries processed
+
+   template <typename T>
+   static void AppendValue(std::vector<char> &buffer, const T &value)
+   {
+      const auto bytes = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+   }
+
+   template <std::size_t... S>
+   void AppendValues(unsigned int slot, const ColumnTypes &... values, std::index_sequence<S...>)
+   {
+      int expander[] = {(AppendValue(fBuffers[slot][S], values), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+   }
+
+   void Flush(unsigned int slot)
+   {
+      std::vector<const char *> columns;
+      for (auto &buffer : fBuffers[slot])
+         columns.emplace_back(buffer.data());
+      fWriter->WriteRowGroup(fNBufferedEntries[slot], columns);
+      for (auto &buffer : fBuffers[slot])
+         buffer.clear();
+      fNBufferedEntries[slot] = 0;
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColumnTypes...>;
+   DiskCacheHelper(const std::shared_ptr<ULong64_t> &nEntries, unsigned int nSlots, const std::string &fileName,
+                   const ColumnNames_t &columnNames)
+      : fNEntries(nEntries), fFileName(fileName), fColumnNames(columnNames),
+        fBuffers(nSlots, std::vector<std::vector<char>>(sizeof...(ColumnTypes))), fNBufferedEntries(nSlots, 0),
+        fNSlotEntries(nSlots, 0)
+   {
+   }
+   DiskCacheHelper(DiskCacheHelper &&) = default;
+   DiskCacheHelper(const DiskCacheHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Initialize()
+   {
+      fWriter.reset(new RDiskCacheWriter(fFileName, fColumnNames, {TypeID2TypeName(typeid(ColumnTypes))...},
+                                         {sizeof(ColumnTypes)...}));
+   }
+
+   void Exec(unsigned int slot, const ColumnTypes &... values)
+   {
+      AppendValues(slot, values..., std::index_sequence_for<ColumnTypes...>());
+      ++fNSlotEntries[slot];
+      if (++fNBufferedEntries[slot] == kRowGroupSize)
+         Flush(slot);
+   }
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fBuffers.size(); ++slot)
+         Flush(slot);
+      fWriter->Commit();
+      fWriter.reset();
+      *fNEntries = std::accumulate(fNSlotEntries.begin(), fNSlotEntries.end(), 0ull);
+   }
+
+   ULong64_t &PartialUpdate(unsigned int slot) { return fNSlotEntries[slot]; }
+
+   std::string GetActionName() { return "Cache"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
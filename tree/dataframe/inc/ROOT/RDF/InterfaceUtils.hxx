@@ -22,6 +22,7 @@
 #include <ROOT/RDF/RJittedCustomColumn.hxx>
 #include <ROOT/RDF/RJittedFilter.hxx>
 #include <ROOT/RDF/RLoopManager.hxx>
+#include <ROOT/RDF/RVariedColumn.hxx>
 #include <ROOT/RMakeUnique.hxx>
 #include <ROOT/RStringView.hxx>
 #include <ROOT/TypeTraits.hxx>
@@ -32,6 +33,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -257,10 +259,9 @@ void BookDefineJit(std::string_view name, std::string_view expression, RLoopMana
                    const std::shared_ptr<RJittedCustomColumn> &jittedCustomColumn,
                    const RDFInternal::RBookedCustomColumns &customCols, const ColumnNames_t &branches);
 
-std::string JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::type_info &art, const std::type_info &at,
-                           void *r, TTree *tree, const unsigned int nSlots,
-                           const RDFInternal::RBookedCustomColumns &customColumns, RDataSource *ds,
-                           std::shared_ptr<RJittedAction> *jittedActionOnHeap, unsigned int namespaceID);
+RJitCall JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::type_info &art, const std::type_info &at,
+                        void *r, TTree *tree, const RDFInternal::RBookedCustomColumns &customColumns, RDataSource *ds,
+                        std::shared_ptr<RJittedAction> *jittedActionOnHeap, unsigned int namespaceID);
 
 // allocate a shared_ptr on the heap, return a reference to it. the user is responsible of deleting the shared_ptr*.
 // this function is meant to only be used by RInterface's action methods, and should be deprecated as soon as we find
@@ -380,7 +381,7 @@ void JitDefineHelper(F &&f, const ColumnNames_t &cols, std::string_view name, RL
 
 /// Convenience function invoked by jitted code to build action nodes at runtime
 template <typename ActionTag, typename... BranchTypes, typename PrevNodeType, typename ActionResultType>
-void CallBuildAction(std::shared_ptr<PrevNodeType> *prevNodeOnHeap, const ColumnNames_t &bl, const unsigned int nSlots,
+void CallBuildAction(std::shared_ptr<PrevNodeType> *prevNodeOnHeap, const ColumnNames_t &bl,
                      const std::shared_ptr<ActionResultType> *rOnHeap,
                      std::shared_ptr<RJittedAction> *jittedActionOnHeap,
                      RDFInternal::RBookedCustomColumns *customColumns)
@@ -396,7 +397,8 @@ void CallBuildAction(std::shared_ptr<PrevNodeType> *prevNodeOnHeap, const Column
                         : *customColumns;
 
    auto actionPtr =
-      BuildAction<BranchTypes...>(bl, *rOnHeap, nSlots, std::move(prevNodePtr), ActionTag{}, std::move(newColumns));
+      BuildAction<BranchTypes...>(bl, *rOnHeap, loopManager.GetNSlots(), std::move(prevNodePtr), ActionTag{},
+                                  std::move(newColumns));
    (*jittedActionOnHeap)->SetAction(std::move(actionPtr));
 
    // customColumns points to the columns structure in the heap, created before the jitted call so that the jitter can
@@ -518,6 +520,53 @@ struct TEvalAnd {
    static constexpr bool value = IsTrueForAllImpl_t<Conditions...>::value;
 };
 
+/****** Systematic variations ******/
+
+/// Check whether a node booked with the input `columns` after `nominalNode` must be copied in `variation`, i.e.
+/// whether its upstream node or one of its input columns differs from the nominal one.
+/// Pass a null `nominalNode` for nodes that do not depend on upstream nodes, like custom columns.
+bool IsVaried(const RVariation &variation, const RNodeBase *nominalNode, const RBookedCustomColumns &nominalColumns,
+              const ColumnNames_t &columns);
+
+/// Add to the columns of a variation the names and custom columns of the nominal graph that it does not know yet,
+/// e.g. data-source columns booked after the variation was created.
+void AddMissingColumns(RBookedCustomColumns &columns, const RBookedCustomColumns &nominalColumns);
+
+/// Return the names of the columns used by a jitted expression, with aliases resolved.
+ColumnNames_t FindUsedColumns(std::string_view expression, RLoopManager &lm, RDataSource *ds,
+                              const RBookedCustomColumns &customColumns);
+
+/// Return the name of the file, in cacheDir, that caches the dataset described by provenance.
+std::string GetDiskCacheFileName(std::string_view cacheDir, const std::string &provenance);
+
+/// Copy a callable for the copies of a node booked in the systematic variations.
+template <typename F, typename std::enable_if<std::is_copy_constructible<F>::value, int>::type = 0>
+F CopyForVariation(const F &f)
+{
+   return f;
+}
+
+template <typename F, typename std::enable_if<!std::is_copy_constructible<F>::value, int>::type = 0>
+F CopyForVariation(const F &)
+{
+   throw std::runtime_error("A callable that is not copy-constructible cannot be used downstream of Vary: it must be "
+                            "copied in each systematic variation that it depends on.");
+}
+
+/// Return a copy of the initial value of an action result, to be filled by the same action in a systematic variation.
+/// Results that cannot be copied are not varied: a null pointer is returned.
+template <typename T, typename std::enable_if<std::is_copy_constructible<T>::value, int>::type = 0>
+std::shared_ptr<T> CloneResult(const std::shared_ptr<T> &r)
+{
+   return std::make_shared<T>(*r);
+}
+
+template <typename T, typename std::enable_if<!std::is_copy_constructible<T>::value, int>::type = 0>
+std::shared_ptr<T> CloneResult(const std::shared_ptr<T> &)
+{
+   return nullptr;
+}
+
 // Check if a class is a specialisation of stl containers templates
 // clang-format off
 
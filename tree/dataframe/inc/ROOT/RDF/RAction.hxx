@@ -20,7 +20,9 @@
 
 #include <cstddef> // std::size_t
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ROOT {
@@ -149,6 +151,14 @@ public:
          static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
    }
 
+   void RunBatch(unsigned int slot, const RBatch &batch) final
+   {
+      const auto &mask = fPrevData.CheckFiltersBatch(slot, batch);
+      static_cast<Action_t *>(this)->ExecBatch(slot, batch, mask, TypeInd_t());
+   }
+
+   bool SupportsBatch() const override { return AreBatchable<ColumnTypes_t>::value; }
+
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
 
    void FinalizeSlot(unsigned int slot) final
@@ -237,6 +247,18 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   template <std::size_t... S>
+   void ExecBatch(unsigned int slot, const RBatch &batch, const RBatchMask_t &mask, std::index_sequence<S...>)
+   {
+      auto values = GetBatchRDFValueTuple(fValues[slot], batch, mask, std::index_sequence<S...>());
+      auto &helper = ActionCRTP_t::GetHelper();
+      for (auto i = 0u; i < batch.fSize; ++i) {
+         if (mask[i])
+            helper.Exec(slot, std::get<S>(values)[i]...);
+      }
+      (void)values; // avoid "unused variable" warnings if there are no input columns
+   }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
@@ -288,6 +310,15 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, fValues[slot][S].template Get<ColTypes>(entry)...);
    }
 
+   template <std::size_t... S>
+   void ExecBatch(unsigned int, const RBatch &, const RBatchMask_t &, std::index_sequence<S...>)
+   {
+      throw std::logic_error("Snapshot cannot be run in batch mode.");
+   }
+
+   /// Snapshot relies on the addresses of its input values being the same for all entries
+   bool SupportsBatch() const final { return false; }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
@@ -328,6 +359,15 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, fValues[slot][S].template Get<ColTypes>(entry)...);
    }
 
+   template <std::size_t... S>
+   void ExecBatch(unsigned int, const RBatch &, const RBatchMask_t &, std::index_sequence<S...>)
+   {
+      throw std::logic_error("Snapshot cannot be run in batch mode.");
+   }
+
+   /// Snapshot relies on the addresses of its input values being the same for all entries
+   bool SupportsBatch() const final { return false; }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
@@ -11,6 +11,7 @@
 #ifndef ROOT_RACTIONBASE
 #define ROOT_RACTIONBASE
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
@@ -65,6 +66,10 @@ public:
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Run the action on the entries of the batch that pass all upstream filters (batch mode).
+   virtual void RunBatch(unsigned int slot, const RBatch &batch) = 0;
+   /// Whether the input columns of this action can be processed in batches.
+   virtual bool SupportsBatch() const = 0;
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -0,0 +1,59 @@
+// Author: agent <agent@local>  07/2020
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RBATCH
+#define ROOT_RDF_RBATCH
+
+#include "ROOT/TypeTraits.hxx"
+#include "RtypesCore.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// A block of consecutive entries that the nodes of the computation graph process at once in batch mode.
+/// Batches never cross the boundaries of the trees of a TChain.
+struct RBatch {
+   Long64_t fFirstEntry;       ///< Entry number of the first entry of the batch, as returned by `rdfentry_`
+   Long64_t fFirstReaderEntry; ///< Entry number of the first entry of the batch in the TTreeReader, -1 if no tree
+   Long64_t fFirstTreeEntry;   ///< Entry number of the first entry of the batch in its TTree of a chain, -1 if no tree
+   unsigned int fSize;         ///< Number of entries in the batch
+};
+
+/// For each entry of a batch, whether it is selected (e.g. it passed all upstream filters).
+using RBatchMask_t = std::vector<char>;
+
+/// Values of type T can be gathered in a batch if they can be stored in (and copied into) an array.
+template <typename T>
+struct IsBatchable
+   : std::integral_constant<bool, std::is_default_constructible<T>::value && std::is_copy_assignable<T>::value> {
+};
+
+/// Whether all types in a TypeList can be gathered in a batch.
+template <typename TypeList>
+struct AreBatchable;
+
+template <>
+struct AreBatchable<ROOT::TypeTraits::TypeList<>> : std::true_type {
+};
+
+template <typename T, typename... Ts>
+struct AreBatchable<ROOT::TypeTraits::TypeList<T, Ts...>>
+   : std::integral_constant<bool, IsBatchable<T>::value && AreBatchable<ROOT::TypeTraits::TypeList<Ts...>>::value> {
+};
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif // ROOT_RDF_RBATCH
@@ -95,6 +95,12 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Internally it recreates the map with the new column name, and swaps with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Describe the given columns in a way that is stable across processes, e.g. to identify cached values.
+   /// Custom columns are described by how their values are computed (see RCustomColumnBase::GetProvenance), the
+   /// other columns by their name.
+   std::string GetProvenance(const ColumnNames_t &columns) const;
 };
 
 } // Namespace RDF
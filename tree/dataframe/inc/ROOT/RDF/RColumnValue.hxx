@@ -11,6 +11,7 @@
 #ifndef ROOT_RCOLUMNVALUE
 #define ROOT_RCOLUMNVALUE
 
+#include <ROOT/RDF/RBatch.hxx>
 #include <ROOT/RDF/RCustomColumnBase.hxx>
 #include <ROOT/RDF/Utils.hxx> // IsRVec_t, TypeID2TypeName
 #include <ROOT/RIntegerSequence.hxx>
@@ -18,10 +19,17 @@
 #include <ROOT/RVec.hxx>
 #include <ROOT/TypeTraits.hxx> // TakeFirstParameter_t
 #include <RtypesCore.h>
+#include <TBranch.h>
+#include <TBufferFile.h>
+#include <TDataType.h>
+#include <TLeaf.h>
+#include <TTree.h>
 #include <TTreeReader.h>
 #include <TTreeReaderValue.h>
 #include <TTreeReaderArray.h>
 
+#include <algorithm>
+#include <cstddef> // std::size_t
 #include <cstring> // strcmp
 #include <initializer_list>
 #include <limits>
@@ -56,7 +64,10 @@ for a given RColumnValue, depending on whether the value comes from a real
 TTree branch or from a temporary column respectively.
 
 RDataFrame nodes can store tuples of RColumnValues and retrieve an updated
-value for the column via the `Get` method.
+value for the column via the `Get` method, or the values for a whole batch of
+entries via GetBatchRDFValueTuple. In batch mode, branches holding one value of
+fundamental type per entry are decoded a basket at a time with the TBranch bulk
+API; other branches are read entry by entry.
 **/
 template <typename T>
 class R__CLING_PTRCHECK(off) RColumnValue {
@@ -68,6 +79,8 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    using ColumnValue_t = typename std::conditional<MustUseRVec_t::value, TakeFirstParameter_t<T>, T>::type;
    using TreeReader_t = typename std::conditional<MustUseRVec_t::value, TTreeReaderArray<ColumnValue_t>,
                                                   TTreeReaderValue<ColumnValue_t>>::type;
+   // Types that cannot be gathered in a batch get a placeholder buffer type, never used
+   using BatchValue_t = typename std::conditional<IsBatchable<T>::value, T, char>::type;
 
    /// RColumnValue has a slightly different behaviour whether the column comes from a TTreeReader, a RDataFrame Define
    /// or a RDataSource. It stores which it is as an enum.
@@ -98,6 +111,99 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    /// If MustUseRVec, i.e. we are reading an array, we return a reference to this RVec to clients
    RVec<ColumnValue_t> fRVec;
    bool fCopyWarningPrinted = false;
+   /// The TTreeReader of the Tree column, positioned on each entry of a batch that is not read in bulk.
+   TTreeReader *fReader = nullptr;
+   /// The name of the branch of a Tree column.
+   std::string fBranchName;
+   /// The branch of a Tree column read in bulk in batch mode, null if it cannot be read in bulk.
+   TBranch *fBulkBranch = nullptr;
+   /// The tree (and its number in a chain) for which fBulkBranch was looked up.
+   TTree *fBulkTree = nullptr;
+   Int_t fBulkTreeNumber = -1;
+   /// The values of the basket of fBulkBranch decoded last, and the tree-local entry number of the first one.
+   std::unique_ptr<TBufferFile> fBulkBuffer;
+   Long64_t fBulkFirst = -1;
+   Long64_t fBulkSize = 0;
+   /// The values of the entries of the last batch. Only used for Tree columns and custom columns of a derived type.
+   std::unique_ptr<BatchValue_t[]> fBatchValues;
+   unsigned int fBatchCapacity = 0;
+   /// Distance between the values of a custom column of a type that inherits from T, zero if the type is T.
+   std::size_t fBatchStride = 0;
+   /// Offset of the T base class in the values of a custom column of a type that inherits from T.
+   std::size_t fBatchBaseOffset = 0;
+
+   void ReserveBatch(unsigned int size)
+   {
+      if (size > fBatchCapacity) {
+         fBatchValues.reset(new BatchValue_t[size]);
+         fBatchCapacity = size;
+      }
+   }
+
+   /// Look up the branch of the Tree column in `tree` and check whether it can be read in bulk: it must hold exactly
+   /// one value of type T per entry, in a single leaf of the tree itself (not of a friend).
+   void SetupBulkRead(TTree *tree)
+   {
+      fBulkTree = tree;
+      fBulkTreeNumber = fReader->GetTree()->GetTreeNumber();
+      fBulkBranch = nullptr;
+      fBulkFirst = -1;
+      fBulkSize = 0;
+      const auto type = TDataType::GetType(typeid(T));
+      if (type == kOther_t || type == kNoType_t)
+         return;
+      auto branch = tree->GetBranch(fBranchName.c_str());
+      if (!branch || branch->GetTree() != tree || !branch->SupportsBulkRead() ||
+          branch->GetListOfLeaves()->GetEntriesFast() != 1)
+         return;
+      auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+      auto dataType = dynamic_cast<TDataType *>(TDictionary::GetDictionary(leaf->GetTypeName()));
+      if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || !dataType || dataType->GetType() != type)
+         return;
+      fBulkBranch = branch;
+      if (!fBulkBuffer)
+         fBulkBuffer = std::make_unique<TBufferFile>(TBuffer::kWrite, 32 * 1024);
+   }
+
+   /// Decode the basket of fBulkBranch that holds the tree-local `entry`, unless it is the one decoded last.
+   void LoadBulkBasket(Long64_t entry)
+   {
+      if (entry >= fBulkFirst && entry < fBulkFirst + fBulkSize)
+         return;
+      // The bulk API only decodes entire baskets, so we need to start at the basket's first entry
+      const Long64_t *basketEntry = fBulkBranch->GetBasketEntry();
+      const auto basketEnd = basketEntry + fBulkBranch->GetWriteBasket() + 1;
+      fBulkFirst = *(std::upper_bound(basketEntry, basketEnd, entry) - 1);
+      fBulkSize = fBulkBranch->GetBulkRead().GetBulkEntries(fBulkFirst, *fBulkBuffer);
+      if (fBulkSize <= 0 || entry >= fBulkFirst + fBulkSize) {
+         fBulkFirst = -1;
+         fBulkSize = 0;
+         throw std::runtime_error("RColumnValue: could not read the values of branch " + fBranchName + " in bulk.");
+      }
+   }
+
+   /// The values of the Tree column read in bulk for a batch. The values of a batch that lies in a single basket
+   /// are used in place, without copies.
+   T *GetBulkBatch(const RBatch &batch, const RBatchMask_t &mask)
+   {
+      ReserveBatch(batch.fSize);
+      const auto first = batch.fFirstTreeEntry;
+      for (auto i = 0u; i < batch.fSize;) {
+         // do not decode baskets of which no entry is selected
+         if (std::none_of(mask.begin() + i, mask.begin() + batch.fSize, [](char selected) { return selected; }))
+            break;
+         LoadBulkBasket(first + i);
+         auto values = reinterpret_cast<T *>(fBulkBuffer->GetCurrent()) + (first + i - fBulkFirst);
+         if (i == 0 && first + batch.fSize <= fBulkFirst + fBulkSize)
+            return values;
+         const auto n = std::min<Long64_t>(batch.fSize - i, fBulkFirst + fBulkSize - first - i);
+         for (auto j = 0u; j < n; ++j, ++i) {
+            if (mask[i])
+               fBatchValues[i] = values[j];
+         }
+      }
+      return fBatchValues.get();
+   }
 
 public:
    RColumnValue(){};
@@ -134,6 +240,11 @@ public:
          }
          throw std::runtime_error(errMsg);
       }
+      if (diffTypes) {
+         auto colTClass = TClass::GetClass(customColumn->GetTypeId());
+         fBatchStride = colTClass->Size();
+         fBatchBaseOffset = colTClass->GetBaseClassOffset(TClass::GetClass<T>());
+      }
 
       if (customColumn->IsDataSourceColumn()) {
          fColumnKind = EColumnKind::kDataSource;
@@ -148,6 +259,10 @@ public:
    void MakeProxy(TTreeReader *r, const std::string &bn)
    {
       fColumnKind = EColumnKind::kTree;
+      fReader = r;
+      fBranchName = bn;
+      fBulkTree = nullptr;
+      fBulkBranch = nullptr;
       fTreeReader = std::make_unique<TreeReader_t>(*r, bn.c_str());
    }
 
@@ -260,6 +375,70 @@ public:
       }
    }
 
+   /// Get ready to read the values of the column for a batch of entries. Set `reader` if the values must be read
+   /// entry by entry, through ReadBatchEntry, before calling GetBatch.
+   template <typename U = T, typename std::enable_if<IsBatchable<U>::value, int>::type = 0>
+   void PrepareBatch(const RBatch &batch, TTreeReader *&reader)
+   {
+      if (fColumnKind != EColumnKind::kTree)
+         return;
+      auto tree = fReader->GetTree()->GetTree();
+      if (tree != fBulkTree || fReader->GetTree()->GetTreeNumber() != fBulkTreeNumber)
+         SetupBulkRead(tree);
+      if (!fBulkBranch) {
+         ReserveBatch(batch.fSize);
+         reader = fReader;
+      }
+   }
+
+   /// Store the value of the column at the current entry of the TTreeReader as the i-th value of the batch.
+   template <typename U = T, typename std::enable_if<IsBatchable<U>::value, int>::type = 0>
+   void ReadBatchEntry(const RBatch &batch, unsigned int i)
+   {
+      if (fColumnKind == EColumnKind::kTree && !fBulkBranch)
+         fBatchValues[i] = Get(batch.fFirstEntry + i);
+   }
+
+   /// Return the values of the column for a batch of entries: only the values of the entries selected by `mask` are
+   /// read or computed. Tree columns that are not read in bulk must have been read by ReadBatchEntry.
+   template <typename U = T, typename std::enable_if<IsBatchable<U>::value, int>::type = 0>
+   T *GetBatch(const RBatch &batch, const RBatchMask_t &mask)
+   {
+      if (fColumnKind == EColumnKind::kCustomColumn) {
+         fCustomColumn->UpdateBatch(fSlot, batch, mask);
+         auto values = static_cast<char *>(fCustomColumn->GetBatchValuePtr(fSlot));
+         if (fBatchStride == 0)
+            return reinterpret_cast<T *>(values);
+         // the custom column has a type that inherits from T: the values are not laid out as an array of T
+         ReserveBatch(batch.fSize);
+         for (auto i = 0u; i < batch.fSize; ++i) {
+            if (mask[i])
+               fBatchValues[i] = *reinterpret_cast<T *>(values + i * fBatchStride + fBatchBaseOffset);
+         }
+         return fBatchValues.get();
+      }
+
+      if (fColumnKind != EColumnKind::kTree)
+         throw std::runtime_error("RColumnValue: data-source columns cannot be processed in batches.");
+      return fBulkBranch ? GetBulkBatch(batch, mask) : fBatchValues.get();
+   }
+
+   /// These overloads are selected for types that cannot be gathered in a batch. Batch mode is never used for them.
+   template <typename U = T, typename std::enable_if<!IsBatchable<U>::value, int>::type = 0>
+   void PrepareBatch(const RBatch &, TTreeReader *&)
+   {
+   }
+   template <typename U = T, typename std::enable_if<!IsBatchable<U>::value, int>::type = 0>
+   void ReadBatchEntry(const RBatch &, unsigned int)
+   {
+   }
+   template <typename U = T, typename std::enable_if<!IsBatchable<U>::value, int>::type = 0>
+   T *GetBatch(const RBatch &, const RBatchMask_t &)
+   {
+      throw std::runtime_error("RColumnValue: columns of type " + TypeID2TypeName(typeid(T)) +
+                               " cannot be processed in batches.");
+   }
+
    void Reset()
    {
       // This method should by all means not be removed, together with all
@@ -319,6 +498,30 @@ void ResetRDFValueTuple(ValueTuple &values, std::index_sequence<S...>)
    (void)expander; // avoid "unused variable" warnings
 }
 
+/// Return the values of a tuple of RColumnValues for a batch of entries, as a tuple of arrays.
+/// The Tree columns that cannot be read in bulk are read entry by entry, all together: the TTreeReader is positioned
+/// once per selected entry of the batch, not once per selected entry and column.
+template <typename ValueTuple, std::size_t... S>
+auto GetBatchRDFValueTuple(ValueTuple &values, const RBatch &batch, const RBatchMask_t &mask,
+                           std::index_sequence<S...>)
+   -> decltype(std::make_tuple(std::get<S>(values).GetBatch(batch, mask)...))
+{
+   TTreeReader *reader = nullptr;
+   // hack to expand a parameter pack without c++17 fold expressions.
+   std::initializer_list<int> prepare{(std::get<S>(values).PrepareBatch(batch, reader), 0)...};
+   (void)prepare; // avoid "unused variable" warnings
+   if (reader) {
+      for (auto i = 0u; i < batch.fSize; ++i) {
+         if (!mask[i])
+            continue;
+         reader->SetEntry(batch.fFirstReaderEntry + i);
+         std::initializer_list<int> read{(std::get<S>(values).ReadBatchEntry(batch, i), 0)...};
+         (void)read;
+      }
+   }
+   return std::make_tuple(std::get<S>(values).GetBatch(batch, mask)...);
+}
+
 
 } // ns RDF
 } // ns Internal
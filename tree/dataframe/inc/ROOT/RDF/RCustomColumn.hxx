@@ -21,7 +21,11 @@
 #include "RtypesCore.h"
 
 #include <deque>
+#include <memory>
+#include <tuple>
+#include <string>
 #include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 class TTreeReader;
@@ -67,6 +71,10 @@ class RCustomColumn final : public RCustomColumnBase {
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsCustomColumn;
 
+   /// Per-slot values of the current batch, only used in batch mode
+   std::vector<std::unique_ptr<ret_type[]>> fBatchResults;
+   std::vector<unsigned int> fBatchCapacities;
+
    template <std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, std::index_sequence<S...>, NoneTag)
    {
@@ -94,11 +102,43 @@ class RCustomColumn final : public RCustomColumnBase {
       (void)entry;
    }
 
+   template <typename... ColTypes>
+   ret_type EvalExpression(unsigned int, Long64_t, NoneTag, ColTypes &... values)
+   {
+      return fExpression(values...);
+   }
+
+   template <typename... ColTypes>
+   ret_type EvalExpression(unsigned int slot, Long64_t, SlotTag, ColTypes &... values)
+   {
+      return fExpression(slot, values...);
+   }
+
+   template <typename... ColTypes>
+   ret_type EvalExpression(unsigned int slot, Long64_t entry, SlotAndEntryTag, ColTypes &... values)
+   {
+      return fExpression(slot, entry, values...);
+   }
+
+   template <std::size_t... S>
+   void UpdateBatchHelper(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask,
+                          std::index_sequence<S...>)
+   {
+      auto values = RDFInternal::GetBatchRDFValueTuple(fValues[slot], batch, mask, std::index_sequence<S...>());
+      auto results = fBatchResults[slot].get();
+      for (auto i = 0u; i < batch.fSize; ++i) {
+         if (mask[i])
+            results[i] = EvalExpression(slot, batch.fFirstEntry + i, ExtraArgsTag{}, std::get<S>(values)[i]...);
+      }
+      (void)values; // avoid "unused variable" warnings if there are no input columns
+   }
+
 public:
    RCustomColumn(RLoopManager *lm, std::string_view name, F &&expression, const ColumnNames_t &columns,
                  unsigned int nSlots, const RDFInternal::RBookedCustomColumns &customColumns, bool isDSColumn = false)
       : RCustomColumnBase(lm, name, nSlots, isDSColumn, customColumns), fExpression(std::forward<F>(expression)),
-        fColumnNames(columns), fLastResults(fNSlots), fValues(fNSlots), fIsCustomColumn()
+        fColumnNames(columns), fLastResults(fNSlots), fValues(fNSlots), fIsCustomColumn(), fBatchResults(fNSlots),
+        fBatchCapacities(fNSlots, 0u)
    {
       const auto nColumns = fColumnNames.size();
       for (auto i = 0u; i < nColumns; ++i)
@@ -127,6 +167,23 @@ public:
       }
    }
 
+   void *GetBatchValuePtr(unsigned int slot) final { return static_cast<void *>(fBatchResults[slot].get()); }
+
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) final
+   {
+      if (batch.fSize > fBatchCapacities[slot]) {
+         fBatchResults[slot].reset(new ret_type[batch.fSize]);
+         fBatchCapacities[slot] = batch.fSize;
+      }
+      if (auto toEvaluate = GetEntriesToEvaluate(slot, batch, mask))
+         UpdateBatchHelper(slot, batch, *toEvaluate, TypeInd_t());
+   }
+
+   bool SupportsBatch() const final
+   {
+      return !fIsDataSourceColumn && RDFInternal::AreBatchable<ColumnTypes_t>::value;
+   }
+
    const std::type_info &GetTypeId() const
    {
       return fIsDataSourceColumn ? typeid(typename std::remove_pointer<ret_type>::type) : typeid(ret_type);
@@ -139,6 +196,16 @@ public:
          fIsInitialized[slot] = false;
       }
    }
+
+   std::string GetProvenance(const std::string &expression = "") const final
+   {
+      // the values of data-source columns are identified by the data source
+      if (fIsDataSourceColumn)
+         return fName;
+      const auto callable =
+         expression.empty() ? RDFInternal::kCompiledCallableProvenance + std::string(typeid(F).name()) : expression;
+      return "Define(" + fName + ": " + callable + "; " + fCustomColumns.GetProvenance(fColumnNames) + ")";
+   }
 };
 
 } // ns RDF
@@ -12,6 +12,7 @@
 #define ROOT_RCUSTOMCOLUMNBASE
 
 #include "ROOT/RDF/GraphNode.hxx"
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 
 #include <memory>
@@ -43,8 +44,15 @@ protected:
    const unsigned int fID = GetNextID();
    RDFInternal::RBookedCustomColumns fCustomColumns;
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
+   /// Per-slot flags of the entries of the current batch whose value has already been computed.
+   /// In batch mode, fLastCheckedEntry holds the first entry of the current batch.
+   std::vector<RDFInternal::RBatchMask_t> fBatchEvaluated;
+   /// Per-slot flags of the entries of the current batch that must be computed by the ongoing UpdateBatch call
+   std::vector<RDFInternal::RBatchMask_t> fBatchToEvaluate;
 
    static unsigned int GetNextID();
+   const RDFInternal::RBatchMask_t *
+   GetEntriesToEvaluate(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask);
 
 public:
    RCustomColumnBase(RLoopManager *lm, std::string_view name, const unsigned int nSlots, const bool isDSColumn,
@@ -58,7 +66,18 @@ public:
    RLoopManager *GetLoopManagerUnchecked() const;
    std::string GetName() const;
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Compute the values of the entries of the batch selected by `mask`, if not already done (batch mode).
+   virtual void
+   UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) = 0;
+   /// Return the address of the array of values of the current batch in the given slot.
+   virtual void *GetBatchValuePtr(unsigned int slot) = 0;
+   /// Whether the values of this column and of its input columns can be processed in batches.
+   virtual bool SupportsBatch() const { return true; }
    virtual void ClearValueReaders(unsigned int slot) = 0;
+   /// Return a description of how the values of this column are computed that is stable across processes, e.g. to
+   /// identify cached values: its callable and, recursively, its input columns. If not empty, `expression` describes
+   /// the callable instead of its type (used for jitted columns).
+   virtual std::string GetProvenance(const std::string &expression = "") const = 0;
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
    virtual void InitNode();
    /// Return the unique identifier of this RCustomColumnBase.
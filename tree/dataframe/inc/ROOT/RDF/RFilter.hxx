@@ -24,6 +24,8 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <typeinfo>
 #include <vector>
 
 namespace ROOT {
@@ -107,6 +109,37 @@ public:
       return fFilter(std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   const RDFInternal::RBatchMask_t &CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch) final
+   {
+      auto &mask = fBatchMasks[slot];
+      if (batch.fFirstEntry != fLastCheckedEntry[slot]) {
+         mask = fPrevData.CheckFiltersBatch(slot, batch);
+         CheckFiltersBatchHelper(slot, batch, mask, TypeInd_t());
+         fLastCheckedEntry[slot] = batch.fFirstEntry;
+      }
+      return mask;
+   }
+
+   /// Evaluate the filter on the entries of the batch that passed the upstream filters, updating the mask in place
+   template <std::size_t... S>
+   void CheckFiltersBatchHelper(unsigned int slot, const RDFInternal::RBatch &batch, RDFInternal::RBatchMask_t &mask,
+                                std::index_sequence<S...>)
+   {
+      auto values = RDFInternal::GetBatchRDFValueTuple(fValues[slot], batch, mask, std::index_sequence<S...>());
+      auto &accepted = fAccepted[slot];
+      auto &rejected = fRejected[slot];
+      for (auto i = 0u; i < batch.fSize; ++i) {
+         if (!mask[i])
+            continue;
+         const bool passed = fFilter(std::get<S>(values)[i]...);
+         passed ? ++accepted : ++rejected;
+         mask[i] = passed;
+      }
+      (void)values; // avoid "unused variable" warnings if there are no input columns
+   }
+
+   bool SupportsBatch() const final { return RDFInternal::AreBatchable<ColumnTypes_t>::value; }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : fCustomColumns.GetColumns())
@@ -156,6 +189,15 @@ public:
       filters.push_back(name);
    }
 
+   std::string GetProvenance(const std::string &expression = "") final
+   {
+      const auto selection = expression.empty()
+                                ? RDFInternal::kCompiledCallableProvenance + std::string(typeid(FilterF).name())
+                                : expression;
+      return fPrevData.GetProvenance() + "\nFilter(" + fName + ": " + selection + "; " +
+             fCustomColumns.GetProvenance(fColumnNames) + ")";
+   }
+
    virtual void ClearTask(unsigned int slot) final
    {
       for (auto &column : fCustomColumns.GetColumns()) {
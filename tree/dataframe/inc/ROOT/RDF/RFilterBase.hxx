@@ -39,6 +39,9 @@ protected:
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
    std::vector<ULong64_t> fAccepted = {0};
    std::vector<ULong64_t> fRejected = {0};
+   /// Per-slot results of the filter for the entries of the current batch, only used in batch mode.
+   /// In batch mode, fLastCheckedEntry holds the first entry of the current batch.
+   std::vector<RDFInternal::RBatchMask_t> fBatchMasks;
    const std::string fName;
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
@@ -67,6 +70,8 @@ public:
    virtual void ClearTask(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Whether the input columns of this filter can be processed in batches.
+   virtual bool SupportsBatch() const = 0;
 };
 
 } // ns RDF
@@ -12,6 +12,7 @@
 #define ROOT_RDF_TINTERFACE
 
 #include "ROOT/RDataSource.hxx"
+#include "ROOT/RDiskCacheDS.hxx"
 #include "ROOT/RDF/ActionHelpers.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/HistoModels.hxx"
@@ -20,6 +21,7 @@
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RDF/RLazyDSImpl.hxx"
+#include "ROOT/RResultMap.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/RStringView.hxx"
@@ -107,6 +109,9 @@ class RInterface {
    /// Contains the custom columns defined up to this node.
    RDFInternal::RBookedCustomColumns fCustomColumns;
 
+   /// The systematic variations in scope at this node, see Vary.
+   RDFInternal::RVariations_t fVariations;
+
 public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Copy-assignment operator for RInterface.
@@ -150,7 +155,7 @@ public:
    operator RNode() const
    {
       return RNode(std::static_pointer_cast<::ROOT::Detail::RDF::RNodeBase>(fProxiedPtr), *fLoopManager, fCustomColumns,
-                   fDataSource);
+                   fDataSource, fVariations);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -195,9 +200,20 @@ public:
 
       using F_t = RDFDetail::RFilter<F, Proxied>;
 
+      // Copies of the filter in the variations are not named: they do not appear in the cut-flow reports
+      auto variations = VaryNode(validColumnNames, [&](const RDFInternal::RVariation &v) {
+         using VariedF_t = RDFDetail::RFilter<F, RDFDetail::RNodeBase>;
+         auto variedColumns = v.fColumns;
+         RDFInternal::AddMissingColumns(variedColumns, newColumns);
+         auto variedFilterPtr =
+            std::make_shared<VariedF_t>(RDFInternal::CopyForVariation(f), validColumnNames, v.fNode, variedColumns);
+         fLoopManager->Book(variedFilterPtr.get());
+         return variedFilterPtr;
+      });
+
       auto filterPtr = std::make_shared<F_t>(std::move(f), validColumnNames, fProxiedPtr, newColumns, name);
       fLoopManager->Book(filterPtr.get());
-      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, newColumns, fDataSource);
+      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, newColumns, fDataSource, std::move(variations));
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -251,15 +267,30 @@ public:
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer<decltype(upcastNodeOnHeap)>::type::element_type;
       RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fCustomColumns, fDataSource);
-      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name);
+      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name, expression);
 
       RDFInternal::BookFilterJit(jittedFilter.get(), upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
                                  fLoopManager->GetBranchNames(), fCustomColumns, fLoopManager->GetTree(), fDataSource,
                                  fLoopManager->GetID());
 
       fLoopManager->Book(jittedFilter.get());
+
+      const auto usedColumns = fVariations.empty()
+                                  ? ColumnNames_t{}
+                                  : RDFInternal::FindUsedColumns(expression, *fLoopManager, fDataSource, fCustomColumns);
+      auto variations = VaryNode(usedColumns, [&](const RDFInternal::RVariation &v) {
+         // deleted by the jitted call to JitFilterHelper
+         auto variedNodeOnHeap = RDFInternal::MakeSharedOnHeap(v.fNode);
+         auto variedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, "", expression);
+         RDFInternal::BookFilterJit(variedFilter.get(), variedNodeOnHeap, "", expression, fLoopManager->GetAliasMap(),
+                                    fLoopManager->GetBranchNames(), v.fColumns, fLoopManager->GetTree(), fDataSource,
+                                    fLoopManager->GetID());
+         fLoopManager->Book(variedFilter.get());
+         return variedFilter;
+      });
+
       return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fCustomColumns,
-                                                        fDataSource);
+                                                        fDataSource, std::move(variations));
    }
 
    // clang-format off
@@ -376,7 +407,7 @@ public:
                                      fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
 
       auto jittedCustomColumn =
-         std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name, fLoopManager->GetNSlots());
+         std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name, fLoopManager->GetNSlots(), expression);
 
       RDFInternal::BookDefineJit(name, expression, *fLoopManager, fDataSource, jittedCustomColumn, fCustomColumns,
                                  fLoopManager->GetBranchNames());
@@ -387,7 +418,26 @@ public:
 
       fLoopManager->RegisterCustomColumn(jittedCustomColumn.get());
 
-      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      // Define the column again in the variations that change its inputs
+      auto variations = fVariations;
+      const auto usedColumns = variations.empty()
+                                  ? ColumnNames_t{}
+                                  : RDFInternal::FindUsedColumns(expression, *fLoopManager, fDataSource, fCustomColumns);
+      for (auto &v : variations) {
+         std::shared_ptr<RDFDetail::RCustomColumnBase> column = jittedCustomColumn;
+         if (RDFInternal::IsVaried(v, nullptr, fCustomColumns, usedColumns)) {
+            auto variedColumn = std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name,
+                                                                                 fLoopManager->GetNSlots(), expression);
+            RDFInternal::BookDefineJit(name, expression, *fLoopManager, fDataSource, variedColumn, v.fColumns,
+                                       fLoopManager->GetBranchNames());
+            column = std::move(variedColumn);
+         }
+         v.fColumns.AddName(name);
+         v.fColumns.AddColumn(column, name);
+      }
+
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource,
+                                             std::move(variations));
 
       return newInterface;
    }
@@ -424,11 +474,126 @@ public:
       RDFInternal::RBookedCustomColumns newCols(fCustomColumns);
 
       newCols.AddName(alias);
-      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      auto variations = fVariations;
+      for (auto &v : variations)
+         v.fColumns.AddName(alias);
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource,
+                                             std::move(variations));
 
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations of a column.
+   /// \param[in] colName The name of the column to vary.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object returning a RVec with the values of the column in each variation.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] variationTags The names of the variations, one per element of the RVec returned by `expression`.
+   /// \param[in] variationName The name of this systematic variation. The name of the varied column is used by default.
+   /// \return the same node of the computation graph, with the variations in scope.
+   ///
+   /// Downstream of a call to Vary, the nodes of the computation graph that depend on the varied column, directly or
+   /// through other custom columns and filters, are booked once per variation tag, with the varied value of the column in
+   /// place of the nominal one. Nodes that do not depend on the varied column are shared with the nominal graph and
+   /// executed only once per entry, as is `expression` itself. All variations are processed in the same event loop.
+   /// The varied results of an action are retrieved with ROOT::RDF::VariationsFor, under the key "variationName:tag".
+   ///
+   /// The value of `colName` in each variation is an element of the RVec returned by `expression`, which must have
+   /// exactly one element per variation tag. Calls to Vary with the same `variationName` and tags vary several columns
+   /// together. The inputs of `expression` are always read with their nominal values.
+   ///
+   /// Variations are propagated through Define, Filter, Alias, Range, Count and the actions returning a histogram, a
+   /// graph or a statistic (Histo*D, Profile*D, Graph, Fill, Min, Max, Mean, StdDev, Sum, Display). Other actions, e.g.
+   /// Snapshot or Take, only produce the nominal result. Copies of named filters are not named: they do not appear in
+   /// cut-flow reports.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto scaled = df.Vary("pt", [](float pt) { return ROOT::RVec<float>{0.98f * pt, 1.02f * pt}; }, {"pt"},
+   ///                       {"down", "up"}, "ptscale");
+   /// auto h = scaled.Filter([](float pt) { return pt > 20; }, {"pt"}).Histo1D<float>({"h", "h", 100, 0, 200}, "pt");
+   /// auto hs = ROOT::RDF::VariationsFor(h); // keys: "nominal", "ptscale:down", "ptscale:up"
+   /// hs["ptscale:up"].Draw();
+   /// ~~~
+   // clang-format on
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      using RetType_t = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsRVec_t<RetType_t>::value,
+                    "Error in `Vary`: the expression must return a RVec with the values of the column in each variation");
+      using T = typename RetType_t::value_type;
+      using ColTypes_t = typename TTraits::CallableTraits<F>::arg_types;
+      constexpr auto nColumns = ColTypes_t::list_size;
+
+      if (variationTags.empty())
+         throw std::runtime_error("Vary: at least one variation tag is required.");
+      const auto variedColumn = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, inputColumns);
+      auto newColumns = CheckAndFillDSColumns(validColumnNames, std::make_index_sequence<nColumns>(), ColTypes_t());
+
+      // All variations of the column are computed at once by this custom column, which is not visible to the user
+      using Variations_t = RDFDetail::RCustomColumn<F>;
+      auto variationsColumn = std::make_shared<Variations_t>(fLoopManager, variedColumn, std::move(expression),
+                                                             validColumnNames, fLoopManager->GetNSlots(), newColumns);
+
+      // Custom columns need a type alias, for jitted nodes booked in the variations. Dataset columns do not.
+      const auto isCustom =
+         fCustomColumns.HasName(variedColumn) && !(fDataSource && fDataSource->HasColumn(variedColumn));
+      const auto typeName = RDFInternal::TypeID2TypeName(typeid(T));
+
+      const auto name = variationName.empty() ? variedColumn : std::string(variationName);
+      auto variations = fVariations;
+      for (auto i = 0u; i < variationTags.size(); ++i) {
+         const auto key = name + ":" + variationTags[i];
+         auto variation = std::find_if(variations.begin(), variations.end(),
+                                       [&key](const RDFInternal::RVariation &v) { return v.fName == key; });
+         if (variation == variations.end()) {
+            variations.push_back(RDFInternal::RVariation{key, fProxiedPtr, newColumns});
+            variation = variations.end() - 1;
+         } else if (RDFInternal::IsVaried(*variation, nullptr, fCustomColumns, {variedColumn})) {
+            throw std::runtime_error("Vary: column \"" + variedColumn + "\" is already varied in variation \"" + key +
+                                     "\".");
+         }
+
+         auto column = std::make_shared<RDFDetail::RVariedColumn<T>>(
+            fLoopManager, variedColumn, variationsColumn, i, variationTags.size(), fLoopManager->GetNSlots());
+         if (isCustom && !typeName.empty()) {
+            fLoopManager->ToJitDeclare("namespace __rdf" + std::to_string(fLoopManager->GetID()) + " { using " +
+                                       variedColumn + std::to_string(column->GetID()) + "_type = " + typeName + "; }");
+         }
+         if (!variation->fColumns.HasName(variedColumn))
+            variation->fColumns.AddName(variedColumn);
+         variation->fColumns.AddColumn(column, variedColumn);
+      }
+
+      return RInterface<Proxied, DS_t>(fProxiedPtr, *fLoopManager, std::move(newColumns), fDataSource,
+                                       std::move(variations));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations of a column.
+   /// \param[in] colName The name of the column to vary.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object returning a RVec
+   /// with the values of the column in each variation.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] nVariations The number of variations, tagged "0", "1"... "nVariations-1".
+   /// \param[in] variationName The name of this systematic variation. The name of the varied column is used by default.
+   /// \return the same node of the computation graph, with the variations in scope.
+   ///
+   /// Refer to the first overload of this method for the full documentation.
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  std::size_t nVariations, std::string_view variationName = "")
+   {
+      std::vector<std::string> variationTags;
+      for (auto i = 0u; i < nVariations; ++i)
+         variationTags.emplace_back(std::to_string(i));
+      return Vary(colName, std::move(expression), inputColumns, variationTags, variationName);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns to disk, in a new TTree `treename` in file `filename`.
    /// \tparam ColumnTypes variadic list of branch/column types.
@@ -630,37 +795,7 @@ public:
          return emptyRDF;
       }
 
-      auto tree = fLoopManager->GetTree();
-      const auto nsID = fLoopManager->GetID();
-      std::stringstream cacheCall;
-      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
-      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
-                                                                                      fCustomColumns, fDataSource);
-      // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
-      RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
-      cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
-                << RDFInternal::PrettyPrintAddr(&resRDF)
-                << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
-                << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->Cache<";
-
-      const auto &customCols = fCustomColumns.GetNames();
-      const auto validColumnNames = GetValidatedColumnNames(columnList.size(), columnList);
-      for (auto &c : validColumnNames) {
-         const auto isCustom = std::find(customCols.begin(), customCols.end(), c) != customCols.end();
-         const auto customColID = isCustom ? fCustomColumns.GetColumns().at(c)->GetID() : 0;
-         cacheCall << RDFInternal::ColumnName2ColumnTypeName(c, nsID, tree, fDataSource, isCustom,
-                                                             /*vector2rvec=*/true, customColID)
-                   << ", ";
-      };
-      if (!columnList.empty())
-         cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
-      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnList) << "));";
-      // jit cacheCall, return result
-      fLoopManager->JitDeclarations(); // some type aliases might be needed by the code jitted in the next line
-      RDFInternal::InterpreterCalc(cacheCall.str(), "Cache");
-      return resRDF;
+      return JitCache(columnList, nullptr);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -690,6 +825,69 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in a persistent cache on disk
+   /// \tparam ColumnTypes variadic list of column types, which must be arithmetic types.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] cacheDir directory that holds the cache files, created if needed.
+   /// \param[in] key identifies the code of the compiled callables upstream of the cached columns, e.g. a version.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// As the in-memory `Cache`, this method returns a new `RDataFrame` that only contains the cached columns. Their
+   /// values are stored in a file in `cacheDir`, in a columnar format that is memory-mapped when read: later runs of
+   /// the same analysis, also in different processes, read the cached columns in place, without running the
+   /// computation graph that produced them nor deserializing their values.
+   ///
+   /// The cache file is identified by everything its content depends on: the names, sizes and modification times of
+   /// the input files, the entries of the entry list, the expressions of the filters and defines upstream of the cached
+   /// columns, the ranges, the names and the types of the cached columns, and `key`. If any of them changes, a new
+   /// cache file is written. Old cache files are never deleted: `cacheDir` can be cleaned up at any time.
+   /// Modification times have a granularity of one second: an input file rewritten with the same size within the
+   /// second in which its cache was written is not detected as changed, and the stale cache is read.
+   ///
+   /// The code of compiled callables (e.g. lambdas passed to `Filter` or `Define`) cannot be inspected: a change of
+   /// their body would go unnoticed. If compiled callables are upstream of the cached columns, a `key` must be passed,
+   /// and changed whenever their code changes; otherwise an exception is thrown.
+   ///
+   /// If no valid cache exists yet, it is written during the first event loop over the returned `RDataFrame`, which
+   /// runs the event loop of this `RDataFrame` first. With implicit multi-threading enabled, the order of the entries
+   /// in the cache is not guaranteed.
+   ///
+   /// Only columns of arithmetic types can be cached on disk, and the columns of a `RDataSource` cannot be cached
+   /// on disk.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// // the first run writes the cache, the next ones read it
+   /// auto cached = df.Filter("pt > 10").Define("e", "sqrt(px*px + pz*pz)").Cache<float, double>({"pt", "e"}, "cache");
+   /// auto h = cached.Histo1D("e");
+   /// // compiled callables require a key, to be changed with their code
+   /// auto cachedSel = df.Filter([](float pt) { return pt > 10; }, {"pt"}).Cache<float>({"pt"}, "cache", "sel-v1");
+   /// ~~~
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, std::string_view cacheDir, std::string_view key = "")
+   {
+      return DiskCacheImpl<ColumnTypes...>(columnList, cacheDir, key);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in a persistent cache on disk
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] cacheDir directory that holds the cache files, created if needed.
+   /// \param[in] key identifies the code of the compiled callables upstream of the cached columns, e.g. a version.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// The types of the columns are inferred (this invocation relies on jitting). See the previous overload for more
+   /// information.
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, std::string_view cacheDir, std::string_view key = "")
+   {
+      if (columnList.empty())
+         throw std::runtime_error("Cache: no columns were selected to be cached on disk.");
+      const std::string cacheDirStr(cacheDir);
+      const std::string keyStr(key);
+      return JitCache(columnList, &cacheDirStr, &keyStr);
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end)
@@ -716,9 +914,15 @@ public:
       CheckIMTDisabled("Range");
 
       using Range_t = RDFDetail::RRange<Proxied>;
+      auto variations = VaryNode({}, [&](const RDFInternal::RVariation &v) {
+         auto variedRangePtr = std::make_shared<RDFDetail::RRange<RDFDetail::RNodeBase>>(begin, end, stride, v.fNode);
+         fLoopManager->Book(variedRangePtr.get());
+         return variedRangePtr;
+      });
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
       fLoopManager->Book(rangePtr.get());
-      RInterface<RDFDetail::RRange<Proxied>> tdf_r(std::move(rangePtr), *fLoopManager, fCustomColumns, fDataSource);
+      RInterface<RDFDetail::RRange<Proxied>> tdf_r(std::move(rangePtr), *fLoopManager, fCustomColumns, fDataSource,
+                                                   std::move(variations));
       return tdf_r;
    }
 
@@ -880,7 +1084,15 @@ public:
       auto action =
          std::make_unique<Action_t>(Helper_t(cSPtr, nSlots), ColumnNames_t({}), fProxiedPtr, std::move(fCustomColumns));
       fLoopManager->Book(action.get());
-      return MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
+      auto resPtr = MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
+      VaryAction(resPtr, cSPtr, {}, fCustomColumns,
+                 [&](const RDFInternal::RVariation &v, const std::shared_ptr<ULong64_t> &variedResult,
+                     RDFInternal::RBookedCustomColumns &&variedColumns) -> std::shared_ptr<RDFInternal::RActionBase> {
+                    using VariedAction_t = RDFInternal::RAction<Helper_t, RDFDetail::RNodeBase>;
+                    return std::make_unique<VariedAction_t>(Helper_t(variedResult, nSlots), ColumnNames_t({}), v.fNode,
+                                                            std::move(variedColumns));
+                 });
+      return resPtr;
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -2305,6 +2517,54 @@ private:
       }
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the systematic variations in scope downstream of a new node.
+   /// \param[in] columns The input columns of the new node.
+   /// \param[in] makeNode Callable creating and booking the copy of the new node in a given variation.
+   ///
+   /// The new node is copied in the variations in which its upstream node or one of its input columns is varied.
+   /// In all other variations the node is left null: the constructor of RInterface replaces it with the nominal one.
+   template <typename MakeNode_t>
+   RDFInternal::RVariations_t VaryNode(const ColumnNames_t &columns, MakeNode_t &&makeNode)
+   {
+      RDFInternal::RVariations_t variations(fVariations);
+      for (auto &v : variations) {
+         if (RDFInternal::IsVaried(v, fProxiedPtr.get(), fCustomColumns, columns))
+            v.fNode = makeNode(v);
+         else
+            v.fNode = nullptr;
+      }
+      return variations;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Book the copies of an action in the systematic variations it depends on.
+   /// \param[in] resPtr The nominal result, to which the varied results are attached (see VariationsFor).
+   /// \param[in] r The initial value of the nominal result, copied to initialize the varied results.
+   /// \param[in] columns The input columns of the action.
+   /// \param[in] actionColumns The custom columns of the nominal action.
+   /// \param[in] makeAction Callable creating the copy of the action for a given variation, result and columns.
+   ///
+   /// Results that are not copy-constructible are not varied.
+   template <typename ActionResultType, typename MakeAction_t>
+   void VaryAction(RResultPtr<ActionResultType> &resPtr, const std::shared_ptr<ActionResultType> &r,
+                   const ColumnNames_t &columns, const RDFInternal::RBookedCustomColumns &actionColumns,
+                   MakeAction_t &&makeAction)
+   {
+      for (const auto &v : fVariations) {
+         if (!RDFInternal::IsVaried(v, fProxiedPtr.get(), fCustomColumns, columns))
+            continue;
+         auto variedResult = RDFInternal::CloneResult(r);
+         if (!variedResult)
+            continue;
+         auto variedColumns = v.fColumns;
+         RDFInternal::AddMissingColumns(variedColumns, actionColumns);
+         auto variedAction = makeAction(v, variedResult, std::move(variedColumns));
+         fLoopManager->Book(variedAction.get());
+         RDFDetail::AddVariedResult(resPtr, v.fName, MakeResultPtr(variedResult, *fLoopManager, variedAction));
+      }
+   }
+
    // Type was specified by the user, no need to infer it
    template <typename ActionTag, typename... BranchTypes, typename ActionResultType,
              typename std::enable_if<!RDFInternal::TNeedJitting<BranchTypes...>::value, int>::type = 0>
@@ -2320,9 +2580,16 @@ private:
       const auto nSlots = fLoopManager->GetNSlots();
 
       auto action = RDFInternal::BuildAction<BranchTypes...>(validColumnNames, r, nSlots, fProxiedPtr, ActionTag{},
-                                                             std::move(newColumns));
+                                                             RDFInternal::RBookedCustomColumns(newColumns));
       fLoopManager->Book(action.get());
-      return MakeResultPtr(r, *fLoopManager, std::move(action));
+      auto resPtr = MakeResultPtr(r, *fLoopManager, std::move(action));
+      VaryAction(resPtr, r, validColumnNames, newColumns,
+                 [&](const RDFInternal::RVariation &v, const std::shared_ptr<ActionResultType> &variedResult,
+                     RDFInternal::RBookedCustomColumns &&variedColumns) -> std::shared_ptr<RDFInternal::RActionBase> {
+                    return RDFInternal::BuildAction<BranchTypes...>(validColumnNames, variedResult, nSlots, v.fNode,
+                                                                    ActionTag{}, std::move(variedColumns));
+                 });
+      return resPtr;
    }
 
    // User did not specify type, do type inference
@@ -2336,7 +2603,6 @@ private:
       auto realNColumns = (nColumns > -1 ? nColumns : sizeof...(BranchTypes));
 
       const auto validColumnNames = GetValidatedColumnNames(realNColumns, columns);
-      const unsigned int nSlots = fLoopManager->GetNSlots();
 
       auto tree = fLoopManager->GetTree();
       auto rOnHeap = RDFInternal::MakeSharedOnHeap(r);
@@ -2350,10 +2616,26 @@ private:
 
       auto toJit = RDFInternal::JitBuildAction(
          validColumnNames, upcastNodeOnHeap, typeid(std::shared_ptr<ActionResultType>), typeid(ActionTag), rOnHeap,
-         tree, nSlots, fCustomColumns, fDataSource, jittedActionOnHeap, fLoopManager->GetID());
+         tree, fCustomColumns, fDataSource, jittedActionOnHeap, fLoopManager->GetID());
       fLoopManager->Book(jittedActionOnHeap->get());
-      fLoopManager->ToJitExec(toJit);
-      return MakeResultPtr(r, *fLoopManager, *jittedActionOnHeap);
+      fLoopManager->ToJitExec(std::move(toJit));
+      auto resPtr = MakeResultPtr(r, *fLoopManager, *jittedActionOnHeap);
+      VaryAction(resPtr, r, validColumnNames, fCustomColumns,
+                 [&](const RDFInternal::RVariation &v, const std::shared_ptr<ActionResultType> &variedResult,
+                     RDFInternal::RBookedCustomColumns &&variedColumns) -> std::shared_ptr<RDFInternal::RActionBase> {
+                    // all deleted by the jitted call to CallBuildAction
+                    auto variedResultOnHeap = RDFInternal::MakeSharedOnHeap(variedResult);
+                    auto variedNodeOnHeap = RDFInternal::MakeSharedOnHeap(v.fNode);
+                    auto variedActionOnHeap =
+                       RDFInternal::MakeSharedOnHeap(std::make_shared<RDFInternal::RJittedAction>(*fLoopManager));
+                    std::shared_ptr<RDFInternal::RActionBase> variedAction = *variedActionOnHeap;
+                    fLoopManager->ToJitExec(RDFInternal::JitBuildAction(
+                       validColumnNames, variedNodeOnHeap, typeid(std::shared_ptr<ActionResultType>),
+                       typeid(ActionTag), variedResultOnHeap, tree, variedColumns, fDataSource,
+                       variedActionOnHeap, fLoopManager->GetID()));
+                    return variedAction;
+                 });
+      return resPtr;
    }
 
    template <typename F, typename CustomColumnType, typename RetType = typename TTraits::CallableTraits<F>::ret_type>
@@ -2378,6 +2660,19 @@ private:
 
       using NewCol_t = RDFDetail::RCustomColumn<F, CustomColumnType>;
       RDFInternal::RBookedCustomColumns newCols(newColumns);
+
+      // Define the column again in the variations that change its inputs
+      auto variations = fVariations;
+      std::vector<std::shared_ptr<RDFDetail::RCustomColumnBase>> variedColumns(variations.size());
+      for (auto i = 0u; i < variations.size(); ++i) {
+         if (!RDFInternal::IsVaried(variations[i], nullptr, fCustomColumns, validColumnNames))
+            continue;
+         auto variedCols = variations[i].fColumns;
+         RDFInternal::AddMissingColumns(variedCols, newColumns);
+         variedColumns[i] = std::make_shared<NewCol_t>(fLoopManager, name, RDFInternal::CopyForVariation(expression),
+                                                       validColumnNames, fLoopManager->GetNSlots(), variedCols);
+      }
+
       auto newColumn = std::make_shared<NewCol_t>(fLoopManager, name, std::forward<F>(expression), validColumnNames,
                                                   fLoopManager->GetNSlots(), newCols);
 
@@ -2391,16 +2686,27 @@ private:
          retTypeName = "void /* The type of column \"" + std::string(name) + "\" (" + demangledType +
                        ") is not known to the interpreter. */";
       }
-      const auto retTypeDeclaration = "namespace __rdf" + std::to_string(fLoopManager->GetID()) +
-                                      " { " + +" using " + std::string(name) + std::to_string(newColumn->GetID()) +
-                                      "_type = " + retTypeName + "; }";
-      fLoopManager->ToJitDeclare(retTypeDeclaration);
+      auto declareRetType = [&](const RDFDetail::RCustomColumnBase &column) {
+         const auto retTypeDeclaration = "namespace __rdf" + std::to_string(fLoopManager->GetID()) + " { " +
+                                         +" using " + std::string(name) + std::to_string(column.GetID()) +
+                                         "_type = " + retTypeName + "; }";
+         fLoopManager->ToJitDeclare(retTypeDeclaration);
+      };
+      declareRetType(*newColumn);
 
       fLoopManager->RegisterCustomColumn(newColumn.get());
       newCols.AddName(name);
       newCols.AddColumn(newColumn, name);
 
-      RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      for (auto i = 0u; i < variations.size(); ++i) {
+         if (variedColumns[i])
+            declareRetType(*variedColumns[i]);
+         variations[i].fColumns.AddName(name);
+         variations[i].fColumns.AddColumn(variedColumns[i] ? variedColumns[i] : newColumn, name);
+      }
+
+      RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource,
+                                       std::move(variations));
 
       return newInterface;
    }
@@ -2461,9 +2767,13 @@ private:
          // multi-thread snapshot
          using Helper_t = RDFInternal::SnapshotHelperMT<ColumnTypes...>;
          using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
-         actionPtr.reset(new Action_t(
-            Helper_t(fLoopManager->GetNSlots(), filename, dirname, treename, validCols, columnList, options), validCols,
-            fProxiedPtr, std::move(newColumns)));
+         auto lm = fLoopManager;
+         auto getTaskRange = [lm](unsigned int slot) {
+            return std::make_pair(lm->GetTaskPosition(slot), lm->GetTaskEnd(slot));
+         };
+         actionPtr.reset(new Action_t(Helper_t(fLoopManager->GetNSlots(), filename, dirname, treename, validCols,
+                                               columnList, options, getTaskRange),
+                                      validCols, fProxiedPtr, std::move(newColumns)));
       }
 
       fLoopManager->Book(actionPtr.get());
@@ -2472,6 +2782,108 @@ private:
                                            std::move(actionPtr));
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Jit the call to the Cache overload that takes the column types as template parameters
+   /// \param[in] columnList The columns to cache, not empty.
+   /// \param[in] cacheDir The directory of the on-disk cache, nullptr to cache in memory.
+   /// \param[in] key The key of the on-disk cache, only used if cacheDir is not nullptr.
+   RInterface<RLoopManager>
+   JitCache(const ColumnNames_t &columnList, const std::string *cacheDir, const std::string *key = nullptr)
+   {
+      auto tree = fLoopManager->GetTree();
+      const auto nsID = fLoopManager->GetID();
+      std::stringstream cacheCall;
+      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
+      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
+                                                                                      fCustomColumns, fDataSource);
+      // build a string equivalent to
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList)[, *(std::string*)(cacheDir),
+      // *(std::string*)(key)])"
+      RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
+      cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
+                << RDFInternal::PrettyPrintAddr(&resRDF)
+                << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
+                << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->Cache<";
+
+      const auto &customCols = fCustomColumns.GetNames();
+      const auto validColumnNames = GetValidatedColumnNames(columnList.size(), columnList);
+      for (auto &c : validColumnNames) {
+         const auto isCustom = std::find(customCols.begin(), customCols.end(), c) != customCols.end();
+         const auto customColID = isCustom ? fCustomColumns.GetColumns().at(c)->GetID() : 0;
+         cacheCall << RDFInternal::ColumnName2ColumnTypeName(c, nsID, tree, fDataSource, isCustom,
+                                                             /*vector2rvec=*/true, customColID)
+                   << ", ";
+      };
+      if (!columnList.empty())
+         cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
+      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
+                << RDFInternal::PrettyPrintAddr(&columnList) << ")";
+      if (cacheDir) {
+         cacheCall << ", *reinterpret_cast<std::string*>(" << RDFInternal::PrettyPrintAddr(cacheDir) << ")";
+         if (key)
+            cacheCall << ", *reinterpret_cast<std::string*>(" << RDFInternal::PrettyPrintAddr(key) << ")";
+      }
+      cacheCall << ");";
+      // jit cacheCall, return result
+      fLoopManager->JitDeclarations(); // some type aliases might be needed by the code jitted in the next line
+      RDFInternal::InterpreterCalc(cacheCall.str(), "Cache");
+      return resRDF;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of the on-disk cache
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> DiskCacheImpl(const ColumnNames_t &columnList, std::string_view cacheDir,
+                                          std::string_view key)
+   {
+      constexpr bool areArithmetic = RDFInternal::TEvalAnd<std::is_arithmetic<ColumnTypes>::value...>::value;
+      static_assert(areArithmetic, "Only columns of arithmetic types can be cached on disk.");
+
+      RDFInternal::CheckTypesAndPars(sizeof...(ColumnTypes), columnList.size());
+      if (columnList.empty())
+         throw std::runtime_error("Cache: no columns were selected to be cached on disk.");
+      if (fDataSource)
+         throw std::runtime_error("Cache: the columns of a data source cannot be cached on disk: the content of a "
+                                  "data source cannot be identified to decide whether a cache is still valid.");
+
+      const auto validCols = GetValidatedColumnNames(columnList.size(), columnList);
+      const std::vector<std::string> typeNames{RDFInternal::TypeID2TypeName(typeid(ColumnTypes))...};
+
+      // The cache file is named after everything its content depends on: a change of the input files or of the
+      // expressions of the filters and defines upstream leads to a different file.
+      std::string provenance = "RDataFrame disk cache, version " + std::to_string(RDFInternal::kDiskCacheVersion) +
+                               "\n" + fProxiedPtr->GetProvenance();
+      for (auto i = 0u; i < columnList.size(); ++i)
+         provenance += "\nColumn(" + columnList[i] + ": " + typeNames[i] + "; " +
+                       fCustomColumns.GetProvenance({validCols[i]}) + ")";
+      if (key.empty() && provenance.find(RDFInternal::kCompiledCallableProvenance) != std::string::npos)
+         throw std::runtime_error("Cache: the cached columns depend on compiled callables, whose code cannot be "
+                                  "identified to decide whether a cache is still valid: pass a key to Cache, to be "
+                                  "changed whenever the code of the callables changes.");
+      if (!key.empty())
+         provenance += "\nKey(" + std::string(key) + ")";
+      const auto fileName = RDFInternal::GetDiskCacheFileName(cacheDir, provenance);
+
+      if (RDFInternal::IsValidDiskCache(fileName, columnList, typeNames)) {
+         auto ds = std::make_unique<RDiskCacheDS>(fileName, columnList, typeNames);
+         return RInterface<RLoopManager>(std::make_shared<RLoopManager>(std::move(ds), columnList));
+      }
+
+      // Book the action that writes the cache: it runs, together with all other actions booked so far, the first
+      // time an event loop over the cached dataset starts
+      auto nEntries = std::make_shared<ULong64_t>(0);
+      using Helper_t = RDFInternal::DiskCacheHelper<ColumnTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      RDFInternal::RBookedCustomColumns columns(fCustomColumns);
+      auto action = std::make_unique<Action_t>(Helper_t(nEntries, fLoopManager->GetNSlots(), fileName, columnList),
+                                               validCols, fProxiedPtr, std::move(columns));
+      fLoopManager->Book(action.get());
+      auto resPtr = MakeResultPtr(nEntries, *fLoopManager, std::move(action));
+      auto ds = std::make_unique<RDiskCacheDS>(fileName, columnList, typeNames,
+                                               [resPtr]() mutable { resPtr.GetValue(); });
+      return RInterface<RLoopManager>(std::make_shared<RLoopManager>(std::move(ds), columnList));
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Implementation of cache
    template <typename... BranchTypes, std::size_t... S>
@@ -2498,9 +2910,18 @@ private:
 
 protected:
    RInterface(const std::shared_ptr<Proxied> &proxied, RLoopManager &lm,
-              const RDFInternal::RBookedCustomColumns &columns, RDataSource *ds)
-      : fProxiedPtr(proxied), fLoopManager(&lm), fDataSource(ds), fCustomColumns(columns)
-   {
+              const RDFInternal::RBookedCustomColumns &columns, RDataSource *ds,
+              RDFInternal::RVariations_t variations = {})
+      : fProxiedPtr(proxied), fLoopManager(&lm), fDataSource(ds), fCustomColumns(columns),
+        fVariations(std::move(variations))
+   {
+      // Variations without a node of their own share the nominal one (see VaryNode), and all variations see the
+      // columns of the nominal graph that they do not vary, e.g. data-source columns booked by the last node.
+      for (auto &v : fVariations) {
+         if (!v.fNode)
+            v.fNode = proxied;
+         RDFInternal::AddMissingColumns(v.fColumns, columns);
+      }
    }
 
    RLoopManager *GetLoopManager() const { return fLoopManager; }
@@ -32,10 +32,12 @@ class RLoopManager;
 /// before the event-loop starts.
 class RJittedCustomColumn : public RCustomColumnBase {
    std::unique_ptr<RCustomColumnBase> fConcreteCustomColumn = nullptr;
+   const std::string fExpression; ///< The expression of the column, which identifies it better than its jitted type
 
 public:
-   RJittedCustomColumn(RLoopManager *lm, std::string_view name, unsigned int nSlots)
-      : RCustomColumnBase(lm, name, nSlots, /*isDSColumn=*/false, RDFInternal::RBookedCustomColumns())
+   RJittedCustomColumn(RLoopManager *lm, std::string_view name, unsigned int nSlots, std::string_view expression = "")
+      : RCustomColumnBase(lm, name, nSlots, /*isDSColumn=*/false, RDFInternal::RBookedCustomColumns()),
+        fExpression(expression)
    {
    }
 
@@ -45,7 +47,11 @@ public:
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) final;
+   void *GetBatchValuePtr(unsigned int slot) final;
+   bool SupportsBatch() const final;
    void ClearValueReaders(unsigned int slot) final;
+   std::string GetProvenance(const std::string &expression = "") const final;
    void InitNode() final;
 };
 
@@ -38,15 +38,19 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
    std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   const std::string fExpression; ///< The expression of the filter, which identifies it better than its jitted type
 
 public:
-   RJittedFilter(RLoopManager *lm, std::string_view name);
+   RJittedFilter(RLoopManager *lm, std::string_view name, std::string_view expression = "");
    ~RJittedFilter() { fLoopManager->Deregister(this); }
 
    void SetFilter(std::unique_ptr<RFilterBase> f);
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   const ROOT::Internal::RDF::RBatchMask_t &
+   CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch) final;
+   bool SupportsBatch() const final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -58,6 +62,7 @@ public:
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
+   std::string GetProvenance(const std::string &expression = "") final;
    void ClearTask(unsigned int slot) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
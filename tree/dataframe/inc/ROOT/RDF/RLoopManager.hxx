@@ -36,6 +36,14 @@ ColumnNames_t GetBranchNames(TTree &t, bool allowDuplicates = true);
 class RActionBase;
 class GraphNode;
 
+/// A piece of code that must be jitted right before the event loop, e.g. the construction of a jitted node.
+/// The code refers to the addresses of the objects it operates on as `__rdf_args[i]` rather than as literals, so that
+/// the same code can be compiled once, cached and reused by other processes (see RLoopManager::Jit).
+struct RJitCall {
+   std::string fCode;
+   std::vector<void *> fArgs; ///< The values of `__rdf_args`
+};
+
 namespace GraphDrawing {
 class GraphCreatorHelper;
 } // ns GraphDrawing
@@ -111,6 +119,8 @@ class RLoopManager : public RNodeBase {
    const ELoopType fLoopType; ///< The kind of event loop that is going to be run (e.g. on ROOT files, on no files)
    std::string fToJitDeclare; ///< Code that should be just-in-time declared right before the event loop
    std::string fToJitExec;    ///< Code that should be just-in-time executed right before the event loop
+   std::vector<RDFInternal::RJitCall> fToJitCalls; ///< Jitted calls to be executed right before the event loop
+   std::string fJitDeclared; ///< All code declared so far by JitDeclarations, needed to compile fToJitCalls
    const std::unique_ptr<RDataSource> fDataSource; ///< Owning pointer to a data-source object. Null if no data-source
    std::map<std::string, std::string> fAliasColumnNameMap; ///< ColumnNameAlias-columnName pairs
    std::vector<TCallback> fCallbacks;                      ///< Registered callbacks
@@ -121,6 +131,13 @@ class RLoopManager : public RNodeBase {
    unsigned int fNRuns{0}; ///< Number of event loops run
 
    std::vector<RCustomColumnBase *> fCustomColumns; ///< Non-owning container of all custom columns created so far.
+   /// Number of entries processed at once in batch mode by the current event loop, zero if batch mode is not used
+   unsigned int fBatchSize{0};
+   std::vector<RDFInternal::RBatchMask_t> fBatchMasks; ///< Per-slot masks that select all entries of a batch
+   /// Per-slot position in the input dataset of the task being processed, see GetTaskPosition()
+   std::vector<std::pair<Long64_t, Long64_t>> fTaskPositions;
+   /// Per-slot position in the input dataset that follows the task being processed, see GetTaskEnd()
+   std::vector<std::pair<Long64_t, Long64_t>> fTaskEnds;
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
@@ -132,11 +149,16 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void RunBatchAndCheckFilters(unsigned int slot, const RDFInternal::RBatch &batch);
+   void RunEmptySourceBatches(unsigned int slot, ULong64_t begin, ULong64_t end);
+   void RunTreeReaderBatches(TTreeReader &r, unsigned int slot, Long64_t firstEntry);
+   bool CanRunBatches() const;
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void EvalChildrenCounts();
+   bool RunCachedJitCalls(const std::string &cacheDir);
    static unsigned int GetNextID();
 
 public:
@@ -148,6 +170,7 @@ public:
 
    void JitDeclarations();
    void Jit();
+   bool IsJitCacheEnabled() const;
    RLoopManager *GetLoopManagerUnchecked() final { return this; }
    void Run();
    const ColumnNames_t &GetDefaultColumnNames() const;
@@ -162,7 +185,16 @@ public:
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   const RDFInternal::RBatchMask_t &CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch) final;
    unsigned int GetNSlots() const { return fNSlots; }
+   /// Position in the input dataset of the first entry of the task that the slot is processing in a multi-thread
+   /// event loop, as the index of the input file and the entry number in that file (or in the whole dataset if tasks
+   /// are not bound to a single file). Sorting tasks by position sorts them in the order of the dataset.
+   std::pair<Long64_t, Long64_t> GetTaskPosition(unsigned int slot) const { return fTaskPositions[slot]; }
+   /// Position in the input dataset right after the last entry of the task that the slot is processing, in the same
+   /// format as GetTaskPosition(). A task that reaches the end of its file ends at the beginning of the next file, so
+   /// that it ends where the following task starts.
+   std::pair<Long64_t, Long64_t> GetTaskEnd(unsigned int slot) const { return fTaskEnds[slot]; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final {}
@@ -171,6 +203,7 @@ public:
    void StopProcessing() final { ++fNStopsReceived; }
    void ToJitDeclare(const std::string &s) { fToJitDeclare.append(s); }
    void ToJitExec(const std::string &s) { fToJitExec.append(s); }
+   void ToJitExec(RDFInternal::RJitCall &&call) { fToJitCalls.emplace_back(std::move(call)); }
    void AddColumnAlias(const std::string &alias, const std::string &colName) { fAliasColumnNameMap[alias] = colName; }
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
@@ -179,6 +212,7 @@ public:
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
+   std::string GetProvenance(const std::string &expression = "") final;
    /// For each booked filter, returns either the name or "Unnamed Filter"
    std::vector<std::string> GetFiltersNames();
 
@@ -11,6 +11,7 @@
 #ifndef ROOT_RDFNODEBASE
 #define ROOT_RDFNODEBASE
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "RtypesCore.h"
 
 #include <memory>
@@ -48,12 +49,19 @@ public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Return, for each entry of the batch, whether it passes this node and all upstream filters (batch mode).
+   virtual const ROOT::Internal::RDF::RBatchMask_t &
+   CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
    virtual void StopProcessing() = 0;
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
+   /// Return a description of the entries selected by this node that is stable across processes, e.g. to identify
+   /// cached results: the input dataset, then the filters and ranges down to this node. If not empty, `expression`
+   /// describes the selection of this node instead of the type of its callable (used for jitted filters).
+   virtual std::string GetProvenance(const std::string &expression = "") = 0;
 
    virtual void ResetChildrenCount()
    {
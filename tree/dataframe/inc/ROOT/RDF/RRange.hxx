@@ -16,6 +16,7 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <string>
 
 namespace ROOT {
 
@@ -31,6 +32,7 @@ std::shared_ptr<GraphNode> CreateRangeNode(const ROOT::Detail::RDF::RRangeBase *
 namespace Detail {
 namespace RDF {
 namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
+namespace RDFInternal = ROOT::Internal::RDF;
 
 template <typename PrevData>
 class RRange final : public RRangeBase {
@@ -75,6 +77,32 @@ public:
       return fLastResult;
    }
 
+   const RDFInternal::RBatchMask_t &CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch) final
+   {
+      if (batch.fFirstEntry != fLastCheckedEntry) {
+         auto &mask = fLastBatchResult;
+         mask = fPrevData.CheckFiltersBatch(slot, batch);
+         // same logic as in CheckFilters, entry by entry: the range can stop in the middle of a batch
+         for (auto i = 0u; i < batch.fSize; ++i) {
+            if (!mask[i])
+               continue;
+            if (fHasStopped) {
+               mask[i] = 0;
+               continue;
+            }
+            ++fNProcessedEntries;
+            mask[i] = !(fNProcessedEntries <= fStart || (fStop > 0 && fNProcessedEntries > fStop) ||
+                        (fStride != 1 && fNProcessedEntries % fStride != 0));
+            if (fNProcessedEntries == fStop) {
+               fHasStopped = true;
+               fPrevData.StopProcessing();
+            }
+         }
+         fLastCheckedEntry = batch.fFirstEntry;
+      }
+      return fLastBatchResult;
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevData.PartialReport(rep); }
@@ -98,6 +126,11 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
+   std::string GetProvenance(const std::string & = "") final
+   {
+      return fPrevData.GetProvenance() + "\nRange(" + std::to_string(fStart) + ", " + std::to_string(fStop) + ", " +
+             std::to_string(fStride) + ")";
+   }
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // TODO: Ranges node have no information about custom columns, hence it is not possible now
@@ -0,0 +1,146 @@
+// Author: agent <agent@local>  07/2020
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RVARIEDCOLUMN
+#define ROOT_RVARIEDCOLUMN
+
+#include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCustomColumnBase.hxx"
+#include "ROOT/RStringView.hxx"
+#include "ROOT/RVec.hxx"
+#include "RtypesCore.h"
+
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Detail {
+namespace RDF {
+
+class RNodeBase;
+
+/// One systematic variation of a column, as seen by the nodes booked in that variation.
+/// All variations of a column are computed at once by a single custom column returning a RVec (the expression passed
+/// to RInterface::Vary), which is evaluated at most once per entry. A RVariedColumn exposes one element of that RVec.
+template <typename T>
+class RVariedColumn final : public RCustomColumnBase {
+   // Avoid instantiating vector<bool> as `operator[]` returns temporaries in that case. Use std::deque instead.
+   using ValuesPerSlot_t =
+      typename std::conditional<std::is_same<T, bool>::value, std::deque<T>, std::vector<T>>::type;
+
+   /// The custom column that computes all variations, shared by all RVariedColumns of the same Vary call
+   std::shared_ptr<RCustomColumnBase> fVariations;
+   const std::size_t fIndex;       ///< index of this variation in the RVec returned by fVariations
+   const std::size_t fNVariations; ///< expected size of the RVec returned by fVariations
+   ValuesPerSlot_t fLastResults;
+   /// Per-slot values of the current batch, only used in batch mode
+   std::vector<std::unique_ptr<T[]>> fBatchResults;
+   std::vector<unsigned int> fBatchCapacities;
+
+   void CheckNVariations(const ROOT::VecOps::RVec<T> &values) const
+   {
+      if (values.size() != fNVariations) {
+         throw std::runtime_error("The expression varying column \"" + fName + "\" returned " +
+                                  std::to_string(values.size()) + " values instead of " +
+                                  std::to_string(fNVariations) + ".");
+      }
+   }
+
+public:
+   RVariedColumn(RLoopManager *lm, std::string_view name, std::shared_ptr<RCustomColumnBase> variations,
+                 std::size_t index, std::size_t nVariations, unsigned int nSlots)
+      : RCustomColumnBase(lm, name, nSlots, /*isDSColumn=*/false, RDFInternal::RBookedCustomColumns()),
+        fVariations(std::move(variations)), fIndex(index), fNVariations(nVariations), fLastResults(fNSlots),
+        fBatchResults(fNSlots), fBatchCapacities(fNSlots, 0u)
+   {
+   }
+
+   RVariedColumn(const RVariedColumn &) = delete;
+   RVariedColumn &operator=(const RVariedColumn &) = delete;
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final { fVariations->InitSlot(r, slot); }
+
+   void *GetValuePtr(unsigned int slot) final { return static_cast<void *>(&fLastResults[slot]); }
+
+   void Update(unsigned int slot, Long64_t entry) final
+   {
+      if (entry != fLastCheckedEntry[slot]) {
+         fVariations->Update(slot, entry);
+         const auto &values = *static_cast<ROOT::VecOps::RVec<T> *>(fVariations->GetValuePtr(slot));
+         CheckNVariations(values);
+         fLastResults[slot] = values[fIndex];
+         fLastCheckedEntry[slot] = entry;
+      }
+   }
+
+   void *GetBatchValuePtr(unsigned int slot) final { return static_cast<void *>(fBatchResults[slot].get()); }
+
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) final
+   {
+      if (batch.fSize > fBatchCapacities[slot]) {
+         fBatchResults[slot].reset(new T[batch.fSize]);
+         fBatchCapacities[slot] = batch.fSize;
+      }
+      const auto toEvaluate = GetEntriesToEvaluate(slot, batch, mask);
+      if (!toEvaluate)
+         return;
+      fVariations->UpdateBatch(slot, batch, *toEvaluate);
+      const auto variations = static_cast<ROOT::VecOps::RVec<T> *>(fVariations->GetBatchValuePtr(slot));
+      auto results = fBatchResults[slot].get();
+      for (auto i = 0u; i < batch.fSize; ++i) {
+         if ((*toEvaluate)[i]) {
+            CheckNVariations(variations[i]);
+            results[i] = variations[i][fIndex];
+         }
+      }
+   }
+
+   bool SupportsBatch() const final { return fVariations->SupportsBatch(); }
+
+   const std::type_info &GetTypeId() const final { return typeid(T); }
+
+   void ClearValueReaders(unsigned int slot) final { fVariations->ClearValueReaders(slot); }
+
+   std::string GetProvenance(const std::string & = "") const final
+   {
+      return "Variation(" + fName + ": " + std::to_string(fIndex) + "; " + fVariations->GetProvenance() + ")";
+   }
+};
+
+} // ns RDF
+} // ns Detail
+
+namespace Internal {
+namespace RDF {
+
+namespace RDFDetail = ROOT::Detail::RDF;
+
+/// The state of the computation graph in one systematic variation, e.g. "jes:up".
+/// fNode and fColumns take the place of the nominal node and custom columns for all nodes booked in this variation.
+/// Nodes and columns that do not depend on varied columns are shared with the nominal computation graph.
+struct RVariation {
+   std::string fName;                           ///< "variationName:tag"
+   std::shared_ptr<RDFDetail::RNodeBase> fNode; ///< the node of the varied graph corresponding to the nominal one
+   RBookedCustomColumns fColumns;               ///< the custom columns of the varied graph, including varied ones
+};
+
+using RVariations_t = std::vector<RVariation>;
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif // ROOT_RVARIEDCOLUMN
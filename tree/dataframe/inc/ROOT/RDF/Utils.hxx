@@ -176,6 +176,10 @@ void InterpreterDeclare(const std::string &code);
 /// The pointer returned by the call to TInterpreter::Calc is returned in case of success.
 Long64_t InterpreterCalc(const std::string &code, const std::string &context = "");
 
+/// Prefix of the provenance (see RNodeBase::GetProvenance) of the filters and defines that run compiled callables.
+/// Only the type of a compiled callable is known: a change of its code does not change the provenance.
+constexpr const char *kCompiledCallableProvenance = "compiled callable ";
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
@@ -0,0 +1,135 @@
+// Author: agent <agent@local>  07/2020
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDISKCACHEDS
+#define ROOT_RDISKCACHEDS
+
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h" // ULong64_t
+
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+
+/**
+\class ROOT::Internal::RDF::RDiskCacheWriter
+\ingroup dataframe
+\brief Write the columns cached by RInterface::Cache(columns, cacheDir) to a file that can be memory-mapped.
+
+The file starts with a header listing the names, the type names and the sizes of the columns. It continues with a
+sequence of row groups, each one storing the values of a block of entries column by column as contiguous arrays, and
+ends with an index of the row groups. Every array starts at an offset aligned to 16 bytes so that, once the file is
+memory-mapped, the values can be read in place. Row groups can be written concurrently from several threads.
+
+The file is written under a temporary name and only renamed to its final name by Commit: a cache file that exists
+is always complete.
+*/
+class RDiskCacheWriter {
+   const std::string fFileName;
+   const std::string fTmpFileName;
+   std::FILE *fFile = nullptr;
+   ULong64_t fOffset = 0;                                   ///< Current size of the file
+   std::vector<std::size_t> fColumnSizes;                   ///< Size of the values of each column
+   std::vector<std::pair<ULong64_t, ULong64_t>> fRowGroups; ///< Offset and number of entries of each row group
+   std::mutex fMutex;
+
+   void Write(const void *data, std::size_t size);
+   void Pad();
+
+public:
+   RDiskCacheWriter(const std::string &fileName, const std::vector<std::string> &columnNames,
+                    const std::vector<std::string> &typeNames, const std::vector<std::size_t> &columnSizes);
+   RDiskCacheWriter(const RDiskCacheWriter &) = delete;
+   RDiskCacheWriter &operator=(const RDiskCacheWriter &) = delete;
+   ~RDiskCacheWriter();
+
+   /// Append a row group with `nEntries` entries, `columns[i]` holding the values of the i-th column.
+   void WriteRowGroup(ULong64_t nEntries, const std::vector<const char *> &columns);
+   /// Write the index of the row groups and move the file to its final name.
+   void Commit();
+};
+
+/// Whether fileName is a complete cache file holding the given columns.
+bool IsValidDiskCache(const std::string &fileName, const std::vector<std::string> &columnNames,
+                      const std::vector<std::string> &typeNames);
+
+/// Version of the format of the cache files. Changing it invalidates all existing caches.
+constexpr unsigned int kDiskCacheVersion = 1;
+
+} // ns RDF
+} // ns Internal
+
+namespace RDF {
+
+/**
+\class ROOT::RDF::RDiskCacheDS
+\ingroup dataframe
+\brief A RDataSource that reads the columns cached on disk by RInterface::Cache(columns, cacheDir).
+
+The cache file is memory-mapped: column values are read in place, without copies nor deserialization, and the
+operating system pages in only the parts of the file that are accessed. Each row group of the file is an entry range
+that can be processed by a different slot.
+
+If the cache file does not exist yet, a function that produces it (typically by running the event loop that fills it)
+can be passed to the constructor. It is invoked when the first event loop over this data source starts.
+*/
+class RDiskCacheDS final : public ROOT::RDF::RDataSource {
+   const std::string fFileName;
+   const std::vector<std::string> fColumnNames;
+   const std::vector<std::string> fTypeNames;
+   std::function<void()> fProducer;
+   unsigned int fNSlots = 0U;
+   char *fBuffer = nullptr; ///< The memory-mapped file
+   std::size_t fBufferSize = 0;
+   std::vector<char> fBufferFallback; ///< Holds the content of the file where memory-mapping is not available
+   std::vector<std::size_t> fColumnSizes;
+   std::vector<ULong64_t> fRowGroupFirstEntries; ///< First entry of each row group, followed by the number of entries
+   /// For each row group, the offset of the values of each column in the file
+   std::vector<std::vector<ULong64_t>> fRowGroupColumnOffsets;
+   /// For each slot, the address of the current value of each column
+   std::vector<std::vector<void *>> fColumnAddresses;
+   bool fRangesReturned = false;
+
+   void Open();
+   void Close();
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &) final;
+
+protected:
+   std::string AsString() final { return "on-disk cache data source"; };
+
+public:
+   RDiskCacheDS(std::string_view fileName, const std::vector<std::string> &columnNames,
+                const std::vector<std::string> &typeNames, std::function<void()> producer = nullptr);
+   ~RDiskCacheDS();
+   const std::vector<std::string> &GetColumnNames() const final { return fColumnNames; }
+   bool HasColumn(std::string_view colName) const final;
+   std::string GetTypeName(std::string_view colName) const final;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
+   bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   void SetNSlots(unsigned int nSlots) final;
+   void Initialise() final;
+   std::string GetLabel() final { return "DiskCache"; }
+};
+
+} // ns RDF
+
+} // ns ROOT
+
+#endif
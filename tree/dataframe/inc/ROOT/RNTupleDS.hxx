@@ -21,8 +21,10 @@
 #include <ROOT/RStringView.hxx>
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ROOT {
@@ -33,6 +35,13 @@ class REntry;
 
 
 class RNTupleDS final : public ROOT::RDF::RDataSource {
+   /// A range cut on the values of a column that is used to skip clusters, see SkipClustersOutside()
+   struct RValueRangeCut {
+      std::uint64_t fColumnId;
+      double fMin;
+      double fMax;
+   };
+
    /// Clones of the first reader, one for each slot
    std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>> fReaders;
    std::vector<std::unique_ptr<ROOT::Experimental::REntry>> fEntries;
@@ -42,6 +51,7 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    bool fHasSeenAllRanges = false;
    std::vector<std::string> fColumnNames;
    std::vector<std::string> fColumnTypes;
+   std::vector<RValueRangeCut> fValueRangeCuts;
 
 public:
    explicit RNTupleDS(std::unique_ptr<ROOT::Experimental::RNTupleReader> ntuple);
@@ -56,11 +66,22 @@ public:
 
    void Initialise() final;
 
+   /// Skips the clusters whose stored value range of the given top-level numerical field does not overlap with
+   /// [min, max].  This is an I/O optimization only: entries outside the range in the remaining clusters are still
+   /// processed and the corresponding Filter() is still required.  Has to be called before the event loop starts.
+   /// Value ranges are only stored if the ntuple was written with RNTupleWriteOptions::SetUseValueRanges().
+   void SkipClustersOutside(std::string_view fieldName, double min, double max);
+
 protected:
    Record_t GetColumnReadersImpl(std::string_view name, const std::type_info &) final;
 };
 
 RDataFrame MakeNTupleDataFrame(std::string_view ntupleName, std::string_view fileName);
+/// Skips the clusters whose stored value range of any of the given top-level numerical fields does not overlap with
+/// the corresponding [min, max] interval, e.g. `MakeNTupleDataFrame("ntpl", "f.root", {{"pt", {150., 250.}}})`.
+/// See RNTupleDS::SkipClustersOutside().
+RDataFrame MakeNTupleDataFrame(std::string_view ntupleName, std::string_view fileName,
+                               const std::map<std::string, std::pair<double, double>> &skipClustersOutside);
 
 } // ns Experimental
 } // ns ROOT
@@ -0,0 +1,90 @@
+// Author: agent <agent@local>  07/2020
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRESULTMAP
+#define ROOT_RRESULTMAP
+
+#include "ROOT/RResultPtr.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+
+/**
+\class ROOT::RDF::RResultMap
+\ingroup dataframe
+\brief The results of an action in the nominal computation graph and in all the systematic variations it depends on.
+\tparam T Type of the action result
+
+Results are accessed by variation name, "nominal" for the nominal result and "variationName:tag" for the others (see
+RInterface::Vary). As for RResultPtr, accessing a result triggers the event loop if needed: all results are filled in the
+same event loop.
+~~~{.cpp}
+auto h = df.Vary("pt", varyPt, {"pt"}, {"down", "up"}, "ptscale").Histo1D<float>("pt");
+auto hs = ROOT::RDF::VariationsFor(h);
+hs["nominal"].Draw();
+hs["ptscale:up"].Draw("SAME");
+~~~
+*/
+template <typename T>
+class RResultMap {
+   std::vector<std::string> fKeys;
+   std::vector<RResultPtr<T>> fResults;
+
+public:
+   RResultMap(std::vector<std::string> keys, std::vector<RResultPtr<T>> results)
+      : fKeys(std::move(keys)), fResults(std::move(results))
+   {
+   }
+
+   /// Return the names of the variations available, "nominal" first.
+   const std::vector<std::string> &GetKeys() const { return fKeys; }
+
+   /// Return the result of the action in the given variation.
+   /// Triggers event loop and execution of all actions booked in the associated RLoopManager.
+   T &operator[](const std::string &key)
+   {
+      const auto it = std::find(fKeys.begin(), fKeys.end(), key);
+      if (it == fKeys.end())
+         throw std::runtime_error("RResultMap: there is no variation named \"" + key + "\" for this result.");
+      return *fResults[std::distance(fKeys.begin(), it)];
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////
+/// \brief Return the results of an action in all the systematic variations it depends on.
+/// \param[in] resPtr The nominal result of an action booked downstream of one or more calls to RInterface::Vary.
+/// \return a RResultMap with the nominal result under "nominal" and the varied ones under "variationName:tag".
+///
+/// Variations that do not affect the inputs of the action, nor any of the filters upstream of it, are not listed:
+/// their result is the nominal one.
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr)
+{
+   std::vector<std::string> keys{"nominal"};
+   std::vector<RResultPtr<T>> results{resPtr};
+   if (resPtr.fVariedResults) {
+      for (const auto &variation : *resPtr.fVariedResults) {
+         keys.emplace_back(variation.first);
+         results.emplace_back(variation.second);
+      }
+   }
+   return RResultMap<T>(std::move(keys), std::move(results));
+}
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RRESULTMAP
@@ -18,6 +18,9 @@
 
 #include <memory>
 #include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -33,6 +36,9 @@ namespace RDF {
 template <typename T>
 class RResultPtr;
 
+template <typename T>
+class RResultMap;
+
 } // ns RDF
 
 namespace Detail {
@@ -42,6 +48,8 @@ using ROOT::RDF::RResultPtr;
 template <typename T>
 RResultPtr<T> MakeResultPtr(const std::shared_ptr<T> &r, RLoopManager &df,
                             std::shared_ptr<ROOT::Internal::RDF::RActionBase> actionPtr);
+template <typename T>
+void AddVariedResult(RResultPtr<T> &nominal, const std::string &variation, const RResultPtr<T> &varied);
 } // ns RDF
 } // ns Detail
 namespace RDF {
@@ -80,6 +88,10 @@ class RResultPtr {
    template <typename T1>
    friend RResultPtr<T1> RDFDetail::MakeResultPtr(const std::shared_ptr<T1> &, ::ROOT::Detail::RDF::RLoopManager &,
                                                   std::shared_ptr<RDFInternal::RActionBase>);
+   template <typename T1>
+   friend void RDFDetail::AddVariedResult(RResultPtr<T1> &, const std::string &, const RResultPtr<T1> &);
+   template <typename T1>
+   friend RResultMap<T1> VariationsFor(RResultPtr<T1> resPtr);
    template <class T1, class T2>
    friend bool operator==(const RResultPtr<T1> &lhs, const RResultPtr<T2> &rhs);
    template <class T1, class T2>
@@ -118,6 +130,9 @@ class RResultPtr {
    /// Owning pointer to the action that will produce this result.
    /// Ownership is shared with other copies of this ResultPtr.
    std::shared_ptr<RDFInternal::RActionBase> fActionPtr;
+   /// The results of the same action booked in the systematic variations it depends on, see VariationsFor().
+   /// Shared with other copies of this ResultPtr.
+   std::shared_ptr<std::vector<std::pair<std::string, RResultPtr<T>>>> fVariedResults;
 
    /// Triggers the event loop in the RLoopManager
    void TriggerRun();
@@ -347,6 +362,15 @@ MakeResultPtr(const std::shared_ptr<T> &r, RLoopManager &lm, std::shared_ptr<RDF
 {
    return RResultPtr<T>(r, &lm, std::move(actionPtr));
 }
+
+/// Attach to the result of an action the result of a copy of that action booked in a systematic variation.
+template <typename T>
+void AddVariedResult(RResultPtr<T> &nominal, const std::string &variation, const RResultPtr<T> &varied)
+{
+   if (!nominal.fVariedResults)
+      nominal.fVariedResults = std::make_shared<std::vector<std::pair<std::string, RResultPtr<T>>>>();
+   nominal.fVariedResults->emplace_back(variation, varied);
+}
 } // end NS RDF
 } // end NS Detail
 } // end NS ROOT
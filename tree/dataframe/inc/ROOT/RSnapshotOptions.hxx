@@ -37,6 +37,7 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   bool fKeepEntryOrder = false; ///< In multi-thread event loops, write the entries in the order of the input dataset
 };
 } // ns RDF
 } // ns ROOT
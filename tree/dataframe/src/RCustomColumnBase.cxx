@@ -30,7 +30,7 @@ unsigned int RCustomColumnBase::GetNextID()
 RCustomColumnBase::RCustomColumnBase(RLoopManager *lm, std::string_view name, const unsigned int nSlots,
                                      const bool isDSColumn, const RDFInternal::RBookedCustomColumns &customColumns)
    : fLoopManager(lm), fName(name), fNSlots(nSlots), fIsDataSourceColumn(isDSColumn), fCustomColumns(customColumns),
-     fIsInitialized(nSlots, false)
+     fIsInitialized(nSlots, false), fBatchEvaluated(nSlots), fBatchToEvaluate(nSlots)
 {
    fLoopManager->RegisterCustomColumn(this);
 }
@@ -50,3 +50,27 @@ void RCustomColumnBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
 }
+
+/// Return the entries selected by `mask` whose value has not been computed yet in the current batch, or nullptr if
+/// there are none. The returned entries are flagged as computed: the caller is expected to compute them.
+const RDFInternal::RBatchMask_t *RCustomColumnBase::GetEntriesToEvaluate(unsigned int slot,
+                                                                         const RDFInternal::RBatch &batch,
+                                                                         const RDFInternal::RBatchMask_t &mask)
+{
+   auto &evaluated = fBatchEvaluated[slot];
+   if (batch.fFirstEntry != fLastCheckedEntry[slot]) {
+      evaluated.assign(batch.fSize, 0);
+      fLastCheckedEntry[slot] = batch.fFirstEntry;
+   }
+   auto &toEvaluate = fBatchToEvaluate[slot];
+   toEvaluate.assign(batch.fSize, 0);
+   bool any = false;
+   for (auto i = 0u; i < batch.fSize; ++i) {
+      if (mask[i] && !evaluated[i]) {
+         toEvaluate[i] = 1;
+         evaluated[i] = 1;
+         any = true;
+      }
+   }
+   return any ? &toEvaluate : nullptr;
+}
@@ -1,4 +1,6 @@
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCustomColumnBase.hxx"
+#include "ROOT/RDF/InterfaceUtils.hxx" // IsInternalColumn
 
 namespace ROOT {
 namespace Internal {
@@ -25,6 +27,22 @@ void RBookedCustomColumns::AddName(std::string_view name)
    fCustomColumnsNames = newColsNames;
 }
 
+std::string RBookedCustomColumns::GetProvenance(const ColumnNames_t &columns) const
+{
+   std::string provenance;
+   for (const auto &column : columns) {
+      if (!provenance.empty())
+         provenance += ", ";
+      const auto it = fCustomColumns->find(column);
+      // the values of the internal columns, e.g. rdfentry_, only depend on the input dataset
+      if (it == fCustomColumns->end() || IsInternalColumn(column))
+         provenance += column;
+      else
+         provenance += it->second->GetProvenance();
+   }
+   return provenance;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -20,6 +20,7 @@
 #include <TClassEdit.h>
 #include <TFriendElement.h>
 #include <TInterpreter.h>
+#include <TMD5.h>
 #include <TObject.h>
 #include <TRegexp.h>
 #include <TPRegexp.h>
@@ -615,20 +616,18 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::strin
    const bool hasReturnStmt = re.Index(dotlessExpr, &matchedLen) != -1;
 
    auto lm = jittedFilter->GetLoopManagerUnchecked();
-   lm->JitDeclarations(); // TryToJitExpression might need some of the Define'd column type aliases
-   TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
+   // With the jit cache, the expression is checked when the event loop starts, by the compiler or by the interpreter
+   if (!lm->IsJitCacheEnabled()) {
+      lm->JitDeclarations(); // TryToJitExpression might need some of the Define'd column type aliases
+      TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
+   }
 
    const auto filterLambda = BuildLambdaString(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
 
-   const auto jittedFilterAddr = PrettyPrintAddr(jittedFilter);
-   const auto prevNodeAddr = PrettyPrintAddr(prevNodeOnHeap);
-
    // columnsOnHeap is deleted by the jitted call to JitFilterHelper
    ROOT::Internal::RDF::RBookedCustomColumns *columnsOnHeap = new ROOT::Internal::RDF::RBookedCustomColumns(customCols);
-   const auto columnsOnHeapAddr = PrettyPrintAddr(columnsOnHeap);
 
    // Produce code snippet that creates the filter and registers it with the corresponding RJittedFilter
-   // Windows requires std::hex << std::showbase << (size_t)pointer to produce notation "0x1234"
    std::stringstream filterInvocation;
    filterInvocation << "ROOT::Internal::RDF::JitFilterHelper(" << filterLambda << ", {";
    for (const auto &brName : usedBranches) {
@@ -640,12 +639,12 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::strin
    if (!usedBranches.empty())
       filterInvocation.seekp(-2, filterInvocation.cur); // remove the last ",
    filterInvocation << "}, \"" << name << "\", "
-                    << "reinterpret_cast<ROOT::Detail::RDF::RJittedFilter*>(" << jittedFilterAddr << "), "
-                    << "reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(" << prevNodeAddr << "),"
-                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(" << columnsOnHeapAddr << ")"
+                    << "reinterpret_cast<ROOT::Detail::RDF::RJittedFilter*>(__rdf_args[0]), "
+                    << "reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(__rdf_args[1]),"
+                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(__rdf_args[2])"
                     << ");";
 
-   lm->ToJitExec(filterInvocation.str());
+   lm->ToJitExec({filterInvocation.str(), {jittedFilter, prevNodeOnHeap, columnsOnHeap}});
 }
 
 // Jit a Define call
@@ -669,8 +668,11 @@ void BookDefineJit(std::string_view name, std::string_view expression, RLoopMana
    Ssiz_t matchedLen;
    const bool hasReturnStmt = re.Index(dotlessExpr, &matchedLen) != -1;
 
-   lm.JitDeclarations(); // TryToJitExpression might need some of the Define'd column type aliases
-   TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
+   // With the jit cache, the expression is checked when the event loop starts, by the compiler or by the interpreter
+   if (!lm.IsJitCacheEnabled()) {
+      lm.JitDeclarations(); // TryToJitExpression might need some of the Define'd column type aliases
+      TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
+   }
 
    const auto definelambda = BuildLambdaString(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
    const auto customColID = std::to_string(jittedCustomColumn->GetID());
@@ -678,7 +680,6 @@ void BookDefineJit(std::string_view name, std::string_view expression, RLoopMana
    const auto ns = "__rdf" + std::to_string(namespaceID);
 
    auto customColumnsCopy = new RDFInternal::RBookedCustomColumns(customCols);
-   auto customColumnsAddr = PrettyPrintAddr(customColumnsCopy);
 
    // Declare the lambda variable and an alias for the type of the defined column in namespace __rdf
    // This assumes that a given variable is Define'd once per RDataFrame -- we might want to relax this requirement
@@ -698,21 +699,19 @@ void BookDefineJit(std::string_view name, std::string_view expression, RLoopMana
    }
    if (!usedBranches.empty())
       defineInvocation.seekp(-2, defineInvocation.cur); // remove the last ",
-   defineInvocation << "}, \"" << name << "\", reinterpret_cast<ROOT::Detail::RDF::RLoopManager*>("
-                    << PrettyPrintAddr(&lm) << "), *reinterpret_cast<ROOT::Detail::RDF::RJittedCustomColumn*>("
-                    << PrettyPrintAddr(jittedCustomColumn.get()) << "),"
-                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(" << customColumnsAddr << ")"
+   defineInvocation << "}, \"" << name << "\", reinterpret_cast<ROOT::Detail::RDF::RLoopManager*>(__rdf_args[0]), "
+                    << "*reinterpret_cast<ROOT::Detail::RDF::RJittedCustomColumn*>(__rdf_args[1]),"
+                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(__rdf_args[2])"
                     << ");";
 
-   lm.ToJitExec(defineInvocation.str());
+   lm.ToJitExec({defineInvocation.str(), {&lm, jittedCustomColumn.get(), customColumnsCopy}});
 }
 
 // Jit and call something equivalent to "this->BuildAndBook<BranchTypes...>(params...)"
 // (see comments in the body for actual jitted code)
-std::string JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::type_info &art, const std::type_info &at,
-                           void *rOnHeap, TTree *tree, const unsigned int nSlots,
-                           const RDFInternal::RBookedCustomColumns &customCols, RDataSource *ds,
-                           std::shared_ptr<RJittedAction> *jittedActionOnHeap, unsigned int namespaceID)
+RJitCall JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::type_info &art, const std::type_info &at,
+                        void *rOnHeap, TTree *tree, const RDFInternal::RBookedCustomColumns &customCols,
+                        RDataSource *ds, std::shared_ptr<RJittedAction> *jittedActionOnHeap, unsigned int namespaceID)
 {
    auto nBranches = bl.size();
 
@@ -749,7 +748,6 @@ std::string JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::t
    const auto actionTypeName = actionTypeClass->GetName();
 
    auto customColumnsCopy = new RDFInternal::RBookedCustomColumns(customCols); // deleted in jitted CallBuildAction
-   auto customColumnsAddr = PrettyPrintAddr(customColumnsCopy);
 
    // Build a call to CallBuildAction with the appropriate argument. When run through the interpreter, this code will
    // just-in-time create an RAction object and it will assign it to its corresponding RJittedAction.
@@ -758,22 +756,17 @@ std::string JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::t
                     << "<" << actionTypeName;
    for (auto &colType : columnTypeNames)
       createAction_str << ", " << colType;
-   // on Windows, to prefix the hexadecimal value of a pointer with '0x',
-   // one need to write: std::hex << std::showbase << (size_t)pointer
-   createAction_str << ">(reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>("
-                    << PrettyPrintAddr(prevNode) << "), {";
+   createAction_str << ">(reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(__rdf_args[0]), {";
    for (auto i = 0u; i < bl.size(); ++i) {
       if (i != 0u)
          createAction_str << ", ";
       createAction_str << '"' << bl[i] << '"';
    }
-   createAction_str << "}, " << std::dec << std::noshowbase << nSlots << ", reinterpret_cast<" << actionResultTypeName
-                    << "*>(" << PrettyPrintAddr(rOnHeap) << ")"
-                    << ", reinterpret_cast<std::shared_ptr<ROOT::Internal::RDF::RJittedAction>*>("
-                    << PrettyPrintAddr(jittedActionOnHeap) << "),"
-                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(" << customColumnsAddr << ")"
+   createAction_str << "}, reinterpret_cast<" << actionResultTypeName << "*>(__rdf_args[1])"
+                    << ", reinterpret_cast<std::shared_ptr<ROOT::Internal::RDF::RJittedAction>*>(__rdf_args[2]),"
+                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(__rdf_args[3])"
                     << ");";
-   return createAction_str.str();
+   return {createAction_str.str(), {prevNode, rOnHeap, jittedActionOnHeap, customColumnsCopy}};
 }
 
 bool AtLeastOneEmptyString(const std::vector<std::string_view> strings)
@@ -790,6 +783,52 @@ std::shared_ptr<RNodeBase> UpcastNode(std::shared_ptr<RNodeBase> ptr)
    return ptr;
 }
 
+bool IsVaried(const RVariation &variation, const RNodeBase *nominalNode, const RBookedCustomColumns &nominalColumns,
+              const ColumnNames_t &columns)
+{
+   if (nominalNode && variation.fNode.get() != nominalNode)
+      return true;
+
+   const auto &variedCols = variation.fColumns.GetColumns();
+   const auto &nominalCols = nominalColumns.GetColumns();
+   for (const auto &c : columns) {
+      const auto variedIt = variedCols.find(c);
+      const auto nominalIt = nominalCols.find(c);
+      const auto variedCol = variedIt == variedCols.end() ? nullptr : variedIt->second.get();
+      const auto nominalCol = nominalIt == nominalCols.end() ? nullptr : nominalIt->second.get();
+      if (variedCol != nominalCol)
+         return true;
+   }
+   return false;
+}
+
+void AddMissingColumns(RBookedCustomColumns &columns, const RBookedCustomColumns &nominalColumns)
+{
+   for (const auto &name : nominalColumns.GetNames()) {
+      if (!columns.HasName(name))
+         columns.AddName(name);
+   }
+   const auto &knownCols = columns.GetColumns();
+   for (const auto &col : nominalColumns.GetColumns()) {
+      if (knownCols.find(col.first) == knownCols.end())
+         columns.AddColumn(col.second, col.first);
+   }
+}
+
+ColumnNames_t FindUsedColumns(std::string_view expression, RLoopManager &lm, RDataSource *ds,
+                              const RBookedCustomColumns &customColumns)
+{
+   const auto &aliasMap = lm.GetAliasMap();
+   auto usedColumns = FindUsedColumnNames(expression, lm.GetBranchNames(), customColumns.GetNames(),
+                                          ds ? ds->GetColumnNames() : ColumnNames_t{}, aliasMap);
+   for (auto &c : usedColumns) {
+      const auto aliasIt = aliasMap.find(c);
+      if (aliasIt != aliasMap.end())
+         c = aliasIt->second;
+   }
+   return usedColumns;
+}
+
 /// Given the desired number of columns and the user-provided list of columns:
 /// * fallback to using the first nColumns default columns if needed (or throw if nColumns > nDefaultColumns)
 /// * check that selected column names refer to valid branches, custom columns or datasource columns (throw if not)
@@ -830,6 +869,14 @@ ColumnNames_t GetValidatedColumnNames(RLoopManager &lm, const unsigned int nColu
    return selectedColumns;
 }
 
+std::string GetDiskCacheFileName(std::string_view cacheDir, const std::string &provenance)
+{
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(provenance.data()), provenance.size());
+   md5.Final();
+   return std::string(cacheDir) + "/" + md5.AsString() + ".rdfcache";
+}
+
 /// Return a bitset each element of which indicates whether the corresponding element in `selectedColumns` is the
 /// name of a column that must be defined via datasource. All elements of the returned vector are false if no
 /// data-source is present.
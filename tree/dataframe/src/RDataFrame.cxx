@@ -84,7 +84,7 @@ produce several different results in one event loop. Instant actions trigger the
 |------------------|-----------------|
 | [Aggregate](classROOT_1_1RDF_1_1RInterface.html#ae540b00addc441f9b504cbae0ef0a24d) | Execute a user-defined accumulation operation on the processed column values. |
 | [Book](classROOT_1_1RDF_1_1RInterface.html#a9b2f61f3333d1669e57055b9ae8be9d9) | Book execution of a custom action using a user-defined helper object. |
-| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). Columns of arithmetic types can also be cached in a persistent, memory-mapped file on disk, reused across runs until the inputs, the upstream expressions or the key given for compiled callables change. |
 | [Count](classROOT_1_1RDF_1_1RInterface.html#a37f9e00c2ece7f53fae50b740adc1456) | Return the number of events processed. |
 | [Display](classROOT_1_1RDF_1_1RInterface.html#aee68f4411f16f00a1d46eccb6d296f01) | Obtains the events in the dataset for the requested columns. The method returns a [RDisplay](classROOT_1_1RDF_1_1RDisplay.html) instance which can be queried to get a compressed tabular representation on the standard output or a complete representation as a string. |
 | [Fill](classROOT_1_1RDF_1_1RInterface.html#a0cac4d08297c23d16de81ff25545440a) | Fill a user-defined object with the values of the specified branches, as if by calling `Obj.Fill(branch1, branch2, ...). |
@@ -483,6 +483,16 @@ dataFrame.Min<MyNumber_t>("myObject"); // OK, "myObject" is deduced to be of typ
 Deducing types at runtime requires the just-in-time compilation of the relevant actions, which has a small runtime
 overhead, so specifying the type of the columns as template parameters to the action is good practice when performance is a goal.
 
+The code jitted before the event loop can also be compiled once and reused by later jobs that book the same computation
+graph, which then skip most of the jitting. To do so, point the `RDataFrame.JitCacheDir` entry of `.rootrc` (or the
+`ROOT_RDF_JITCACHE` environment variable) to a directory, possibly shared between jobs: the jitted code is compiled in a
+shared library stored there, named after a hash of the code and of the ROOT version. Since the jitted code mentions the
+names of columns and their types, a library is only reused by jobs that book exactly the same computation graph, e.g.
+the same analysis running on different input files with the same schema. Jitted code that uses functions or types only
+known to the interpreter cannot be compiled in a library: in that case it is jitted as usual. Note that, when the cache
+is enabled, the expressions of jitted Filters and Defines are not checked as they are booked: invalid expressions are
+reported when the event loop starts.
+
 ### Generic actions
 `RDataFrame` strives to offer a comprehensive set of standard actions that can be performed on each event. At the same
 time, it **allows users to execute arbitrary code (i.e. a generic action) inside the event loop** through the `Foreach`
@@ -623,6 +633,22 @@ ROOT::RDF::SaveGraph(rd1, "./mydot.dot");
 ROOT::RDF::SaveGraph(rd1);
 ~~~
 
+### <a name="batch-processing"></a>Processing entries in batches
+By default, each entry flows through the computation graph on its own: every filter and custom column is evaluated for
+one entry at a time. For graphs made of simple filters and definitions, the cost of moving each entry through the graph
+can dominate the cost of the computations themselves. Setting the `RDataFrame.BatchSize` entry of `.rootrc` (or the
+`ROOT_RDF_BATCHSIZE` environment variable) to a number of entries, e.g. 256, makes the event loop process blocks of that
+many entries at once: each column is read for the whole block, each filter produces a selection mask over the block,
+and custom columns are computed for the selected entries before moving on to the next node. As in the default mode,
+custom columns are only evaluated for entries that pass the filters upstream of them. Branches holding one value of a
+fundamental type per entry are decoded a basket at a time, with the values of a block read in place when they lie in a
+single basket; the other branches are read entry by entry.
+
+The results do not depend on the batch size, with one exception: when a `Range` stops the processing, filters upstream
+of it might have already been evaluated on the rest of the batch, which shows in their `Report`. Event loops over
+data-sources or `TTree`s with a `TEntryList`, as well as event loops that book a `Snapshot` or read columns of types that
+cannot be copied, always process one entry at a time.
+
 ### RDataFrame variables as function arguments and return values
 RDataFrame variables/nodes are relatively cheap to copy and it's possible to both pass them to (or move them into)
 functions and to return them from functions. However, in general each dataframe node will have a different C++ type,
@@ -755,6 +781,13 @@ processing of these batches. There are no guarantees on the order the batches ar
 order entries of the dataset are processed. Note that this in turn means that, for multi-thread event loops, there is no
 guarantee on the order in which `Snapshot` will _write_ entries: they could be scrambled with respect to the input dataset.
 
+In multi-thread event loops, each thread serializes and compresses the entries it writes with `Snapshot` on its own, and
+appends them to the output tree one whole cluster at a time: no thread is dedicated to merging the output of the others,
+and memory usage does not grow with the number of entries written. If the entries must be written in the order of the
+input dataset, set `RSnapshotOptions::fKeepEntryOrder`: the compressed output of each task is then appended to the
+output tree as soon as all the tasks that precede it in the dataset are done. Only the output of the tasks that finish
+ahead of a slower one is kept in memory while they wait. If no entry passes, no tree is written to the output file.
+
 \warning RDataFrame will by default start as many threads as the hardware supports, using up **all** the resources on
 a machine. On a worker node of *e.g.* a batch cluster, this might not be desired if the machine is shared with other
 users. Therefore, **when running on shared computing resources**, use
@@ -0,0 +1,476 @@
+// Author: agent <agent@local>  07/2020
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDiskCacheDS.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+#include "TError.h"
+#include "TSystem.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+// Layout of a cache file, all integers in the byte order of the machine that wrote it:
+// header:    magic, version, byte-order marker, number of columns, then name, type name and value size of each column
+// row group: for each column, the array of its values
+// index:     number of row groups, offset and number of entries of each row group
+// trailer:   offset of the index, magic
+// The header, the index and every array start at an offset multiple of kAlignment.
+const char kMagic[8] = {'R', 'D', 'F', 'C', 'A', 'C', 'H', 'E'};
+const std::uint32_t kByteOrderMarker = 0x01020304;
+const std::size_t kAlignment = 16;
+const std::size_t kTrailerSize = sizeof(std::uint64_t) + sizeof(kMagic);
+
+/// Number of writers created by this process, to give each of them its own temporary file
+std::atomic<unsigned int> gNWriters{0};
+
+std::size_t PaddedSize(std::size_t size)
+{
+   return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/// Read the content of a cache file, checking that it does not read past its end
+class RBufferReader {
+   const char *fBuffer;
+   const std::size_t fSize;
+   std::size_t fOffset;
+
+public:
+   RBufferReader(const char *buffer, std::size_t size, std::size_t offset = 0)
+      : fBuffer(buffer), fSize(size), fOffset(offset)
+   {
+   }
+
+   const char *ReadBytes(std::size_t size)
+   {
+      if (fOffset > fSize || size > fSize - fOffset)
+         throw std::runtime_error("truncated file");
+      const auto bytes = fBuffer + fOffset;
+      fOffset += size;
+      return bytes;
+   }
+
+   template <typename T>
+   T Read()
+   {
+      T value;
+      std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+      return value;
+   }
+
+   std::string ReadString()
+   {
+      const auto size = Read<std::uint32_t>();
+      return std::string(ReadBytes(size), size);
+   }
+};
+
+struct RDiskCacheLayout {
+   std::vector<std::string> fColumnNames;
+   std::vector<std::string> fTypeNames;
+   std::vector<std::size_t> fColumnSizes;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fRowGroups; ///< Offset and number of entries of each row group
+};
+
+/// Parse the header and the index of a cache file, throwing if they are invalid.
+RDiskCacheLayout ReadLayout(const char *buffer, std::size_t size)
+{
+   RDiskCacheLayout layout;
+   RBufferReader header(buffer, size);
+   if (std::memcmp(header.ReadBytes(sizeof(kMagic)), kMagic, sizeof(kMagic)) != 0)
+      throw std::runtime_error("not a cache file");
+   if (header.Read<std::uint32_t>() != ROOT::Internal::RDF::kDiskCacheVersion)
+      throw std::runtime_error("unsupported version of the cache format");
+   if (header.Read<std::uint32_t>() != kByteOrderMarker)
+      throw std::runtime_error("written on a machine with a different byte order");
+   const auto nColumns = header.Read<std::uint32_t>();
+   for (auto i = 0u; i < nColumns; ++i) {
+      layout.fColumnNames.emplace_back(header.ReadString());
+      layout.fTypeNames.emplace_back(header.ReadString());
+      layout.fColumnSizes.emplace_back(header.Read<std::uint64_t>());
+   }
+
+   if (size < kTrailerSize)
+      throw std::runtime_error("truncated file");
+   RBufferReader trailer(buffer, size, size - kTrailerSize);
+   const auto indexOffset = trailer.Read<std::uint64_t>();
+   if (std::memcmp(trailer.ReadBytes(sizeof(kMagic)), kMagic, sizeof(kMagic)) != 0)
+      throw std::runtime_error("incomplete file");
+
+   RBufferReader index(buffer, size - kTrailerSize, indexOffset);
+   const auto nRowGroups = index.Read<std::uint64_t>();
+   for (auto i = 0ull; i < nRowGroups; ++i) {
+      const auto offset = index.Read<std::uint64_t>();
+      const auto nEntries = index.Read<std::uint64_t>();
+      // check that the values of the row group are all within the file
+      RBufferReader rowGroup(buffer, indexOffset, offset);
+      for (auto columnSize : layout.fColumnSizes) {
+         if (columnSize != 0 && nEntries > (std::numeric_limits<std::size_t>::max() - kAlignment) / columnSize)
+            throw std::runtime_error("corrupted index");
+         rowGroup.ReadBytes(PaddedSize(nEntries * columnSize));
+      }
+      layout.fRowGroups.emplace_back(offset, nEntries);
+   }
+   return layout;
+}
+
+/// A read-only view of the content of a file, memory-mapped where possible.
+/// The mapping is private and writable: RDataFrame passes column values to user code as non-const references, and
+/// modifications must not reach the file.
+class RMappedFile {
+   char *fBuffer = nullptr;
+   std::size_t fSize = 0;
+#ifdef _WIN32
+   std::vector<char> fContent;
+#endif
+
+public:
+   explicit RMappedFile(const std::string &fileName)
+   {
+#ifdef _WIN32
+      std::ifstream f(fileName, std::ios::binary);
+      if (!f)
+         throw std::runtime_error("cannot open file");
+      fContent.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+      fBuffer = fContent.data();
+      fSize = fContent.size();
+#else
+      const auto fd = open(fileName.c_str(), O_RDONLY);
+      if (fd < 0)
+         throw std::runtime_error("cannot open file");
+      struct stat info;
+      if (fstat(fd, &info) != 0) {
+         close(fd);
+         throw std::runtime_error("cannot stat file");
+      }
+      fSize = info.st_size;
+      if (fSize > 0) {
+         auto address = mmap(nullptr, fSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+         if (address == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("cannot memory-map file");
+         }
+         fBuffer = static_cast<char *>(address);
+      }
+      close(fd); // the mapping stays valid
+#endif
+   }
+
+   RMappedFile(const RMappedFile &) = delete;
+   RMappedFile &operator=(const RMappedFile &) = delete;
+
+   ~RMappedFile()
+   {
+#ifndef _WIN32
+      if (fBuffer)
+         munmap(fBuffer, fSize);
+#endif
+   }
+
+   /// Hand the mapping over to the caller, who must release it with Unmap
+   std::pair<char *, std::size_t> Release()
+   {
+      auto mapping = std::make_pair(fBuffer, fSize);
+#ifndef _WIN32
+      fBuffer = nullptr;
+#endif
+      return mapping;
+   }
+
+   static void Unmap(char *buffer, std::size_t size)
+   {
+#ifdef _WIN32
+      (void)buffer;
+      (void)size;
+#else
+      if (buffer)
+         munmap(buffer, size);
+#endif
+   }
+
+#ifdef _WIN32
+   std::vector<char> &GetContent() { return fContent; }
+#endif
+   const char *GetBuffer() const { return fBuffer; }
+   std::size_t GetSize() const { return fSize; }
+};
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RDiskCacheWriter::RDiskCacheWriter(const std::string &fileName, const std::vector<std::string> &columnNames,
+                                   const std::vector<std::string> &typeNames,
+                                   const std::vector<std::size_t> &columnSizes)
+   : fFileName(fileName), fTmpFileName(fileName + "." + std::to_string(gSystem->GetPid()) + "_" +
+                                       std::to_string(gNWriters++) + ".tmp"),
+     fColumnSizes(columnSizes)
+{
+   R__ASSERT(columnNames.size() == typeNames.size() && columnNames.size() == columnSizes.size());
+   const TString dirName = gSystem->GetDirName(fFileName.c_str());
+   gSystem->mkdir(dirName, /*recursive=*/true);
+   fFile = std::fopen(fTmpFileName.c_str(), "wb");
+   if (!fFile)
+      throw std::runtime_error("Cache: cannot write the cache file \"" + fTmpFileName + "\".");
+
+   Write(kMagic, sizeof(kMagic));
+   const std::uint32_t version = kDiskCacheVersion;
+   Write(&version, sizeof(version));
+   Write(&kByteOrderMarker, sizeof(kByteOrderMarker));
+   const std::uint32_t nColumns = columnNames.size();
+   Write(&nColumns, sizeof(nColumns));
+   for (auto i = 0u; i < nColumns; ++i) {
+      for (const auto *str : {&columnNames[i], &typeNames[i]}) {
+         const std::uint32_t size = str->size();
+         Write(&size, sizeof(size));
+         Write(str->data(), size);
+      }
+      const std::uint64_t columnSize = columnSizes[i];
+      Write(&columnSize, sizeof(columnSize));
+   }
+   Pad();
+}
+
+RDiskCacheWriter::~RDiskCacheWriter()
+{
+   // the cache was not committed, e.g. because the event loop threw: leave no partial file behind
+   if (fFile) {
+      std::fclose(fFile);
+      gSystem->Unlink(fTmpFileName.c_str());
+   }
+}
+
+void RDiskCacheWriter::Write(const void *data, std::size_t size)
+{
+   if (size > 0 && std::fwrite(data, 1, size, fFile) != size)
+      throw std::runtime_error("Cache: error while writing the cache file \"" + fTmpFileName + "\".");
+   fOffset += size;
+}
+
+void RDiskCacheWriter::Pad()
+{
+   static const char zeros[kAlignment] = {};
+   Write(zeros, PaddedSize(fOffset) - fOffset);
+}
+
+void RDiskCacheWriter::WriteRowGroup(ULong64_t nEntries, const std::vector<const char *> &columns)
+{
+   R__ASSERT(columns.size() == fColumnSizes.size());
+   if (nEntries == 0)
+      return;
+   std::lock_guard<std::mutex> lock(fMutex);
+   fRowGroups.emplace_back(fOffset, nEntries);
+   for (auto i = 0u; i < columns.size(); ++i) {
+      Write(columns[i], nEntries * fColumnSizes[i]);
+      Pad();
+   }
+}
+
+void RDiskCacheWriter::Commit()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   const std::uint64_t indexOffset = fOffset;
+   const std::uint64_t nRowGroups = fRowGroups.size();
+   Write(&nRowGroups, sizeof(nRowGroups));
+   for (const auto &rowGroup : fRowGroups) {
+      const std::uint64_t offsetAndEntries[] = {rowGroup.first, rowGroup.second};
+      Write(offsetAndEntries, sizeof(offsetAndEntries));
+   }
+   Write(&indexOffset, sizeof(indexOffset));
+   Write(kMagic, sizeof(kMagic));
+
+   const auto closeStatus = std::fclose(fFile);
+   fFile = nullptr;
+   // the rename is atomic: concurrent readers either see no cache or a complete one
+   if (closeStatus != 0 || gSystem->Rename(fTmpFileName.c_str(), fFileName.c_str()) != 0) {
+      gSystem->Unlink(fTmpFileName.c_str());
+      throw std::runtime_error("Cache: cannot write the cache file \"" + fFileName + "\".");
+   }
+}
+
+bool IsValidDiskCache(const std::string &fileName, const std::vector<std::string> &columnNames,
+                      const std::vector<std::string> &typeNames)
+{
+   if (gSystem->AccessPathName(fileName.c_str())) // sic: true if the file does _not_ exist
+      return false;
+   try {
+      RMappedFile file(fileName);
+      const auto layout = ReadLayout(file.GetBuffer(), file.GetSize());
+      return layout.fColumnNames == columnNames && layout.fTypeNames == typeNames;
+   } catch (const std::runtime_error &e) {
+      Warning("Cache", "Ignoring the invalid cache file \"%s\": %s.", fileName.c_str(), e.what());
+      return false;
+   }
+}
+
+} // ns RDF
+} // ns Internal
+
+namespace RDF {
+
+RDiskCacheDS::RDiskCacheDS(std::string_view fileName, const std::vector<std::string> &columnNames,
+                           const std::vector<std::string> &typeNames, std::function<void()> producer)
+   : fFileName(fileName), fColumnNames(columnNames), fTypeNames(typeNames), fProducer(std::move(producer))
+{
+   R__ASSERT(fColumnNames.size() == fTypeNames.size());
+}
+
+RDiskCacheDS::~RDiskCacheDS()
+{
+   Close();
+}
+
+void RDiskCacheDS::Open()
+{
+   std::unique_ptr<RMappedFile> file;
+   RDiskCacheLayout layout;
+   try {
+      file.reset(new RMappedFile(fFileName));
+      layout = ReadLayout(file->GetBuffer(), file->GetSize());
+   } catch (const std::runtime_error &e) {
+      throw std::runtime_error("Cache: the cache file \"" + fFileName + "\" is invalid: " + e.what() + ".");
+   }
+   if (layout.fColumnNames != fColumnNames || layout.fTypeNames != fTypeNames)
+      throw std::runtime_error("Cache: the cache file \"" + fFileName + "\" does not hold the expected columns.");
+
+   fColumnSizes = layout.fColumnSizes;
+   fRowGroupFirstEntries.assign(1, 0ull);
+   fRowGroupColumnOffsets.clear();
+   for (const auto &rowGroup : layout.fRowGroups) {
+      std::vector<ULong64_t> columnOffsets;
+      auto offset = rowGroup.first;
+      for (auto columnSize : fColumnSizes) {
+         columnOffsets.emplace_back(offset);
+         offset += PaddedSize(rowGroup.second * columnSize);
+      }
+      fRowGroupColumnOffsets.emplace_back(std::move(columnOffsets));
+      fRowGroupFirstEntries.emplace_back(fRowGroupFirstEntries.back() + rowGroup.second);
+   }
+
+#ifdef _WIN32
+   fBufferFallback = std::move(file->GetContent());
+   fBuffer = fBufferFallback.data();
+   fBufferSize = fBufferFallback.size();
+#else
+   std::tie(fBuffer, fBufferSize) = file->Release();
+#endif
+}
+
+void RDiskCacheDS::Close()
+{
+#ifdef _WIN32
+   fBufferFallback.clear();
+#else
+   RMappedFile::Unmap(fBuffer, fBufferSize);
+#endif
+   fBuffer = nullptr;
+   fBufferSize = 0;
+}
+
+std::vector<void *> RDiskCacheDS::GetColumnReadersImpl(std::string_view name, const std::type_info &ti)
+{
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), name);
+   if (it == fColumnNames.end())
+      throw std::runtime_error("Cache: there is no cached column named \"" + std::string(name) + "\".");
+   const auto index = std::distance(fColumnNames.begin(), it);
+   const auto typeName = ROOT::Internal::RDF::TypeID2TypeName(ti);
+   if (typeName != fTypeNames[index])
+      throw std::runtime_error("Cache: the type of the cached column \"" + std::string(name) + "\" is " +
+                               fTypeNames[index] + ", but it was read as " + typeName + ".");
+
+   std::vector<void *> readers;
+   for (auto &addresses : fColumnAddresses)
+      readers.emplace_back(&addresses[index]);
+   return readers;
+}
+
+bool RDiskCacheDS::HasColumn(std::string_view colName) const
+{
+   return std::find(fColumnNames.begin(), fColumnNames.end(), colName) != fColumnNames.end();
+}
+
+std::string RDiskCacheDS::GetTypeName(std::string_view colName) const
+{
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+   if (it == fColumnNames.end())
+      throw std::runtime_error("Cache: there is no cached column named \"" + std::string(colName) + "\".");
+   return fTypeNames[std::distance(fColumnNames.begin(), it)];
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> RDiskCacheDS::GetEntryRanges()
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+   if (fRangesReturned)
+      return ranges;
+   for (auto i = 1u; i < fRowGroupFirstEntries.size(); ++i)
+      ranges.emplace_back(fRowGroupFirstEntries[i - 1], fRowGroupFirstEntries[i]);
+   fRangesReturned = true;
+   return ranges;
+}
+
+bool RDiskCacheDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   const auto rowGroupEnd = std::upper_bound(fRowGroupFirstEntries.begin(), fRowGroupFirstEntries.end(), entry);
+   const auto rowGroup = std::distance(fRowGroupFirstEntries.begin(), rowGroupEnd) - 1;
+   const auto entryInRowGroup = entry - fRowGroupFirstEntries[rowGroup];
+   const auto &columnOffsets = fRowGroupColumnOffsets[rowGroup];
+   auto &addresses = fColumnAddresses[slot];
+   for (auto i = 0u; i < addresses.size(); ++i)
+      addresses[i] = fBuffer + columnOffsets[i] + entryInRowGroup * fColumnSizes[i];
+   return true;
+}
+
+void RDiskCacheDS::SetNSlots(unsigned int nSlots)
+{
+   R__ASSERT(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+   fNSlots = nSlots;
+   fColumnAddresses.assign(fNSlots, std::vector<void *>(fColumnNames.size(), nullptr));
+}
+
+void RDiskCacheDS::Initialise()
+{
+   if (fProducer) {
+      // clear the producer first: it might run an event loop that involves this data source.
+      // It is restored if it fails, so that the next event loop tries again to write the cache file.
+      auto producer = std::move(fProducer);
+      fProducer = nullptr;
+      try {
+         producer();
+      } catch (...) {
+         fProducer = std::move(producer);
+         throw;
+      }
+   }
+   if (!fBuffer)
+      Open();
+   fRangesReturned = false;
+}
+
+} // ns RDF
+} // ns ROOT
@@ -16,8 +16,8 @@ using namespace ROOT::Detail::RDF;
 
 RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const unsigned int nSlots,
                          const RDFInternal::RBookedCustomColumns &customColumns)
-   : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fName(name), fNSlots(nSlots),
-     fCustomColumns(customColumns) {}
+   : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fBatchMasks(nSlots), fName(name),
+     fNSlots(nSlots), fCustomColumns(customColumns) {}
 
 // outlined to pin virtual table
 RFilterBase::~RFilterBase() {}
@@ -24,6 +24,18 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunBatch(slot, batch);
+}
+
+bool RJittedAction::SupportsBatch() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->SupportsBatch();
+}
+
 void RJittedAction::Initialize()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include <ROOT/RDF/RJittedCustomColumn.hxx>
+#include <ROOT/RDF/RLoopManager.hxx>
 #include <TError.h> // R__ASSERT
 
 using namespace ROOT::Detail::RDF;
@@ -37,12 +38,41 @@ void RJittedCustomColumn::Update(unsigned int slot, Long64_t entry)
    fConcreteCustomColumn->Update(slot, entry);
 }
 
+void RJittedCustomColumn::UpdateBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch,
+                                      const ROOT::Internal::RDF::RBatchMask_t &mask)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   fConcreteCustomColumn->UpdateBatch(slot, batch, mask);
+}
+
+void *RJittedCustomColumn::GetBatchValuePtr(unsigned int slot)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetBatchValuePtr(slot);
+}
+
+bool RJittedCustomColumn::SupportsBatch() const
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->SupportsBatch();
+}
+
 void RJittedCustomColumn::ClearValueReaders(unsigned int slot)
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
    fConcreteCustomColumn->ClearValueReaders(slot);
 }
 
+std::string RJittedCustomColumn::GetProvenance(const std::string &) const
+{
+   if (fConcreteCustomColumn == nullptr) {
+      // No event loop performed yet, but the JITTING must be performed.
+      fLoopManager->Jit();
+   }
+   // the type of the jitted lambda is not stable across processes, its expression is
+   return fConcreteCustomColumn->GetProvenance(fExpression);
+}
+
 void RJittedCustomColumn::InitNode()
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
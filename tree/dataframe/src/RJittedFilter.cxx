@@ -15,8 +15,8 @@
 
 using namespace ROOT::Detail::RDF;
 
-RJittedFilter::RJittedFilter(RLoopManager *lm, std::string_view name)
-   : RFilterBase(lm, name, lm->GetNSlots(), RDFInternal::RBookedCustomColumns()) { }
+RJittedFilter::RJittedFilter(RLoopManager *lm, std::string_view name, std::string_view expression)
+   : RFilterBase(lm, name, lm->GetNSlots(), RDFInternal::RBookedCustomColumns()), fExpression(expression) { }
 
 void RJittedFilter::SetFilter(std::unique_ptr<RFilterBase> f)
 {
@@ -35,6 +35,19 @@ bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+const ROOT::Internal::RDF::RBatchMask_t &
+RJittedFilter::CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBatch(slot, batch);
+}
+
+bool RJittedFilter::SupportsBatch() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->SupportsBatch();
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -110,6 +123,16 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+std::string RJittedFilter::GetProvenance(const std::string &)
+{
+   if (fConcreteFilter == nullptr) {
+      // No event loop performed yet, but the JITTING must be performed.
+      GetLoopManagerUnchecked()->Jit();
+   }
+   // the type of the jitted lambda is not stable across processes, its expression is
+   return fConcreteFilter->GetProvenance(fExpression);
+}
+
 std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
 {
    if (fConcreteFilter != nullptr) {
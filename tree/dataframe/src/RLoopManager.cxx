@@ -8,10 +8,16 @@
 #include "RtypesCore.h" // Long64_t
 #include "TBranchElement.h"
 #include "TBranchObject.h"
+#include "TChain.h"
 #include "TEntryList.h"
+#include "TEnv.h"
+#include "TError.h"
+#include "TFile.h"
 #include "TFriendElement.h"
 #include "TInterpreter.h"
+#include "TMD5.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TSystem.h"
 #include "TTreeReader.h"
 
 #ifdef R__USE_IMT
@@ -19,18 +25,144 @@
 #include "ROOT/TTreeProcessorMT.hxx"
 #endif
 
+#include <algorithm>
 #include <atomic>
+#include <cstdlib> // std::atoi
 #include <functional>
 #include <memory>
 #include <exception>
+#include <fstream>
+#include <map>
+#include <regex>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <iostream>
 
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+std::string PrettyPrintAddr(const void *const addr);
+}
+}
+}
+
 using namespace ROOT::Detail::RDF;
 using namespace ROOT::Internal::RDF;
 
+///////////////////////////////////////////////////////////////////////////////
+/// Return the directory in which the jitted calls are cached as compiled libraries, empty if caching is disabled.
+/// Set by the `RDataFrame.JitCacheDir` rootrc entry, which can be overridden by the environment variable
+/// ROOT_RDF_JITCACHE.
+static std::string GetJitCacheDir()
+{
+   const char *dir = gSystem->Getenv("ROOT_RDF_JITCACHE");
+   if (!dir || !*dir)
+      dir = gEnv->GetValue("RDataFrame.JitCacheDir", "");
+   return dir ? dir : "";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Return the number of entries that the nodes process at once in batch mode, zero if batch mode is disabled.
+/// Set by the `RDataFrame.BatchSize` rootrc entry, which can be overridden by the environment variable
+/// ROOT_RDF_BATCHSIZE.
+static unsigned int GetBatchSizeFromEnv()
+{
+   const char *size = gSystem->Getenv("ROOT_RDF_BATCHSIZE");
+   const int batchSize = (size && *size) ? std::atoi(size) : gEnv->GetValue("RDataFrame.BatchSize", 0);
+   return batchSize > 0 ? batchSize : 0u;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Identify a file by its name, size and modification time. Files that cannot be inspected, e.g. remote ones, are
+/// only identified by their name.
+static std::string GetFileProvenance(const std::string &fileName)
+{
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fileName.c_str(), stat) != 0)
+      return fileName;
+   return fileName + " (" + std::to_string(stat.fSize) + " bytes, modified " + std::to_string(stat.fMtime) + ")";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Identify the content of an entry list by the MD5 of its entries and of the trees they belong to.
+static std::string GetEntryListDigest(const TEntryList &entryList)
+{
+   TEntryList copy(entryList); // iterating over an entry list changes its state
+   TMD5 md5;
+   auto addEntries = [&md5](TEntryList &list) {
+      const std::string tree = std::string(list.GetTreeName()) + " in " + list.GetFileName() + "\n";
+      md5.Update(reinterpret_cast<const UChar_t *>(tree.data()), tree.size());
+      for (Long64_t entry = list.GetEntry(0); entry >= 0; entry = list.Next())
+         md5.Update(reinterpret_cast<const UChar_t *>(&entry), sizeof(entry));
+   };
+   if (auto lists = copy.GetLists()) {
+      for (auto list : *lists)
+         addEntries(*static_cast<TEntryList *>(list));
+   } else {
+      addEntries(copy);
+   }
+   md5.Final();
+   return md5.AsString();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Identify the entries of a tree or chain, including its friends and its entry list.
+static std::string GetTreeProvenance(TTree &tree)
+{
+   std::string provenance = std::string(tree.ClassName()) + "(" + tree.GetName();
+   if (auto chain = dynamic_cast<TChain *>(&tree)) {
+      for (auto element : *chain->GetListOfFiles())
+         provenance += ", " + std::string(element->GetName()) + " in " + GetFileProvenance(element->GetTitle());
+   } else if (auto file = tree.GetCurrentFile()) {
+      provenance += " in " + GetFileProvenance(file->GetName());
+   } else {
+      // an in-memory tree can only be identified by its size
+      provenance += " in memory, " + std::to_string(tree.GetEntries()) + " entries";
+   }
+   if (auto friends = tree.GetListOfFriends()) {
+      for (auto friendObj : *friends) {
+         auto friendElement = static_cast<TFriendElement *>(friendObj);
+         if (auto friendTree = friendElement->GetTree())
+            provenance += ", friend " + std::string(friendElement->GetName()) + ": " + GetTreeProvenance(*friendTree);
+      }
+   }
+   if (auto entryList = tree.GetEntryList())
+      provenance += ", entry list " + std::string(entryList->GetName()) + " of " + std::to_string(entryList->GetN()) +
+                    " entries, MD5 " + GetEntryListDigest(*entryList);
+   return provenance + ")";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Return the index, in the list of files of the input chain, of the file processed by a TTreeProcessorMT task.
+/// Tasks that read a chain of several files (e.g. because of friends or entry lists) use global entry numbers: zero
+/// is returned for them.
+static Long64_t GetTaskFileIndex(TTree &inputTree, TTreeReader &r)
+{
+   auto inputChain = dynamic_cast<TChain *>(&inputTree);
+   auto taskChain = dynamic_cast<TChain *>(r.GetTree());
+   if (!inputChain || !taskChain || taskChain->GetListOfFiles()->GetEntries() != 1)
+      return 0;
+   const std::string fileName = taskChain->GetListOfFiles()->At(0)->GetTitle();
+   const auto inputFiles = inputChain->GetListOfFiles();
+   for (Long64_t i = 0; i < inputFiles->GetEntries(); ++i) {
+      if (fileName == inputFiles->At(i)->GetTitle())
+         return i;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Return the position, in the format of RLoopManager::GetTaskPosition, that follows the last entry of a
+/// TTreeProcessorMT task: the beginning of the next file if the task reaches the end of the file it processes.
+static std::pair<Long64_t, Long64_t> GetTaskFileEnd(TTreeReader &r, Long64_t fileIndex, Long64_t end)
+{
+   auto taskChain = dynamic_cast<TChain *>(r.GetTree());
+   if (taskChain && taskChain->GetListOfFiles()->GetEntries() == 1 && end >= taskChain->GetEntries())
+      return {fileIndex + 1, 0ll};
+   return {fileIndex, end};
+}
+
 bool ContainsLeaf(const std::set<TLeaf *> &leaves, TLeaf *leaf)
 {
    return (leaves.find(leaf) != leaves.end());
@@ -252,10 +384,16 @@ void RLoopManager::RunEmptySourceMT()
    // Each task will generate a subrange of entries
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       auto slot = slotStack.GetSlot();
+      fTaskPositions[slot] = {0ll, static_cast<Long64_t>(range.first)};
+      fTaskEnds[slot] = {0ll, static_cast<Long64_t>(range.second)};
       InitNodeSlots(nullptr, slot);
       try {
-         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-            RunAndCheckFilters(slot, currEntry);
+         if (fBatchSize > 0) {
+            RunEmptySourceBatches(slot, range.first, range.second);
+         } else {
+            for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
+               RunAndCheckFilters(slot, currEntry);
+            }
          }
       } catch (...) {
          CleanUpTask(slot);
@@ -278,8 +416,12 @@ void RLoopManager::RunEmptySource()
 {
    InitNodeSlots(nullptr, 0);
    try {
-      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
-         RunAndCheckFilters(0, currEntry);
+      if (fBatchSize > 0) {
+         RunEmptySourceBatches(0u, 0ull, fNEmptyEntries);
+      } else {
+         for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
+            RunAndCheckFilters(0, currEntry);
+         }
       }
    } catch (...) {
       CleanUpTask(0u);
@@ -302,14 +444,21 @@ void RLoopManager::RunTreeProcessorMT()
 
    tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
       auto slot = slotStack.GetSlot();
-      InitNodeSlots(&r, slot);
       const auto entryRange = r.GetEntriesRange(); // we trust TTreeProcessorMT to call SetEntriesRange
+      const auto fileIndex = GetTaskFileIndex(*fTree, r);
+      fTaskPositions[slot] = {fileIndex, entryRange.first};
+      fTaskEnds[slot] = GetTaskFileEnd(r, fileIndex, entryRange.second);
+      InitNodeSlots(&r, slot);
       const auto nEntries = entryRange.second - entryRange.first;
       auto count = entryCount.fetch_add(nEntries);
       try {
-         // recursive call to check filters and conditionally execute actions
-         while (r.Next()) {
-            RunAndCheckFilters(slot, count++);
+         if (fBatchSize > 0) {
+            RunTreeReaderBatches(r, slot, count);
+         } else {
+            // recursive call to check filters and conditionally execute actions
+            while (r.Next()) {
+               RunAndCheckFilters(slot, count++);
+            }
          }
       } catch (...) {
          CleanUpTask(slot);
@@ -334,8 +483,12 @@ void RLoopManager::RunTreeReader()
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
    try {
-      while (r.Next() && fNStopsReceived < fNChildren) {
-         RunAndCheckFilters(0, r.GetCurrentEntry());
+      if (fBatchSize > 0) {
+         RunTreeReaderBatches(r, 0u, 0ll);
+      } else {
+         while (r.Next() && fNStopsReceived < fNChildren) {
+            RunAndCheckFilters(0, r.GetCurrentEntry());
+         }
       }
    } catch (...) {
       CleanUpTask(0u);
@@ -391,6 +544,8 @@ void RLoopManager::RunDataSourceMT()
    // Each task works on a subrange of entries
    auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       const auto slot = slotStack.GetSlot();
+      fTaskPositions[slot] = {0ll, static_cast<Long64_t>(range.first)};
+      fTaskEnds[slot] = {0ll, static_cast<Long64_t>(range.second)};
       InitNodeSlots(nullptr, slot);
       fDataSource->InitSlot(slot, range.first);
       const auto end = range.second;
@@ -432,6 +587,69 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Batch-mode counterpart of RunAndCheckFilters: run all actions and named filters on a batch of entries.
+void RLoopManager::RunBatchAndCheckFilters(unsigned int slot, const RBatch &batch)
+{
+   for (auto &actionPtr : fBookedActions)
+      actionPtr->RunBatch(slot, batch);
+   for (auto &namedFilterPtr : fBookedNamedFilters)
+      namedFilterPtr->CheckFiltersBatch(slot, batch);
+   for (auto i = 0u; i < batch.fSize; ++i) {
+      for (auto &callback : fCallbacks)
+         callback(slot);
+   }
+}
+
+/// Process entries [begin, end) of an empty source in batches of fBatchSize entries.
+void RLoopManager::RunEmptySourceBatches(unsigned int slot, ULong64_t begin, ULong64_t end)
+{
+   // processing can be stopped early by ranges, hence the check on fNStopsReceived
+   for (auto first = begin; first < end && fNStopsReceived < fNChildren; first += fBatchSize) {
+      const auto size = static_cast<unsigned int>(std::min<ULong64_t>(fBatchSize, end - first));
+      RunBatchAndCheckFilters(slot, RBatch{static_cast<Long64_t>(first), -1ll, -1ll, size});
+   }
+}
+
+/// Process the entries of the range of the TTreeReader in batches of at most fBatchSize entries.
+/// `firstEntry` is the entry number (as returned by `rdfentry_`) of the first entry of the range.
+void RLoopManager::RunTreeReaderBatches(TTreeReader &r, unsigned int slot, Long64_t firstEntry)
+{
+   const auto range = r.GetEntriesRange();
+   auto readerEntry = range.first;
+   auto entry = firstEntry;
+   // processing can be stopped early by ranges, hence the check on fNStopsReceived
+   while ((range.second < 0 || readerEntry < range.second) && fNStopsReceived < fNChildren) {
+      if (r.SetEntry(readerEntry) != TTreeReader::kEntryValid)
+         return;
+      // Batches do not cross tree boundaries: columns are read one at a time over the whole batch, which would
+      // otherwise switch back and forth between the trees of a chain.
+      const auto tree = r.GetTree()->GetTree();
+      auto size = std::min<Long64_t>(fBatchSize, tree->GetEntries() - tree->GetReadEntry());
+      if (range.second >= 0)
+         size = std::min(size, range.second - readerEntry);
+      RunBatchAndCheckFilters(slot, RBatch{entry, readerEntry, tree->GetReadEntry(), static_cast<unsigned int>(size)});
+      readerEntry += size;
+      entry += size;
+   }
+}
+
+/// Batch mode is used only if all nodes support it. Data sources and TEntryLists are always processed entry by entry.
+bool RLoopManager::CanRunBatches() const
+{
+   if (fDataSource || (fTree && fTree->GetEntryList()))
+      return false;
+   for (auto actionPtr : fBookedActions)
+      if (!actionPtr->SupportsBatch())
+         return false;
+   for (auto filterPtr : fBookedFilters)
+      if (!filterPtr->SupportsBatch())
+         return false;
+   for (auto columnPtr : fCustomColumns)
+      if (!columnPtr->SupportsBatch())
+         return false;
+   return true;
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitRDFValues` methods. It is called once per node per slot, before
@@ -505,19 +723,175 @@ void RLoopManager::JitDeclarations()
       return;
 
    RDFInternal::InterpreterDeclare(fToJitDeclare);
+   fJitDeclared.append(fToJitDeclare);
    fToJitDeclare.clear();
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
-/// This method also invokes JitDeclarations() if needed, and clears the `fToJitExec` member variable.
+/// This method also invokes JitDeclarations() if needed, and clears the `fToJitExec` and `fToJitCalls` member
+/// variables.
+///
+/// If a jit cache directory is configured (see GetJitCacheDir), the jitted calls are compiled into a shared library
+/// stored in that directory, named after a hash of its source, which is just loaded by later jobs that book the same
+/// computation graph. The declarations are compiled in the library as well: when it can be used, they are left
+/// pending and only jitted if some other code needs them later. If the library cannot be built, e.g. because the
+/// jitted code uses entities only known to the interpreter, the calls are jitted as usual.
 void RLoopManager::Jit()
 {
-   if (fToJitExec.empty())
+   if (fToJitExec.empty() && fToJitCalls.empty())
+      return;
+
+   if (!fToJitExec.empty()) {
+      JitDeclarations();
+      RDFInternal::InterpreterCalc(fToJitExec, "RLoopManager::Run");
+      fToJitExec.clear();
+   }
+   if (fToJitCalls.empty())
       return;
 
-   JitDeclarations();
-   RDFInternal::InterpreterCalc(fToJitExec, "RLoopManager::Run");
-   fToJitExec.clear();
+   const auto cacheDir = GetJitCacheDir();
+   if (cacheDir.empty() || !RunCachedJitCalls(cacheDir)) {
+      JitDeclarations();
+      std::string toJit;
+      for (const auto &call : fToJitCalls) {
+         toJit += "{";
+         if (!call.fArgs.empty()) {
+            toJit += "void *__rdf_args[] = {";
+            for (const auto arg : call.fArgs)
+               toJit += "reinterpret_cast<void*>(" + RDFInternal::PrettyPrintAddr(arg) + "),";
+            toJit += "};";
+         }
+         toJit += call.fCode + "}\n";
+      }
+      RDFInternal::InterpreterCalc(toJit, "RLoopManager::Run");
+   }
+   fToJitCalls.clear();
+}
+
+/// Whether the jitted calls are compiled in shared libraries (see Jit). In that case the expressions of jitted
+/// filters and custom columns are not checked by the interpreter when they are booked: errors are only reported when
+/// the event loop starts.
+bool RLoopManager::IsJitCacheEnabled() const
+{
+   return !GetJitCacheDir().empty();
+}
+
+/// Replace the identifiers that depend on the order in which computation graphs and custom columns were created in
+/// this process, i.e. the `__rdfN` namespaces and the `eval_colN` and `colN_type` names, with names that only depend
+/// on their order of appearance in `code`. The same computation graph then always produces the same code.
+/// The `colN_type` and `eval_colN` names are only matched where RDataFrame declares them (`using colN_type =`,
+/// `auto eval_colN =`, `decltype(eval_colN )`) or qualified with their namespace (`__rdfN::colN_type`), so that
+/// identifiers in user expressions are left untouched, as are string literals, e.g. column names.
+static std::string CanonicalizeJitIDs(const std::string &code)
+{
+   static const std::regex idRegex("\"(?:[^\"\\\\]|\\\\.)*\""
+                                   "|\\b(__rdf\\d+)::(\\w+?\\d+_type)\\b"
+                                   "|\\busing (\\w+?\\d+_type) ="
+                                   "|\\bauto (eval_\\w+?\\d+) ="
+                                   "|\\bdecltype\\((eval_\\w+?\\d+) \\)"
+                                   "|\\b(__rdf\\d+)\\b");
+   std::map<std::string, std::string> names;
+   std::string canonical;
+   auto last = code.cbegin();
+   for (std::sregex_iterator it(code.cbegin(), code.cend(), idRegex), end; it != end; ++it) {
+      for (auto i = 1u; i < it->size(); ++i) {
+         const auto &match = (*it)[i];
+         if (!match.matched)
+            continue;
+         auto name = names.emplace(match.str(), "__rdfjit" + std::to_string(names.size())).first;
+         canonical.append(last, match.first).append(name->second);
+         last = match.second;
+      }
+   }
+   canonical.append(last, code.cend());
+   return canonical;
+}
+
+/// Execute `fToJitCalls` through a shared library in `cacheDir`, compiling it if it does not exist yet.
+/// Each call becomes a function taking `__rdf_args` as argument; the declarations jitted or pending so far are
+/// compiled in the library as well, in an anonymous namespace. Return false, without executing any call, if the
+/// library could not be built or loaded.
+///
+/// The library is built in a directory private to this process and then renamed to its final name, so that jobs
+/// sharing the cache directory never load a library that is still being written. Compilation failures are recorded
+/// per host, as they might be due to the local environment rather than to the code.
+bool RLoopManager::RunCachedJitCalls(const std::string &cacheDir)
+{
+   std::string code = "namespace {\n" + fJitDeclared + fToJitDeclare + "\n}\n";
+   for (auto i = 0u; i < fToJitCalls.size(); ++i)
+      code += "extern \"C\" void @RDFJIT@_" + std::to_string(i) + "(void **__rdf_args) {" + fToJitCalls[i].fCode + "}\n";
+   code = CanonicalizeJitIDs(code);
+
+   // The library depends on the ROOT version (e.g. on the layout of the RDF nodes) as well as on the code itself
+   TMD5 md5;
+   const std::string version = std::string(gROOT->GetVersion()) + gROOT->GetGitCommit();
+   md5.Update(reinterpret_cast<const UChar_t *>(version.data()), version.size());
+   md5.Update(reinterpret_cast<const UChar_t *>(code.data()), code.size());
+   md5.Final();
+   const std::string libName = std::string("rdfjit_") + md5.AsString();
+   const std::string basePath = cacheDir + "/" + libName;
+   const std::string libPath = basePath + "." + gSystem->GetSoExt();
+   const std::string failedPath = basePath + "." + gSystem->HostName() + ".failed";
+
+   // AccessPathName returns true if the file does *not* exist
+   if (gSystem->AccessPathName(libPath.c_str())) {
+      if (!gSystem->AccessPathName(failedPath.c_str()))
+         return false; // we already tried and failed on this host, do not waste time recompiling
+      const std::string buildDir =
+         cacheDir + "/.build_" + gSystem->HostName() + "_" + std::to_string(gSystem->GetPid()) + "_" + libName;
+      gSystem->mkdir(buildDir.c_str(), /*recursive=*/true);
+      const std::string srcPath = buildDir + "/" + libName + ".cxx";
+      {
+         std::ofstream src(srcPath);
+         src << "// RDataFrame jitted code compiled ahead of time by ROOT " << version << "\n"
+             << "#include \"ROOT/RDataFrame.hxx\"\n#include \"TMath.h\"\n#ifndef __CLING__\n"
+             << std::regex_replace(code, std::regex("@RDFJIT@"), libName) << "#endif\n";
+      }
+      const bool compiled = gSystem->CompileMacro(srcPath.c_str(), "kOcs", (buildDir + "/" + libName).c_str());
+
+      // Move the products of the build to the cache directory, the library last: once it exists, the rest does too
+      std::vector<std::string> products;
+      if (auto dir = gSystem->OpenDirectory(buildDir.c_str())) {
+         while (const char *entry = gSystem->GetDirEntry(dir)) {
+            const std::string name(entry);
+            if (name != "." && name != "..")
+               products.emplace_back(name);
+         }
+         gSystem->FreeDirectory(dir);
+      }
+      const auto libFileName = libName + "." + gSystem->GetSoExt();
+      std::stable_partition(products.begin(), products.end(),
+                            [&libFileName](const std::string &f) { return f != libFileName; });
+      for (const auto &f : products) {
+         const auto from = buildDir + "/" + f;
+         if (!compiled || gSystem->Rename(from.c_str(), (cacheDir + "/" + f).c_str()) != 0)
+            gSystem->Unlink(from.c_str());
+      }
+      gSystem->Unlink(buildDir.c_str());
+
+      if (!compiled) {
+         Warning("RLoopManager::Jit", "Could not compile the jitted code of %s, it will be jitted instead.",
+                 libName.c_str());
+         std::ofstream failed(failedPath);
+         return false;
+      }
+   }
+
+   if (gSystem->Load(libPath.c_str()) < 0)
+      return false;
+   using JitCall_t = void (*)(void **);
+   std::vector<JitCall_t> calls;
+   for (auto i = 0u; i < fToJitCalls.size(); ++i) {
+      const auto symbol = libName + '_' + std::to_string(i);
+      auto call = reinterpret_cast<JitCall_t>(gSystem->DynFindSymbol(libPath.c_str(), symbol.c_str()));
+      if (!call)
+         return false;
+      calls.emplace_back(call);
+   }
+
+   for (auto i = 0u; i < calls.size(); ++i)
+      calls[i](fToJitCalls[i].fArgs.data());
+   return true;
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -541,6 +915,17 @@ unsigned int RLoopManager::GetNextID()
    return id;
 }
 
+/// Identify the input dataset: the names, sizes and modification times of the input files and the content of the
+/// entry list, the number of entries of an empty source or the label of a data source.
+std::string RLoopManager::GetProvenance(const std::string &)
+{
+   if (fTree)
+      return GetTreeProvenance(*fTree);
+   if (fDataSource)
+      return "RDataSource(" + fDataSource->GetLabel() + ")";
+   return "Empty(" + std::to_string(fNEmptyEntries) + ")";
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 void RLoopManager::Run()
@@ -549,6 +934,11 @@ void RLoopManager::Run()
 
    InitNodes();
 
+   fBatchSize = CanRunBatches() ? GetBatchSizeFromEnv() : 0u;
+   fBatchMasks.resize(fNSlots);
+   fTaskPositions.resize(fNSlots);
+   fTaskEnds.resize(fNSlots);
+
    switch (fLoopType) {
    case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
    case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
@@ -616,6 +1006,15 @@ bool RLoopManager::CheckFilters(unsigned int, Long64_t)
    return true;
 }
 
+/// All entries of a batch are selected at the head of the computation graph.
+const RBatchMask_t &RLoopManager::CheckFiltersBatch(unsigned int slot, const RBatch &batch)
+{
+   auto &mask = fBatchMasks[slot];
+   if (mask.size() != batch.fSize)
+      mask.assign(batch.fSize, 1);
+   return mask;
+}
+
 /// Call `FillReport` on all booked filters
 void RLoopManager::Report(ROOT::RDF::RCutFlowReport &rep) const
 {
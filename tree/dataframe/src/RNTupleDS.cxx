@@ -19,6 +19,7 @@
 
 #include <TError.h>
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -71,6 +72,24 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
    if (fHasSeenAllRanges) return ranges;
 
+   if (!fValueRangeCuts.empty()) {
+      // One range per cluster that may contain entries passing all the cuts
+      const auto &desc = fReaders[0]->GetDescriptor();
+      const auto &firstCut = fValueRangeCuts[0];
+      for (auto clusterId : desc.FindClusterIdsInValueRange(firstCut.fColumnId, firstCut.fMin, firstCut.fMax)) {
+         const auto &clusterDesc = desc.GetClusterDescriptor(clusterId);
+         bool mayPass = true;
+         for (const auto &cut : fValueRangeCuts)
+            mayPass = mayPass && clusterDesc.GetColumnRange(cut.fColumnId).MayContainValues(cut.fMin, cut.fMax);
+         if (!mayPass)
+            continue;
+         const ULong64_t start = clusterDesc.GetFirstEntryIndex();
+         ranges.emplace_back(start, start + clusterDesc.GetNEntries());
+      }
+      fHasSeenAllRanges = true;
+      return ranges;
+   }
+
    auto nEntries = fReaders[0]->GetNEntries();
    const auto chunkSize = nEntries / fNSlots;
    const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
@@ -109,6 +128,19 @@ void RNTupleDS::Initialise()
 }
 
 
+void RNTupleDS::SkipClustersOutside(std::string_view fieldName, double min, double max)
+{
+   const auto &desc = fReaders[0]->GetDescriptor();
+   auto fieldId = desc.FindFieldId(fieldName);
+   if (fieldId == kInvalidDescriptorId)
+      throw std::runtime_error("RNTupleDS: no such field: " + std::string(fieldName));
+   auto columnId = desc.FindColumnId(fieldId, 0);
+   if (columnId == kInvalidDescriptorId)
+      throw std::runtime_error("RNTupleDS: field without values: " + std::string(fieldName));
+   fValueRangeCuts.push_back(RValueRangeCut{columnId, min, max});
+}
+
+
 void RNTupleDS::SetNSlots(unsigned int nSlots)
 {
    R__ASSERT(fNSlots == 0);
@@ -137,5 +169,15 @@ RDataFrame MakeNTupleDataFrame(std::string_view ntupleName, std::string_view fil
    return rdf;
 }
 
+RDataFrame MakeNTupleDataFrame(std::string_view ntupleName, std::string_view fileName,
+                               const std::map<std::string, std::pair<double, double>> &skipClustersOutside)
+{
+   auto ds = std::make_unique<RNTupleDS>(RNTupleReader::Open(ntupleName, fileName));
+   for (const auto &range : skipClustersOutside)
+      ds->SkipClustersOutside(range.first, range.second.first, range.second.second);
+   ROOT::RDataFrame rdf(std::move(ds));
+   return rdf;
+}
+
 } // ns Experimental
 } // ns ROOT
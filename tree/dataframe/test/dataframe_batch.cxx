@@ -0,0 +1,188 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+#include "TChain.h"
+#include "TEnv.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using ROOT::RDataFrame;
+using ROOT::VecOps::RVec;
+
+namespace {
+
+/// Set the batch size of the event loops run while this object is alive
+class TBatchSizeRAII {
+public:
+   TBatchSizeRAII(int size) { gEnv->SetValue("RDataFrame.BatchSize", size); }
+   ~TBatchSizeRAII() { gEnv->SetValue("RDataFrame.BatchSize", 0); }
+};
+
+struct RResults {
+   double fSum;
+   ULong64_t fCount;
+   std::vector<ULong64_t> fEntries;
+   std::vector<RVec<float>> fArrays;
+   std::vector<std::string> fReport;
+};
+
+void WriteFile(const char *fileName, int nEntries, int first, int basketEntries = 0)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   if (basketEntries > 0)
+      t.SetAutoFlush(basketEntries);
+   int x;
+   std::vector<float> v;
+   t.Branch("x", &x);
+   t.Branch("v", &v);
+   for (x = first; x < first + nEntries; ++x) {
+      v.assign(x % 4, x * 0.5f);
+      t.Fill();
+   }
+   t.Write();
+}
+
+RResults RunEmptySourceGraph()
+{
+   RDataFrame df(100);
+   auto x = df.Define("x", [](ULong64_t e) { return e * 0.5; }, {"rdfentry_"}).Filter([](double x) { return x > 3.; },
+                                                                                        {"x"}, "x > 3");
+   auto v = x.Define("v", [](ULong64_t e) { return RVec<float>(e % 5, e); }, {"rdfentry_"})
+               .Filter([](const RVec<float> &v) { return v.size() > 1; }, {"v"}, "size > 1");
+   auto sum = v.Sum<double>("x");
+   auto count = v.Count();
+   auto entries = v.Range(2, 40, 3).Take<ULong64_t>("rdfentry_");
+   auto arrays = v.Take<RVec<float>>("v");
+   RResults res{*sum, *count, *entries, *arrays, {}};
+   for (auto &&cut : df.Report())
+      res.fReport.emplace_back(cut.GetName() + std::to_string(cut.GetPass()) + "/" + std::to_string(cut.GetAll()));
+   return res;
+}
+
+RResults RunTreeGraph(TTree &t)
+{
+   RDataFrame df(t);
+   auto selected = df.Filter("x % 3 != 0").Define("s", "Sum(v)");
+   auto sum = selected.Sum<float>("s");
+   auto count = selected.Count();
+   auto entries = selected.Take<ULong64_t>("rdfentry_");
+   auto arrays = selected.Take<RVec<float>>("v");
+   return RResults{*sum, *count, *entries, *arrays, {}};
+}
+
+void ExpectEqualResults(const RResults &expected, const RResults &actual)
+{
+   EXPECT_DOUBLE_EQ(expected.fSum, actual.fSum);
+   EXPECT_EQ(expected.fCount, actual.fCount);
+   EXPECT_EQ(expected.fEntries, actual.fEntries);
+   ASSERT_EQ(expected.fArrays.size(), actual.fArrays.size());
+   for (auto i = 0u; i < expected.fArrays.size(); ++i)
+      EXPECT_TRUE(All(expected.fArrays[i] == actual.fArrays[i]));
+   EXPECT_EQ(expected.fReport, actual.fReport);
+}
+
+} // anonymous namespace
+
+TEST(RDFBatch, FiltersAndDefinesRunOnWholeBatches)
+{
+   TBatchSizeRAII batchSize(7);
+   std::vector<std::string> calls;
+   RDataFrame df(10);
+   auto even = df.Filter(
+      [&calls](ULong64_t e) {
+         calls.emplace_back("f" + std::to_string(e));
+         return e % 2 == 0;
+      },
+      {"rdfentry_"});
+   auto x = even.Define("x",
+                        [&calls](ULong64_t e) {
+                           calls.emplace_back("d" + std::to_string(e));
+                           return double(e);
+                        },
+                        {"rdfentry_"});
+   EXPECT_DOUBLE_EQ(20., *x.Sum<double>("x"));
+
+   // the filter is evaluated on a whole batch before the define, which is only evaluated for the selected entries
+   const std::vector<std::string> expected{"f0", "f1", "f2", "f3", "f4", "f5", "f6", "d0", "d2",
+                                           "d4", "d6", "f7", "f8", "f9", "d8"};
+   EXPECT_EQ(expected, calls);
+}
+
+TEST(RDFBatch, EmptySource)
+{
+   const auto expected = RunEmptySourceGraph();
+   TBatchSizeRAII batchSize(7);
+   ExpectEqualResults(expected, RunEmptySourceGraph());
+}
+
+TEST(RDFBatch, Chain)
+{
+   // batches of 7 entries do not divide the number of entries of the first tree: they must not cross tree boundaries
+   WriteFile("dataframe_batch_0.root", 25, 0);
+   WriteFile("dataframe_batch_1.root", 30, 25);
+   TChain c("t");
+   c.Add("dataframe_batch_0.root");
+   c.Add("dataframe_batch_1.root");
+
+   const auto expected = RunTreeGraph(c);
+   EXPECT_EQ(36ull, expected.fCount);
+   {
+      TBatchSizeRAII batchSize(7);
+      ExpectEqualResults(expected, RunTreeGraph(c));
+      // Snapshot is not supported in batch mode: the event loop falls back to processing one entry at a time
+      auto out = RDataFrame(c).Filter("x > 50").Snapshot<int>("t", "dataframe_batch_out.root", {"x"});
+      EXPECT_EQ(54, *out->Max<int>("x"));
+      EXPECT_EQ(4ull, *out->Count());
+   }
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   {
+      TBatchSizeRAII batchSize(7);
+      const auto mt = RunTreeGraph(c);
+      EXPECT_DOUBLE_EQ(expected.fSum, mt.fSum);
+      EXPECT_EQ(expected.fCount, mt.fCount);
+   }
+   ROOT::DisableImplicitMT();
+#endif
+
+   gSystem->Unlink("dataframe_batch_0.root");
+   gSystem->Unlink("dataframe_batch_1.root");
+   gSystem->Unlink("dataframe_batch_out.root");
+}
+
+TEST(RDFBatch, BasketBoundaries)
+{
+   // baskets of 5 entries: batches of 7 entries span several baskets of the branches read in bulk
+   WriteFile("dataframe_batch_baskets.root", 60, 0, 5);
+   {
+      TFile f("dataframe_batch_baskets.root");
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      auto runGraph = [t] {
+         RDataFrame df(*t);
+         auto selected = df.Filter([](int x) { return x % 5 < 3; }, {"x"});
+         auto xs = selected.Take<int>("x");
+         auto vs = selected.Take<RVec<float>>("v");
+         return std::make_pair(*xs, *vs);
+      };
+
+      const auto expected = runGraph();
+      EXPECT_EQ(36u, expected.first.size());
+      TBatchSizeRAII batchSize(7);
+      const auto batched = runGraph();
+      EXPECT_EQ(expected.first, batched.first);
+      ASSERT_EQ(expected.second.size(), batched.second.size());
+      for (auto i = 0u; i < expected.second.size(); ++i)
+         EXPECT_TRUE(All(expected.second[i] == batched.second[i]));
+   }
+   gSystem->Unlink("dataframe_batch_baskets.root");
+}
@@ -0,0 +1,247 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RTrivialDS.hxx"
+#include "TEntryList.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ROOT::RDataFrame;
+
+namespace {
+
+const char *kCacheDir = "dataframe_diskcache_dir";
+const char *kInputFile = "dataframe_diskcache.root";
+
+void WriteFile(const char *fileName, int nEntries)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   int x;
+   t.Branch("x", &x);
+   for (x = 0; x < nEntries; ++x)
+      t.Fill();
+   t.Write();
+}
+
+std::vector<std::string> ListCacheFiles()
+{
+   std::vector<std::string> files;
+   auto dir = gSystem->OpenDirectory(kCacheDir);
+   if (!dir)
+      return files;
+   while (auto entry = gSystem->GetDirEntry(dir)) {
+      const std::string name(entry);
+      if (name.size() > 9 && name.substr(name.size() - 9) == ".rdfcache")
+         files.emplace_back(std::string(kCacheDir) + "/" + name);
+   }
+   gSystem->FreeDirectory(dir);
+   std::sort(files.begin(), files.end());
+   return files;
+}
+
+void RemoveCacheDir()
+{
+   for (const auto &f : ListCacheFiles())
+      gSystem->Unlink(f.c_str());
+   gSystem->Unlink(kCacheDir);
+}
+
+/// Remove the input file and the cache directory at the beginning and at the end of a test
+class RDFDiskCache : public ::testing::Test {
+protected:
+   void SetUp() override { RemoveCacheDir(); }
+   void TearDown() override
+   {
+      RemoveCacheDir();
+      gSystem->Unlink(kInputFile);
+   }
+};
+
+} // anonymous namespace
+
+TEST_F(RDFDiskCache, MissThenHit)
+{
+   WriteFile(kInputFile, 100);
+   {
+      RDataFrame df("t", kInputFile);
+      auto cached = df.Filter("x % 2 == 0").Define("y", "x * 0.5").Cache<int, double>({"x", "y"}, kCacheDir);
+      EXPECT_EQ(0u, df.GetNRuns()); // writing the cache is lazy
+      EXPECT_EQ(50ull, *cached.Count());
+      EXPECT_DOUBLE_EQ(1225., *cached.Sum<double>("y"));
+      EXPECT_EQ(98, *cached.Max<int>("x"));
+      EXPECT_EQ(1u, df.GetNRuns());
+   }
+   ASSERT_EQ(1u, ListCacheFiles().size());
+
+   // the same analysis in a new computation graph reads the cache without running the original event loop
+   RDataFrame df("t", kInputFile);
+   auto cached = df.Filter("x % 2 == 0").Define("y", "x * 0.5").Cache<int, double>({"x", "y"}, kCacheDir);
+   EXPECT_EQ(50ull, *cached.Count());
+   EXPECT_DOUBLE_EQ(1225., *cached.Sum<double>("y"));
+   EXPECT_EQ(0u, df.GetNRuns());
+
+   // columns can be read with jitted expressions, as for any other dataset
+   EXPECT_EQ(25ull, *cached.Filter("y < 25").Count());
+   EXPECT_THROW(cached.Sum<float>("y"), std::runtime_error);
+}
+
+TEST_F(RDFDiskCache, Jitted)
+{
+   WriteFile(kInputFile, 100);
+   RDataFrame df("t", kInputFile);
+   auto typed = df.Define("y", "x * 0.5").Cache<int, double>({"x", "y"}, kCacheDir);
+   EXPECT_DOUBLE_EQ(2475., *typed.Sum<double>("y"));
+
+   // the jitted overload infers the same types: it reads the cache written by the typed one
+   RDataFrame df2("t", kInputFile);
+   auto jitted = df2.Define("y", "x * 0.5").Cache({"x", "y"}, kCacheDir);
+   EXPECT_DOUBLE_EQ(2475., *jitted.Sum<double>("y"));
+   EXPECT_EQ(0u, df2.GetNRuns());
+   EXPECT_EQ(1u, ListCacheFiles().size());
+}
+
+TEST_F(RDFDiskCache, Invalidation)
+{
+   WriteFile(kInputFile, 100);
+   auto runAnalysis = [](const char *expression, unsigned int expectedNRuns) {
+      RDataFrame df("t", kInputFile);
+      auto cached = df.Define("y", expression).Filter("y > 10").Cache<double>({"y"}, kCacheDir);
+      const auto sum = *cached.Sum<double>("y");
+      EXPECT_EQ(expectedNRuns, df.GetNRuns());
+      return sum;
+   };
+
+   EXPECT_DOUBLE_EQ(2370., runAnalysis("x * 0.5", 1u));
+   EXPECT_DOUBLE_EQ(2370., runAnalysis("x * 0.5", 0u));
+
+   // a different expression upstream of the cached column is a different cache
+   EXPECT_DOUBLE_EQ(4895., runAnalysis("x * 1.", 1u));
+   EXPECT_EQ(2u, ListCacheFiles().size());
+
+   // so is a different input file
+   WriteFile(kInputFile, 200);
+   EXPECT_DOUBLE_EQ(9845., runAnalysis("x * 0.5", 1u));
+   EXPECT_EQ(3u, ListCacheFiles().size());
+}
+
+TEST_F(RDFDiskCache, EntryListContent)
+{
+   WriteFile(kInputFile, 100);
+   auto runAnalysis = [](int first, unsigned int expectedNRuns) {
+      TFile f(kInputFile);
+      auto t = f.Get<TTree>("t");
+      // the same name and number of entries, but different entries
+      TEntryList entryList("elist", "elist", t);
+      for (auto entry = first; entry < first + 10; ++entry)
+         entryList.Enter(entry);
+      t->SetEntryList(&entryList);
+      RDataFrame df(*t);
+      auto cached = df.Cache<int>({"x"}, kCacheDir);
+      const auto sum = *cached.Sum<int>("x");
+      EXPECT_EQ(expectedNRuns, df.GetNRuns());
+      t->SetEntryList(nullptr);
+      return sum;
+   };
+
+   EXPECT_EQ(45, runAnalysis(0, 1u));
+   EXPECT_EQ(45, runAnalysis(0, 0u));
+   EXPECT_EQ(545, runAnalysis(50, 1u));
+   EXPECT_EQ(2u, ListCacheFiles().size());
+}
+
+TEST_F(RDFDiskCache, CorruptedCacheIsRewritten)
+{
+   WriteFile(kInputFile, 100);
+   auto runAnalysis = [](unsigned int expectedNRuns) {
+      RDataFrame df("t", kInputFile);
+      const auto count = *df.Filter("x > 9").Cache<int>({"x"}, kCacheDir).Count();
+      EXPECT_EQ(expectedNRuns, df.GetNRuns());
+      return count;
+   };
+   EXPECT_EQ(90ull, runAnalysis(1u));
+   const auto files = ListCacheFiles();
+   ASSERT_EQ(1u, files.size());
+
+   // truncate the cache file
+   {
+      std::ofstream f(files[0], std::ios::binary | std::ios::trunc);
+      f << "RDFCACHE";
+   }
+   EXPECT_EQ(90ull, runAnalysis(1u));
+   EXPECT_EQ(90ull, runAnalysis(0u));
+}
+
+TEST_F(RDFDiskCache, CompiledCallablesRequireAKey)
+{
+   WriteFile(kInputFile, 100);
+   auto isEven = [](int x) { return x % 2 == 0; };
+   // the same callable type with a different behaviour, as after a change of its code
+   auto scale = [](double factor) { return [factor](int x) { return x * factor; }; };
+   auto runAnalysis = [&](const char *key, double factor, unsigned int expectedNRuns) {
+      RDataFrame df("t", kInputFile);
+      auto cached =
+         df.Filter(isEven, {"x"}).Define("y", scale(factor), {"x"}).Cache<int, double>({"x", "y"}, kCacheDir, key);
+      const auto sum = *cached.Sum<double>("y");
+      EXPECT_EQ(expectedNRuns, df.GetNRuns());
+      return sum;
+   };
+
+   // the code of a compiled callable cannot be identified: without a key, a stale cache could be read
+   {
+      RDataFrame df("t", kInputFile);
+      auto filtered = df.Filter(isEven, {"x"});
+      EXPECT_THROW(filtered.Cache<int>({"x"}, kCacheDir), std::runtime_error);
+      EXPECT_THROW(filtered.Cache({"x"}, kCacheDir), std::runtime_error);
+      EXPECT_THROW(df.Define("y", scale(0.5), {"x"}).Cache<double>({"y"}, kCacheDir), std::runtime_error);
+   }
+   EXPECT_TRUE(ListCacheFiles().empty());
+
+   EXPECT_DOUBLE_EQ(1225., runAnalysis("v1", 0.5, 1u));
+   EXPECT_DOUBLE_EQ(1225., runAnalysis("v1", 0.5, 0u));
+   // the key identifies the code of the callables: a new key is a new cache
+   EXPECT_DOUBLE_EQ(2450., runAnalysis("v2", 1., 1u));
+   EXPECT_EQ(2u, ListCacheFiles().size());
+
+   // the jitted overload forwards the key
+   RDataFrame df("t", kInputFile);
+   auto jitted = df.Filter(isEven, {"x"}).Define("y", scale(0.5), {"x"}).Cache({"x", "y"}, kCacheDir, "v1");
+   EXPECT_DOUBLE_EQ(1225., *jitted.Sum<double>("y"));
+   EXPECT_EQ(0u, df.GetNRuns());
+}
+
+TEST_F(RDFDiskCache, FailedWriteIsRetried)
+{
+   WriteFile(kInputFile, 100);
+   bool fail = true;
+   RDataFrame df("t", kInputFile);
+   auto cached = df.Define("y",
+                           [&fail](int x) {
+                              if (fail && x == 50)
+                                 throw std::runtime_error("upstream failure");
+                              return x * 0.5;
+                           },
+                           {"x"})
+                    .Cache<double>({"y"}, kCacheDir, "v1");
+   EXPECT_THROW(cached.Sum<double>("y").GetValue(), std::runtime_error);
+   EXPECT_TRUE(ListCacheFiles().empty());
+
+   // the next event loop runs the upstream computation graph again to write the cache
+   fail = false;
+   EXPECT_DOUBLE_EQ(2475., *cached.Sum<double>("y"));
+   EXPECT_EQ(1u, df.GetNRuns());
+   EXPECT_EQ(1u, ListCacheFiles().size());
+}
+
+TEST_F(RDFDiskCache, DataSourceIsNotSupported)
+{
+   auto df = ROOT::RDF::MakeTrivialDataFrame(10);
+   EXPECT_THROW(df.Cache<ULong64_t>({"col0"}, kCacheDir), std::runtime_error);
+}
@@ -1,10 +1,15 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDF/RSlotStack.hxx>
+#include <TEnv.h>
+#include <TInterpreter.h>
 #include <TStatistic.h> // To check reading of columns with types which are mothers of the column type
 #include <TSystem.h>
 
+#include <algorithm>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -58,6 +63,73 @@ TEST(RDataFrameNodes, RLoopManagerJit)
    EXPECT_ANY_THROW(op()) << "Bogus C++ code was jitted and nothing was detected!";
 }
 
+// Enable the jit cache in `dir` for the lifetime of the object, then disable it and remove the directory
+class TJitCacheDirRAII {
+   const std::string fDir;
+
+public:
+   TJitCacheDirRAII(const std::string &dir) : fDir(dir) { gEnv->SetValue("RDataFrame.JitCacheDir", fDir.c_str()); }
+   ~TJitCacheDirRAII()
+   {
+      gEnv->SetValue("RDataFrame.JitCacheDir", "");
+      auto dir = gSystem->OpenDirectory(fDir.c_str());
+      if (!dir)
+         return;
+      std::vector<std::string> files;
+      while (const char *entry = gSystem->GetDirEntry(dir)) {
+         if (entry[0] != '.')
+            files.emplace_back(entry);
+      }
+      gSystem->FreeDirectory(dir);
+      for (const auto &f : files)
+         gSystem->Unlink((fDir + "/" + f).c_str());
+      gSystem->Unlink(fDir.c_str());
+   }
+};
+
+TEST(RDataFrameNodes, RLoopManagerJitCache)
+{
+   const std::string cacheDir = "dataframe_nodes_jitcache";
+   const auto libSuffix = std::string(".") + gSystem->GetSoExt();
+   auto listLibraries = [&]() {
+      std::vector<std::string> files;
+      auto dir = gSystem->OpenDirectory(cacheDir.c_str());
+      if (!dir)
+         return files;
+      while (const char *entry = gSystem->GetDirEntry(dir)) {
+         const std::string f(entry);
+         if (f.find("rdfjit_") == 0 && f.size() > libSuffix.size() &&
+             f.compare(f.size() - libSuffix.size(), libSuffix.size(), libSuffix) == 0)
+            files.emplace_back(f);
+      }
+      gSystem->FreeDirectory(dir);
+      return files;
+   };
+   // The same computation graph, booked on a new loop manager each time: the jitted code does not depend on its ID
+   auto runGraph = [] {
+      auto lm = std::make_shared<ROOT::Detail::RDF::RLoopManager>(10ull);
+      ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager> df(lm);
+      auto sum = df.Define("x", "rdfentry_ * 2").Filter("x > 4").Sum("x");
+      EXPECT_DOUBLE_EQ(84., *sum);
+      return lm->GetID();
+   };
+
+   TJitCacheDirRAII jitCacheDir(cacheDir);
+   runGraph();
+
+   // The jitted code was compiled in a library in the cache directory
+   const auto libraries = listLibraries();
+   ASSERT_EQ(1u, libraries.size());
+
+   // A second run loads that library, and neither declares nor executes anything in the interpreter
+   const auto ns = "__rdf" + std::to_string(runGraph());
+   EXPECT_EQ(TInterpreter::kUnknown, gInterpreter->CheckClassInfo(ns.c_str(), kFALSE, kTRUE));
+   gEnv->SetValue("RDataFrame.JitCacheDir", "");
+   EXPECT_EQ(libraries, listLibraries());
+   const auto libName = libraries[0].substr(0, libraries[0].size() - libSuffix.size());
+   EXPECT_NE(std::string::npos, std::string(gSystem->GetLibraries("", "D")).find(libName));
+}
+
 TEST(RDataFrameNodes, DoubleEvtLoop)
 {
    ROOT::RDataFrame d1(4);
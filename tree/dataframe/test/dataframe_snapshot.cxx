@@ -899,5 +899,74 @@ TEST(RDFSnapshotMore, ReadWriteCarrayMT)
    ROOT::DisableImplicitMT();
 }
 
+TEST(RDFSnapshotMore, KeepEntryOrderMT)
+{
+   ROOT::EnableImplicitMT(4);
+   const auto inputFilePrefix = std::string("snapshot_keeporder_");
+   const auto nInputFiles = 8u;
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fKeepEntryOrder = true;
+   opts.fAutoFlush = 10; // several clusters per task
+
+   // empty source: each task generates a range of entries
+   for (auto i = 0u; i < nInputFiles; ++i) {
+      ROOT::RDataFrame d(100);
+      d.Define("x", [i](ULong64_t e) { return int(i * 100 + e); }, {"rdfentry_"})
+         .Snapshot<int>("t", inputFilePrefix + std::to_string(i) + ".root", {"x"}, opts);
+   }
+
+   // chain of files: tasks process the clusters of different files
+   const auto outputFile = "snapshot_outkeeporder.root";
+   ROOT::RDataFrame tdf("t", (inputFilePrefix + "*.root").c_str());
+   tdf.Filter([](int x) { return x % 3 != 0; }, {"x"}).Snapshot<int>("t", outputFile, {"x"}, opts);
+
+   TFile f(outputFile);
+   auto t = f.Get<TTree>("t");
+   EXPECT_FALSE(t->TestBit(TTree::kEntriesReshuffled));
+   int x = 0;
+   t->SetBranchAddress("x", &x);
+   std::vector<int> expected;
+   for (int i = 0; i < int(nInputFiles) * 100; ++i)
+      if (i % 3 != 0)
+         expected.emplace_back(i);
+   std::vector<int> written;
+   for (auto e = 0ll; e < t->GetEntries(); ++e) {
+      t->GetEntry(e);
+      written.emplace_back(x);
+   }
+   EXPECT_EQ(expected, written);
+   t->ResetBranchAddresses();
+   f.Close();
+
+   // tasks without passing entries do not hold back the ones that follow them
+   const auto lateOutputFile = "snapshot_outkeeporder_late.root";
+   tdf.Filter([](int x) { return x >= 650; }, {"x"}).Snapshot<int>("t", lateOutputFile, {"x"}, opts);
+   TFile lateFile(lateOutputFile);
+   auto lateTree = lateFile.Get<TTree>("t");
+   ASSERT_NE(nullptr, lateTree);
+   lateTree->SetBranchAddress("x", &x);
+   ASSERT_EQ(150ll, lateTree->GetEntries());
+   for (auto e = 0ll; e < lateTree->GetEntries(); ++e) {
+      lateTree->GetEntry(e);
+      EXPECT_EQ(650 + e, x);
+   }
+   lateTree->ResetBranchAddresses();
+   lateFile.Close();
+
+   // if no entry passes, no tree is written
+   const auto emptyOutputFile = "snapshot_outkeeporder_empty.root";
+   tdf.Filter([](int x) { return x < 0; }, {"x"}).Snapshot<int>("t", emptyOutputFile, {"x"}, opts);
+   TFile emptyFile(emptyOutputFile);
+   EXPECT_EQ(nullptr, emptyFile.Get<TTree>("t"));
+   emptyFile.Close();
+
+   gSystem->Unlink(lateOutputFile);
+   gSystem->Unlink(emptyOutputFile);
+   for (auto i = 0u; i < nInputFiles; ++i)
+      gSystem->Unlink((inputFilePrefix + std::to_string(i) + ".root").c_str());
+   gSystem->Unlink(outputFile);
+   ROOT::DisableImplicitMT();
+}
+
 #endif // R__USE_IMT
 
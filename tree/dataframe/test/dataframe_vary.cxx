@@ -0,0 +1,184 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ROOT::RDataFrame;
+using ROOT::RDF::VariationsFor;
+using ROOT::VecOps::RVec;
+
+namespace {
+
+/// A dataset with x = 0..99, varied by -1 and +1 in the "shift:down" and "shift:up" variations
+ROOT::RDF::RNode ShiftedX(RDataFrame &df, int &nEvaluations)
+{
+   auto shift = [&nEvaluations](double x) {
+      ++nEvaluations;
+      return RVec<double>{x - 1., x + 1.};
+   };
+   return df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+      .Vary("x", shift, {"x"}, {"down", "up"}, "shift");
+}
+
+} // anonymous namespace
+
+TEST(RDFVary, DefineFilterActions)
+{
+   RDataFrame df(100);
+   int nEvaluations = 0;
+   auto selected = ShiftedX(df, nEvaluations)
+                      .Define("y", [](double x) { return 2. * x; }, {"x"})
+                      .Filter([](double y) { return y > 50.; }, {"y"}, "cut");
+   auto sum = selected.Sum<double>("y");
+   auto count = selected.Count();
+   auto max = selected.Max<double>("x");
+
+   auto sums = VariationsFor(sum);
+   auto counts = VariationsFor(count);
+   EXPECT_EQ(std::vector<std::string>({"nominal", "shift:down", "shift:up"}), sums.GetKeys());
+   EXPECT_DOUBLE_EQ(9250., sums["nominal"]);
+   EXPECT_DOUBLE_EQ(9052., sums["shift:down"]);
+   EXPECT_DOUBLE_EQ(9450., sums["shift:up"]);
+   EXPECT_EQ(74u, counts["nominal"]);
+   EXPECT_EQ(73u, counts["shift:down"]);
+   EXPECT_EQ(75u, counts["shift:up"]);
+   EXPECT_DOUBLE_EQ(100., VariationsFor(max)["shift:up"]);
+   EXPECT_THROW(sums["shift:sideways"], std::runtime_error);
+
+   // All variations were filled in a single event loop, computing the variations once per entry
+   EXPECT_EQ(1u, df.GetNRuns());
+   EXPECT_EQ(100, nEvaluations);
+}
+
+TEST(RDFVary, UnaffectedNodesAreShared)
+{
+   RDataFrame df(100);
+   int nEvaluations = 0;
+   auto varied = ShiftedX(df, nEvaluations);
+   int nFilterCalls = 0;
+   auto even = varied.Filter(
+      [&nFilterCalls](ULong64_t e) {
+         ++nFilterCalls;
+         return e % 2 == 0;
+      },
+      {"rdfentry_"});
+   auto sumEntries = even.Sum<ULong64_t>("rdfentry_");
+   auto sumX = even.Sum<double>("x");
+
+   // The result does not depend on "x": there are no variations to list
+   EXPECT_EQ(std::vector<std::string>({"nominal"}), VariationsFor(sumEntries).GetKeys());
+   auto sumsX = VariationsFor(sumX);
+   EXPECT_DOUBLE_EQ(2450., sumsX["nominal"]);
+   EXPECT_DOUBLE_EQ(2400., sumsX["shift:down"]);
+   EXPECT_DOUBLE_EQ(2500., sumsX["shift:up"]);
+   // The filter does not depend on "x": it is evaluated once per entry
+   EXPECT_EQ(100, nFilterCalls);
+}
+
+TEST(RDFVary, VaryTogether)
+{
+   RDataFrame df(10);
+   auto varied =
+      df.Define("a", [] { return 1; })
+         .Define("b", [] { return 10; })
+         .Vary("a", [](int a) { return RVec<int>{a - 1, a + 1}; }, {"a"}, {"down", "up"}, "sys")
+         .Vary("b", [](int b) { return RVec<int>{b - 10, b + 10}; }, {"b"}, {"down", "up"}, "sys");
+   auto sum = varied.Define("c", [](int a, int b) { return a + b; }, {"a", "b"}).Sum<int>("c");
+   auto sums = VariationsFor(sum);
+   EXPECT_EQ(3u, sums.GetKeys().size());
+   EXPECT_EQ(110, sums["nominal"]);
+   EXPECT_EQ(0, sums["sys:down"]);
+   EXPECT_EQ(220, sums["sys:up"]);
+
+   EXPECT_THROW(varied.Vary("a", [](int a) { return RVec<int>{a}; }, {"a"}, {"up"}, "sys"), std::runtime_error);
+}
+
+TEST(RDFVary, RangeAndNVariations)
+{
+   RDataFrame df(100);
+   auto varied = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                    .Vary("x", [](int x) { return RVec<int>{x, -x, 2 * x}; }, {"x"}, 3)
+                    .Filter([](int x) { return x % 2 == 0; }, {"x"})
+                    .Range(3);
+   auto counts = VariationsFor(varied.Count());
+   EXPECT_EQ(std::vector<std::string>({"nominal", "x:0", "x:1", "x:2"}), counts.GetKeys());
+   auto sums = VariationsFor(varied.Sum<int>("x"));
+   EXPECT_EQ(6, sums["nominal"]);
+   EXPECT_EQ(-6, sums["x:1"]);
+   EXPECT_EQ(6, sums["x:2"]); // all entries pass the filter: 0 + 2 + 4
+}
+
+TEST(RDFVary, Jitted)
+{
+   RDataFrame df(100);
+   int nEvaluations = 0;
+   auto selected = ShiftedX(df, nEvaluations).Define("y", "x * 2").Filter("y > 50");
+   auto h = selected.Histo1D<double>({"h", "h", 200, 0, 200}, "y");
+   auto hJitted = selected.Histo1D({"hJitted", "h", 200, 0, 200}, "x");
+
+   auto hs = VariationsFor(h);
+   EXPECT_DOUBLE_EQ(74., hs["nominal"].GetEntries());
+   EXPECT_DOUBLE_EQ(73., hs["shift:down"].GetEntries());
+   EXPECT_DOUBLE_EQ(75., hs["shift:up"].GetEntries());
+   auto hsJitted = VariationsFor(hJitted);
+   EXPECT_DOUBLE_EQ(62.5, hsJitted["nominal"].GetMean());
+   EXPECT_DOUBLE_EQ(62., hsJitted["shift:down"].GetMean());
+   EXPECT_DOUBLE_EQ(63., hsJitted["shift:up"].GetMean());
+   EXPECT_EQ(1u, df.GetNRuns());
+}
+
+TEST(RDFVary, JittedTTreeBranch)
+{
+   const auto fileName = "dataframe_vary_ttree.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      double x;
+      t.Branch("x", &x);
+      for (auto i = 0; i < 100; ++i) {
+         x = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   {
+      // the varied column is a branch: jitted nodes read it through its variations, not through the TTreeReader
+      RDataFrame df("t", fileName);
+      auto selected = df.Vary("x", [](double x) { return RVec<double>{x - 1, x + 1}; }, {"x"}, {"down", "up"}, "shift")
+                         .Define("y", "x * 2")
+                         .Filter("y > 50");
+      auto count = selected.Count();
+      auto h = selected.Histo1D({"h", "h", 200, 0, 200}, "x");
+
+      auto counts = VariationsFor(count);
+      EXPECT_EQ(74ull, counts["nominal"]);
+      EXPECT_EQ(73ull, counts["shift:down"]);
+      EXPECT_EQ(75ull, counts["shift:up"]);
+      auto hs = VariationsFor(h);
+      EXPECT_DOUBLE_EQ(62.5, hs["nominal"].GetMean());
+      EXPECT_DOUBLE_EQ(62., hs["shift:down"].GetMean());
+      EXPECT_DOUBLE_EQ(63., hs["shift:up"].GetMean());
+      EXPECT_EQ(1u, df.GetNRuns());
+   }
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFVary, WrongNumberOfVariations)
+{
+   RDataFrame df(1);
+   auto sum = df.Define("x", [] { return 1.; })
+                 .Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, {"down", "up"})
+                 .Sum<double>("x");
+   auto sums = VariationsFor(sum);
+   EXPECT_THROW(sums["x:up"], std::runtime_error);
+}
@@ -0,0 +1,202 @@
+/// \file ROOT/RCluster.hxx
+/// \ingroup NTuple ROOT7
+/// \author agent <agent@local>
+/// \date 2020-03-11
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RCluster
+#define ROOT7_RCluster
+
+#include <ROOT/RNTupleUtil.hxx>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROnDiskPage
+\ingroup NTuple
+\brief A page as being stored on disk, that is packed and compressed
+
+Used by the cluster pool to cache pages from the physical storage. Such pages generally need to be
+uncompressed and unpacked before they can be used by RNTuple upper layers.
+*/
+// clang-format on
+class ROnDiskPage {
+private:
+   /// The memory location of the bytes
+   const void *fAddress = nullptr;
+   /// The compressed and packed size of the page
+   std::uint32_t fSize = 0;
+
+public:
+   /// On-disk pages within a page source are identified by the column and page number. The key is used for
+   /// associative collections of on-disk pages.
+   struct Key {
+      DescriptorId_t fColumnId;
+      NTupleSize_t fPageNo;
+      Key(DescriptorId_t columnId, NTupleSize_t pageNo) : fColumnId(columnId), fPageNo(pageNo) {}
+      friend bool operator ==(const Key &lhs, const Key &rhs) {
+         return lhs.fColumnId == rhs.fColumnId && lhs.fPageNo == rhs.fPageNo;
+      }
+   };
+
+   ROnDiskPage() = default;
+   ROnDiskPage(void *address, std::uint32_t size) : fAddress(address), fSize(size) {}
+
+   const void *GetAddress() const { return fAddress; }
+   std::uint32_t GetSize() const { return fSize; }
+
+   bool IsNull() const { return fAddress == nullptr; }
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+// For hash maps ROnDiskPage::Key --> ROnDiskPage
+namespace std
+{
+   template <>
+   struct hash<ROOT::Experimental::Detail::ROnDiskPage::Key>
+   {
+      /// Combines the hashes of the column id and of the page number as in boost::hash_combine
+      size_t operator()(const ROOT::Experimental::Detail::ROnDiskPage::Key &key) const
+      {
+         auto seed = std::hash<ROOT::Experimental::DescriptorId_t>()(key.fColumnId);
+         seed ^= hash<ROOT::Experimental::NTupleSize_t>()(key.fPageNo) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+         return seed;
+      }
+   };
+}
+
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::ROnDiskPageMap
+\ingroup NTuple
+\brief A memory region that contains packed and compressed pages
+
+Derived classes implement how the on-disk pages are stored in memory, e.g. mmap'd or in a special area.
+*/
+// clang-format on
+class ROnDiskPageMap {
+   friend class RCluster;
+
+private:
+   std::unordered_map<ROnDiskPage::Key, ROnDiskPage> fOnDiskPages;
+
+public:
+   ROnDiskPageMap() = default;
+   ROnDiskPageMap(const ROnDiskPageMap &other) = delete;
+   ROnDiskPageMap(ROnDiskPageMap &&other) = default;
+   ROnDiskPageMap &operator =(const ROnDiskPageMap &other) = delete;
+   ROnDiskPageMap &operator =(ROnDiskPageMap &&other) = default;
+   virtual ~ROnDiskPageMap();
+
+   /// Inform the map about the location of a page on disk
+   void Register(const ROnDiskPage::Key &key, const ROnDiskPage &onDiskPage) { fOnDiskPages.emplace(key, onDiskPage); }
+};
+
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::ROnDiskPageMapHeap
+\ingroup NTuple
+\brief An ROnDiskPageMap that is used for an fMemory allocated as an array of unsigned char.
+*/
+// clang-format on
+class ROnDiskPageMapHeap : public ROnDiskPageMap {
+private:
+   /// The memory region containing the on-disk pages.
+   std::unique_ptr<unsigned char[]> fMemory;
+
+public:
+   explicit ROnDiskPageMapHeap(std::unique_ptr<unsigned char[]> memory) : fMemory(std::move(memory)) {}
+   ROnDiskPageMapHeap(const ROnDiskPageMapHeap &other) = delete;
+   ROnDiskPageMapHeap(ROnDiskPageMapHeap &&other) = default;
+   ROnDiskPageMapHeap &operator =(const ROnDiskPageMapHeap &other) = delete;
+   ROnDiskPageMapHeap &operator =(ROnDiskPageMapHeap &&other) = default;
+   ~ROnDiskPageMapHeap();
+};
+
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RCluster
+\ingroup NTuple
+\brief An in-memory subset of the packed and compressed pages of a cluster
+
+Binds to the many page maps that may result from reading the pages of a cluster. The cluster pool prepares
+clusters for the page source, e.g. by reading them ahead of time in a background thread. The cluster knows
+which columns it contains so that the page source can decide whether a cluster can satisfy a page request.
+A cluster may contain only a subset of the columns of the ntuple, e.g. the columns that are actually used
+by the reader.
+*/
+// clang-format on
+class RCluster {
+public:
+   using ColumnSet_t = std::unordered_set<DescriptorId_t>;
+
+protected:
+   /// References the cluster identifier in the page source that created the cluster
+   DescriptorId_t fClusterId;
+   /// Multiple page maps can be combined in a single RCluster
+   std::vector<std::unique_ptr<ROnDiskPageMap>> fPageMaps;
+   /// List of the (complete) columns represented by the RCluster
+   ColumnSet_t fAvailColumns;
+   /// Lookup table for the on-disk pages
+   std::unordered_map<ROnDiskPage::Key, ROnDiskPage> fOnDiskPages;
+
+public:
+   explicit RCluster(DescriptorId_t clusterId) : fClusterId(clusterId) {}
+   RCluster(const RCluster &other) = delete;
+   RCluster(RCluster &&other) = default;
+   RCluster &operator =(const RCluster &other) = delete;
+   RCluster &operator =(RCluster &&other) = default;
+   virtual ~RCluster();
+
+   /// Move the given page map into this cluster; on-disk pages that are present in both the cluster at hand and
+   /// pageMap are ignored.
+   void Adopt(std::unique_ptr<ROnDiskPageMap> pageMap);
+   /// Move the contents of other into this cluster; on-disk pages that are present in both the cluster at hand and
+   /// the "other" cluster are ignored; the other cluster's id is ignored.
+   void Adopt(RCluster &&other);
+   /// Marks the column as complete; must be done for all columns, even empty ones without associated pages,
+   /// before the cluster is given from the page storage to the cluster pool.
+   void SetColumnAvailable(DescriptorId_t columnId);
+   const ROnDiskPage *GetOnDiskPage(const ROnDiskPage::Key &key) const;
+
+   DescriptorId_t GetId() const { return fClusterId; }
+   const ColumnSet_t &GetAvailColumns() const { return fAvailColumns; }
+   bool ContainsColumn(DescriptorId_t columnId) const { return fAvailColumns.count(columnId) > 0; }
+   size_t GetNOnDiskPages() const { return fOnDiskPages.size(); }
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,153 @@
+/// \file ROOT/RClusterPool.hxx
+/// \ingroup NTuple ROOT7
+/// \author agent <agent@local>
+/// \date 2020-03-11
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RClusterPool
+#define ROOT7_RClusterPool
+
+#include <ROOT/RCluster.hxx>
+#include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RPageStorage.hxx>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RClusterPool
+\ingroup NTuple
+\brief Manages a set of clusters containing compressed and packed pages
+
+The cluster pool steers the preloading of (partial) clusters. There is a two-step pipeline: in a first step,
+compressed pages are read from clusters into a memory buffer. The first pipeline step is performed by the I/O thread.
+In a second step, the pages are decompressed and unpacked and preloaded into the page pool. The second pipeline
+step is performed by the unzip thread, which can in turn dispatch the decompression of the individual pages to
+the page source's task scheduler, e.g. the IMT thread pool.
+
+Both steps run in the background while the reader works on the current cluster. When the reader requests a
+cluster, the pool schedules the following clusters of the access window so that reading and decompressing the
+next cluster overlaps with processing the current one. The pool only loads the columns that are requested by
+the page source, i.e. the columns that are actually used.
+
+The cluster pool is owned by the page source. It uses the page source's LoadCluster() and UnzipCluster() methods.
+*/
+// clang-format on
+class RClusterPool {
+private:
+   /// Request to load a subset of the columns of a particular cluster.
+   /// Work items come in groups and are executed by the page source.
+   struct RReadItem {
+      std::promise<std::unique_ptr<RCluster>> fPromise;
+      DescriptorId_t fClusterId = kInvalidDescriptorId;
+      RPageSource::ColumnSet_t fColumns;
+   };
+
+   /// Request to decompress and if necessary unpack compressed pages. The unzipped pages are supposed to be
+   /// preloaded in a page pool attached to the source.
+   struct RUnzipItem {
+      std::unique_ptr<RCluster> fCluster;
+      std::promise<std::unique_ptr<RCluster>> fPromise;
+   };
+
+   /// Clusters that are currently being processed by the pipeline.  Every in-flight cluster has a corresponding
+   /// work item, first a read item and then an unzip item.
+   struct RInFlightCluster {
+      std::future<std::unique_ptr<RCluster>> fFuture;
+      DescriptorId_t fClusterId = kInvalidDescriptorId;
+      RPageSource::ColumnSet_t fColumns;
+      /// By the time a cluster has been loaded, this cluster might not be necessary anymore. This can happen if
+      /// there are jumps in the access pattern (i.e. the access pattern deviates from linear access).
+      bool fIsExpired = false;
+   };
+
+   /// Every cluster id has at most one corresponding RCluster pointer in the pool
+   std::vector<std::unique_ptr<RCluster>> fPool;
+   /// The page source that creates the cluster pool.  The cluster pool has to be destructed before the page source.
+   RPageSource &fPageSource;
+   /// The number of clusters before the currently active cluster that should stay in the pool if present
+   unsigned int fWindowPre;
+   /// The number of desired clusters in the pool, including the currently active cluster
+   unsigned int fWindowPost;
+   /// Protects the shared state between the main thread and the I/O thread
+   std::mutex fLockWorkQueue;
+   /// Signals a non-empty I/O work queue
+   std::condition_variable fCvHasReadWork;
+   /// The communication channel to the I/O thread
+   std::deque<RReadItem> fReadQueue;
+   /// The clusters that were handed off to the I/O thread; only accessed from the main thread
+   std::vector<RInFlightCluster> fInFlightClusters;
+   /// The I/O thread calls RPageSource::LoadCluster() asynchronously.  The thread is mostly waiting for the
+   /// data to arrive (blocked by the kernel) and therefore can safely run in addition to the application
+   /// main threads.
+   std::thread fThreadIo;
+   /// Protects the shared state between the I/O thread and the unzip thread
+   std::mutex fLockUnzipQueue;
+   /// Signals non-empty unzip work queue
+   std::condition_variable fCvHasUnzipWork;
+   /// The communication channel between the I/O thread and the unzip thread
+   std::deque<RUnzipItem> fUnzipQueue;
+   /// The unzip thread takes a loaded cluster and passes it to fPageSource.UnzipCluster() on it. If implicit
+   /// multi-threading is turned on, the UnzipCluster() call is parallelized over the pages of the cluster.
+   std::thread fThreadUnzip;
+
+   /// Every cluster pool is responsible for exactly one page source that triggers loading of the clusters
+   /// (GetCluster()) and is used for implementing the I/O and cluster memory allocation (PageSource::LoadCluster()).
+   /// The I/O thread loop processes the work queue and hands off the loaded clusters to the unzip thread.
+   void ExecReadClusters();
+   /// The unzip thread loop processes the loaded clusters and fulfills the promises of the corresponding read items
+   void ExecUnzipClusters();
+   /// Moves the clusters of the ready in-flight items into the pool, or discards them if they are expired
+   void CollectInFlightClusters();
+   /// Returns the given cluster from the pool, which needs to contain at least the columns `columns`.
+   /// Executed at the end of GetCluster when all missing data pieces have been sent to the load queue.
+   /// Ideally, the function returns without blocking if the cluster is already in the pool.
+   RCluster *WaitFor(DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns);
+   /// Puts a loaded cluster into the pool, merging it with a partial cluster of the same id if necessary
+   RCluster *Insert(std::unique_ptr<RCluster> cluster);
+   RCluster *FindInPool(DescriptorId_t clusterId) const;
+   size_t FindFreeSlot() const;
+
+public:
+   static constexpr unsigned int kDefaultPoolSize = 4;
+   RClusterPool(RPageSource &pageSource, unsigned int size);
+   explicit RClusterPool(RPageSource &pageSource) : RClusterPool(pageSource, kDefaultPoolSize) {}
+   RClusterPool(const RClusterPool &other) = delete;
+   RClusterPool &operator =(const RClusterPool &other) = delete;
+   ~RClusterPool();
+
+   unsigned int GetWindowPre() const { return fWindowPre; }
+   unsigned int GetWindowPost() const { return fWindowPost; }
+
+   /// Returns the requested cluster either from the pool or, in case of a cache miss, lets the I/O thread load
+   /// the cluster in the pool and blocks until done.  The returned cluster contains at least the given columns.
+   /// The request triggers loading the following clusters in the background, up to the size of the pool.
+   /// The returned cluster pointer is valid until the next GetCluster() call.
+   RCluster *GetCluster(DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns);
+};
+
+} // namespace Detail
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
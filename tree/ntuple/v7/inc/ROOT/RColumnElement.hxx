@@ -23,6 +23,7 @@
 
 #include <cstring> // for memcpy
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 
 namespace ROOT {
@@ -68,7 +69,12 @@ public:
    RColumnElementBase& operator =(RColumnElementBase&& other) = default;
    virtual ~RColumnElementBase() = default;
 
-   static RColumnElementBase Generate(EColumnType type);
+   /// Creates a typed column element (without associated C++ value) for the given on-disk column type, e.g. to
+   /// unpack pages of columns that are not connected to a field.
+   static std::unique_ptr<RColumnElementBase> Generate(EColumnType type);
+   /// Returns the split encoded column type with the same in-memory representation as the given column type,
+   /// e.g. kSplitReal32 for kReal32, or kUnknown if there is no such encoding.
+   static EColumnType GetSplitType(EColumnType type);
 
    /// Write one or multiple column elements into destination
    void WriteTo(void *destination, std::size_t count) const {
@@ -84,6 +90,19 @@ public:
    virtual bool IsMappable() const { R__ASSERT(false); return false; }
    virtual std::size_t GetBitsOnStorage() const { R__ASSERT(false); return 0; }
 
+   /// For numerical elements, determines the smallest and the largest of count in-memory values, converted to double
+   /// such that the resulting range includes all the values. NaN values are ignored. Returns false if the element
+   /// has no notion of a value range or if there are no values to consider.
+   virtual bool GetValueRange(const void * /* values */, std::size_t /* count */,
+                              double & /* min */, double & /* max */) const
+   {
+      return false;
+   }
+
+   /// Creates an element for the split encoded column type of this element with the same C++ type, or returns nullptr
+   /// if there is no split encoding for the column type (see GetSplitType())
+   virtual std::unique_ptr<RColumnElementBase> GenerateSplit() const { return nullptr; }
+
    /// If the on-storage layout and the in-memory layout differ, packing creates an on-disk page from an in-memory page
    virtual void Pack(void *destination, void *source, std::size_t count) const
    {
@@ -124,6 +143,8 @@ public:
    explicit RColumnElement(float *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -135,6 +156,8 @@ public:
    explicit RColumnElement(double *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -157,6 +180,8 @@ public:
    explicit RColumnElement(std::int32_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -168,6 +193,8 @@ public:
    explicit RColumnElement(std::uint32_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -179,6 +206,8 @@ public:
    explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -190,6 +219,8 @@ public:
    explicit RColumnElement(std::uint64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -201,6 +232,7 @@ public:
    explicit RColumnElement(ClusterSize_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   std::unique_ptr<RColumnElementBase> GenerateSplit() const final;
 };
 
 template <>
@@ -239,6 +271,113 @@ public:
    void Unpack(void *dst, void *src, std::size_t count) const final;
 };
 
+/**
+ * Split encoded elements, see EColumnType; they are packed and unpacked by byte shuffling
+ */
+template <>
+class RColumnElement<float, EColumnType::kSplitReal32> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(float);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(float *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<double, EColumnType::kSplitReal64> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(double);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(double *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::int32_t, EColumnType::kSplitInt32> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::int32_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::int32_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::uint32_t, EColumnType::kSplitInt32> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::uint32_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::uint32_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::int64_t, EColumnType::kSplitInt64> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::int64_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::uint64_t, EColumnType::kSplitInt64> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::uint64_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::uint64_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *values, std::size_t count, double &min, double &max) const final;
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<ClusterSize_t, EColumnType::kSplitIndex> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(ROOT::Experimental::ClusterSize_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(ClusterSize_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
 } // namespace Detail
 } // namespace Experimental
 } // namespace ROOT
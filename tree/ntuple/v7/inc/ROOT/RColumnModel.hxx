@@ -48,6 +48,14 @@ enum class EColumnType {
    kInt64,
    kInt32,
    kInt16,
+   // Encoded variants of the types above that have the same in-memory representation. The split types store
+   // the first bytes of all the elements of a page, then the second bytes, etc., which compresses better.
+   // kSplitIndex additionally stores the zigzag encoded differences between consecutive elements.
+   kSplitIndex,
+   kSplitReal64,
+   kSplitReal32,
+   kSplitInt64,
+   kSplitInt32,
 };
 
 // clang-format off
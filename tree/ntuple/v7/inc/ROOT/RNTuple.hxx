@@ -24,10 +24,13 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -35,10 +38,34 @@ namespace Experimental {
 class REntry;
 class RNTupleModel;
 
+class TTaskGroup;
+
 namespace Detail {
 class RPageSink;
 class RPageSource;
-}
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleImtTaskScheduler
+\ingroup NTuple
+\brief A page storage task scheduler that dispatches the (de)compression tasks to the IMT thread pool
+
+Only used if implicit multi-threading is turned on.
+*/
+// clang-format on
+class RNTupleImtTaskScheduler : public RPageStorage::RTaskScheduler {
+private:
+   std::unique_ptr<TTaskGroup> fTaskGroup;
+
+public:
+   RNTupleImtTaskScheduler();
+   virtual ~RNTupleImtTaskScheduler();
+   void Reset() final;
+   void AddTask(const std::function<void(void)> &taskFunc) final;
+   void Wait() final;
+};
+
+} // namespace Detail
 
 
 /**
@@ -48,6 +75,7 @@ enum class ENTupleInfo {
    kSummary,  // The ntuple name, description, number of entries
    kStorageDetails, // size on storage, page sizes, compression factor, etc.
    kMetrics, // internals performance counters, requires that EnableMetrics() was called
+   kMetricsJSON, // like kMetrics but as a JSON object, e.g. for consumption by monitoring tools
 };
 
 /**
@@ -72,12 +100,18 @@ Individual fields can be read as well by instantiating a tree view.
 // clang-format on
 class RNTupleReader {
 private:
+   /// Set as the page source's scheduler for parallel page decompression if IMT is on.
+   /// Needs to be destructed after the page source is destructed (and thus be declared before)
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fUnzipTasks;
+
    std::unique_ptr<Detail::RPageSource> fSource;
    /// Needs to be destructed before fSource
    std::unique_ptr<RNTupleModel> fModel;
    Detail::RNTupleMetrics fMetrics;
 
    void ConnectModel();
+   /// Installs fUnzipTasks as the task scheduler of the page source if implicit multi-threading is enabled
+   void InitPageSource();
 
 public:
    // Browse through the entries
@@ -169,6 +203,9 @@ triggered by Flush() or by destructing the ntuple.  On I/O errors, an exception
 class RNTupleWriter {
 private:
    static constexpr NTupleSize_t kDefaultClusterSizeEntries = 64000;
+   /// Set as the page sink's scheduler for parallel page compression if IMT is on.
+   /// Needs to be destructed after the page sink is destructed (and thus be declared before)
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fZipTasks;
    std::unique_ptr<Detail::RPageSink> fSink;
    /// Needs to be destructed before fSink
    std::unique_ptr<RNTupleModel> fModel;
@@ -202,6 +239,95 @@ public:
    void CommitCluster();
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleFillContext
+\ingroup NTuple
+\brief A context for filling entries (data) into clusters of an RNTupleParallelWriter
+
+A fill context is created by RNTupleParallelWriter::CreateFillContext() and is meant to be used by a single thread.
+It has its own copy of the ntuple model and its own buffered page sink. The pages are packed and compressed in the
+thread that calls Fill(). Full clusters are handed over to the writer's page sink under a lock, such that several
+fill contexts can fill the same ntuple concurrently. The order of the clusters in the ntuple is the order in which
+the fill contexts commit them. All fill contexts need to be destructed before their parallel writer.
+*/
+// clang-format on
+class RNTupleFillContext {
+   friend class RNTupleParallelWriter;
+
+private:
+   static constexpr NTupleSize_t kDefaultClusterSizeEntries = 64000;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   NTupleSize_t fClusterSizeEntries;
+   NTupleSize_t fLastCommitted;
+   NTupleSize_t fNEntries;
+
+   RNTupleFillContext(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+
+public:
+   RNTupleFillContext(const RNTupleFillContext&) = delete;
+   RNTupleFillContext& operator=(const RNTupleFillContext&) = delete;
+   ~RNTupleFillContext();
+
+   /// The fill context's copy of the model; entries to be filled need to be created from this model
+   RNTupleModel *GetModel() { return fModel.get(); }
+   /// The simplest user interface if the default entry that comes with the fill context's model is used
+   void Fill() { Fill(fModel->GetDefaultEntry()); }
+   /// Multiple entries can have been instantiated from the fill context's model
+   void Fill(REntry *entry) {
+      for (auto& value : *entry) {
+         value.GetField()->Append(value);
+      }
+      fNEntries++;
+      if ((fNEntries % fClusterSizeEntries) == 0)
+         CommitCluster();
+   }
+   /// Hand over the entries filled since the last cluster commit as a new cluster to the parallel writer
+   void CommitCluster();
+   /// The number of entries filled through this context so far
+   NTupleSize_t GetNEntries() const { return fNEntries; }
+};
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleParallelWriter
+\ingroup NTuple
+\brief An RNTuple that can be filled concurrently from multiple threads
+
+Instead of filling the parallel writer directly, every thread creates its own RNTupleFillContext and fills entries
+through it. Fill contexts can be created at any time and from any thread. The parallel writer owns the page sink
+that writes the clusters of all the fill contexts to storage and commits the data set on destruction.
+
+The fill contexts use copies of the model given to the parallel writer. Collections created with
+RNTupleModel::MakeCollection() cannot be copied and are therefore not supported by the parallel writer.
+*/
+// clang-format on
+class RNTupleParallelWriter {
+private:
+   /// Protects fSink and fFillContexts; locked by the fill contexts when they commit a cluster
+   std::mutex fMutex;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// The model from which the fill contexts' models are cloned; needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   /// Used to detect fill contexts that outlive the parallel writer
+   std::vector<std::weak_ptr<RNTupleFillContext>> fFillContexts;
+
+public:
+   static std::unique_ptr<RNTupleParallelWriter> Recreate(std::unique_ptr<RNTupleModel> model,
+                                                          std::string_view ntupleName,
+                                                          std::string_view storage,
+                                                          const RNTupleWriteOptions &options = RNTupleWriteOptions());
+   RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+   RNTupleParallelWriter(const RNTupleParallelWriter&) = delete;
+   RNTupleParallelWriter& operator=(const RNTupleParallelWriter&) = delete;
+   ~RNTupleParallelWriter();
+
+   /// Creates a new fill context that can be used to fill entries from one thread. Thread-safe.
+   std::shared_ptr<RNTupleFillContext> CreateFillContext();
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::RCollectionNTuple
@@ -170,18 +170,31 @@ public:
       /// The usual format for ROOT compression settings (see Compression.h).
       /// The pages of a particular column in a particular cluster are all compressed with the same settings.
       std::int64_t fCompressionSettings = 0;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      /// For numerical columns, the smallest and the largest value of the column in the cluster, converted to
+      /// double.  The range is conservative, i.e. it can be wider than the actual values but it never excludes any.
+      /// NaN values are not taken into account.  Not set for non-numerical columns and for empty column ranges.
+      bool fHasValueRange = false;
+      double fMinValue = 0.0;
+      double fMaxValue = 0.0;
 
       bool operator==(const RColumnRange &other) const {
          return fColumnId == other.fColumnId && fFirstElementIndex == other.fFirstElementIndex &&
-                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings;
+                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings &&
+                fHasValueRange == other.fHasValueRange && fMinValue == other.fMinValue &&
+                fMaxValue == other.fMaxValue;
       }
 
       bool Contains(NTupleSize_t index) const {
          return (fFirstElementIndex <= index && (fFirstElementIndex + fNElements) > index);
       }
+
+      /// Returns false only if the value range is known and none of the values in [min, max] can be part of the
+      /// column range.  Used to skip clusters that cannot match a range predicate.
+      bool MayContainValues(double min, double max) const {
+         if (!fHasValueRange)
+            return true;
+         return !(fMaxValue < min || fMinValue > max);
+      }
    };
 
    /// Records the parition of data into pages for a particular column in a particular cluster
@@ -228,8 +241,9 @@ private:
 
 public:
    /// In order to handle changes to the serialization routine in future ntuple versions
-   static constexpr std::uint16_t kFrameVersionCurrent = 0;
-   static constexpr std::uint16_t kFrameVersionMin = 0;
+   /// Version 1 adds the value ranges to the column ranges
+   static constexpr std::uint16_t kFrameVersionCurrent = 1;
+   static constexpr std::uint16_t kFrameVersionMin = 1;
 
    RClusterDescriptor() = default;
    RClusterDescriptor(const RClusterDescriptor &other) = delete;
@@ -357,6 +371,13 @@ public:
    DescriptorId_t FindFieldId(std::string_view fieldName) const;
    DescriptorId_t FindColumnId(DescriptorId_t fieldId, std::uint32_t columnIndex) const;
    DescriptorId_t FindClusterId(DescriptorId_t columnId, NTupleSize_t index) const;
+   /// The cluster that contains the entries immediately following the given cluster, or kInvalidDescriptorId
+   DescriptorId_t FindNextClusterId(DescriptorId_t clusterId) const;
+   /// The cluster that contains the entries immediately preceding the given cluster, or kInvalidDescriptorId
+   DescriptorId_t FindPrevClusterId(DescriptorId_t clusterId) const;
+   /// The clusters in which the given column may have values in [min, max] according to the clusters' value ranges,
+   /// ordered by their first entry.  Clusters without a value range for the column are always part of the result.
+   std::vector<DescriptorId_t> FindClusterIdsInValueRange(DescriptorId_t columnId, double min, double max) const;
 
    /// Re-create the C++ model from the stored meta-data
    std::unique_ptr<RNTupleModel> GenerateModel() const;
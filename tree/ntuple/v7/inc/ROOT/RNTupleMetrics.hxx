@@ -20,8 +20,10 @@
 
 #include <TError.h>
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <ctime> // for CPU time measurement with clock()
 #include <memory>
@@ -52,6 +54,8 @@ private:
    std::string fUnit;
    std::string fDescription;
    bool fIsEnabled = false;
+   /// Detailed counters, such as per-column counters, are only exported as JSON and left out of Print()
+   bool fIsDetailed = false;
 
 public:
    RNTuplePerfCounter(const std::string &name, const std::string &unit, const std::string &desc)
@@ -59,11 +63,15 @@ public:
    virtual ~RNTuplePerfCounter();
    void Enable() { fIsEnabled = true; }
    bool IsEnabled() const { return fIsEnabled; }
+   void SetDetailed() { fIsDetailed = true; }
+   bool IsDetailed() const { return fIsDetailed; }
    std::string GetName() const { return fName; }
    std::string GetDescription() const { return fDescription; }
    std::string GetUnit() const { return fUnit; }
 
    virtual std::string ValueToString() const = 0;
+   /// By default, the value is written as a JSON number; structured counters write a JSON object instead
+   virtual std::string ValueToJSON() const { return ValueToString(); }
    std::string ToString() const;
 };
 
@@ -224,6 +232,107 @@ using RNTuplePlainTimer = RNTupleTimer<RNTuplePlainCounter, RNTupleTickCounter<R
 using RNTupleAtomicTimer = RNTupleTimer<RNTupleAtomicCounter, RNTupleTickCounter<RNTupleAtomicCounter>>;
 
 
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleLatencyHistogram
+\ingroup NTuple
+\brief A thread-safe histogram of latencies in nanoseconds with logarithmic bins
+
+Bin i counts the latencies in the interval [2^i, 2^(i+1)) ns; the first bin also takes latencies below 1 ns and the
+last bin takes all latencies above its lower edge. Besides the bins, the number of entries and the sum of all
+latencies are recorded, so that the mean latency can be derived. Like the atomic counter, the histogram ignores
+fills while it is disabled.
+*/
+// clang-format on
+class RNTupleLatencyHistogram : public RNTuplePerfCounter {
+public:
+   /// The last bin starts at 2^(kNBins - 1) ns, i.e. at approximately 1 s
+   static constexpr std::size_t kNBins = 31;
+
+private:
+   std::array<std::atomic<std::int64_t>, kNBins> fBins;
+   std::atomic<std::int64_t> fCount{0};
+   std::atomic<std::int64_t> fSum{0};
+
+public:
+   RNTupleLatencyHistogram(const std::string &name, const std::string &unit, const std::string &desc)
+      : RNTuplePerfCounter(name, unit, desc)
+   {
+      R__ASSERT(unit == "ns");
+      for (auto &b : fBins)
+         b.store(0);
+   }
+
+   /// Returns the bin that takes the given latency
+   static std::size_t FindBin(std::int64_t latencyNs) {
+      std::size_t bin = 0;
+      for (auto l = latencyNs; (l > 1) && (bin < kNBins - 1); l >>= 1)
+         ++bin;
+      return bin;
+   }
+   /// The upper edge of the given bin in ns; the last bin is unbounded and returns -1
+   static std::int64_t GetBinUpperEdge(std::size_t bin) {
+      return (bin < kNBins - 1) ? (std::int64_t(1) << (bin + 1)) : -1;
+   }
+
+   R__ALWAYS_INLINE
+   void Fill(std::int64_t latencyNs) {
+      if (R__unlikely(IsEnabled())) {
+         fBins[FindBin(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+         fCount.fetch_add(1, std::memory_order_relaxed);
+         fSum.fetch_add(latencyNs, std::memory_order_relaxed);
+      }
+   }
+
+   std::int64_t GetBinContent(std::size_t bin) const { return fBins[bin].load(); }
+   std::int64_t GetCount() const { return fCount.load(); }
+   std::int64_t GetSum() const { return fSum.load(); }
+   /// Returns an upper bound of the given quantile in ns, taken from the upper edge of the bin that contains it.
+   /// Returns 0 for an empty histogram and -1 if the quantile falls into the unbounded last bin.
+   std::int64_t GetQuantileUpperBound(double quantile) const;
+
+   std::string ValueToString() const final;
+   std::string ValueToJSON() const final;
+};
+
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleLatencyTimer
+\ingroup NTuple
+\brief Record the wall time between construction and destruction in a latency histogram
+
+Only timers constructed while the histogram is enabled record a latency.
+*/
+// clang-format on
+class RNTupleLatencyTimer {
+private:
+   using Clock_t = std::chrono::steady_clock;
+
+   RNTupleLatencyHistogram &fHisto;
+   /// Whether the histogram was enabled at construction, i.e. whether fStartTime is set
+   bool fIsActive;
+   Clock_t::time_point fStartTime;
+
+public:
+   explicit RNTupleLatencyTimer(RNTupleLatencyHistogram &histo) : fHisto(histo), fIsActive(histo.IsEnabled())
+   {
+      if (!fIsActive)
+         return;
+      fStartTime = Clock_t::now();
+   }
+
+   ~RNTupleLatencyTimer() {
+      if (!fIsActive)
+         return;
+      fHisto.Fill(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - fStartTime).count());
+   }
+
+   RNTupleLatencyTimer(const RNTupleLatencyTimer &other) = delete;
+   RNTupleLatencyTimer &operator =(const RNTupleLatencyTimer &other) = delete;
+};
+
+
 // clang-format off
 /**
 \class ROOT::Experimental::Detail::RNTupleMetrics
@@ -231,6 +340,8 @@ using RNTupleAtomicTimer = RNTupleTimer<RNTupleAtomicCounter, RNTupleTickCounter
 \brief A collection of Counter objects with a name, a unit, and a description.
 
 The class owns the counters; on registration of a new
+counter, the counter is enabled if the metrics object is already enabled.  The counters of the metrics object and of
+the observed metrics can be printed in a human-readable form or exported as JSON.
 */
 // clang-format on
 class RNTupleMetrics {
@@ -244,6 +355,8 @@ private:
    bool fIsEnabled = false;
 
    bool Contains(const std::string &name) const;
+   /// Writes the counters as comma-separated JSON members, keyed by their fully qualified name
+   void PrintJSONMembers(std::ostream &output, const std::string &prefix, bool &isFirst) const;
 
 public:
    explicit RNTupleMetrics(const std::string &name) : fName(name) {}
@@ -257,13 +370,19 @@ public:
       R__ASSERT(!Contains(name));
       auto counter = std::make_unique<std::remove_pointer_t<CounterPtrT>>(name, unit, desc);
       auto ptrCounter = counter.get();
+      if (fIsEnabled)
+         ptrCounter->Enable();
       fCounters.emplace_back(std::move(counter));
       return ptrCounter;
    }
 
    void ObserveMetrics(RNTupleMetrics &observee);
 
+   /// Prints the counters in a human-readable form, one per line.  Detailed counters are left out.
    void Print(std::ostream &output, const std::string &prefix = "") const;
+   /// Writes a single JSON object that maps the fully qualified counter names, e.g. "RNTupleReader.RPageSourceFile.
+   /// szReadPayload", to objects with the counter's unit, description, and value
+   void PrintJSON(std::ostream &output) const;
    void Enable();
    bool IsEnabled() const { return fIsEnabled; }
 };
@@ -18,6 +18,8 @@
 
 #include <Compression.h>
 
+#include <cstddef>
+
 namespace ROOT {
 namespace Experimental {
 
@@ -46,6 +48,9 @@ All page sink classes need to support the common options.
 class RNTupleWriteOptions {
   int fCompression{RCompressionSetting::EDefaults::kUseAnalysis};
   ENTupleContainerFormat fContainerFormat{ENTupleContainerFormat::kTFile};
+  bool fUseBufferedWrite{true};
+  bool fUseSplitEncoding{false};
+  bool fUseValueRanges{false};
 
 public:
   RNTupleWriteOptions() = default;
@@ -58,6 +63,24 @@ public:
 
   ENTupleContainerFormat GetContainerFormat() const { return fContainerFormat; }
   void SetContainerFormat(ENTupleContainerFormat val) { fContainerFormat = val; }
+
+  /// With buffered writing, the pages of a cluster are held back until the cluster is committed.  They are then
+  /// compressed in parallel (if implicit multi-threading is enabled) and written to storage in one go.
+  /// Otherwise, every page is compressed and written as soon as it is committed.
+  bool GetUseBufferedWrite() const { return fUseBufferedWrite; }
+  void SetUseBufferedWrite(bool val) { fUseBufferedWrite = val; }
+
+  /// With split encoding, columns of floating point numbers, integers, and collection indexes are written in their
+  /// split variants (e.g. EColumnType::kSplitReal32 instead of EColumnType::kReal32).  Split pages compress
+  /// better but they cannot be memory mapped from uncompressed storage.  Off by default.
+  bool GetUseSplitEncoding() const { return fUseSplitEncoding; }
+  void SetUseSplitEncoding(bool val) { fUseSplitEncoding = val; }
+
+  /// With value ranges, the smallest and largest value of every numerical column are recorded for every cluster, so
+  /// that readers can skip clusters (see RNTupleDescriptor::FindClusterIdsInValueRange()).  Recording them takes an
+  /// extra pass over every committed page.  Off by default.
+  bool GetUseValueRanges() const { return fUseValueRanges; }
+  void SetUseValueRanges(bool val) { fUseValueRanges = val; }
 };
 
 
@@ -71,6 +94,36 @@ All page source classes need to support the common options.
 */
 // clang-format on
 class RNTupleReadOptions {
+public:
+  enum EClusterCache {
+    kOff,
+    kOn,
+    kDefault = kOn,
+  };
+
+private:
+  EClusterCache fClusterCache = EClusterCache::kDefault;
+  unsigned int fClusterBunchSize = 4;
+  bool fUseMemoryMap = false;
+  std::size_t fPagePoolBudget = 256 * 1024 * 1024;
+
+public:
+  /// With the cluster cache turned on, whole clusters are read ahead of time in a background thread and their pages
+  /// are unzipped in parallel.  With the cluster cache turned off, every page is read and unzipped on demand.
+  EClusterCache GetClusterCache() const { return fClusterCache; }
+  void SetClusterCache(EClusterCache val) { fClusterCache = val; }
+  /// The number of clusters, including the currently processed one, that the cluster cache keeps in flight
+  unsigned int GetClusterBunchSize() const { return fClusterBunchSize; }
+  void SetClusterBunchSize(unsigned int val) { fClusterBunchSize = val; }
+  /// If the storage supports it, map the data into memory. Uncompressed pages of columns whose in-memory and
+  /// on-disk representation are identical are then used in place, without copying them into a page buffer.
+  bool GetUseMemoryMap() const { return fUseMemoryMap; }
+  void SetUseMemoryMap(bool val) { fUseMemoryMap = val; }
+  /// The number of bytes of unzipped pages beyond which the page pool frees pages that are not in use, least recently
+  /// used first.  Pages in use are never freed, so the budget can be exceeded temporarily.  Clones of a page source
+  /// share the page pool and its budget.
+  std::size_t GetPagePoolBudget() const { return fPagePoolBudget; }
+  void SetPagePoolBudget(std::size_t val) { fPagePoolBudget = val; }
 };
 
 } // namespace Experimental
@@ -18,8 +18,12 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -134,6 +138,10 @@ accessed by index. For top level fields, the index refers to the entry number. F
 nested collections have global index numbers that are derived from their parent indexes.
 
 Fields of simple types with a Map() method will use that and thus expose zero-copy access.
+
+For columnar processing, ReadBulk() fills a caller-provided buffer with the values of a whole range of indexes in one
+call.  For fields of simple types, the values are copied page by page; MapV() gives direct access to the values of
+the page that contains a given index.
 */
 // clang-format on
 template <typename T>
@@ -192,6 +200,63 @@ public:
       fField.Read(clusterIndex, &fValue);
       return *fValue.Get<T>();
    }
+
+   /// Returns a pointer to the value at globalIndex; nItems is set to the number of consecutive values, starting with
+   /// the requested one, that are available from the pointer.  The pointer is invalidated by the next read access.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, const C*>
+   MapV(NTupleSize_t globalIndex, NTupleSize_t &nItems) { return fField.MapV(globalIndex, nItems); }
+
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, const C*>
+   MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) { return fField.MapV(clusterIndex, nItems); }
+
+   /// Reads the values [globalIndex, globalIndex + values.size()) into values
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value && std::is_same<C, T>::value>
+   ReadBulk(NTupleSize_t globalIndex, std::span<T> values) {
+      std::size_t nRead = 0;
+      while (nRead < values.size()) {
+         NTupleSize_t nItems;
+         const T *src = fField.MapV(globalIndex + nRead, nItems);
+         const auto nBatch = std::min<std::size_t>(nItems, values.size() - nRead);
+         std::memcpy(values.data() + nRead, src, nBatch * sizeof(T));
+         nRead += nBatch;
+      }
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<!Internal::IsMappable<FieldT>::value && std::is_same<C, T>::value>
+   ReadBulk(NTupleSize_t globalIndex, std::span<T> values) {
+      for (std::size_t i = 0; i < values.size(); ++i) {
+         fField.Read(globalIndex + i, &fValue);
+         values[i] = *fValue.Get<T>();
+      }
+   }
+
+   /// Reads the values [clusterIndex, clusterIndex + values.size()), which need to be part of the same cluster
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value && std::is_same<C, T>::value>
+   ReadBulk(const RClusterIndex &clusterIndex, std::span<T> values) {
+      std::size_t nRead = 0;
+      while (nRead < values.size()) {
+         NTupleSize_t nItems;
+         const T *src =
+            fField.MapV(RClusterIndex(clusterIndex.GetClusterId(), clusterIndex.GetIndex() + nRead), nItems);
+         const auto nBatch = std::min<std::size_t>(nItems, values.size() - nRead);
+         std::memcpy(values.data() + nRead, src, nBatch * sizeof(T));
+         nRead += nBatch;
+      }
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<!Internal::IsMappable<FieldT>::value && std::is_same<C, T>::value>
+   ReadBulk(const RClusterIndex &clusterIndex, std::span<T> values) {
+      for (std::size_t i = 0; i < values.size(); ++i) {
+         fField.Read(RClusterIndex(clusterIndex.GetClusterId(), clusterIndex.GetIndex() + i), &fValue);
+         values[i] = *fValue.Get<T>();
+      }
+   }
 };
 
 
@@ -247,6 +312,29 @@ public:
       return RNTupleViewCollection(fieldId, fSource);
    }
 
+   /// Reads the collection sizes of the entries [globalIndex, globalIndex + sizes.size()) into sizes.  The items of
+   /// consecutive entries are stored consecutively, so that the items of the entire range can be read in bulk, too,
+   /// starting from the first item of the first entry.
+   void ReadBulkSizes(NTupleSize_t globalIndex, std::span<ClusterSize_t> sizes) {
+      std::size_t nRead = 0;
+      while (nRead < sizes.size()) {
+         // Maps the page of the first requested offset and provides the end offset of the preceding entry, which is
+         // zero at the beginning of a cluster
+         ClusterSize_t size;
+         RClusterIndex collectionStart;
+         fField.GetCollectionInfo(globalIndex + nRead, &collectionStart, &size);
+         NTupleSize_t nItems;
+         const ClusterSize_t *offsets = fField.MapV(globalIndex + nRead, nItems);
+         const auto nBatch = std::min<std::size_t>(nItems, sizes.size() - nRead);
+         auto prevOffset = collectionStart.GetIndex();
+         for (std::size_t i = 0; i < nBatch; ++i) {
+            sizes[nRead + i] = offsets[i] - prevOffset;
+            prevOffset = offsets[i];
+         }
+         nRead += nBatch;
+      }
+   }
+
    ClusterSize_t operator()(NTupleSize_t globalIndex) {
       ClusterSize_t size;
       RClusterIndex collectionStart;
@@ -118,6 +118,48 @@ public:
       return nbytes;
    }
 
+   /// Returns the size of the compressed data block. The data is written into the target buffer, which must be
+   /// at least nbytes large. Uncompressible data is copied verbatim, in which case the return value is nbytes.
+   /// As it does not use the zip buffer, it can be called concurrently, e.g. to compress pages in parallel.
+   static size_t Zip(const void *from, size_t nbytes, int compression, void *to) {
+      R__ASSERT(from != nullptr);
+      R__ASSERT(to != nullptr);
+
+      auto cxLevel = compression % 100;
+      if ((cxLevel == 0) || (nbytes == 0)) {
+         memcpy(to, from, nbytes);
+         return nbytes;
+      }
+
+      auto cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compression / 100);
+      unsigned int nZipBlocks = 1 + (nbytes - 1) / kMAXZIPBUF;
+      char *source = const_cast<char *>(static_cast<const char *>(from));
+      char *target = static_cast<char *>(to);
+      int szRemaining = nbytes;
+      size_t szZipData = 0;
+      for (unsigned int i = 0; i < nZipBlocks; ++i) {
+         int szSource = std::min(static_cast<int>(kMAXZIPBUF), szRemaining);
+         // The compressed block must be smaller than the source block, so there is always enough room in the target
+         int szTarget = szSource;
+         int szOutBlock = 0;
+         R__zipMultipleAlgorithm(cxLevel, &szSource, source, &szTarget, target, &szOutBlock, cxAlgorithm);
+         R__ASSERT(szOutBlock >= 0);
+         if ((szOutBlock == 0) || (szOutBlock >= szSource)) {
+            // Uncompressible block, we have to store the entire input data uncompressed
+            memcpy(to, from, nbytes);
+            return nbytes;
+         }
+
+         szZipData += szOutBlock;
+         target += szOutBlock;
+         source += szSource;
+         szRemaining -= szSource;
+      }
+      R__ASSERT(szRemaining == 0);
+      R__ASSERT(szZipData < nbytes);
+      return szZipData;
+   }
+
    const void *GetZipBuffer() { return fZipBuffer->data(); }
 };
 
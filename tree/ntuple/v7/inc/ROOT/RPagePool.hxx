@@ -20,8 +20,15 @@
 #include <ROOT/RPageAllocator.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
-#include <vector>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 namespace ROOT {
 namespace Experimental {
@@ -37,40 +44,107 @@ namespace Detail {
 The page pool provides memory tracking for data written into an ntuple or read from an ntuple. Adding and removing
 pages is thread-safe. The page pool does not allocate the memory -- allocation and deallocation is performed by the
 page storage, which might do it in a way optimized to the backing store (e.g., mmap()).
-Multiple page caches can coexist.
+Multiple page caches can coexist, and a single page cache can be shared by several page sources of the same ntuple.
 
-TODO(jblomer): it should be possible to register pages and to find them by column and index; this would
-facilitate pre-filling a cache, e.g. by read-ahead.
+Pages are reference counted.  Pages that are in use (pinned) are never freed.  Pages that are not in use, i.e. pages
+that have been returned or preloaded pages that have not been requested yet, stay in the pool as long as the memory
+taken by all the pages is within the memory budget.  Beyond the budget, the least recently used unpinned pages are
+freed.
+
+Page sources sharing a pool (e.g. clones) can preload the same page. The page then remains preloaded until all of them
+have released its cluster, see EvictPreloadedPages().
+
+In order to reduce lock contention, the pool is partitioned into shards by column id.  Every shard has its own lock
+and its own LRU list.  Within a shard, pages are indexed by their first element index, so that lookups are
+logarithmic in the number of pages of a column.
 */
 // clang-format on
 class RPagePool {
 private:
-   /// TODO(jblomer): should be an efficient index structure that allows
-   ///   - random insert
-   ///   - random delete
-   ///   - searching by page
-   ///   - searching by tree index
-   std::vector<RPage> fPages;
-   std::vector<std::uint32_t> fReferences;
-   std::vector<RPageDeleter> fDeleters;
+   static constexpr std::size_t kNShards = 16;
+
+   /// Pages are identified by their column id and their first global element index
+   using RKey = std::pair<ColumnId_t, NTupleSize_t>;
+
+   struct REntry {
+      RPage fPage;
+      RPageDeleter fDeleter;
+      /// The number of GetPage()/RegisterPage() calls not yet matched by a ReturnPage() call
+      std::uint32_t fNPins = 0;
+      /// The number of PreloadPage() calls, i.e. of page sources that unzipped the page ahead of time from a cluster
+      /// of their cluster pool, not yet matched by an EvictPreloadedPages() call for the page's cluster
+      std::uint32_t fNPreloads = 0;
+      /// Position in the shard's LRU list; only valid for unpinned pages
+      std::list<RKey>::iterator fLruPosition;
+   };
+
+   /// The pages of a single column
+   struct RColumnPages {
+      /// Pages ordered by their first global element index
+      std::map<NTupleSize_t, REntry> fByGlobalIndex;
+      /// Maps the cluster id and the cluster-local first element index of a page to its first global element index
+      std::map<std::pair<DescriptorId_t, ClusterSize_t::ValueType>, NTupleSize_t> fByClusterIndex;
+   };
+
+   struct RShard {
+      std::mutex fLock;
+      std::unordered_map<ColumnId_t, RColumnPages> fColumns;
+      /// The unpinned pages of the shard, the most recently used one first
+      std::list<RKey> fLru;
+   };
+
+   std::array<RShard, kNShards> fShards;
+   /// Upper limit for fMemoryUsage beyond which unpinned pages are freed
+   const std::size_t fMemoryBudget;
+   /// The sum of the page capacities of all the pages in the pool
+   std::atomic<std::size_t> fMemoryUsage{0};
+
+   static std::size_t GetShardIndex(ColumnId_t columnId) { return static_cast<std::size_t>(columnId) % kNShards; }
+   /// Adds a page with the given initial reference counter to the pool. If an equivalent page is already in the
+   /// pool, e.g. because another page source sharing the pool has read it, the given page is freed and the existing
+   /// page is used instead.
+   RPage AddPage(const RPage &page, const RPageDeleter &deleter, std::uint32_t nPins);
+   void Pin(RShard &shard, REntry &entry);
+   void Unpin(RShard &shard, REntry &entry, const RKey &key);
+   /// Frees an unpinned page and removes it from the shard.  Needs to be called with the shard lock held.
+   void Remove(RShard &shard, const RKey &key);
+   /// Removes unpinned pages from the given shard, least recently used first, until the memory budget is met.
+   /// Needs to be called with the shard lock held.
+   void EvictFromShard(RShard &shard);
+   /// Evicts pages from all the shards, starting with the given one, if the memory budget is exceeded
+   void Evict(std::size_t firstShardIndex);
 
 public:
-   RPagePool() = default;
+   explicit RPagePool(std::size_t memoryBudget) : fMemoryBudget(memoryBudget) {}
    RPagePool(const RPagePool&) = delete;
    RPagePool& operator =(const RPagePool&) = delete;
-   ~RPagePool() = default;
+   /// Frees the pages that are still registered, in particular preloaded pages that have never been requested
+   ~RPagePool();
 
    /// Adds a new page to the pool together with the function to free its space. Upon registration,
    /// the page pool takes ownership of the page's memory. The new page has its reference counter set to 1.
-   void RegisterPage(const RPage &page, const RPageDeleter &deleter);
+   /// Returns the page that the caller should use, which is an already registered page if the pool contains an
+   /// equivalent one.
+   RPage RegisterPage(const RPage &page, const RPageDeleter &deleter);
+   /// Like RegisterPage() but the reference counter is initialized to 0, i.e. the page is cached for a future
+   /// GetPage() call.  Used to fill the pool with pages that are unzipped ahead of time.
+   void PreloadPage(const RPage &page, const RPageDeleter &deleter);
    /// Tries to find the page corresponding to column and index in the cache. If the page is found, its reference
    /// counter is increased
    RPage GetPage(ColumnId_t columnId, NTupleSize_t globalIndex);
    RPage GetPage(ColumnId_t columnId, const RClusterIndex &clusterIndex);
    /// Give back a page to the pool and decrease the reference counter. There must not be any pointers anymore into
-   /// this page. If the reference counter drops to zero, the page pool might decide to call the deleter given in
-   /// during registration.
+   /// this page. If the reference counter drops to zero, the page remains cached until it is evicted according to
+   /// the memory budget.
    void ReturnPage(const RPage &page);
+   /// Called when the cluster pool of a page source releases the given cluster: the pages that it preloaded are not
+   /// requested anymore by the reader that moved on to the next clusters.  The preloaded pages of the cluster that
+   /// no other page source sharing the pool still holds preloaded are freed if unpinned, or otherwise left to the
+   /// LRU eviction like any other page.
+   void EvictPreloadedPages(DescriptorId_t clusterId);
+
+   std::size_t GetMemoryBudget() const { return fMemoryBudget; }
+   std::size_t GetMemoryUsage() const { return fMemoryUsage; }
 };
 
 } // namespace Detail
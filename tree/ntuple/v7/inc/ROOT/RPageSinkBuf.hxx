@@ -0,0 +1,90 @@
+/// \file ROOT/RPageSinkBuf.hxx
+/// \ingroup NTuple ROOT7
+/// \author agent <agent@local>
+/// \date 2020-04-06
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSinkBuf
+#define ROOT7_RPageSinkBuf
+
+#include <ROOT/RNTupleMetrics.hxx>
+#include <ROOT/RPageStorage.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageSinkBuf
+\ingroup NTuple
+\brief Page sink that buffers the sealed pages of a cluster and forwards them to an inner sink
+
+The buffered sink packs and compresses the committed pages in the calling thread and keeps the resulting sealed
+pages in memory. On committing a cluster, the sealed pages and the cluster are handed over to the inner sink in one
+go, while holding the given lock. Several buffered sinks can thus be filled concurrently from different threads and
+share a single inner sink; every buffered sink contributes whole clusters to the inner sink.
+
+The buffered sink needs to be created from a model that yields the same column ids as the inner sink's model,
+e.g. a clone of it.
+*/
+// clang-format on
+class RPageSinkBuf : public RPageSink {
+private:
+   /// A packed and compressed page of the currently open cluster
+   struct RBufferedPage {
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      std::unique_ptr<unsigned char[]> fBuffer;
+      std::size_t fSize = 0;
+      std::uint32_t fNElements = 0;
+   };
+
+   RNTupleMetrics fMetrics;
+   /// The sink that eventually writes the sealed pages; shared with other buffered sinks
+   RPageSink &fInnerSink;
+   /// Serializes access to the inner sink
+   std::mutex &fInnerLock;
+   /// The sealed pages of the currently open cluster in the order of their commit
+   std::vector<RBufferedPage> fBufferedPages;
+
+protected:
+   void CreateImpl(const RNTupleModel &model) final;
+   RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
+   RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
+   void CommitDatasetImpl() final;
+
+public:
+   static constexpr std::size_t kDefaultElementsPerPage = 10000;
+
+   RPageSinkBuf(RPageSink &innerSink, std::mutex &innerLock);
+   RPageSinkBuf(const RPageSinkBuf &other) = delete;
+   RPageSinkBuf &operator =(const RPageSinkBuf &other) = delete;
+   virtual ~RPageSinkBuf();
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) final;
+   void ReleasePage(RPage &page) final;
+
+   RNTupleMetrics &GetMetrics() final { return fMetrics; }
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -16,6 +16,7 @@
 #ifndef ROOT7_RPageStorage
 #define ROOT7_RPageStorage
 
+#include <ROOT/RCluster.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RNTupleUtil.hxx>
@@ -25,7 +26,11 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <unordered_set>
 
 namespace ROOT {
 namespace Experimental {
@@ -56,8 +61,24 @@ an ntuple.  Concrete implementations can use a TFile, a raw file, an object stor
 */
 // clang-format on
 class RPageStorage {
+public:
+   /// The interface of a task scheduler to schedule page (de)compression tasks
+   class RTaskScheduler {
+   public:
+      virtual ~RTaskScheduler() = default;
+      /// Start a new set of tasks
+      virtual void Reset() = 0;
+      /// Take a callable that represents a task
+      virtual void AddTask(const std::function<void(void)> &taskFunc) = 0;
+      /// Blocks until all scheduled tasks finished
+      virtual void Wait() = 0;
+   };
+
 protected:
    std::string fNTupleName;
+   /// For the time being, we don't own the task scheduler; if it is set, page (de)compression tasks are dispatched
+   /// to the scheduler, otherwise they are run sequentially.
+   RTaskScheduler *fTaskScheduler = nullptr;
 
 public:
    explicit RPageStorage(std::string_view name);
@@ -86,6 +107,9 @@ public:
 
    /// Page storage implementations usually have their own metrics
    virtual RNTupleMetrics &GetMetrics() = 0;
+
+   void SetTaskScheduler(RTaskScheduler *taskScheduler) { fTaskScheduler = taskScheduler; }
+   const std::string &GetNTupleName() const { return fNTupleName; }
 };
 
 // clang-format off
@@ -100,6 +124,19 @@ up to the given entry number are committed.
 */
 // clang-format on
 class RPageSink : public RPageStorage {
+public:
+   /// A page that is already packed and compressed into its on-disk representation, e.g. by another page sink.
+   /// Sealed pages are written as is; the buffer is not owned and needs to stay valid during the commit call.
+   struct RSealedPage {
+      const void *fBuffer = nullptr;
+      /// The number of bytes of the packed and compressed page
+      std::size_t fSize = 0;
+      std::uint32_t fNElements = 0;
+
+      RSealedPage() = default;
+      RSealedPage(const void *b, std::size_t s, std::uint32_t n) : fBuffer(b), fSize(s), fNElements(n) {}
+   };
+
 protected:
    const RNTupleWriteOptions fOptions;
 
@@ -117,6 +154,8 @@ protected:
 
    virtual void CreateImpl(const RNTupleModel &model) = 0;
    virtual RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) = 0;
+   virtual RClusterDescriptor::RLocator
+   CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) = 0;
    virtual RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) = 0;
    virtual void CommitDatasetImpl() = 0;
 
@@ -127,6 +166,7 @@ public:
    static std::unique_ptr<RPageSink> Create(std::string_view ntupleName, std::string_view location,
                                             const RNTupleWriteOptions &options = RNTupleWriteOptions());
    EPageStorageType GetType() final { return EPageStorageType::kSink; }
+   const RNTupleWriteOptions &GetWriteOptions() const { return fOptions; }
 
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
 
@@ -136,10 +176,18 @@ public:
    void Create(RNTupleModel &model);
    /// Write a page to the storage. The column must have been added before.
    void CommitPage(ColumnHandle_t columnHandle, const RPage &page);
+   /// Write a preprocessed page to storage. The column must have been added before.
+   void CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage);
+   /// Extends the value range of the given column in the currently open cluster such that it includes [min, max].
+   /// Called for every committed page if value ranges are enabled in the write options; sealed pages need to provide
+   /// their value range through this method.
+   void UpdateValueRange(DescriptorId_t columnId, double min, double max);
    /// Finalize the current cluster and create a new one for the following data.
    void CommitCluster(NTupleSize_t nEntries);
    /// Finalize the current cluster and the entrire data set.
    void CommitDataset() { CommitDatasetImpl(); }
+   /// The number of entries in the committed clusters
+   NTupleSize_t GetNEntries() const { return fPrevClusterNEntries; }
 
    /// Get a new, empty page for the given column that can be filled with up to nElements.  If nElements is zero,
    /// the page sink picks an appropriate size.
@@ -157,9 +205,15 @@ mapped into memory. The page source also gives access to the ntuple's meta-data.
 */
 // clang-format on
 class RPageSource : public RPageStorage {
+public:
+   /// Derived from the model (fields) that are actually being requested at a given point in time
+   using ColumnSet_t = RCluster::ColumnSet_t;
+
 protected:
    const RNTupleReadOptions fOptions;
    RNTupleDescriptor fDescriptor;
+   /// The active columns are implicitly defined by the model fields or views
+   ColumnSet_t fActiveColumns;
 
    virtual RNTupleDescriptor AttachImpl() = 0;
 
@@ -186,6 +240,20 @@ public:
    virtual RPage PopulatePage(ColumnHandle_t columnHandle, NTupleSize_t globalIndex) = 0;
    /// Another version of PopulatePage that allows to specify cluster-relative indexes
    virtual RPage PopulatePage(ColumnHandle_t columnHandle, const RClusterIndex &clusterIndex) = 0;
+
+   /// Populates all the pages of the given cluster id and columns; it is possible that some columns do not
+   /// contain any pages.  The pages are kept packed and compressed; this method is called by the cluster pool,
+   /// possibly from a background thread, and it must be thread-safe with respect to the page requests of the reader.
+   virtual std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) = 0;
+   /// Parallel decompression and unpacking of the pages in the given cluster. The unzipped pages are supposed
+   /// to be preloaded in a page pool attached to the source. The method is triggered by the cluster pool's
+   /// unzip thread. It is an optional optimization, the method can safely do nothing. In particular, the
+   /// actual implementation will only run if a task scheduler is set. In practice, a task scheduler is set
+   /// if implicit multi-threading is turned on.
+   virtual void UnzipCluster(RCluster *cluster);
+   /// Called by the cluster pool when the given cluster leaves its window.  Page sources that preload the pages
+   /// of the cluster in UnzipCluster() free the preloaded pages that have not been used.
+   virtual void ReleaseCluster(DescriptorId_t clusterId);
 };
 
 } // namespace Detail
@@ -16,6 +16,7 @@
 #ifndef ROOT7_RPageStorageFile
 #define ROOT7_RPageStorageFile
 
+#include <ROOT/RCluster.hxx>
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RMiniFile.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
@@ -23,9 +24,11 @@
 #include <ROOT/RStringView.hxx>
 
 #include <array>
+#include <cstddef>
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TFile;
 
@@ -38,6 +41,8 @@ class RRawFile;
 namespace Experimental {
 namespace Detail {
 
+class RClusterPool;
+class RColumnElementBase;
 class RPageAllocatorHeap;
 class RPagePool;
 
@@ -48,12 +53,16 @@ class RPagePool;
 \ingroup NTuple
 \brief Storage provider that write ntuple pages into a file
 
-The written file can be either in ROOT format or in RNTuple bare format.
+The written file can be either in ROOT format or in RNTuple bare format. By default, the pages of a cluster are
+buffered and, on committing the cluster, compressed in parallel and written sequentially (see
+RNTupleWriteOptions::SetUseBufferedWrite()).
 */
 // clang-format on
 class RPageSinkFile : public RPageSink {
 public:
    static constexpr std::size_t kDefaultElementsPerPage = 10000;
+   /// In buffered write mode, pages are concatenated into blobs of up to this size
+   static constexpr std::size_t kMaxBlobSize = 256 * 1024 * 1024;
 
 private:
    RNTupleMetrics fMetrics;
@@ -67,9 +76,29 @@ private:
    /// Helper for zipping keys and header / footer; comprises a 16MB zip buffer
    RNTupleCompressor fCompressor;
 
+   /// In buffered write mode, a committed page of the currently open cluster that is not yet written
+   struct RBufferedPage {
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      /// The index of the page in the page range of the column in the open cluster
+      std::size_t fPageIdx = 0;
+      /// A copy of the page in its packed on-disk format; nullptr for sealed pages, which are already compressed
+      std::unique_ptr<unsigned char[]> fPackedBuffer;
+      std::size_t fPackedBytes = 0;
+      /// The compressed page, or nullptr if the packed buffer is written as is
+      std::unique_ptr<unsigned char[]> fZippedBuffer;
+      std::size_t fZippedBytes = 0;
+   };
+   /// The pages of the currently open cluster in buffered write mode
+   std::vector<RBufferedPage> fBufferedPages;
+
+   /// Compresses the buffered pages, in parallel if a task scheduler is set, and writes them in large blobs.
+   /// The page locators of the open page ranges are updated accordingly.
+   void WriteBufferedPages();
+
 protected:
    void CreateImpl(const RNTupleModel &model) final;
    RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
    RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
    void CommitDatasetImpl() final;
 
@@ -115,6 +144,22 @@ public:
 
 private:
    RNTupleMetrics fMetrics;
+   /// Number of vector read requests issued for loading clusters or single pages
+   RNTupleAtomicCounter *fCtrNReadV = nullptr;
+   /// Number of bytes read from the file, i.e. the compressed size of the loaded pages
+   RNTupleAtomicCounter *fCtrSzReadPayload = nullptr;
+   /// Number of bytes of unzipped and unpacked pages
+   RNTupleAtomicCounter *fCtrSzUnzip = nullptr;
+   /// Number of pages used in place in the memory mapped file
+   RNTupleAtomicCounter *fCtrNPageMapped = nullptr;
+   /// Latency of the read requests
+   RNTupleLatencyHistogram *fHistoTimeRead = nullptr;
+   /// Latency of decompressing and unpacking a single page
+   RNTupleLatencyHistogram *fHistoTimeUnzip = nullptr;
+   /// Latency of PopulatePage(), including page pool lookups and waiting for the cluster pool
+   RNTupleLatencyHistogram *fHistoTimePopulate = nullptr;
+   /// Number of bytes read from the file per column, indexed by the column id; created on attaching the source
+   std::vector<RNTupleAtomicCounter *> fCtrSzReadColumn;
    /// Populated pages might be shared; there memory buffer is managed by the RPageAllocatorFile
    std::unique_ptr<RPageAllocatorFile> fPageAllocator;
    /// The page pool migh, at some point, be used by multiple page sources
@@ -125,8 +170,25 @@ private:
    std::unique_ptr<ROOT::Internal::RRawFile> fFile;
    /// Takes the fFile to read ntuple blobs from it
    Internal::RMiniFileReader fReader;
+   /// If memory mapping is requested and supported by fFile, the entire file is mapped into this region
+   void *fMappedFile = nullptr;
+   /// The length of the fMappedFile region
+   std::size_t fMappedFileSize = 0;
+   /// The last cluster from which a page got populated.  Points into fClusterPool->fPool
+   RCluster *fCurrentCluster = nullptr;
+   /// The cluster pool asynchronously preloads the next few clusters; it uses LoadCluster() and UnzipCluster()
+   /// from the I/O and the unzip threads. Declared last such that it is destructed first, which stops the
+   /// background threads before the raw file and the page pool go away.
+   std::unique_ptr<RClusterPool> fClusterPool;
 
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
+   /// Decompresses and unpacks the on-disk page at the given memory location into a newly allocated page buffer
+   RPage UnsealPage(const void *sealedBuffer, std::uint32_t sealedSize, const RColumnElementBase &element,
+                    ColumnId_t columnId, ClusterSize_t::ValueType nElements);
+   /// Returns the location of the page in the memory mapped file if the page can be used in place, i.e. if it is
+   /// uncompressed, its element type is mappable, and its location is suitably aligned.  Otherwise returns nullptr.
+   void *GetMappedPage(const RColumnElementBase &element,
+                       const RClusterDescriptor::RPageRange::RPageInfo &pageInfo) const;
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType clusterIndex);
 
@@ -144,6 +206,10 @@ public:
    RPage PopulatePage(ColumnHandle_t columnHandle, const RClusterIndex &clusterIndex) final;
    void ReleasePage(RPage &page) final;
 
+   std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) final;
+   void UnzipCluster(RCluster *cluster) final;
+   void ReleaseCluster(DescriptorId_t clusterId) final;
+
    RNTupleMetrics &GetMetrics() final { return fMetrics; }
 };
 
@@ -0,0 +1,69 @@
+/// \file RCluster.cxx
+/// \ingroup NTuple ROOT7
+/// \author agent <agent@local>
+/// \date 2020-03-11
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RCluster.hxx>
+
+#include <TError.h>
+
+#include <iterator>
+#include <utility>
+
+
+ROOT::Experimental::Detail::ROnDiskPageMap::~ROnDiskPageMap() = default;
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+ROOT::Experimental::Detail::ROnDiskPageMapHeap::~ROnDiskPageMapHeap() = default;
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+ROOT::Experimental::Detail::RCluster::~RCluster() = default;
+
+
+const ROOT::Experimental::Detail::ROnDiskPage *
+ROOT::Experimental::Detail::RCluster::GetOnDiskPage(const ROnDiskPage::Key &key) const
+{
+   const auto itr = fOnDiskPages.find(key);
+   if (itr != fOnDiskPages.end())
+      return &(itr->second);
+   return nullptr;
+}
+
+void ROOT::Experimental::Detail::RCluster::Adopt(std::unique_ptr<ROnDiskPageMap> pageMap)
+{
+   auto &pages = pageMap->fOnDiskPages;
+   fOnDiskPages.insert(pages.begin(), pages.end());
+   pageMap->fOnDiskPages.clear();
+   fPageMaps.emplace_back(std::move(pageMap));
+}
+
+void ROOT::Experimental::Detail::RCluster::Adopt(RCluster &&other)
+{
+   fAvailColumns.insert(other.fAvailColumns.begin(), other.fAvailColumns.end());
+   other.fAvailColumns.clear();
+   fOnDiskPages.insert(other.fOnDiskPages.begin(), other.fOnDiskPages.end());
+   other.fOnDiskPages.clear();
+   std::move(other.fPageMaps.begin(), other.fPageMaps.end(), std::back_inserter(fPageMaps));
+   other.fPageMaps.clear();
+}
+
+void ROOT::Experimental::Detail::RCluster::SetColumnAvailable(DescriptorId_t columnId)
+{
+   fAvailColumns.insert(columnId);
+}
@@ -0,0 +1,284 @@
+/// \file RClusterPool.cxx
+/// \ingroup NTuple ROOT7
+/// \author agent <agent@local>
+/// \date 2020-03-11
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RClusterPool.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RPageStorage.hxx>
+
+#include <TError.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <unordered_map>
+#include <utility>
+
+
+ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int size)
+   : fPageSource(pageSource)
+   , fWindowPre(0)
+   , fWindowPost(size)
+{
+   R__ASSERT(size > 0);
+   fPool.resize(fWindowPre + fWindowPost);
+   fThreadIo = std::thread(&RClusterPool::ExecReadClusters, this);
+   fThreadUnzip = std::thread(&RClusterPool::ExecUnzipClusters, this);
+}
+
+ROOT::Experimental::Detail::RClusterPool::~RClusterPool()
+{
+   {
+      // An empty request terminates the I/O thread, which in turn terminates the unzip thread
+      std::unique_lock<std::mutex> lock(fLockWorkQueue);
+      fReadQueue.emplace_back(RReadItem());
+      fCvHasReadWork.notify_one();
+   }
+   fThreadIo.join();
+   fThreadUnzip.join();
+}
+
+void ROOT::Experimental::Detail::RClusterPool::ExecReadClusters()
+{
+   while (true) {
+      std::deque<RReadItem> readItems;
+      {
+         std::unique_lock<std::mutex> lock(fLockWorkQueue);
+         fCvHasReadWork.wait(lock, [&]{ return !fReadQueue.empty(); });
+         std::swap(readItems, fReadQueue);
+      }
+
+      while (!readItems.empty()) {
+         auto item = std::move(readItems.front());
+         readItems.pop_front();
+
+         if (item.fClusterId == kInvalidDescriptorId) {
+            // Forward the termination request to the unzip thread
+            std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+            fUnzipQueue.emplace_back(RUnzipItem());
+            fCvHasUnzipWork.notify_one();
+            return;
+         }
+
+         std::unique_ptr<RCluster> cluster;
+         try {
+            cluster = fPageSource.LoadCluster(item.fClusterId, item.fColumns);
+         } catch (...) {
+            item.fPromise.set_exception(std::current_exception());
+            continue;
+         }
+
+         std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+         RUnzipItem unzipItem;
+         unzipItem.fCluster = std::move(cluster);
+         unzipItem.fPromise = std::move(item.fPromise);
+         fUnzipQueue.emplace_back(std::move(unzipItem));
+         fCvHasUnzipWork.notify_one();
+      }
+   }
+}
+
+void ROOT::Experimental::Detail::RClusterPool::ExecUnzipClusters()
+{
+   while (true) {
+      std::deque<RUnzipItem> unzipItems;
+      {
+         std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+         fCvHasUnzipWork.wait(lock, [&]{ return !fUnzipQueue.empty(); });
+         std::swap(unzipItems, fUnzipQueue);
+      }
+
+      while (!unzipItems.empty()) {
+         auto item = std::move(unzipItems.front());
+         unzipItems.pop_front();
+
+         if (!item.fCluster)
+            return;
+
+         try {
+            fPageSource.UnzipCluster(item.fCluster.get());
+         } catch (...) {
+            item.fPromise.set_exception(std::current_exception());
+            continue;
+         }
+         // Afterwards the GetCluster() method in the main thread can pick-up the cluster
+         item.fPromise.set_value(std::move(item.fCluster));
+      }
+   }
+}
+
+ROOT::Experimental::Detail::RCluster *
+ROOT::Experimental::Detail::RClusterPool::FindInPool(DescriptorId_t clusterId) const
+{
+   for (const auto &cptr : fPool) {
+      if (cptr && (cptr->GetId() == clusterId))
+         return cptr.get();
+   }
+   return nullptr;
+}
+
+size_t ROOT::Experimental::Detail::RClusterPool::FindFreeSlot() const
+{
+   auto N = fPool.size();
+   for (unsigned i = 0; i < N; ++i) {
+      if (!fPool[i])
+         return i;
+   }
+
+   R__ASSERT(false);
+   return N;
+}
+
+ROOT::Experimental::Detail::RCluster *
+ROOT::Experimental::Detail::RClusterPool::Insert(std::unique_ptr<RCluster> cluster)
+{
+   auto existing = FindInPool(cluster->GetId());
+   if (existing) {
+      existing->Adopt(std::move(*cluster));
+      return existing;
+   }
+   auto idxFreeSlot = FindFreeSlot();
+   fPool[idxFreeSlot] = std::move(cluster);
+   return fPool[idxFreeSlot].get();
+}
+
+void ROOT::Experimental::Detail::RClusterPool::CollectInFlightClusters()
+{
+   for (auto itr = fInFlightClusters.begin(); itr != fInFlightClusters.end(); ) {
+      if (itr->fFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+         ++itr;
+         continue;
+      }
+
+      if (!itr->fIsExpired) {
+         // Exceptions from the I/O or the unzip thread are rethrown here
+         Insert(itr->fFuture.get());
+      } else if (!FindInPool(itr->fClusterId)) {
+         // The pages of the expired cluster might have been preloaded by the unzip thread in the meantime
+         fPageSource.ReleaseCluster(itr->fClusterId);
+      }
+      itr = fInFlightClusters.erase(itr);
+   }
+}
+
+ROOT::Experimental::Detail::RCluster *
+ROOT::Experimental::Detail::RClusterPool::GetCluster(
+   DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns)
+{
+   const auto &desc = fPageSource.GetDescriptor();
+
+   // Determine the cluster ids that should be kept in the pool and the ones that should be loaded: the window
+   // covers fWindowPre clusters before the requested one and fWindowPost clusters including the requested one
+   std::unordered_map<DescriptorId_t, bool /* isProvide */> keep;
+   keep[clusterId] = true;
+   auto prev = clusterId;
+   for (unsigned int i = 0; i < fWindowPre; ++i) {
+      prev = desc.FindPrevClusterId(prev);
+      if (prev == kInvalidDescriptorId)
+         break;
+      keep[prev] = false;
+   }
+   std::vector<DescriptorId_t> provide{clusterId};
+   auto next = clusterId;
+   for (unsigned int i = 1; i < fWindowPost; ++i) {
+      next = desc.FindNextClusterId(next);
+      if (next == kInvalidDescriptorId)
+         break;
+      keep[next] = true;
+      provide.emplace_back(next);
+   }
+
+   // Clusters in the pool and in flight that fall outside the window are evicted resp. expired
+   for (auto &cptr : fPool) {
+      if (cptr && (keep.count(cptr->GetId()) == 0)) {
+         fPageSource.ReleaseCluster(cptr->GetId());
+         cptr.reset();
+      }
+   }
+   for (auto &inFlight : fInFlightClusters) {
+      if (keep.count(inFlight.fClusterId) == 0)
+         inFlight.fIsExpired = true;
+   }
+   CollectInFlightClusters();
+
+   // Schedule loading of the missing columns of the clusters in the window
+   {
+      std::unique_lock<std::mutex> lock(fLockWorkQueue);
+
+      for (auto id : provide) {
+         RPageSource::ColumnSet_t missingColumns = columns;
+         if (auto cluster = FindInPool(id)) {
+            for (auto columnId : cluster->GetAvailColumns())
+               missingColumns.erase(columnId);
+         }
+         for (const auto &inFlight : fInFlightClusters) {
+            if ((inFlight.fClusterId != id) || inFlight.fIsExpired)
+               continue;
+            for (auto columnId : inFlight.fColumns)
+               missingColumns.erase(columnId);
+         }
+         if (missingColumns.empty())
+            continue;
+
+         RReadItem readItem;
+         readItem.fClusterId = id;
+         readItem.fColumns = missingColumns;
+
+         RInFlightCluster inFlightCluster;
+         inFlightCluster.fClusterId = id;
+         inFlightCluster.fColumns = missingColumns;
+         inFlightCluster.fFuture = readItem.fPromise.get_future();
+         fInFlightClusters.emplace_back(std::move(inFlightCluster));
+
+         fReadQueue.emplace_back(std::move(readItem));
+      }
+      if (!fReadQueue.empty())
+         fCvHasReadWork.notify_one();
+   }
+
+   return WaitFor(clusterId, columns);
+}
+
+ROOT::Experimental::Detail::RCluster *
+ROOT::Experimental::Detail::RClusterPool::WaitFor(
+   DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns)
+{
+   while (true) {
+      // Fast exit: the cluster happens to be already present in the cache pool
+      auto result = FindInPool(clusterId);
+      if (result) {
+         bool hasMissingColumn = false;
+         for (auto cid : columns) {
+            if (result->ContainsColumn(cid))
+               continue;
+            hasMissingColumn = true;
+            break;
+         }
+         if (!hasMissingColumn)
+            return result;
+      }
+
+      // Otherwise the missing data must have been triggered for loading by now, so block and wait
+      auto itr = std::find_if(fInFlightClusters.begin(), fInFlightClusters.end(),
+         [clusterId](const RInFlightCluster &inFlight) {
+            return (inFlight.fClusterId == clusterId) && !inFlight.fIsExpired;
+         });
+      R__ASSERT(itr != fInFlightClusters.end());
+
+      auto future = std::move(itr->fFuture);
+      fInFlightClusters.erase(itr);
+      // Exceptions from the I/O or the unzip thread are rethrown here
+      Insert(future.get());
+   }
+}
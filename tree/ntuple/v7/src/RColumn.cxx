@@ -14,12 +14,16 @@
  *************************************************************************/
 
 #include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RColumnModel.hxx>
 #include <ROOT/RPageStorage.hxx>
 
 #include <TError.h>
 
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 ROOT::Experimental::Detail::RColumn::RColumn(const RColumnModel& model, std::uint32_t index)
    : fModel(model), fIndex(index), fPageSink(nullptr), fPageSource(nullptr), fHeadPage(), fNElements(0),
@@ -41,12 +45,35 @@ void ROOT::Experimental::Detail::RColumn::Connect(DescriptorId_t fieldId, RPageS
    switch (pageStorage->GetType()) {
    case EPageStorageType::kSink:
       fPageSink = static_cast<RPageSink*>(pageStorage); // the page sink initializes fHeadPage on AddColumn
+      if (fPageSink->GetWriteOptions().GetUseSplitEncoding()) {
+         // The in-memory layout stays the same, only packing and unpacking of pages changes
+         auto splitElement = fElement->GenerateSplit();
+         if (splitElement) {
+            fModel = RColumnModel(RColumnElementBase::GetSplitType(fModel.GetType()), fModel.GetIsSorted());
+            fElement = std::move(splitElement);
+         }
+      }
       fHandleSink = fPageSink->AddColumn(fieldId, *this);
       fHeadPage = fPageSink->ReservePage(fHandleSink);
       break;
    case EPageStorageType::kSource:
       fPageSource = static_cast<RPageSource*>(pageStorage);
       fHandleSource = fPageSource->AddColumn(fieldId, *this);
+      {
+         // The column may have been written with a different encoding of the same in-memory type
+         const auto onDiskModel = fPageSource->GetDescriptor().GetColumnDescriptor(fHandleSource.fId).GetModel();
+         if (!(onDiskModel == fModel)) {
+            if (RColumnElementBase::GetSplitType(fModel.GetType()) != onDiskModel.GetType()) {
+               throw std::runtime_error("RColumn: on-disk column type " +
+                                        std::to_string(static_cast<int>(onDiskModel.GetType())) +
+                                        " does not match the in-memory column type " +
+                                        std::to_string(static_cast<int>(fModel.GetType())));
+            }
+            fModel = onDiskModel;
+            fElement = fElement->GenerateSplit();
+            R__ASSERT(fElement);
+         }
+      }
       fNElements = fPageSource->GetNElements(fHandleSource);
       fColumnIdSource = fPageSource->GetColumnId(fHandleSource);
       break;
@@ -17,53 +17,301 @@
 
 #include <TError.h>
 
-#include <algorithm>
-#include <bitset>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <memory>
 
-ROOT::Experimental::Detail::RColumnElementBase
+namespace {
+
+/// Transposes count elements of N bytes each such that the destination contains the first bytes of all the
+/// elements, followed by the second bytes of all the elements, and so on. The loops are simple enough to be
+/// auto-vectorized.
+template <std::size_t N>
+void CastSplitPack(void *destination, const void *source, std::size_t count)
+{
+   auto dst = reinterpret_cast<unsigned char *>(destination);
+   auto src = reinterpret_cast<const unsigned char *>(source);
+   for (std::size_t b = 0; b < N; ++b) {
+      unsigned char *dstBytes = dst + b * count;
+      for (std::size_t i = 0; i < count; ++i)
+         dstBytes[i] = src[i * N + b];
+   }
+}
+
+/// Inverse of CastSplitPack()
+template <std::size_t N>
+void CastSplitUnpack(void *destination, const void *source, std::size_t count)
+{
+   auto dst = reinterpret_cast<unsigned char *>(destination);
+   auto src = reinterpret_cast<const unsigned char *>(source);
+   for (std::size_t b = 0; b < N; ++b) {
+      const unsigned char *srcBytes = src + b * count;
+      for (std::size_t i = 0; i < count; ++i)
+         dst[i * N + b] = srcBytes[i];
+   }
+}
+
+/// Stores the zigzag encoded differences of consecutive 32bit elements in split (little-endian) byte order.
+/// The first element is stored as difference to zero, so that every page can be decoded on its own.
+void DeltaZigzagSplitPack(void *destination, const void *source, std::size_t count)
+{
+   auto dst = reinterpret_cast<unsigned char *>(destination);
+   auto src = reinterpret_cast<const std::uint32_t *>(source);
+   std::uint32_t prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      const auto delta = static_cast<std::int32_t>(src[i] - prev);
+      prev = src[i];
+      const auto zigzag = (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31);
+      dst[i] = zigzag & 0xff;
+      dst[count + i] = (zigzag >> 8) & 0xff;
+      dst[2 * count + i] = (zigzag >> 16) & 0xff;
+      dst[3 * count + i] = (zigzag >> 24) & 0xff;
+   }
+}
+
+/// Inverse of DeltaZigzagSplitPack()
+void DeltaZigzagSplitUnpack(void *destination, const void *source, std::size_t count)
+{
+   auto dst = reinterpret_cast<std::uint32_t *>(destination);
+   auto src = reinterpret_cast<const unsigned char *>(source);
+   std::uint32_t prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      const std::uint32_t zigzag = static_cast<std::uint32_t>(src[i]) |
+                                   (static_cast<std::uint32_t>(src[count + i]) << 8) |
+                                   (static_cast<std::uint32_t>(src[2 * count + i]) << 16) |
+                                   (static_cast<std::uint32_t>(src[3 * count + i]) << 24);
+      prev += (zigzag >> 1) ^ (0 - (zigzag & 1));
+      dst[i] = prev;
+   }
+}
+
+/// Determines the smallest and the largest non-NaN value of an array of numbers. If the type has more digits than
+/// double, the range is widened such that it remains conservative after the conversion.
+template <typename T>
+bool ComputeValueRange(const void *values, std::size_t count, double &min, double &max)
+{
+   auto typedValues = reinterpret_cast<const T *>(values);
+   std::size_t i = 0;
+   // Skip leading NaNs; for integer types the comparison is always true
+   while ((i < count) && !(typedValues[i] == typedValues[i]))
+      ++i;
+   if (i == count)
+      return false;
+
+   T typedMin = typedValues[i];
+   T typedMax = typedValues[i];
+   for (; i < count; ++i) {
+      // NaN compares false and thus never changes the result
+      if (typedValues[i] < typedMin)
+         typedMin = typedValues[i];
+      if (typedValues[i] > typedMax)
+         typedMax = typedValues[i];
+   }
+   min = static_cast<double>(typedMin);
+   max = static_cast<double>(typedMax);
+   if (std::numeric_limits<T>::digits > std::numeric_limits<double>::digits) {
+      min = std::nextafter(min, -std::numeric_limits<double>::infinity());
+      max = std::nextafter(max, std::numeric_limits<double>::infinity());
+   }
+   return true;
+}
+
+} // anonymous namespace
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
 ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
    switch (type) {
    case EColumnType::kReal32:
-      return RColumnElement<float, EColumnType::kReal32>(nullptr);
+      return std::make_unique<RColumnElement<float, EColumnType::kReal32>>(nullptr);
    case EColumnType::kReal64:
-      return RColumnElement<double, EColumnType::kReal64>(nullptr);
+      return std::make_unique<RColumnElement<double, EColumnType::kReal64>>(nullptr);
    case EColumnType::kByte:
-      return RColumnElement<std::uint8_t, EColumnType::kByte>(nullptr);
+      return std::make_unique<RColumnElement<std::uint8_t, EColumnType::kByte>>(nullptr);
    case EColumnType::kInt32:
-      return RColumnElement<std::int32_t, EColumnType::kInt32>(nullptr);
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kInt32>>(nullptr);
    case EColumnType::kInt64:
-      return RColumnElement<std::int64_t, EColumnType::kInt64>(nullptr);
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kInt64>>(nullptr);
    case EColumnType::kBit:
-      return RColumnElement<bool, EColumnType::kBit>(nullptr);
+      return std::make_unique<RColumnElement<bool, EColumnType::kBit>>(nullptr);
    case EColumnType::kIndex:
-      return RColumnElement<ClusterSize_t, EColumnType::kIndex>(nullptr);
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kIndex>>(nullptr);
    case EColumnType::kSwitch:
-      return RColumnElement<RColumnSwitch, EColumnType::kSwitch>(nullptr);
+      return std::make_unique<RColumnElement<RColumnSwitch, EColumnType::kSwitch>>(nullptr);
+   case EColumnType::kSplitIndex:
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>>(nullptr);
+   case EColumnType::kSplitReal64:
+      return std::make_unique<RColumnElement<double, EColumnType::kSplitReal64>>(nullptr);
+   case EColumnType::kSplitReal32:
+      return std::make_unique<RColumnElement<float, EColumnType::kSplitReal32>>(nullptr);
+   case EColumnType::kSplitInt64:
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kSplitInt64>>(nullptr);
+   case EColumnType::kSplitInt32:
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kSplitInt32>>(nullptr);
    default:
       R__ASSERT(false);
    }
    // never here
-   return RColumnElementBase();
+   return nullptr;
+}
+
+ROOT::Experimental::EColumnType ROOT::Experimental::Detail::RColumnElementBase::GetSplitType(EColumnType type)
+{
+   switch (type) {
+   case EColumnType::kIndex:
+      return EColumnType::kSplitIndex;
+   case EColumnType::kReal64:
+      return EColumnType::kSplitReal64;
+   case EColumnType::kReal32:
+      return EColumnType::kSplitReal32;
+   case EColumnType::kInt64:
+      return EColumnType::kSplitInt64;
+   case EColumnType::kInt32:
+      return EColumnType::kSplitInt32;
+   default:
+      return EColumnType::kUnknown;
+   }
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kReal32>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<float>(values, count, min, max);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kReal32>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<float, EColumnType::kSplitReal32>>(nullptr);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kReal64>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<double>(values, count, min, max);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kReal64>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<double, EColumnType::kSplitReal64>>(nullptr);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kInt32>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::int32_t>(values, count, min, max);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kInt32>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<std::int32_t, EColumnType::kSplitInt32>>(nullptr);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kInt32>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::uint32_t>(values, count, min, max);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<
+  std::uint32_t, ROOT::Experimental::EColumnType::kInt32>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<std::uint32_t, EColumnType::kSplitInt32>>(nullptr);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kInt64>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::int64_t>(values, count, min, max);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kInt64>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<std::int64_t, EColumnType::kSplitInt64>>(nullptr);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kInt64>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::uint64_t>(values, count, min, max);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<
+  std::uint64_t, ROOT::Experimental::EColumnType::kInt64>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<std::uint64_t, EColumnType::kSplitInt64>>(nullptr);
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
+ROOT::Experimental::Detail::RColumnElement<
+  ROOT::Experimental::ClusterSize_t, ROOT::Experimental::EColumnType::kIndex>::GenerateSplit() const
+{
+   return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>>(nullptr);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<float>(values, count, min, max);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<double>(values, count, min, max);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<
+  std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::int32_t>(values, count, min, max);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<
+  std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::uint32_t>(values, count, min, max);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<
+  std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::int64_t>(values, count, min, max);
+}
+
+bool ROOT::Experimental::Detail::RColumnElement<
+  std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::GetValueRange(
+  const void *values, std::size_t count, double &min, double &max) const
+{
+   return ComputeValueRange<std::uint64_t>(values, count, min, max);
 }
 
 void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit>::Pack(
   void *dst, void *src, std::size_t count) const
 {
-   bool *boolArray = reinterpret_cast<bool *>(src);
-   char *charArray = reinterpret_cast<char *>(dst);
-   std::bitset<8> bitSet;
-   std::size_t i = 0;
-   for (; i < count; ++i) {
-      bitSet.set(i % 8, boolArray[i]);
-      if (i % 8 == 7) {
-         char packed = bitSet.to_ulong();
-         charArray[i / 8] = packed;
-      }
+   const bool *boolArray = reinterpret_cast<bool *>(src);
+   unsigned char *charArray = reinterpret_cast<unsigned char *>(dst);
+   const std::size_t nFullBytes = count / 8;
+   for (std::size_t i = 0; i < nFullBytes; ++i) {
+      unsigned char packed = 0;
+      for (std::size_t j = 0; j < 8; ++j)
+         packed |= static_cast<unsigned char>(boolArray[i * 8 + j]) << j;
+      charArray[i] = packed;
    }
-   if (i % 8 != 0) {
-      char packed = bitSet.to_ulong();
-      charArray[i / 8] = packed;
+   if (count % 8 != 0) {
+      unsigned char packed = 0;
+      for (std::size_t j = 0; j < count % 8; ++j)
+         packed |= static_cast<unsigned char>(boolArray[nFullBytes * 8 + j]) << j;
+      charArray[nFullBytes] = packed;
    }
 }
 
@@ -71,12 +319,93 @@ void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColum
   void *dst, void *src, std::size_t count) const
 {
    bool *boolArray = reinterpret_cast<bool *>(dst);
-   char *charArray = reinterpret_cast<char *>(src);
-   std::bitset<8> bitSet;
-   for (std::size_t i = 0; i < count; i += 8) {
-      bitSet = charArray[i / 8];
-      for (std::size_t j = i; j < std::min(count, i + 8); ++j) {
-         boolArray[j] = bitSet[j % 8];
-      }
-   }
+   const unsigned char *charArray = reinterpret_cast<unsigned char *>(src);
+   for (std::size_t i = 0; i < count; ++i)
+      boolArray[i] = (charArray[i / 8] >> (i % 8)) & 1;
+}
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitPack<sizeof(float)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitUnpack<sizeof(float)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitPack<sizeof(double)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitUnpack<sizeof(double)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitPack<sizeof(std::int32_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitUnpack<sizeof(std::int32_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitPack<sizeof(std::uint32_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitUnpack<sizeof(std::uint32_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitPack<sizeof(std::int64_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitUnpack<sizeof(std::int64_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitPack<sizeof(std::uint64_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   CastSplitUnpack<sizeof(std::uint64_t)>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<
+  ROOT::Experimental::ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   DeltaZigzagSplitPack(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<
+  ROOT::Experimental::ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   DeltaZigzagSplitUnpack(dst, src, count);
 }
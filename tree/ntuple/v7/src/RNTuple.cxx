@@ -16,19 +16,51 @@
 #include "ROOT/RNTuple.hxx"
 
 #include "ROOT/RFieldVisitor.hxx"
+#include "ROOT/RLogger.hxx"
 #include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RPageSinkBuf.hxx"
 #include "ROOT/RPageStorage.hxx"
+#include "ROOT/TTaskGroup.hxx"
 
 #include <algorithm>
 #include <exception>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 
 #include <TError.h>
+#include <TROOT.h> // for IsImplicitMTEnabled()
+
+ROOT::Experimental::Detail::RNTupleImtTaskScheduler::RNTupleImtTaskScheduler()
+{
+   Reset();
+}
+
+ROOT::Experimental::Detail::RNTupleImtTaskScheduler::~RNTupleImtTaskScheduler()
+{
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::Reset()
+{
+   fTaskGroup = std::make_unique<TTaskGroup>();
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::AddTask(const std::function<void(void)> &taskFunc)
+{
+   fTaskGroup->Run(taskFunc);
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::Wait()
+{
+   fTaskGroup->Wait();
+}
+
+
+//------------------------------------------------------------------------------
 
 
 void ROOT::Experimental::RNTupleReader::ConnectModel() {
@@ -43,6 +75,16 @@ void ROOT::Experimental::RNTupleReader::ConnectModel() {
    }
 }
 
+void ROOT::Experimental::RNTupleReader::InitPageSource()
+{
+   if (IsImplicitMTEnabled()) {
+      fUnzipTasks = std::make_unique<Detail::RNTupleImtTaskScheduler>();
+      fSource->SetTaskScheduler(fUnzipTasks.get());
+   }
+   fSource->Attach();
+   fMetrics.ObserveMetrics(fSource->GetMetrics());
+}
+
 ROOT::Experimental::RNTupleReader::RNTupleReader(
    std::unique_ptr<ROOT::Experimental::RNTupleModel> model,
    std::unique_ptr<ROOT::Experimental::Detail::RPageSource> source)
@@ -50,9 +92,8 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(
    , fModel(std::move(model))
    , fMetrics("RNTupleReader")
 {
-   fSource->Attach();
+   InitPageSource();
    ConnectModel();
-   fMetrics.ObserveMetrics(fSource->GetMetrics());
 }
 
 ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimental::Detail::RPageSource> source)
@@ -60,10 +101,9 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimen
    , fModel(nullptr)
    , fMetrics("RNTupleReader")
 {
-   fSource->Attach();
+   InitPageSource();
    fModel = fSource->GetDescriptor().GenerateModel();
    ConnectModel();
-   fMetrics.ObserveMetrics(fSource->GetMetrics());
 }
 
 ROOT::Experimental::RNTupleReader::~RNTupleReader()
@@ -133,6 +173,9 @@ void ROOT::Experimental::RNTupleReader::PrintInfo(const ENTupleInfo what, std::o
    case ENTupleInfo::kMetrics:
       fMetrics.Print(output);
       break;
+   case ENTupleInfo::kMetricsJSON:
+      fMetrics.PrintJSON(output);
+      break;
    default:
       // Unhandled case, internal error
       R__ASSERT(false);
@@ -182,6 +225,10 @@ ROOT::Experimental::RNTupleWriter::RNTupleWriter(
    , fLastCommitted(0)
    , fNEntries(0)
 {
+   if (IsImplicitMTEnabled()) {
+      fZipTasks = std::make_unique<Detail::RNTupleImtTaskScheduler>();
+      fSink->SetTaskScheduler(fZipTasks.get());
+   }
    fSink->Create(*fModel.get());
 }
 
@@ -216,6 +263,88 @@ void ROOT::Experimental::RNTupleWriter::CommitCluster()
 //------------------------------------------------------------------------------
 
 
+ROOT::Experimental::RNTupleFillContext::RNTupleFillContext(
+   std::unique_ptr<ROOT::Experimental::RNTupleModel> model,
+   std::unique_ptr<ROOT::Experimental::Detail::RPageSink> sink)
+   : fSink(std::move(sink))
+   , fModel(std::move(model))
+   , fClusterSizeEntries(kDefaultClusterSizeEntries)
+   , fLastCommitted(0)
+   , fNEntries(0)
+{
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleFillContext::~RNTupleFillContext()
+{
+   CommitCluster();
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster()
+{
+   if (fNEntries == fLastCommitted) return;
+   for (auto& field : *fModel->GetRootField()) {
+      field.Flush();
+      field.CommitCluster();
+   }
+   fSink->CommitCluster(fNEntries);
+   fLastCommitted = fNEntries;
+}
+
+
+//------------------------------------------------------------------------------
+
+
+ROOT::Experimental::RNTupleParallelWriter::RNTupleParallelWriter(
+   std::unique_ptr<ROOT::Experimental::RNTupleModel> model,
+   std::unique_ptr<ROOT::Experimental::Detail::RPageSink> sink)
+   : fSink(std::move(sink))
+   , fModel(std::move(model))
+{
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleParallelWriter::~RNTupleParallelWriter()
+{
+   for (const auto &context : fFillContexts) {
+      if (!context.expired()) {
+         R__ERROR_HERE("NTuple") << "RNTupleFillContext outlives its RNTupleParallelWriter, data loss!";
+         break;
+      }
+   }
+   fSink->CommitDataset();
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> ROOT::Experimental::RNTupleParallelWriter::Recreate(
+   std::unique_ptr<RNTupleModel> model,
+   std::string_view ntupleName,
+   std::string_view storage,
+   const RNTupleWriteOptions &options)
+{
+   return std::make_unique<RNTupleParallelWriter>(std::move(model),
+                                                  Detail::RPageSink::Create(ntupleName, storage, options));
+}
+
+std::shared_ptr<ROOT::Experimental::RNTupleFillContext> ROOT::Experimental::RNTupleParallelWriter::CreateFillContext()
+{
+   std::lock_guard<std::mutex> guard(fMutex);
+
+   auto model = std::unique_ptr<RNTupleModel>(fModel->Clone());
+   auto sink = std::make_unique<Detail::RPageSinkBuf>(*fSink, fMutex);
+   // The fill context's constructor is private, hence no std::make_shared
+   auto context = std::shared_ptr<RNTupleFillContext>(new RNTupleFillContext(std::move(model), std::move(sink)));
+   // Drop the bookkeeping of fill contexts that are gone
+   fFillContexts.erase(std::remove_if(fFillContexts.begin(), fFillContexts.end(),
+                                      [](const std::weak_ptr<RNTupleFillContext> &c) { return c.expired(); }),
+                       fFillContexts.end());
+   fFillContexts.emplace_back(context);
+   return context;
+}
+
+
+//------------------------------------------------------------------------------
+
+
 ROOT::Experimental::RCollectionNTuple::RCollectionNTuple(std::unique_ptr<REntry> defaultEntry)
    : fOffset(0), fDefaultEntry(std::move(defaultEntry))
 {
@@ -209,16 +209,19 @@ std::uint32_t SerializeFrame(std::uint16_t protocolVersionCurrent, std::uint16_t
    return 8;
 }
 
-std::uint32_t DeserializeFrame(std::uint16_t protocolVersion, const void *buffer, std::uint32_t *size)
+std::uint32_t DeserializeFrame(std::uint16_t protocolVersion, const void *buffer, std::uint32_t *size,
+   std::uint16_t *protocolVersionAtWrite = nullptr)
 {
    auto bytes = reinterpret_cast<const unsigned char *>(buffer);
-   std::uint16_t protocolVersionAtWrite;
+   std::uint16_t versionAtWrite;
    std::uint16_t protocolVersionMinRequired;
-   bytes += DeserializeUInt16(bytes, &protocolVersionAtWrite);
+   bytes += DeserializeUInt16(bytes, &versionAtWrite);
    bytes += DeserializeUInt16(bytes, &protocolVersionMinRequired);
-   R__ASSERT(protocolVersionAtWrite >= protocolVersionMinRequired);
+   R__ASSERT(versionAtWrite >= protocolVersionMinRequired);
    R__ASSERT(protocolVersion >= protocolVersionMinRequired);
    bytes += DeserializeUInt32(bytes, size);
+   if (protocolVersionAtWrite)
+      *protocolVersionAtWrite = versionAtWrite;
    return 8;
 }
 
@@ -329,6 +332,22 @@ std::uint32_t DeserializeTimeStamp(const void *buffer, std::chrono::system_clock
    return size;
 }
 
+std::uint32_t SerializeDouble(double val, void *buffer)
+{
+   std::uint64_t bits;
+   static_assert(sizeof(bits) == sizeof(val), "unsupported double size");
+   std::memcpy(&bits, &val, sizeof(bits));
+   return SerializeUInt64(bits, buffer);
+}
+
+std::uint32_t DeserializeDouble(const void *buffer, double *val)
+{
+   std::uint64_t bits;
+   auto size = DeserializeUInt64(buffer, &bits);
+   std::memcpy(val, &bits, sizeof(bits));
+   return size;
+}
+
 std::uint32_t SerializeColumnRange(const ROOT::Experimental::RClusterDescriptor::RColumnRange &val, void *buffer)
 {
    // To keep the cluster footers small, we don't put a frame around individual column ranges.
@@ -338,11 +357,17 @@ std::uint32_t SerializeColumnRange(const ROOT::Experimental::RClusterDescriptor:
       pos += SerializeUInt64(val.fFirstElementIndex, pos);
       pos += SerializeClusterSize(val.fNElements, pos);
       pos += SerializeInt64(val.fCompressionSettings, pos);
+      // Flags; bit 0 indicates a valid value range
+      pos += SerializeUInt32(val.fHasValueRange ? 0x01 : 0x00, pos);
+      pos += SerializeDouble(val.fMinValue, pos);
+      pos += SerializeDouble(val.fMaxValue, pos);
    }
-   return 20;
+   return 40;
 }
 
-std::uint32_t DeserializeColumnRange(const void *buffer,
+/// The layout of the column range depends on the version of the cluster frame that wrote it: version 0 has no
+/// value range.
+std::uint32_t DeserializeColumnRange(const void *buffer, std::uint16_t clusterFrameVersion,
    ROOT::Experimental::RClusterDescriptor::RColumnRange *columnRange)
 {
    auto bytes = reinterpret_cast<const unsigned char *>(buffer);
@@ -350,7 +375,16 @@ std::uint32_t DeserializeColumnRange(const void *buffer,
    bytes += DeserializeUInt64(bytes, &columnRange->fFirstElementIndex);
    bytes += DeserializeClusterSize(bytes, &columnRange->fNElements);
    bytes += DeserializeInt64(bytes, &columnRange->fCompressionSettings);
-   return 20;
+   if (clusterFrameVersion == 0) {
+      columnRange->fHasValueRange = false;
+      return 20;
+   }
+   std::uint32_t flags;
+   bytes += DeserializeUInt32(bytes, &flags);
+   columnRange->fHasValueRange = (flags & 0x01) != 0;
+   bytes += DeserializeDouble(bytes, &columnRange->fMinValue);
+   bytes += DeserializeDouble(bytes, &columnRange->fMaxValue);
+   return 40;
 }
 
 std::uint32_t SerializePageInfo(const ROOT::Experimental::RClusterDescriptor::RPageRange::RPageInfo &val, void *buffer)
@@ -694,6 +728,51 @@ ROOT::Experimental::RNTupleDescriptor::FindClusterId(DescriptorId_t columnId, NT
 }
 
 
+// TODO(jblomer): fix for cases of sharded clusters
+ROOT::Experimental::DescriptorId_t
+ROOT::Experimental::RNTupleDescriptor::FindNextClusterId(DescriptorId_t clusterId) const
+{
+   const auto &clusterDesc = GetClusterDescriptor(clusterId);
+   auto firstEntryInNextCluster = clusterDesc.GetFirstEntryIndex() + clusterDesc.GetNEntries();
+   // TODO(jblomer): binary search?
+   for (const auto &cd : fClusterDescriptors) {
+      if ((cd.first != clusterId) && (cd.second.GetFirstEntryIndex() == firstEntryInNextCluster))
+         return cd.second.GetId();
+   }
+   return kInvalidDescriptorId;
+}
+
+
+// TODO(jblomer): fix for cases of sharded clusters
+ROOT::Experimental::DescriptorId_t
+ROOT::Experimental::RNTupleDescriptor::FindPrevClusterId(DescriptorId_t clusterId) const
+{
+   const auto &clusterDesc = GetClusterDescriptor(clusterId);
+   // TODO(jblomer): binary search?
+   for (const auto &cd : fClusterDescriptors) {
+      if ((cd.first != clusterId) &&
+          (cd.second.GetFirstEntryIndex() + cd.second.GetNEntries() == clusterDesc.GetFirstEntryIndex()))
+         return cd.second.GetId();
+   }
+   return kInvalidDescriptorId;
+}
+
+
+std::vector<ROOT::Experimental::DescriptorId_t>
+ROOT::Experimental::RNTupleDescriptor::FindClusterIdsInValueRange(DescriptorId_t columnId, double min, double max) const
+{
+   std::vector<DescriptorId_t> result;
+   for (const auto &cd : fClusterDescriptors) {
+      if (cd.second.GetColumnRange(columnId).MayContainValues(min, max))
+         result.emplace_back(cd.first);
+   }
+   std::sort(result.begin(), result.end(), [this](DescriptorId_t a, DescriptorId_t b) {
+      return GetClusterDescriptor(a).GetFirstEntryIndex() < GetClusterDescriptor(b).GetFirstEntryIndex();
+   });
+   return result;
+}
+
+
 std::unique_ptr<ROOT::Experimental::RNTupleModel> ROOT::Experimental::RNTupleDescriptor::GenerateModel() const
 {
    auto model = std::make_unique<RNTupleModel>();
@@ -804,7 +883,8 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
       pos += DeserializeUuid(pos, &uuid);
       R__ASSERT(uuid == fDescriptor.fOwnUuid);
       auto clusterBase = pos;
-      pos += DeserializeFrame(RClusterDescriptor::kFrameVersionCurrent, clusterBase, &frameSize);
+      std::uint16_t clusterFrameVersion;
+      pos += DeserializeFrame(RClusterDescriptor::kFrameVersionCurrent, clusterBase, &frameSize, &clusterFrameVersion);
 
       std::uint64_t clusterId;
       RNTupleVersion version;
@@ -829,7 +909,7 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
 
          RClusterDescriptor::RColumnRange columnRange;
          columnRange.fColumnId = columnId;
-         pos += DeserializeColumnRange(pos, &columnRange);
+         pos += DeserializeColumnRange(pos, clusterFrameVersion, &columnRange);
          AddClusterColumnRange(clusterId, columnRange);
 
          RClusterDescriptor::RPageRange pageRange;
@@ -15,7 +15,36 @@
 
 #include <ROOT/RNTupleMetrics.hxx>
 
+#include <cstdio>
 #include <ostream>
+#include <sstream>
+
+namespace {
+
+/// Escapes the given string for use as a JSON string literal, including the enclosing quotes
+std::string QuoteJSON(const std::string &str)
+{
+   std::string result = "\"";
+   for (auto c : str) {
+      switch (c) {
+      case '"': result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[7];
+            snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+            result += buf;
+         } else {
+            result += c;
+         }
+      }
+   }
+   return result + "\"";
+}
+
+} // anonymous namespace
 
 ROOT::Experimental::Detail::RNTuplePerfCounter::~RNTuplePerfCounter()
 {
@@ -26,6 +55,53 @@ std::string ROOT::Experimental::Detail::RNTuplePerfCounter::ToString() const
    return fName + kFieldSeperator + fUnit + kFieldSeperator + fDescription + kFieldSeperator + ValueToString();
 }
 
+std::int64_t ROOT::Experimental::Detail::RNTupleLatencyHistogram::GetQuantileUpperBound(double quantile) const
+{
+   const auto count = GetCount();
+   if (count == 0)
+      return 0;
+   std::int64_t sum = 0;
+   for (std::size_t i = 0; i < kNBins; ++i) {
+      sum += GetBinContent(i);
+      if (double(sum) >= quantile * double(count))
+         return GetBinUpperEdge(i);
+   }
+   return GetBinUpperEdge(kNBins - 1);
+}
+
+std::string ROOT::Experimental::Detail::RNTupleLatencyHistogram::ValueToString() const
+{
+   const auto count = GetCount();
+   std::ostringstream str;
+   str << "n=" << count << " mean=" << ((count > 0) ? (GetSum() / count) : 0)
+       << " p50<=" << GetQuantileUpperBound(0.5) << " p99<=" << GetQuantileUpperBound(0.99);
+   return str.str();
+}
+
+std::string ROOT::Experimental::Detail::RNTupleLatencyHistogram::ValueToJSON() const
+{
+   std::ostringstream str;
+   str << "{\"count\": " << GetCount() << ", \"sum\": " << GetSum() << ", \"buckets\": [";
+   // Only non-empty bins are written; the upper edge of the unbounded last bin is written as null
+   bool isFirst = true;
+   for (std::size_t i = 0; i < kNBins; ++i) {
+      const auto content = GetBinContent(i);
+      if (content == 0)
+         continue;
+      if (!isFirst)
+         str << ", ";
+      isFirst = false;
+      str << "{\"le\": ";
+      if (i < kNBins - 1)
+         str << GetBinUpperEdge(i);
+      else
+         str << "null";
+      str << ", \"count\": " << content << "}";
+   }
+   str << "]}";
+   return str.str();
+}
+
 bool ROOT::Experimental::Detail::RNTupleMetrics::Contains(const std::string &name) const
 {
    for (const auto &c : fCounters) {
@@ -43,6 +119,8 @@ void ROOT::Experimental::Detail::RNTupleMetrics::Print(std::ostream &output, con
    }
 
    for (const auto &c : fCounters) {
+      if (c->IsDetailed())
+         continue;
       output << prefix << fName << kNamespaceSeperator << c->ToString() << std::endl;
    }
    for (const auto c : fObservedMetrics) {
@@ -50,6 +128,36 @@ void ROOT::Experimental::Detail::RNTupleMetrics::Print(std::ostream &output, con
    }
 }
 
+void ROOT::Experimental::Detail::RNTupleMetrics::PrintJSONMembers(std::ostream &output, const std::string &prefix,
+                                                                  bool &isFirst) const
+{
+   for (const auto &c : fCounters) {
+      if (!isFirst)
+         output << "," << std::endl;
+      isFirst = false;
+      output << "  " << QuoteJSON(prefix + fName + kNamespaceSeperator + c->GetName()) << ": {"
+             << "\"unit\": " << QuoteJSON(c->GetUnit()) << ", "
+             << "\"description\": " << QuoteJSON(c->GetDescription()) << ", "
+             << "\"value\": " << c->ValueToJSON() << "}";
+   }
+   for (const auto c : fObservedMetrics) {
+      c->PrintJSONMembers(output, prefix + fName + kNamespaceSeperator, isFirst);
+   }
+}
+
+void ROOT::Experimental::Detail::RNTupleMetrics::PrintJSON(std::ostream &output) const
+{
+   // Disabled metrics are written as an empty object so that the output is always valid JSON
+   output << "{";
+   if (fIsEnabled) {
+      bool isFirst = true;
+      output << std::endl;
+      PrintJSONMembers(output, "", isFirst);
+      output << std::endl;
+   }
+   output << "}" << std::endl;
+}
+
 void ROOT::Experimental::Detail::RNTupleMetrics::Enable()
 {
    for (auto &c: fCounters)
@@ -19,60 +19,195 @@
 #include <TError.h>
 
 #include <cstdlib>
+#include <vector>
 
-void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
+ROOT::Experimental::Detail::RPagePool::~RPagePool()
 {
-   fPages.emplace_back(page);
-   fReferences.emplace_back(1);
-   fDeleters.emplace_back(deleter);
+   for (auto &shard : fShards) {
+      for (auto &column : shard.fColumns) {
+         for (auto &page : column.second.fByGlobalIndex)
+            page.second.fDeleter(page.second.fPage);
+      }
+   }
+}
+
+void ROOT::Experimental::Detail::RPagePool::Pin(RShard &shard, REntry &entry)
+{
+   if (entry.fNPins++ == 0)
+      shard.fLru.erase(entry.fLruPosition);
+}
+
+void ROOT::Experimental::Detail::RPagePool::Unpin(RShard &shard, REntry &entry, const RKey &key)
+{
+   R__ASSERT(entry.fNPins > 0);
+   if (--entry.fNPins == 0) {
+      shard.fLru.push_front(key);
+      entry.fLruPosition = shard.fLru.begin();
+   }
+}
+
+void ROOT::Experimental::Detail::RPagePool::Remove(RShard &shard, const RKey &key)
+{
+   auto &column = shard.fColumns[key.first];
+   auto itrEntry = column.fByGlobalIndex.find(key.second);
+   R__ASSERT(itrEntry != column.fByGlobalIndex.end());
+   R__ASSERT(itrEntry->second.fNPins == 0);
+   shard.fLru.erase(itrEntry->second.fLruPosition);
+   auto &page = itrEntry->second.fPage;
+   column.fByClusterIndex.erase(std::make_pair(page.GetClusterInfo().GetId(), page.GetClusterRangeFirst()));
+   fMemoryUsage -= page.GetCapacity();
+   itrEntry->second.fDeleter(page);
+   column.fByGlobalIndex.erase(itrEntry);
+   if (column.fByGlobalIndex.empty())
+      shard.fColumns.erase(key.first);
+}
+
+void ROOT::Experimental::Detail::RPagePool::EvictFromShard(RShard &shard)
+{
+   while ((fMemoryUsage > fMemoryBudget) && !shard.fLru.empty())
+      Remove(shard, shard.fLru.back());
+}
+
+void ROOT::Experimental::Detail::RPagePool::EvictPreloadedPages(DescriptorId_t clusterId)
+{
+   for (auto &shard : fShards) {
+      std::lock_guard<std::mutex> lockGuard(shard.fLock);
+      std::vector<RKey> victims;
+      for (auto &column : shard.fColumns) {
+         const auto &clusterPages = column.second.fByClusterIndex;
+         for (auto itr = clusterPages.lower_bound(std::make_pair(clusterId, ClusterSize_t::ValueType(0)));
+              (itr != clusterPages.end()) && (itr->first.first == clusterId); ++itr) {
+            auto &entry = column.second.fByGlobalIndex.at(itr->second);
+            if (entry.fNPreloads == 0)
+               continue;
+            // The page stays preloaded for the other page sources that preloaded it and did not release the cluster
+            if ((--entry.fNPreloads == 0) && (entry.fNPins == 0))
+               victims.emplace_back(column.first, itr->second);
+         }
+      }
+      for (const auto &key : victims)
+         Remove(shard, key);
+   }
+}
+
+void ROOT::Experimental::Detail::RPagePool::Evict(std::size_t firstShardIndex)
+{
+   // Only one shard lock is held at any given time
+   for (std::size_t i = 0; (i < kNShards) && (fMemoryUsage > fMemoryBudget); ++i) {
+      auto &shard = fShards[(firstShardIndex + i) % kNShards];
+      std::lock_guard<std::mutex> lockGuard(shard.fLock);
+      EvictFromShard(shard);
+   }
+}
+
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::AddPage(
+   const RPage &page, const RPageDeleter &deleter, std::uint32_t nPins)
+{
+   const auto columnId = page.GetColumnId();
+   const auto shardIndex = GetShardIndex(columnId);
+   auto &shard = fShards[shardIndex];
+   RPage result;
+   {
+      std::lock_guard<std::mutex> lockGuard(shard.fLock);
+      auto &column = shard.fColumns[columnId];
+      const RKey key(columnId, page.GetGlobalRangeFirst());
+      auto itrEntry = column.fByGlobalIndex.find(key.second);
+      if (itrEntry != column.fByGlobalIndex.end()) {
+         auto deleterCopy = deleter;
+         deleterCopy(page);
+         if (nPins > 0)
+            Pin(shard, itrEntry->second);
+         else
+            ++itrEntry->second.fNPreloads;
+         return itrEntry->second.fPage;
+      }
+
+      auto &entry = column.fByGlobalIndex[key.second];
+      entry.fPage = page;
+      entry.fDeleter = deleter;
+      entry.fNPins = nPins;
+      entry.fNPreloads = (nPins == 0) ? 1 : 0;
+      if (nPins == 0) {
+         shard.fLru.push_front(key);
+         entry.fLruPosition = shard.fLru.begin();
+      }
+      column.fByClusterIndex[std::make_pair(page.GetClusterInfo().GetId(), page.GetClusterRangeFirst())] = key.second;
+      fMemoryUsage += page.GetCapacity();
+      result = page;
+   }
+   Evict(shardIndex);
+   return result;
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
+{
+   return AddPage(page, deleter, 1);
+}
+
+void ROOT::Experimental::Detail::RPagePool::PreloadPage(const RPage &page, const RPageDeleter &deleter)
+{
+   AddPage(page, deleter, 0);
 }
 
 void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
 {
    if (page.IsNull()) return;
 
-   unsigned int N = fPages.size();
-   for (unsigned i = 0; i < N; ++i) {
-      if (fPages[i] != page) continue;
-
-      if (--fReferences[i] == 0) {
-         fDeleters[i](fPages[i]);
-         fPages[i] = fPages[N-1];
-         fReferences[i] = fReferences[N-1];
-         fDeleters[i] = fDeleters[N-1];
-         fPages.resize(N-1);
-         fReferences.resize(N-1);
-         fDeleters.resize(N-1);
-      }
-      return;
+   const auto columnId = page.GetColumnId();
+   const auto shardIndex = GetShardIndex(columnId);
+   auto &shard = fShards[shardIndex];
+   {
+      std::lock_guard<std::mutex> lockGuard(shard.fLock);
+      auto itrColumn = shard.fColumns.find(columnId);
+      R__ASSERT(itrColumn != shard.fColumns.end());
+      const RKey key(columnId, page.GetGlobalRangeFirst());
+      auto itrEntry = itrColumn->second.fByGlobalIndex.find(key.second);
+      R__ASSERT(itrEntry != itrColumn->second.fByGlobalIndex.end());
+      R__ASSERT(itrEntry->second.fPage == page);
+      Unpin(shard, itrEntry->second, key);
    }
-   R__ASSERT(false);
+   Evict(shardIndex);
 }
 
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
    ColumnId_t columnId, NTupleSize_t globalIndex)
 {
-   unsigned int N = fPages.size();
-   for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] == 0) continue;
-      if (fPages[i].GetColumnId() != columnId) continue;
-      if (!fPages[i].Contains(globalIndex)) continue;
-      fReferences[i]++;
-      return fPages[i];
-   }
-   return RPage();
+   auto &shard = fShards[GetShardIndex(columnId)];
+   std::lock_guard<std::mutex> lockGuard(shard.fLock);
+   auto itrColumn = shard.fColumns.find(columnId);
+   if (itrColumn == shard.fColumns.end())
+      return RPage();
+   const auto &pages = itrColumn->second.fByGlobalIndex;
+   // The last page that starts at or before globalIndex
+   auto itrEntry = itrColumn->second.fByGlobalIndex.upper_bound(globalIndex);
+   if (itrEntry == pages.begin())
+      return RPage();
+   --itrEntry;
+   if (!itrEntry->second.fPage.Contains(globalIndex))
+      return RPage();
+   Pin(shard, itrEntry->second);
+   return itrEntry->second.fPage;
 }
 
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
    ColumnId_t columnId, const RClusterIndex &clusterIndex)
 {
-   unsigned int N = fPages.size();
-   for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] == 0) continue;
-      if (fPages[i].GetColumnId() != columnId) continue;
-      if (!fPages[i].Contains(clusterIndex)) continue;
-      fReferences[i]++;
-      return fPages[i];
-   }
-   return RPage();
+   auto &shard = fShards[GetShardIndex(columnId)];
+   std::lock_guard<std::mutex> lockGuard(shard.fLock);
+   auto itrColumn = shard.fColumns.find(columnId);
+   if (itrColumn == shard.fColumns.end())
+      return RPage();
+   const auto &clusterPages = itrColumn->second.fByClusterIndex;
+   auto itrFirst = clusterPages.upper_bound(std::make_pair(clusterIndex.GetClusterId(), clusterIndex.GetIndex()));
+   if (itrFirst == clusterPages.begin())
+      return RPage();
+   --itrFirst;
+   if (itrFirst->first.first != clusterIndex.GetClusterId())
+      return RPage();
+   auto &entry = itrColumn->second.fByGlobalIndex.at(itrFirst->second);
+   if (!entry.fPage.Contains(clusterIndex))
+      return RPage();
+   Pin(shard, entry);
+   return entry.fPage;
 }
@@ -0,0 +1,125 @@
+/// \file RPageSinkBuf.cxx
+/// \ingroup NTuple ROOT7
+/// \author agent <agent@local>
+/// \date 2020-04-06
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
+#include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RPage.hxx>
+#include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RPageSinkBuf.hxx>
+
+#include <cstring>
+#include <utility>
+
+
+ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(RPageSink &innerSink, std::mutex &innerLock)
+   : RPageSink(innerSink.GetNTupleName(), innerSink.GetWriteOptions())
+   , fMetrics("RPageSinkBuf")
+   , fInnerSink(innerSink)
+   , fInnerLock(innerLock)
+{
+}
+
+ROOT::Experimental::Detail::RPageSinkBuf::~RPageSinkBuf()
+{
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CreateImpl(const RNTupleModel & /* model */)
+{
+   // The inner sink has been created from the original model; the buffered sink only needs the column handles
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   // The page buffer is reused by the column, so the page is packed into a copy and compressed right away in the
+   // calling thread
+   auto element = columnHandle.fColumn->GetElement();
+   const auto packedBytes = (page.GetNElements() * element->GetBitsOnStorage() + 7) / 8;
+   auto packedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[packedBytes]);
+   if (element->IsMappable()) {
+      memcpy(packedBuffer.get(), page.GetBuffer(), packedBytes);
+   } else {
+      element->Pack(packedBuffer.get(), page.GetBuffer(), page.GetNElements());
+   }
+
+   RBufferedPage bufferedPage;
+   bufferedPage.fColumnId = columnHandle.fId;
+   bufferedPage.fNElements = page.GetNElements();
+   const auto compression = fOptions.GetCompression();
+   if (compression % 100 != 0) {
+      bufferedPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[packedBytes]);
+      bufferedPage.fSize = RNTupleCompressor::Zip(packedBuffer.get(), packedBytes, compression,
+                                                  bufferedPage.fBuffer.get());
+   } else {
+      bufferedPage.fBuffer = std::move(packedBuffer);
+      bufferedPage.fSize = packedBytes;
+   }
+   fBufferedPages.emplace_back(std::move(bufferedPage));
+   return RClusterDescriptor::RLocator();
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   RBufferedPage bufferedPage;
+   bufferedPage.fColumnId = columnId;
+   bufferedPage.fNElements = sealedPage.fNElements;
+   bufferedPage.fSize = sealedPage.fSize;
+   bufferedPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[sealedPage.fSize]);
+   memcpy(bufferedPage.fBuffer.get(), sealedPage.fBuffer, sealedPage.fSize);
+   fBufferedPages.emplace_back(std::move(bufferedPage));
+   return RClusterDescriptor::RLocator();
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitClusterImpl(ROOT::Experimental::NTupleSize_t nEntries)
+{
+   const auto nClusterEntries = nEntries - fPrevClusterNEntries;
+   {
+      std::lock_guard<std::mutex> guard(fInnerLock);
+      for (const auto &bufferedPage : fBufferedPages) {
+         fInnerSink.CommitSealedPage(bufferedPage.fColumnId,
+            RSealedPage(bufferedPage.fBuffer.get(), bufferedPage.fSize, bufferedPage.fNElements));
+      }
+      for (const auto &range : fOpenColumnRanges) {
+         if (range.fHasValueRange)
+            fInnerSink.UpdateValueRange(range.fColumnId, range.fMinValue, range.fMaxValue);
+      }
+      fInnerSink.CommitCluster(fInnerSink.GetNEntries() + nClusterEntries);
+   }
+   fBufferedPages.clear();
+   // The buffered sink's own descriptor is not used for storage, the cluster locator is meaningless
+   return RClusterDescriptor::RLocator();
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CommitDatasetImpl()
+{
+   // The data set is committed through the inner sink
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSinkBuf::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
+{
+   if (nElements == 0)
+      nElements = kDefaultElementsPerPage;
+   auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   return RPageAllocatorHeap::NewPage(columnHandle.fId, elementSize, nElements);
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::ReleasePage(RPage &page)
+{
+   RPageAllocatorHeap::DeletePage(page);
+}
@@ -25,6 +25,7 @@
 #include <Compression.h>
 #include <TError.h>
 
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
 
@@ -62,6 +63,7 @@ ROOT::Experimental::Detail::RPageSource::AddColumn(DescriptorId_t fieldId, const
    R__ASSERT(fieldId != kInvalidDescriptorId);
    auto columnId = fDescriptor.FindColumnId(fieldId, column.GetIndex());
    R__ASSERT(columnId != kInvalidDescriptorId);
+   fActiveColumns.emplace(columnId);
    return ColumnHandle_t(columnId, &column);
 }
 
@@ -81,6 +83,14 @@ ROOT::Experimental::ColumnId_t ROOT::Experimental::Detail::RPageSource::GetColum
    return columnHandle.fId;
 }
 
+void ROOT::Experimental::Detail::RPageSource::UnzipCluster(RCluster * /* cluster */)
+{
+}
+
+void ROOT::Experimental::Detail::RPageSource::ReleaseCluster(DescriptorId_t /* clusterId */)
+{
+}
+
 
 //------------------------------------------------------------------------------
 
@@ -155,6 +165,41 @@ void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHand
    pageInfo.fNElements = page.GetNElements();
    pageInfo.fLocator = locator;
    fOpenPageRanges[columnId].fPageInfos.emplace_back(pageInfo);
+
+   if (!fOptions.GetUseValueRanges())
+      return;
+   double min;
+   double max;
+   if (columnHandle.fColumn->GetElement()->GetValueRange(page.GetBuffer(), page.GetNElements(), min, max))
+      UpdateValueRange(columnId, min, max);
+}
+
+
+void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(ROOT::Experimental::DescriptorId_t columnId,
+                                                             const RSealedPage &sealedPage)
+{
+   auto locator = CommitSealedPageImpl(columnId, sealedPage);
+
+   fOpenColumnRanges[columnId].fNElements += sealedPage.fNElements;
+   RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   pageInfo.fNElements = sealedPage.fNElements;
+   pageInfo.fLocator = locator;
+   fOpenPageRanges[columnId].fPageInfos.emplace_back(pageInfo);
+}
+
+
+void ROOT::Experimental::Detail::RPageSink::UpdateValueRange(ROOT::Experimental::DescriptorId_t columnId,
+                                                             double min, double max)
+{
+   auto &range = fOpenColumnRanges[columnId];
+   if (range.fHasValueRange) {
+      range.fMinValue = std::min(range.fMinValue, min);
+      range.fMaxValue = std::max(range.fMaxValue, max);
+   } else {
+      range.fMinValue = min;
+      range.fMaxValue = max;
+      range.fHasValueRange = true;
+   }
 }
 
 
@@ -170,6 +215,7 @@ void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NT
       fDescriptorBuilder.AddClusterColumnRange(fLastClusterId, range);
       range.fFirstElementIndex += range.fNElements;
       range.fNElements = 0;
+      range.fHasValueRange = false;
    }
    for (auto &range : fOpenPageRanges) {
       RClusterDescriptor::RPageRange fullRange;
@@ -13,6 +13,9 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <ROOT/RCluster.hxx>
+#include <ROOT/RClusterPool.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RLogger.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
@@ -28,10 +31,15 @@
 #include <TError.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 
 ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntupleName, std::string_view path,
@@ -96,6 +104,24 @@ void ROOT::Experimental::Detail::RPageSinkFile::CreateImpl(const RNTupleModel &
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
 {
+   if (fOptions.GetUseBufferedWrite()) {
+      // The page buffer is reused by the column, so the page needs to be copied (packed) until the cluster is written
+      auto element = columnHandle.fColumn->GetElement();
+      RBufferedPage bufferedPage;
+      bufferedPage.fColumnId = columnHandle.fId;
+      bufferedPage.fPageIdx = fOpenPageRanges[columnHandle.fId].fPageInfos.size();
+      bufferedPage.fPackedBytes = (page.GetNElements() * element->GetBitsOnStorage() + 7) / 8;
+      bufferedPage.fPackedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[bufferedPage.fPackedBytes]);
+      if (element->IsMappable()) {
+         memcpy(bufferedPage.fPackedBuffer.get(), page.GetBuffer(), bufferedPage.fPackedBytes);
+      } else {
+         element->Pack(bufferedPage.fPackedBuffer.get(), page.GetBuffer(), page.GetNElements());
+      }
+      fBufferedPages.emplace_back(std::move(bufferedPage));
+      // The locator is set when the cluster is committed
+      return RClusterDescriptor::RLocator();
+   }
+
    unsigned char *buffer = reinterpret_cast<unsigned char *>(page.GetBuffer());
    bool isAdoptedBuffer = true;
    auto packedBytes = page.GetSize();
@@ -132,9 +158,105 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnH
 }
 
 
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkFile::CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   if (fOptions.GetUseBufferedWrite()) {
+      RBufferedPage bufferedPage;
+      bufferedPage.fColumnId = columnId;
+      bufferedPage.fPageIdx = fOpenPageRanges[columnId].fPageInfos.size();
+      bufferedPage.fZippedBytes = sealedPage.fSize;
+      bufferedPage.fZippedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[sealedPage.fSize]);
+      memcpy(bufferedPage.fZippedBuffer.get(), sealedPage.fBuffer, sealedPage.fSize);
+      fBufferedPages.emplace_back(std::move(bufferedPage));
+      return RClusterDescriptor::RLocator();
+   }
+
+   auto offsetData = fWriter->WriteBlob(sealedPage.fBuffer, sealedPage.fSize, sealedPage.fSize);
+   fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
+   fClusterMaxOffset = std::max(offsetData, fClusterMaxOffset);
+
+   RClusterDescriptor::RLocator result;
+   result.fPosition = offsetData;
+   result.fBytesOnStorage = sealedPage.fSize;
+   return result;
+}
+
+
+void ROOT::Experimental::Detail::RPageSinkFile::WriteBufferedPages()
+{
+   const auto compression = fOptions.GetCompression();
+   if (compression % 100 != 0) {
+      if (fTaskScheduler)
+         fTaskScheduler->Reset();
+      for (auto &bufferedPage : fBufferedPages) {
+         // Sealed pages are already compressed
+         if (!bufferedPage.fPackedBuffer)
+            continue;
+         auto taskFunc = [&bufferedPage, compression]() {
+            bufferedPage.fZippedBuffer =
+               std::unique_ptr<unsigned char[]>(new unsigned char[bufferedPage.fPackedBytes]);
+            bufferedPage.fZippedBytes = RNTupleCompressor::Zip(bufferedPage.fPackedBuffer.get(),
+               bufferedPage.fPackedBytes, compression, bufferedPage.fZippedBuffer.get());
+            // Free the memory of the uncompressed copy early
+            bufferedPage.fPackedBuffer.reset();
+         };
+         if (fTaskScheduler)
+            fTaskScheduler->AddTask(taskFunc);
+         else
+            taskFunc();
+      }
+      if (fTaskScheduler)
+         fTaskScheduler->Wait();
+   } else {
+      for (auto &bufferedPage : fBufferedPages) {
+         if (!bufferedPage.fPackedBuffer)
+            continue;
+         bufferedPage.fZippedBuffer = std::move(bufferedPage.fPackedBuffer);
+         bufferedPage.fZippedBytes = bufferedPage.fPackedBytes;
+      }
+   }
+
+   // Concatenate the sealed pages into blobs and write them sequentially
+   std::vector<unsigned char> blob;
+   auto itrFirstInBlob = fBufferedPages.begin();
+   while (itrFirstInBlob != fBufferedPages.end()) {
+      std::size_t szBlob = 0;
+      auto itrLastInBlob = itrFirstInBlob;
+      do {
+         szBlob += itrLastInBlob->fZippedBytes;
+         ++itrLastInBlob;
+      } while ((itrLastInBlob != fBufferedPages.end()) && (szBlob + itrLastInBlob->fZippedBytes <= kMaxBlobSize));
+
+      blob.resize(szBlob);
+      std::size_t posInBlob = 0;
+      for (auto itr = itrFirstInBlob; itr != itrLastInBlob; ++itr) {
+         memcpy(blob.data() + posInBlob, itr->fZippedBuffer.get(), itr->fZippedBytes);
+         posInBlob += itr->fZippedBytes;
+      }
+      auto offsetBlob = fWriter->WriteBlob(blob.data(), szBlob, szBlob);
+
+      posInBlob = 0;
+      for (auto itr = itrFirstInBlob; itr != itrLastInBlob; ++itr) {
+         auto &locator = fOpenPageRanges[itr->fColumnId].fPageInfos[itr->fPageIdx].fLocator;
+         locator.fPosition = offsetBlob + posInBlob;
+         locator.fBytesOnStorage = itr->fZippedBytes;
+         fClusterMinOffset = std::min(offsetBlob + posInBlob, fClusterMinOffset);
+         fClusterMaxOffset = std::max(offsetBlob + posInBlob, fClusterMaxOffset);
+         posInBlob += itr->fZippedBytes;
+      }
+      itrFirstInBlob = itrLastInBlob;
+   }
+   fBufferedPages.clear();
+}
+
+
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */)
 {
+   if (!fBufferedPages.empty())
+      WriteBufferedPages();
+
    RClusterDescriptor::RLocator result;
    result.fPosition = fClusterMinOffset;
    result.fBytesOnStorage = fClusterMaxOffset - fClusterMinOffset;
@@ -201,8 +323,21 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
    : RPageSource(ntupleName, options)
    , fMetrics("RPageSourceFile")
    , fPageAllocator(std::make_unique<RPageAllocatorFile>())
-   , fPagePool(std::make_shared<RPagePool>())
+   , fPagePool(std::make_shared<RPagePool>(options.GetPagePoolBudget()))
 {
+   fCtrNReadV = fMetrics.MakeCounter<RNTupleAtomicCounter *>("nReadV", "", "number of vector read requests");
+   fCtrSzReadPayload = fMetrics.MakeCounter<RNTupleAtomicCounter *>("szReadPayload", "B",
+      "volume read from the file (compressed pages)");
+   fCtrSzUnzip = fMetrics.MakeCounter<RNTupleAtomicCounter *>("szUnzip", "B", "volume after unzipping and unpacking");
+   fCtrNPageMapped = fMetrics.MakeCounter<RNTupleAtomicCounter *>("nPageMapped", "",
+      "number of pages used in place in the memory mapped file");
+   fHistoTimeRead = fMetrics.MakeCounter<RNTupleLatencyHistogram *>("timeRead", "ns", "latency of read requests");
+   fHistoTimeUnzip = fMetrics.MakeCounter<RNTupleLatencyHistogram *>("timeUnzip", "ns",
+      "latency of unzipping and unpacking a page");
+   fHistoTimePopulate = fMetrics.MakeCounter<RNTupleLatencyHistogram *>("timePopulate", "ns",
+      "latency of populating a page");
+   if (options.GetClusterCache() != RNTupleReadOptions::EClusterCache::kOff)
+      fClusterPool = std::make_unique<RClusterPool>(*this, options.GetClusterBunchSize());
 }
 
 
@@ -218,6 +353,10 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
 
 ROOT::Experimental::Detail::RPageSourceFile::~RPageSourceFile()
 {
+   // Stop the background threads before the mapped pages go away
+   fClusterPool.reset();
+   if (fMappedFile)
+      fFile->Unmap(fMappedFile, fMappedFileSize);
 }
 
 
@@ -237,8 +376,85 @@ ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Detail::RPageSourceFil
    fReader.ReadBuffer(zipBuffer.get(), fNTuple.fNBytesFooter, fNTuple.fSeekFooter);
    fDecompressor(zipBuffer.get(), fNTuple.fNBytesFooter, fNTuple.fLenFooter, buffer.get());
    descBuilder.AddClustersFromFooter(buffer.get());
+   auto descriptor = descBuilder.MoveDescriptor();
+
+   // Column ids are consecutive, starting from zero
+   for (std::size_t i = fCtrSzReadColumn.size(); i < descriptor.GetNColumns(); ++i) {
+      const auto &fieldDesc = descriptor.GetFieldDescriptor(descriptor.GetColumnDescriptor(i).GetFieldId());
+      fCtrSzReadColumn.emplace_back(fMetrics.MakeCounter<RNTupleAtomicCounter *>("szReadColumn" + std::to_string(i),
+         "B", "volume read from the file for column " + std::to_string(i) + " of field " + fieldDesc.GetFieldName()));
+      // One counter per column would flood the printout of the metrics; they are part of the JSON export only
+      fCtrSzReadColumn.back()->SetDetailed();
+   }
 
-   return descBuilder.MoveDescriptor();
+   if (fOptions.GetUseMemoryMap() && (fFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap)) {
+      fMappedFileSize = fFile->GetSize();
+      std::uint64_t mapdOffset;
+      try {
+         fMappedFile = fFile->Map(fMappedFileSize, 0, mapdOffset);
+         R__ASSERT(mapdOffset == 0);
+      } catch (const std::runtime_error &err) {
+         // Not an error: fall back to reading pages into memory buffers
+         R__DEBUG_HERE("NTuple") << "cannot memory map '" << fNTupleName << "': " << err.what();
+         fMappedFile = nullptr;
+         fMappedFileSize = 0;
+      }
+   }
+
+   return descriptor;
+}
+
+
+void *ROOT::Experimental::Detail::RPageSourceFile::GetMappedPage(
+   const RColumnElementBase &element, const RClusterDescriptor::RPageRange::RPageInfo &pageInfo) const
+{
+   if (!fMappedFile || !element.IsMappable())
+      return nullptr;
+   const auto bytesPacked = (element.GetBitsOnStorage() * pageInfo.fNElements + 7) / 8;
+   if (pageInfo.fLocator.fBytesOnStorage != bytesPacked)
+      return nullptr;
+   const auto &locator = pageInfo.fLocator;
+   if ((locator.fPosition < 0) ||
+       (static_cast<std::uint64_t>(locator.fPosition) + locator.fBytesOnStorage > fMappedFileSize))
+      return nullptr;
+
+   auto address = reinterpret_cast<unsigned char *>(fMappedFile) + locator.fPosition;
+   // The largest power of two that divides the element size gives the natural alignment of the element type
+   const std::size_t elementSize = element.GetSize();
+   const std::size_t alignment = std::min(elementSize & (~elementSize + 1), alignof(std::max_align_t));
+   if (reinterpret_cast<std::uintptr_t>(address) % alignment != 0)
+      return nullptr;
+   return address;
+}
+
+
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::UnsealPage(
+   const void *sealedBuffer, std::uint32_t sealedSize, const RColumnElementBase &element,
+   ColumnId_t columnId, ClusterSize_t::ValueType nElements)
+{
+   const auto elementSize = element.GetSize();
+   const auto bytesPacked = (element.GetBitsOnStorage() * nElements + 7) / 8;
+   const auto bytesUnpacked = elementSize * nElements;
+
+   RNTupleLatencyTimer timer(*fHistoTimeUnzip);
+   fCtrSzUnzip->Add(bytesUnpacked);
+
+   // Decompression does not use the decompressor's shared unzip buffer and can thus run concurrently
+   auto pageBuffer = new unsigned char[std::max(bytesPacked, bytesUnpacked)];
+   if (sealedSize != bytesPacked) {
+      fDecompressor(sealedBuffer, sealedSize, bytesPacked, pageBuffer);
+   } else {
+      memcpy(pageBuffer, sealedBuffer, bytesPacked);
+   }
+
+   if (!element.IsMappable()) {
+      auto unpackedBuffer = new unsigned char[bytesUnpacked];
+      element.Unpack(unpackedBuffer, pageBuffer, nElements);
+      delete[] pageBuffer;
+      pageBuffer = unpackedBuffer;
+   }
+
+   return fPageAllocator->NewPage(columnId, pageBuffer, elementSize, nElements);
 }
 
 
@@ -252,53 +468,76 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    // TODO(jblomer): binary search
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    decltype(clusterIndex) firstInPage = 0;
+   NTupleSize_t pageNo = 0;
    for (const auto &pi : pageRange.fPageInfos) {
       if (firstInPage + pi.fNElements > clusterIndex) {
          pageInfo = pi;
          break;
       }
       firstInPage += pi.fNElements;
+      ++pageNo;
    }
    R__ASSERT(firstInPage <= clusterIndex);
    R__ASSERT((firstInPage + pageInfo.fNElements) > clusterIndex);
 
    const auto element = columnHandle.fColumn->GetElement();
-   const auto elementSize = element->GetSize();
-
-   auto pageSize = pageInfo.fLocator.fBytesOnStorage;
-   auto pageBuffer = new unsigned char[
-      std::max(pageSize, static_cast<std::uint32_t>(elementSize * pageInfo.fNElements))];
-   fReader.ReadBuffer(pageBuffer, pageInfo.fLocator.fBytesOnStorage, pageInfo.fLocator.fPosition);
+   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
 
-   const auto bytesOnStorage = (element->GetBitsOnStorage() * pageInfo.fNElements + 7) / 8;
-   if (pageSize != bytesOnStorage) {
-      fDecompressor(pageBuffer, pageSize, bytesOnStorage);
-      pageSize = bytesOnStorage;
+   // Zero-copy path: the page is used in place in the memory mapped file
+   if (auto mappedPage = GetMappedPage(*element, pageInfo)) {
+      fCtrNPageMapped->Inc();
+      auto newPage = fPageAllocator->NewPage(columnId, mappedPage, element->GetSize(), pageInfo.fNElements);
+      newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+      return fPagePool->RegisterPage(newPage,
+         RPageDeleter([](const RPage & /*page*/, void * /*userData*/) {}, nullptr));
    }
 
-   if (!element->IsMappable()) {
-      pageSize = elementSize * pageInfo.fNElements;
-      auto unpackedBuffer = new unsigned char[pageSize];
-      element->Unpack(unpackedBuffer, pageBuffer, pageInfo.fNElements);
-      delete[] pageBuffer;
-      pageBuffer = unpackedBuffer;
+   // Points either to directReadBuffer or to a read-only page in the cluster
+   const void *sealedPageBuffer = nullptr;
+   // Only used if the cluster pool is turned off
+   std::unique_ptr<unsigned char[]> directReadBuffer;
+   if (!fClusterPool) {
+      directReadBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pageInfo.fLocator.fBytesOnStorage]);
+      {
+         RNTupleLatencyTimer timer(*fHistoTimeRead);
+         fReader.ReadBuffer(directReadBuffer.get(), pageInfo.fLocator.fBytesOnStorage, pageInfo.fLocator.fPosition);
+      }
+      fCtrNReadV->Inc();
+      fCtrSzReadPayload->Add(pageInfo.fLocator.fBytesOnStorage);
+      fCtrSzReadColumn[columnId]->Add(pageInfo.fLocator.fBytesOnStorage);
+      sealedPageBuffer = directReadBuffer.get();
+   } else {
+      if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
+         fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
+      R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
+
+      // The unzip thread might have preloaded the page by now
+      auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, clusterIndex));
+      if (!cachedPage.IsNull())
+         return cachedPage;
+
+      ROnDiskPage::Key key(columnId, pageNo);
+      auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
+      R__ASSERT(onDiskPage);
+      R__ASSERT(onDiskPage->GetSize() == pageInfo.fLocator.fBytesOnStorage);
+      sealedPageBuffer = onDiskPage->GetAddress();
    }
 
-   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
-   auto newPage = fPageAllocator->NewPage(columnId, pageBuffer, elementSize, pageInfo.fNElements);
+   auto newPage = UnsealPage(sealedPageBuffer, pageInfo.fLocator.fBytesOnStorage, *element,
+                             columnId, pageInfo.fNElements);
    newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
-   fPagePool->RegisterPage(newPage,
+   return fPagePool->RegisterPage(newPage,
       RPageDeleter([](const RPage &page, void * /*userData*/)
       {
          RPageAllocatorFile::DeletePage(page);
       }, nullptr));
-   return newPage;
 }
 
 
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePage(
    ColumnHandle_t columnHandle, NTupleSize_t globalIndex)
 {
+   RNTupleLatencyTimer timer(*fHistoTimePopulate);
    const auto columnId = columnHandle.fId;
    auto cachedPage = fPagePool->GetPage(columnId, globalIndex);
    if (!cachedPage.IsNull())
@@ -316,6 +555,7 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePage(
    ColumnHandle_t columnHandle, const RClusterIndex &clusterIndex)
 {
+   RNTupleLatencyTimer timer(*fHistoTimePopulate);
    const auto clusterId = clusterIndex.GetClusterId();
    const auto index = clusterIndex.GetIndex();
    const auto columnId = columnHandle.fId;
@@ -338,5 +578,147 @@ std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Det
    auto clone = new RPageSourceFile(fNTupleName, fOptions);
    clone->fFile = fFile->Clone();
    clone->fReader = Internal::RMiniFileReader(clone->fFile.get());
+   // Clones share the unzipped pages.  Memory mapped pages point into the file mapping of the source that
+   // registered them and thus cannot outlive it.
+   if (!fOptions.GetUseMemoryMap())
+      clone->fPagePool = fPagePool;
    return std::unique_ptr<RPageSourceFile>(clone);
 }
+
+std::unique_ptr<ROOT::Experimental::Detail::RCluster>
+ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
+{
+   const auto &clusterDesc = GetDescriptor().GetClusterDescriptor(clusterId);
+
+   struct ROnDiskPageLocator {
+      ROnDiskPageLocator() = default;
+      ROnDiskPageLocator(DescriptorId_t c, NTupleSize_t p, std::uint64_t o, std::uint64_t s)
+         : fColumnId(c), fPageNo(p), fOffset(o), fSize(s) {}
+      DescriptorId_t fColumnId = 0;
+      NTupleSize_t fPageNo = 0;
+      std::uint64_t fOffset = 0;
+      std::uint64_t fSize = 0;
+      std::size_t fBufPos = 0;
+   };
+
+   // Collect the necessary page meta-data and sum up the total size of the compressed and packed pages
+   std::vector<ROnDiskPageLocator> onDiskPages;
+   std::size_t szPayload = 0;
+   for (auto columnId : columns) {
+      const auto &pageRange = clusterDesc.GetPageRange(columnId);
+      const auto element = RColumnElementBase::Generate(fDescriptor.GetColumnDescriptor(columnId).GetModel().GetType());
+      NTupleSize_t pageNo = 0;
+      for (const auto &pageInfo : pageRange.fPageInfos) {
+         // Pages that are used in place in the memory mapped file need not be read
+         if (GetMappedPage(*element, pageInfo)) {
+            ++pageNo;
+            continue;
+         }
+         const auto &pageLocator = pageInfo.fLocator;
+         onDiskPages.emplace_back(ROnDiskPageLocator(
+            columnId, pageNo, pageLocator.fPosition, pageLocator.fBytesOnStorage));
+         szPayload += pageLocator.fBytesOnStorage;
+         ++pageNo;
+      }
+   }
+
+   // Linearize the page requests by file offset
+   std::sort(onDiskPages.begin(), onDiskPages.end(),
+      [](const ROnDiskPageLocator &a, const ROnDiskPageLocator &b) {return a.fOffset < b.fOffset;});
+
+   // All the pages of the cluster go into a single memory block; they are read with a single vector request
+   auto buffer = std::unique_ptr<unsigned char[]>(new unsigned char[szPayload]);
+   std::vector<ROOT::Internal::RRawFile::RIOVec> readRequests(onDiskPages.size());
+   std::size_t bufPos = 0;
+   for (std::size_t i = 0; i < onDiskPages.size(); ++i) {
+      auto &s = onDiskPages[i];
+      s.fBufPos = bufPos;
+      readRequests[i].fBuffer = buffer.get() + bufPos;
+      readRequests[i].fOffset = s.fOffset;
+      readRequests[i].fSize = s.fSize;
+      bufPos += s.fSize;
+   }
+   {
+      RNTupleLatencyTimer timer(*fHistoTimeRead);
+      fFile->ReadV(readRequests.data(), readRequests.size());
+   }
+   fCtrNReadV->Inc();
+   fCtrSzReadPayload->Add(szPayload);
+
+   auto pageMap = std::make_unique<ROnDiskPageMapHeap>(std::move(buffer));
+   for (std::size_t i = 0; i < onDiskPages.size(); ++i) {
+      const auto &s = onDiskPages[i];
+      R__ASSERT(readRequests[i].fOutBytes == s.fSize);
+      fCtrSzReadColumn[s.fColumnId]->Add(s.fSize);
+      ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
+      pageMap->Register(key, ROnDiskPage(readRequests[i].fBuffer, s.fSize));
+   }
+
+   auto cluster = std::make_unique<RCluster>(clusterId);
+   cluster->Adopt(std::move(pageMap));
+   for (auto colId : columns)
+      cluster->SetColumnAvailable(colId);
+   return cluster;
+}
+
+void ROOT::Experimental::Detail::RPageSourceFile::UnzipCluster(RCluster *cluster)
+{
+   const auto clusterId = cluster->GetId();
+   const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
+
+   if (fTaskScheduler)
+      fTaskScheduler->Reset();
+
+   // The page elements are used by the unzip tasks and thus must outlive them
+   std::vector<std::unique_ptr<RColumnElementBase>> allElements;
+
+   for (const auto columnId : cluster->GetAvailColumns()) {
+      const auto &columnDesc = fDescriptor.GetColumnDescriptor(columnId);
+      allElements.emplace_back(RColumnElementBase::Generate(columnDesc.GetModel().GetType()));
+      const RColumnElementBase *element = allElements.back().get();
+
+      const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+      const auto &pageRange = clusterDescriptor.GetPageRange(columnId);
+      NTupleSize_t pageNo = 0;
+      NTupleSize_t firstInPage = 0;
+      for (const auto &pi : pageRange.fPageInfos) {
+         if (GetMappedPage(*element, pi)) {
+            firstInPage += pi.fNElements;
+            ++pageNo;
+            continue;
+         }
+
+         ROnDiskPage::Key key(columnId, pageNo);
+         const auto onDiskPage = cluster->GetOnDiskPage(key);
+         R__ASSERT(onDiskPage);
+         R__ASSERT(onDiskPage->GetSize() == pi.fLocator.fBytesOnStorage);
+         const auto nElements = pi.fNElements;
+
+         auto taskFunc = [this, columnId, clusterId, firstInPage, onDiskPage, element, nElements, indexOffset]() {
+            auto newPage = UnsealPage(onDiskPage->GetAddress(), onDiskPage->GetSize(), *element, columnId, nElements);
+            newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+            fPagePool->PreloadPage(newPage,
+               RPageDeleter([](const RPage &page, void * /*userData*/)
+               {
+                  RPageAllocatorFile::DeletePage(page);
+               }, nullptr));
+         };
+
+         if (fTaskScheduler)
+            fTaskScheduler->AddTask(taskFunc);
+         else
+            taskFunc();
+
+         firstInPage += nElements;
+         ++pageNo;
+      }
+   }
+
+   if (fTaskScheduler)
+      fTaskScheduler->Wait();
+}
+
+void ROOT::Experimental::Detail::RPageSourceFile::ReleaseCluster(DescriptorId_t clusterId)
+{
+   fPagePool->EvictPreloadedPages(clusterId);
+}
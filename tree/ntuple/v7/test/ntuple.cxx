@@ -20,20 +20,29 @@
 #include <array>
 #include <cstdio>
 #include <exception>
+#include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #if __cplusplus >= 201703L
 #include <variant>
 #endif
 
+using ClusterSize_t = ROOT::Experimental::ClusterSize_t;
 using DescriptorId_t = ROOT::Experimental::DescriptorId_t;
 using EColumnType = ROOT::Experimental::EColumnType;
+using ENTupleInfo = ROOT::Experimental::ENTupleInfo;
 using ENTupleStructure = ROOT::Experimental::ENTupleStructure;
 using NTupleSize_t = ROOT::Experimental::NTupleSize_t;
+using RClusterIndex = ROOT::Experimental::RClusterIndex;
 using RColumnModel = ROOT::Experimental::RColumnModel;
 using RNTupleDescriptor = ROOT::Experimental::RNTupleDescriptor;
 using RNTupleDescriptorBuilder = ROOT::Experimental::RNTupleDescriptorBuilder;
+using RNTupleFillContext = ROOT::Experimental::RNTupleFillContext;
+using RNTupleParallelWriter = ROOT::Experimental::RNTupleParallelWriter;
 using RNTupleReader = ROOT::Experimental::RNTupleReader;
 using RNTupleReadOptions = ROOT::Experimental::RNTupleReadOptions;
 using RNTupleWriter = ROOT::Experimental::RNTupleWriter;
@@ -434,6 +443,292 @@ TEST(RNTuple, Clusters)
 }
 
 
+TEST(RNTuple, MemoryMap)
+{
+   FileRaii fileGuard("test_ntuple_memorymap.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto wrEnergy = model->MakeField<double>("energy");
+      auto wrHits = model->MakeField<std::vector<std::int32_t>>("hits");
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      RNTupleWriter ntuple(std::move(model),
+         std::make_unique<RPageSinkFile>("myNTuple", fileGuard.GetPath(), options));
+      for (unsigned int i = 0; i < 50000; ++i) {
+         *wrEnergy = i;
+         wrHits->assign(i % 4, i);
+         ntuple.Fill();
+         if (i % 20000 == 19999)
+            ntuple.CommitCluster();
+      }
+   }
+
+   auto nPageMapped = [](RNTupleReader &ntuple) -> long long {
+      std::ostringstream os;
+      ntuple.PrintInfo(ENTupleInfo::kMetricsJSON, os);
+      const auto json = os.str();
+      auto pos = json.find("\"RNTupleReader.RPageSourceFile.nPageMapped\"");
+      if (pos == std::string::npos)
+         return -1;
+      pos = json.find("\"value\": ", pos);
+      return std::stoll(json.substr(pos + 9));
+   };
+
+   for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOff, RNTupleReadOptions::EClusterCache::kOn}) {
+      RNTupleReadOptions options;
+      options.SetUseMemoryMap(true);
+      options.SetClusterCache(clusterCache);
+      RNTupleReader ntuple(std::make_unique<RPageSourceFile>("myNTuple", fileGuard.GetPath(), options));
+      ntuple.EnableMetrics();
+      EXPECT_EQ(50000U, ntuple.GetNEntries());
+
+      auto viewEnergy = ntuple.GetView<double>("energy");
+      auto viewHits = ntuple.GetView<std::vector<std::int32_t>>("hits");
+      for (auto i : ntuple.GetEntryRange()) {
+         ASSERT_EQ(static_cast<double>(i), viewEnergy(i));
+         ASSERT_EQ(std::vector<std::int32_t>(i % 4, i), viewHits(i));
+      }
+      // The pages that are suitably aligned in the file are used in place
+      EXPECT_GT(nPageMapped(ntuple), 0);
+   }
+
+   RNTupleReader ntuple(std::make_unique<RPageSourceFile>("myNTuple", fileGuard.GetPath(), RNTupleReadOptions()));
+   ntuple.EnableMetrics();
+   auto viewEnergy = ntuple.GetView<double>("energy");
+   EXPECT_EQ(42.0, viewEnergy(42));
+   EXPECT_EQ(0, nPageMapped(ntuple));
+}
+
+
+TEST(RNTuple, BufferedWrite)
+{
+   FileRaii fileGuardBuffered("test_ntuple_buffered.root");
+   FileRaii fileGuardUnbuffered("test_ntuple_unbuffered.root");
+
+   for (bool useBufferedWrite : {true, false}) {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrFlags = model->MakeField<std::vector<bool>>("flags");
+      auto wrTag = model->MakeField<std::string>("tag");
+      RNTupleWriteOptions options;
+      options.SetUseBufferedWrite(useBufferedWrite);
+      auto path = useBufferedWrite ? fileGuardBuffered.GetPath() : fileGuardUnbuffered.GetPath();
+      RNTupleWriter ntuple(std::move(model), std::make_unique<RPageSinkFile>("myNTuple", path, options));
+      for (unsigned int i = 0; i < 25000; ++i) {
+         *wrPt = i;
+         wrFlags->assign(i % 3, i % 2);
+         *wrTag = std::to_string(i);
+         ntuple.Fill();
+         if (i % 10000 == 9999)
+            ntuple.CommitCluster();
+      }
+   }
+
+   auto ntupleBuffered = RNTupleReader::Open("myNTuple", fileGuardBuffered.GetPath());
+   auto ntupleUnbuffered = RNTupleReader::Open("myNTuple", fileGuardUnbuffered.GetPath());
+   EXPECT_EQ(25000U, ntupleBuffered->GetNEntries());
+   EXPECT_EQ(25000U, ntupleUnbuffered->GetNEntries());
+   EXPECT_EQ(3U, ntupleBuffered->GetDescriptor().GetNClusters());
+
+   auto viewPt = ntupleBuffered->GetView<float>("pt");
+   auto viewFlags = ntupleBuffered->GetView<std::vector<bool>>("flags");
+   auto viewTag = ntupleBuffered->GetView<std::string>("tag");
+   auto viewPtUnbuffered = ntupleUnbuffered->GetView<float>("pt");
+   auto viewTagUnbuffered = ntupleUnbuffered->GetView<std::string>("tag");
+   for (auto i : ntupleBuffered->GetEntryRange()) {
+      ASSERT_EQ(static_cast<float>(i), viewPt(i));
+      ASSERT_EQ(std::vector<bool>(i % 3, i % 2), viewFlags(i));
+      ASSERT_EQ(std::to_string(i), viewTag(i));
+      ASSERT_EQ(viewPtUnbuffered(i), viewPt(i));
+      ASSERT_EQ(viewTagUnbuffered(i), viewTag(i));
+   }
+}
+
+
+TEST(RNTuple, SplitEncoding)
+{
+   FileRaii fileGuardSplit("test_ntuple_split.root");
+   FileRaii fileGuardPlain("test_ntuple_plain.root");
+
+   for (bool useSplitEncoding : {true, false}) {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrHits = model->MakeField<std::vector<double>>("hits");
+      auto wrFlags = model->MakeField<std::vector<bool>>("flags");
+      RNTupleWriteOptions options;
+      options.SetUseSplitEncoding(useSplitEncoding);
+      auto path = useSplitEncoding ? fileGuardSplit.GetPath() : fileGuardPlain.GetPath();
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", path, options);
+      for (unsigned int i = 0; i < 20000; ++i) {
+         *wrPt = i;
+         wrHits->assign(i % 5, -0.5 * i);
+         wrFlags->assign(i % 3, i % 2);
+         ntuple->Fill();
+      }
+   }
+
+   auto ntupleSplit = RNTupleReader::Open("myNTuple", fileGuardSplit.GetPath());
+   auto ntuplePlain = RNTupleReader::Open("myNTuple", fileGuardPlain.GetPath());
+   const auto &descSplit = ntupleSplit->GetDescriptor();
+   const auto &descPlain = ntuplePlain->GetDescriptor();
+   auto typeOf = [](const RNTupleDescriptor &desc, DescriptorId_t fieldId) {
+      return desc.GetColumnDescriptor(desc.FindColumnId(fieldId, 0)).GetModel().GetType();
+   };
+   auto typeOfTopLevel = [&typeOf](const RNTupleDescriptor &desc, std::string_view fieldName) {
+      return typeOf(desc, desc.FindFieldId(fieldName));
+   };
+   EXPECT_EQ(EColumnType::kSplitReal32, typeOfTopLevel(descSplit, "pt"));
+   EXPECT_EQ(EColumnType::kSplitIndex, typeOfTopLevel(descSplit, "hits"));
+   auto hitsItemId = descSplit.FindFieldId("double", descSplit.FindFieldId("hits"));
+   EXPECT_EQ(EColumnType::kSplitReal64, typeOf(descSplit, hitsItemId));
+   auto flagsItemId = descSplit.FindFieldId("bool", descSplit.FindFieldId("flags"));
+   EXPECT_EQ(EColumnType::kBit, typeOf(descSplit, flagsItemId));
+   EXPECT_EQ(EColumnType::kReal32, typeOfTopLevel(descPlain, "pt"));
+   EXPECT_EQ(EColumnType::kIndex, typeOfTopLevel(descPlain, "hits"));
+
+   auto viewPt = ntupleSplit->GetView<float>("pt");
+   auto viewHits = ntupleSplit->GetView<std::vector<double>>("hits");
+   auto viewFlags = ntupleSplit->GetView<std::vector<bool>>("flags");
+   for (auto i : ntupleSplit->GetEntryRange()) {
+      ASSERT_EQ(static_cast<float>(i), viewPt(i));
+      ASSERT_EQ(std::vector<double>(i % 5, -0.5 * i), viewHits(i));
+      ASSERT_EQ(std::vector<bool>(i % 3, i % 2), viewFlags(i));
+   }
+}
+
+TEST(RNTuple, ValueRanges)
+{
+   FileRaii fileGuard("test_ntuple_value_ranges.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrCharge = model->MakeField<std::int32_t>("charge");
+      auto wrHits = model->MakeField<std::vector<double>>("hits");
+      RNTupleWriteOptions options;
+      options.SetUseValueRanges(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), options);
+      // Ten clusters with pt in [100 * i, 100 * i + 99]
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i;
+         *wrCharge = (i % 2) ? 1 : -1;
+         wrHits->assign(1, (i % 100 == 0) ? std::numeric_limits<double>::quiet_NaN() : -1.0 * i);
+         ntuple->Fill();
+         if (i % 100 == 99)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   EXPECT_EQ(10U, desc.GetNClusters());
+   auto ptColumnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+   auto hitsColumnId = desc.FindColumnId(desc.FindFieldId("double", desc.FindFieldId("hits")), 0);
+   auto offsetColumnId = desc.FindColumnId(desc.FindFieldId("hits"), 0);
+   auto chargeColumnId = desc.FindColumnId(desc.FindFieldId("charge"), 0);
+   for (DescriptorId_t i = 0; i < 10; ++i) {
+      const auto &clusterDesc = desc.GetClusterDescriptor(desc.FindClusterId(ptColumnId, 100 * i));
+      const auto &ptRange = clusterDesc.GetColumnRange(ptColumnId);
+      EXPECT_TRUE(ptRange.fHasValueRange);
+      EXPECT_EQ(100.0 * i, ptRange.fMinValue);
+      EXPECT_EQ(100.0 * i + 99, ptRange.fMaxValue);
+      // The NaN in the first entry of every cluster is ignored
+      const auto &hitsRange = clusterDesc.GetColumnRange(hitsColumnId);
+      EXPECT_TRUE(hitsRange.fHasValueRange);
+      EXPECT_EQ(-100.0 * i - 99, hitsRange.fMinValue);
+      EXPECT_EQ(-100.0 * i - 1, hitsRange.fMaxValue);
+      EXPECT_EQ(-1.0, clusterDesc.GetColumnRange(chargeColumnId).fMinValue);
+      EXPECT_EQ(1.0, clusterDesc.GetColumnRange(chargeColumnId).fMaxValue);
+      // Collection offsets are no values
+      EXPECT_FALSE(clusterDesc.GetColumnRange(offsetColumnId).fHasValueRange);
+   }
+   EXPECT_EQ(2U, desc.FindClusterIdsInValueRange(ptColumnId, 150.0, 250.0).size());
+   EXPECT_EQ(1U, desc.FindClusterIdsInValueRange(ptColumnId, 199.5, 199.5).size());
+   EXPECT_TRUE(desc.FindClusterIdsInValueRange(ptColumnId, 1000.0, 2000.0).empty());
+   EXPECT_EQ(10U, desc.FindClusterIdsInValueRange(offsetColumnId, 0.0, 0.0).size());
+
+   auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath(),
+                                                      {{"pt", {150.0, 250.0}}, {"charge", {0.0, 1.0}}});
+   EXPECT_THROW(ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath(), {{"nonexisting", {0.0, 1.0}}}),
+                std::runtime_error);
+   auto nProcessed = rdf.Count();
+   auto nSelected = rdf.Filter([](float pt) { return pt >= 150 && pt <= 250; }, {"pt"}).Count();
+   EXPECT_EQ(200U, *nProcessed);
+   EXPECT_EQ(101U, *nSelected);
+
+   // Without value ranges in the write options, no cluster is skipped
+   FileRaii fileGuardNoRanges("test_ntuple_no_value_ranges.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto writer = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuardNoRanges.GetPath());
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i;
+         writer->Fill();
+         if (i % 100 == 99)
+            writer->CommitCluster();
+      }
+   }
+   auto reader = RNTupleReader::Open("myNTuple", fileGuardNoRanges.GetPath());
+   const auto &descNoRanges = reader->GetDescriptor();
+   ptColumnId = descNoRanges.FindColumnId(descNoRanges.FindFieldId("pt"), 0);
+   EXPECT_FALSE(descNoRanges.GetClusterDescriptor(0).GetColumnRange(ptColumnId).fHasValueRange);
+   EXPECT_EQ(10U, descNoRanges.FindClusterIdsInValueRange(ptColumnId, 150.0, 250.0).size());
+}
+
+TEST(RNTuple, ParallelWriter)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer.root");
+
+   static constexpr unsigned int kNThreads = 4;
+   static constexpr unsigned int kNEntriesPerThread = 5000;
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<float>("pt");
+      model->MakeField<std::vector<std::int32_t>>("vec");
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+
+      std::vector<std::thread> threads;
+      for (unsigned int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&writer, t]() {
+            auto context = writer->CreateFillContext();
+            auto entry = context->GetModel()->GetDefaultEntry();
+            auto wrPt = entry->Get<float>("pt");
+            auto wrVec = entry->Get<std::vector<std::int32_t>>("vec");
+            for (unsigned int i = 0; i < kNEntriesPerThread; ++i) {
+               const auto value = t * kNEntriesPerThread + i;
+               *wrPt = value;
+               wrVec->assign(value % 4, value);
+               context->Fill();
+               if (i % 1000 == 999)
+                  context->CommitCluster();
+            }
+            EXPECT_EQ(kNEntriesPerThread, context->GetNEntries());
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   EXPECT_EQ(kNThreads * kNEntriesPerThread, ntuple->GetNEntries());
+   EXPECT_EQ(kNThreads * kNEntriesPerThread / 1000, ntuple->GetDescriptor().GetNClusters());
+
+   // The clusters of the different threads are interleaved but every entry is present exactly once
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewVec = ntuple->GetView<std::vector<std::int32_t>>("vec");
+   std::vector<bool> seen(kNThreads * kNEntriesPerThread, false);
+   for (auto i : ntuple->GetEntryRange()) {
+      const auto value = static_cast<std::int32_t>(viewPt(i));
+      ASSERT_LT(static_cast<std::size_t>(value), seen.size());
+      EXPECT_FALSE(seen[value]);
+      seen[value] = true;
+      EXPECT_EQ(std::vector<std::int32_t>(value % 4, value), viewVec(i));
+   }
+}
+
+
 #if __cplusplus >= 201703L
 TEST(RNTuple, Variant)
 {
@@ -525,6 +820,110 @@ TEST(RNTuple, View)
    EXPECT_EQ(3, n);
 }
 
+TEST(RNTuple, BulkRead)
+{
+   FileRaii fileGuard("test_ntuple_bulk_read.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrTag = model->MakeField<std::string>("tag");
+      auto wrJets = model->MakeField<std::vector<float>>("jets");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < 25000; ++i) {
+         *wrPt = i;
+         *wrTag = std::to_string(i);
+         wrJets->assign(i % 4, i);
+         ntuple->Fill();
+         if (i == 11999)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   const auto nEntries = ntuple->GetNEntries();
+   ASSERT_EQ(25000U, nEntries);
+
+   // Crosses page and cluster boundaries
+   auto viewPt = ntuple->GetView<float>("pt");
+   std::vector<float> pt(nEntries);
+   viewPt.ReadBulk(0, pt);
+   for (unsigned int i = 0; i < nEntries; ++i)
+      ASSERT_EQ(static_cast<float>(i), pt[i]);
+   ROOT::VecOps::RVec<float> ptChunk(100);
+   viewPt.ReadBulk(11950, std::span<float>(ptChunk.data(), ptChunk.size()));
+   EXPECT_EQ(11950.0, ptChunk[0]);
+   EXPECT_EQ(12049.0, ptChunk[99]);
+   viewPt.ReadBulk(RClusterIndex(1, 10), std::span<float>(ptChunk.data(), ptChunk.size()));
+   EXPECT_EQ(12010.0, ptChunk[0]);
+   EXPECT_EQ(12109.0, ptChunk[99]);
+
+   NTupleSize_t nItems = 0;
+   auto ptMapped = viewPt.MapV(12000, nItems);
+   ASSERT_LE(1U, nItems);
+   EXPECT_EQ(12000.0, ptMapped[0]);
+   EXPECT_EQ(static_cast<float>(12000 + nItems - 1), ptMapped[nItems - 1]);
+
+   auto viewTag = ntuple->GetView<std::string>("tag");
+   std::vector<std::string> tags(3);
+   viewTag.ReadBulk(11999, tags);
+   EXPECT_EQ("11999", tags[0]);
+   EXPECT_EQ("12001", tags[2]);
+
+   auto viewJets = ntuple->GetViewCollection("jets");
+   std::vector<ClusterSize_t> sizes(nEntries);
+   viewJets.ReadBulkSizes(0, sizes);
+   std::size_t nJets = 0;
+   for (unsigned int i = 0; i < nEntries; ++i) {
+      ASSERT_EQ(i % 4, sizes[i]);
+      nJets += sizes[i];
+   }
+   auto viewJetItems = viewJets.GetView<float>("float");
+   std::vector<float> jets(nJets);
+   viewJetItems.ReadBulk(0, jets);
+   std::size_t pos = 0;
+   for (unsigned int i = 0; i < nEntries; ++i) {
+      for (unsigned int j = 0; j < sizes[i]; ++j)
+         ASSERT_EQ(static_cast<float>(i), jets[pos++]);
+   }
+}
+
+
+TEST(RNTuple, MetricsExport)
+{
+   FileRaii fileGuard("test_ntuple_metrics_export.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < 100; ++i) {
+         *wrPt = i;
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   std::ostringstream osDisabled;
+   ntuple->PrintInfo(ENTupleInfo::kMetricsJSON, osDisabled);
+   EXPECT_EQ("{}\n", osDisabled.str());
+
+   ntuple->EnableMetrics();
+   auto viewPt = ntuple->GetView<float>("pt");
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_EQ(static_cast<float>(i), viewPt(i));
+
+   std::ostringstream os;
+   ntuple->PrintInfo(ENTupleInfo::kMetricsJSON, os);
+   const auto json = os.str();
+   EXPECT_EQ('{', json.front());
+   EXPECT_NE(std::string::npos, json.find("\"RNTupleReader.RPageSourceFile.szReadColumn0\""));
+   EXPECT_NE(std::string::npos, json.find("\"RNTupleReader.RPageSourceFile.timePopulate\""));
+   EXPECT_NE(std::string::npos, json.find("\"RNTupleReader.RPageSourceFile.timeUnzip\""));
+   EXPECT_NE(std::string::npos, json.find("\"buckets\": [{\"le\": "));
+}
+
+
 TEST(RNTuple, Capture) {
    auto model = RNTupleModel::Create();
    float pt;
@@ -782,6 +1181,9 @@ TEST(RNTuple, Descriptor)
    columnRange.fColumnId = 4;
    columnRange.fFirstElementIndex = 300;
    columnRange.fNElements = 3000;
+   columnRange.fHasValueRange = true;
+   columnRange.fMinValue = 10.0;
+   columnRange.fMaxValue = 20.5;
    descBuilder.AddClusterColumnRange(1, columnRange);
    ROOT::Experimental::RClusterDescriptor::RPageRange pageRange3;
    pageRange3.fColumnId = 4;
@@ -838,10 +1240,84 @@ TEST(RNTuple, Descriptor)
    EXPECT_EQ(DescriptorId_t(1), reference.FindClusterId(3, 100));
    EXPECT_EQ(ROOT::Experimental::kInvalidDescriptorId, reference.FindClusterId(3, 40000));
 
+   // Cluster #0 has no value range for column 4 and thus always matches
+   EXPECT_EQ(std::vector<DescriptorId_t>({0, 1}), reference.FindClusterIdsInValueRange(4, 20.5, 30.0));
+   EXPECT_EQ(std::vector<DescriptorId_t>({0}), reference.FindClusterIdsInValueRange(4, 20.6, 30.0));
+   EXPECT_EQ(std::vector<DescriptorId_t>({0}), reference.FindClusterIdsInValueRange(4, 0.0, 9.0));
+   EXPECT_TRUE(reco.GetDescriptor().GetClusterDescriptor(1).GetColumnRange(4).fHasValueRange);
+   EXPECT_EQ(20.5, reco.GetDescriptor().GetClusterDescriptor(1).GetColumnRange(4).fMaxValue);
+
    delete[] footerBuffer;
    delete[] headerBuffer;
 }
 
+// Reads a footer written before the value ranges were added to the column ranges (cluster frame version 0)
+TEST(RNTuple, DescriptorFooterV0)
+{
+   RNTupleDescriptorBuilder descBuilder;
+   descBuilder.SetNTuple("MyTuple", "Description", "Me", RNTupleVersion(1, 2, 3), ROOT::Experimental::RNTupleUuid());
+   descBuilder.AddField(0, RNTupleVersion(), RNTupleVersion(), "", "", 0, ENTupleStructure::kRecord);
+   descBuilder.AddField(1, RNTupleVersion(), RNTupleVersion(), "pt", "float", 0, ENTupleStructure::kLeaf);
+   descBuilder.AddFieldLink(0, 1);
+   descBuilder.AddColumn(2, 1, RNTupleVersion(), RColumnModel(EColumnType::kReal32, false), 0);
+   ROOT::Experimental::RClusterDescriptor::RColumnRange columnRange;
+   ROOT::Experimental::RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   for (unsigned i = 0; i < 2; ++i) {
+      descBuilder.AddCluster(i, RNTupleVersion(), 100 * i, ROOT::Experimental::ClusterSize_t(100));
+      columnRange.fColumnId = 2;
+      columnRange.fFirstElementIndex = 100 * i;
+      columnRange.fNElements = 100;
+      descBuilder.AddClusterColumnRange(i, columnRange);
+      ROOT::Experimental::RClusterDescriptor::RPageRange pageRange;
+      pageRange.fColumnId = 2;
+      pageInfo.fNElements = 100;
+      pageInfo.fLocator.fPosition = 1024 * (i + 1);
+      pageInfo.fLocator.fBytesOnStorage = 400;
+      pageRange.fPageInfos.emplace_back(pageInfo);
+      descBuilder.AddClusterPageRange(i, std::move(pageRange));
+   }
+   const auto &reference = descBuilder.GetDescriptor();
+
+   // The footer of the reference descriptor, as serialized with version 0 of the cluster frame
+   unsigned char footerV0[] = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+      0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+      0x64, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,
+      0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x9b, 0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0xa2, 0xcb, 0x35, 0x00
+   };
+
+   auto szHeader = reference.SerializeHeader(nullptr);
+   std::vector<unsigned char> headerBuffer(szHeader);
+   reference.SerializeHeader(headerBuffer.data());
+
+   RNTupleDescriptorBuilder reco;
+   reco.SetFromHeader(headerBuffer.data());
+   reco.AddClustersFromFooter(footerV0);
+   EXPECT_EQ(reference, reco.GetDescriptor());
+   EXPECT_EQ(2U, reco.GetDescriptor().GetNClusters());
+   EXPECT_EQ(NTupleSize_t(200), reco.GetDescriptor().GetNElements(2));
+   EXPECT_FALSE(reco.GetDescriptor().GetClusterDescriptor(1).GetColumnRange(2).fHasValueRange);
+   EXPECT_EQ(2048, reco.GetDescriptor().GetClusterDescriptor(1).GetPageRange(2).fPageInfos[0].fLocator.fPosition);
+   // Without value ranges, no cluster can be excluded
+   EXPECT_EQ(std::vector<DescriptorId_t>({0, 1}), reco.GetDescriptor().FindClusterIdsInValueRange(2, 0.0, 1.0));
+}
+
 // Tests ReadV() in RColumn.hxx (the case where a std::string overflows to the next page)
 TEST(RNTuple, ReadString)
 {
@@ -0,0 +1,257 @@
+#include "gtest/gtest.h"
+
+#include <ROOT/RCluster.hxx>
+#include <ROOT/RClusterPool.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/RPageStorageFile.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ClusterSize_t = ROOT::Experimental::ClusterSize_t;
+using DescriptorId_t = ROOT::Experimental::DescriptorId_t;
+using NTupleSize_t = ROOT::Experimental::NTupleSize_t;
+using RCluster = ROOT::Experimental::Detail::RCluster;
+using RClusterIndex = ROOT::Experimental::RClusterIndex;
+using RClusterPool = ROOT::Experimental::Detail::RClusterPool;
+using RNTupleDescriptor = ROOT::Experimental::RNTupleDescriptor;
+using RNTupleDescriptorBuilder = ROOT::Experimental::RNTupleDescriptorBuilder;
+using RNTupleMetrics = ROOT::Experimental::Detail::RNTupleMetrics;
+using RNTupleModel = ROOT::Experimental::RNTupleModel;
+using RNTupleReader = ROOT::Experimental::RNTupleReader;
+using RNTupleReadOptions = ROOT::Experimental::RNTupleReadOptions;
+using RNTupleVersion = ROOT::Experimental::RNTupleVersion;
+using RNTupleWriter = ROOT::Experimental::RNTupleWriter;
+using ROnDiskPage = ROOT::Experimental::Detail::ROnDiskPage;
+using ROnDiskPageMap = ROOT::Experimental::Detail::ROnDiskPageMap;
+using RPage = ROOT::Experimental::Detail::RPage;
+using RPageSource = ROOT::Experimental::Detail::RPageSource;
+using RPageSourceFile = ROOT::Experimental::Detail::RPageSourceFile;
+
+namespace {
+
+/**
+ * An RAII wrapper around an open temporary file on disk. It cleans up the guarded file when the wrapper object
+ * goes out of scope.
+ */
+class FileRaii {
+private:
+   std::string fPath;
+public:
+   explicit FileRaii(const std::string &path) : fPath(path) { }
+   FileRaii(const FileRaii&) = delete;
+   FileRaii& operator=(const FileRaii&) = delete;
+   ~FileRaii() { std::remove(fPath.c_str()); }
+   std::string GetPath() const { return fPath; }
+};
+
+/**
+ * Used to track LoadCluster calls triggered by the cluster pool
+ */
+class RPageSourceMock : public RPageSource {
+protected:
+   RNTupleDescriptor AttachImpl() final { return RNTupleDescriptor(); }
+
+public:
+   /// Records the cluster ids requests by LoadCluster() calls
+   std::vector<DescriptorId_t> fReqsClusterIds;
+   /// Records the column sets requested by LoadCluster() calls
+   std::vector<ColumnSet_t> fReqsColumns;
+   /// Records the cluster ids passed to ReleaseCluster() calls
+   std::vector<DescriptorId_t> fReleasedClusterIds;
+   RNTupleMetrics fMetrics;
+
+   RPageSourceMock() : RPageSource("test", RNTupleReadOptions()), fMetrics("test") {
+      RNTupleDescriptorBuilder descBuilder;
+      for (unsigned i = 0; i <= 5; ++i) {
+         descBuilder.AddCluster(i, RNTupleVersion(), i, ClusterSize_t(1));
+      }
+      fDescriptor = descBuilder.MoveDescriptor();
+   }
+   std::unique_ptr<RPageSource> Clone() const final { return nullptr; }
+   RPage PopulatePage(ColumnHandle_t, NTupleSize_t) final { return RPage(); }
+   RPage PopulatePage(ColumnHandle_t, const RClusterIndex &) final { return RPage(); }
+   void ReleasePage(RPage &) final {}
+   RNTupleMetrics &GetMetrics() final { return fMetrics; }
+
+   std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) final {
+      fReqsClusterIds.emplace_back(clusterId);
+      fReqsColumns.emplace_back(columns);
+      auto cluster = std::make_unique<RCluster>(clusterId);
+      for (auto colId : columns)
+         cluster->SetColumnAvailable(colId);
+      return cluster;
+   }
+   void ReleaseCluster(DescriptorId_t clusterId) final { fReleasedClusterIds.emplace_back(clusterId); }
+};
+
+} // anonymous namespace
+
+
+TEST(Cluster, Allocate)
+{
+   auto cluster = new RCluster(0);
+   delete cluster;
+
+   cluster = new RCluster(0);
+   cluster->Adopt(std::make_unique<ROnDiskPageMap>());
+   delete cluster;
+}
+
+
+TEST(Cluster, Basics)
+{
+   auto memory = new char[3];
+   auto pageMap = std::make_unique<ROOT::Experimental::Detail::ROnDiskPageMapHeap>(
+      std::unique_ptr<unsigned char []>(reinterpret_cast<unsigned char *>(memory)));
+   pageMap->Register(ROnDiskPage::Key(5, 0), ROnDiskPage(&memory[0], 1));
+   pageMap->Register(ROnDiskPage::Key(5, 1), ROnDiskPage(&memory[1], 2));
+   auto cluster = std::make_unique<RCluster>(0);
+   cluster->Adopt(std::move(pageMap));
+   cluster->SetColumnAvailable(5);
+
+   EXPECT_EQ(nullptr, cluster->GetOnDiskPage(ROnDiskPage::Key(5, 2)));
+   EXPECT_EQ(nullptr, cluster->GetOnDiskPage(ROnDiskPage::Key(4, 0)));
+   auto onDiskPage = cluster->GetOnDiskPage(ROnDiskPage::Key(5, 0));
+   EXPECT_EQ(&memory[0], onDiskPage->GetAddress());
+   EXPECT_EQ(1U, onDiskPage->GetSize());
+   onDiskPage = cluster->GetOnDiskPage(ROnDiskPage::Key(5, 1));
+   EXPECT_EQ(&memory[1], onDiskPage->GetAddress());
+   EXPECT_EQ(2U, onDiskPage->GetSize());
+   EXPECT_TRUE(cluster->ContainsColumn(5));
+   EXPECT_FALSE(cluster->ContainsColumn(4));
+}
+
+
+TEST(Cluster, AdoptCluster)
+{
+   auto memory = new char[4];
+   auto pageMap = std::make_unique<ROOT::Experimental::Detail::ROnDiskPageMapHeap>(
+      std::unique_ptr<unsigned char []>(reinterpret_cast<unsigned char *>(memory)));
+   pageMap->Register(ROnDiskPage::Key(5, 0), ROnDiskPage(&memory[0], 1));
+   pageMap->Register(ROnDiskPage::Key(5, 1), ROnDiskPage(&memory[1], 1));
+   auto cluster5 = std::make_unique<RCluster>(0);
+   cluster5->Adopt(std::move(pageMap));
+   cluster5->SetColumnAvailable(5);
+
+   pageMap = std::make_unique<ROOT::Experimental::Detail::ROnDiskPageMapHeap>(
+      std::unique_ptr<unsigned char []>(reinterpret_cast<unsigned char *>(new char[2])));
+   auto cluster6 = std::make_unique<RCluster>(0);
+   cluster6->Adopt(std::move(pageMap));
+   cluster6->SetColumnAvailable(6);
+
+   cluster5->Adopt(std::move(*cluster6));
+   EXPECT_EQ(0U, cluster6->GetAvailColumns().size());
+   EXPECT_TRUE(cluster5->ContainsColumn(5));
+   EXPECT_TRUE(cluster5->ContainsColumn(6));
+   EXPECT_EQ(2U, cluster5->GetNOnDiskPages());
+}
+
+
+TEST(ClusterPool, Windows)
+{
+   RPageSourceMock p1;
+   {
+      RClusterPool c1(p1, 1);
+      EXPECT_EQ(0U, c1.GetWindowPre());
+      EXPECT_EQ(1U, c1.GetWindowPost());
+      c1.GetCluster(0, {0});
+      c1.GetCluster(1, {0});
+      // Cluster 1 is now in the pool, no further I/O
+      c1.GetCluster(1, {0});
+   }
+   ASSERT_EQ(2U, p1.fReqsClusterIds.size());
+   EXPECT_EQ(0U, p1.fReqsClusterIds[0]);
+   EXPECT_EQ(1U, p1.fReqsClusterIds[1]);
+
+   RPageSourceMock p2;
+   {
+      RClusterPool c2(p2, 2);
+      c2.GetCluster(0, {0});
+      // Cluster 1 has been preloaded, only cluster 2 is requested
+      c2.GetCluster(1, {0});
+      // The missing column of cluster 1 and 2 is requested
+      c2.GetCluster(1, {0, 1});
+      // Cluster 5 is the last cluster and has no successor
+      c2.GetCluster(5, {0});
+   }
+   ASSERT_EQ(6U, p2.fReqsClusterIds.size());
+   EXPECT_EQ(0U, p2.fReqsClusterIds[0]);
+   EXPECT_EQ(1U, p2.fReqsClusterIds[1]);
+   EXPECT_EQ(2U, p2.fReqsClusterIds[2]);
+   EXPECT_EQ(1U, p2.fReqsClusterIds[3]);
+   EXPECT_EQ(RPageSource::ColumnSet_t({1}), p2.fReqsColumns[3]);
+   EXPECT_EQ(2U, p2.fReqsClusterIds[4]);
+   EXPECT_EQ(RPageSource::ColumnSet_t({1}), p2.fReqsColumns[4]);
+   EXPECT_EQ(5U, p2.fReqsClusterIds[5]);
+}
+
+
+TEST(ClusterPool, ReleaseCluster)
+{
+   auto isReleased = [](const RPageSourceMock &p, DescriptorId_t clusterId) {
+      return std::find(p.fReleasedClusterIds.begin(), p.fReleasedClusterIds.end(), clusterId) !=
+             p.fReleasedClusterIds.end();
+   };
+
+   RPageSourceMock p;
+   RClusterPool c(p, 2);
+   c.GetCluster(0, {0});
+   EXPECT_TRUE(p.fReleasedClusterIds.empty());
+   // Cluster 0 leaves the window
+   c.GetCluster(1, {0});
+   EXPECT_TRUE(isReleased(p, 0));
+   EXPECT_FALSE(isReleased(p, 1));
+   c.GetCluster(4, {0});
+   EXPECT_TRUE(isReleased(p, 1));
+   EXPECT_FALSE(isReleased(p, 4));
+   EXPECT_FALSE(isReleased(p, 5));
+}
+
+
+TEST(ClusterPool, ReadOptions)
+{
+   FileRaii fileGuard("test_ntuple_cluster_readoptions.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrVec = model->MakeField<std::vector<std::int32_t>>("vec");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath());
+      for (unsigned i = 0; i < 100; ++i) {
+         *wrPt = i;
+         wrVec->assign(i % 5, i);
+         ntuple->Fill();
+         if (i % 10 == 9)
+            ntuple->CommitCluster();
+      }
+   }
+
+   for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOff, RNTupleReadOptions::EClusterCache::kOn}) {
+      RNTupleReadOptions options;
+      options.SetClusterCache(clusterCache);
+      options.SetClusterBunchSize(3);
+      RNTupleReader ntuple(std::make_unique<RPageSourceFile>("ntpl", fileGuard.GetPath(), options));
+      EXPECT_EQ(100U, ntuple.GetNEntries());
+      EXPECT_EQ(10U, ntuple.GetDescriptor().GetNClusters());
+
+      auto rdPt = ntuple.GetModel()->GetDefaultEntry()->Get<float>("pt");
+      auto rdVec = ntuple.GetModel()->GetDefaultEntry()->Get<std::vector<std::int32_t>>("vec");
+      for (auto i : ntuple.GetEntryRange()) {
+         ntuple.LoadEntry(i);
+         EXPECT_EQ(static_cast<float>(i), *rdPt);
+         EXPECT_EQ(std::vector<std::int32_t>(i % 5, i), *rdVec);
+      }
+      // Jump backwards
+      ntuple.LoadEntry(42);
+      EXPECT_EQ(42.0, *rdPt);
+   }
+}
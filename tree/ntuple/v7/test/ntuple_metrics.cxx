@@ -3,12 +3,18 @@
 #include <ROOT/RNTupleMetrics.hxx>
 
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
 #include <thread>
 
 using RNTuplePlainCounter = ROOT::Experimental::Detail::RNTuplePlainCounter;
 using RNTupleAtomicCounter = ROOT::Experimental::Detail::RNTupleAtomicCounter;
 using RNTuplePlainTimer = ROOT::Experimental::Detail::RNTuplePlainTimer;
 using RNTupleAtomicTimer = ROOT::Experimental::Detail::RNTupleAtomicTimer;
+using RNTupleLatencyHistogram = ROOT::Experimental::Detail::RNTupleLatencyHistogram;
+using RNTupleLatencyTimer = ROOT::Experimental::Detail::RNTupleLatencyTimer;
 using RNTupleMetrics = ROOT::Experimental::Detail::RNTupleMetrics;
 
 TEST(Metrics, Counters)
@@ -56,3 +62,93 @@ TEST(Metrics, Timer)
    }
    EXPECT_GT(ctrWallTime.GetValue(), 0U);
 }
+
+TEST(Metrics, LatencyHistogram)
+{
+   EXPECT_EQ(0U, RNTupleLatencyHistogram::FindBin(0));
+   EXPECT_EQ(0U, RNTupleLatencyHistogram::FindBin(1));
+   EXPECT_EQ(1U, RNTupleLatencyHistogram::FindBin(2));
+   EXPECT_EQ(1U, RNTupleLatencyHistogram::FindBin(3));
+   EXPECT_EQ(10U, RNTupleLatencyHistogram::FindBin(1024));
+   EXPECT_EQ(RNTupleLatencyHistogram::kNBins - 1,
+             RNTupleLatencyHistogram::FindBin(std::numeric_limits<std::int64_t>::max()));
+   EXPECT_EQ(2, RNTupleLatencyHistogram::GetBinUpperEdge(0));
+   EXPECT_EQ(-1, RNTupleLatencyHistogram::GetBinUpperEdge(RNTupleLatencyHistogram::kNBins - 1));
+
+   RNTupleLatencyHistogram histo("latency", "ns", "");
+   histo.Fill(100);
+   EXPECT_EQ(0, histo.GetCount());
+   EXPECT_EQ(0, histo.GetQuantileUpperBound(0.5));
+   histo.Enable();
+   for (int i = 0; i < 99; ++i)
+      histo.Fill(100);
+   histo.Fill(5000);
+   EXPECT_EQ(100, histo.GetCount());
+   EXPECT_EQ(99 * 100 + 5000, histo.GetSum());
+   EXPECT_EQ(99, histo.GetBinContent(RNTupleLatencyHistogram::FindBin(100)));
+   EXPECT_EQ(128, histo.GetQuantileUpperBound(0.5));
+   EXPECT_EQ(128, histo.GetQuantileUpperBound(0.99));
+   EXPECT_EQ(8192, histo.GetQuantileUpperBound(1.0));
+   EXPECT_EQ("{\"count\": 100, \"sum\": 14900, \"buckets\": [{\"le\": 128, \"count\": 99}, "
+             "{\"le\": 8192, \"count\": 1}]}", histo.ValueToJSON());
+
+   {
+      RNTupleLatencyTimer timer(histo);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   }
+   EXPECT_EQ(101, histo.GetCount());
+   EXPECT_GE(histo.GetSum(), 14900 + 10 * 1000 * 1000);
+
+   // A timer started while the histogram was disabled does not record anything
+   RNTupleLatencyHistogram lateHisto("late", "ns", "");
+   {
+      RNTupleLatencyTimer timer(lateHisto);
+      lateHisto.Enable();
+   }
+   EXPECT_EQ(0, lateHisto.GetCount());
+}
+
+TEST(Metrics, JSON)
+{
+   RNTupleMetrics inner("inner");
+   auto ctrBytes = inner.MakeCounter<RNTupleAtomicCounter *>("bytes", "B", "a \"quoted\" description");
+   RNTupleMetrics outer("outer");
+   outer.ObserveMetrics(inner);
+
+   std::ostringstream osDisabled;
+   outer.PrintJSON(osDisabled);
+   EXPECT_EQ("{}\n", osDisabled.str());
+
+   outer.Enable();
+   // Counters registered after enabling the metrics are enabled, too
+   auto ctrLatency = inner.MakeCounter<RNTupleLatencyHistogram *>("latency", "ns", "");
+   EXPECT_TRUE(ctrLatency->IsEnabled());
+   ctrBytes->Add(42);
+
+   std::ostringstream os;
+   outer.PrintJSON(os);
+   EXPECT_EQ("{\n"
+             "  \"outer.inner.bytes\": {\"unit\": \"B\", \"description\": \"a \\\"quoted\\\" description\", "
+             "\"value\": 42},\n"
+             "  \"outer.inner.latency\": {\"unit\": \"ns\", \"description\": \"\", "
+             "\"value\": {\"count\": 0, \"sum\": 0, \"buckets\": []}}\n"
+             "}\n", os.str());
+}
+
+TEST(Metrics, Detailed)
+{
+   RNTupleMetrics metrics("metrics");
+   metrics.MakeCounter<RNTuplePlainCounter *>("total", "B", "");
+   auto ctrDetail = metrics.MakeCounter<RNTuplePlainCounter *>("detail0", "B", "");
+   ctrDetail->SetDetailed();
+   metrics.Enable();
+
+   // Detailed counters are exported as JSON but not printed
+   std::ostringstream osPrint;
+   metrics.Print(osPrint);
+   EXPECT_NE(std::string::npos, osPrint.str().find("metrics.total"));
+   EXPECT_EQ(std::string::npos, osPrint.str().find("detail0"));
+   std::ostringstream osJSON;
+   metrics.PrintJSON(osJSON);
+   EXPECT_NE(std::string::npos, osJSON.str().find("\"metrics.detail0\""));
+}
@@ -2,6 +2,9 @@
 
 #include <ROOT/RColumnElement.hxx>
 
+#include <cstdint>
+#include <limits>
+
 TEST(Packing, Bitfield)
 {
    ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit> element(nullptr);
@@ -34,3 +37,87 @@ TEST(Packing, Bitfield)
       EXPECT_EQ(b9[i], e9[i]);
    }
 }
+
+TEST(Packing, Split)
+{
+   ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32> element(nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   float f[] = {1.0, 2.0, -3.5, 1e30};
+   unsigned char packed[sizeof(f)];
+   element.Pack(packed, f, 4);
+   // The first bytes of all the elements come first
+   for (unsigned i = 0; i < 4; ++i) {
+      for (unsigned b = 0; b < sizeof(float); ++b) {
+         EXPECT_EQ(reinterpret_cast<unsigned char *>(&f[i])[b], packed[b * 4 + i]);
+      }
+   }
+   float e[4];
+   element.Unpack(e, packed, 4);
+   for (unsigned i = 0; i < 4; ++i) {
+      EXPECT_EQ(f[i], e[i]);
+   }
+
+   ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>
+      element64(nullptr);
+   std::int64_t i64[] = {0, -1, 42, std::int64_t(1) << 40, -(std::int64_t(1) << 62)};
+   unsigned char packed64[sizeof(i64)];
+   element64.Pack(packed64, i64, 5);
+   std::int64_t e64[5];
+   element64.Unpack(e64, packed64, 5);
+   for (unsigned i = 0; i < 5; ++i) {
+      EXPECT_EQ(i64[i], e64[i]);
+   }
+}
+
+TEST(Packing, SplitIndex)
+{
+   using ClusterSize_t = ROOT::Experimental::ClusterSize_t;
+   ROOT::Experimental::Detail::RColumnElement<ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex>
+      element(nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   ClusterSize_t offsets[] = {ClusterSize_t(3), ClusterSize_t(3), ClusterSize_t(10), ClusterSize_t(300),
+                              ClusterSize_t(1), ClusterSize_t(0xFFFFFFFF)};
+   unsigned char packed[sizeof(offsets)];
+   element.Pack(packed, offsets, 6);
+   // Small differences only populate the low bytes; the first delta is 3, zigzag encoded as 6
+   EXPECT_EQ(6U, packed[0]);
+   EXPECT_EQ(0U, packed[6]);
+   EXPECT_EQ(0U, packed[1]);
+   ClusterSize_t e[6];
+   element.Unpack(e, packed, 6);
+   for (unsigned i = 0; i < 6; ++i) {
+      EXPECT_EQ(offsets[i], e[i]);
+   }
+}
+
+TEST(Packing, ValueRange)
+{
+   double min = 0.0;
+   double max = 0.0;
+   ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kReal32> elementFloat(nullptr);
+   EXPECT_FALSE(elementFloat.GetValueRange(nullptr, 0, min, max));
+   const float nan = std::numeric_limits<float>::quiet_NaN();
+   float f[] = {nan, 1.5, -2.0, nan, 0.0};
+   EXPECT_TRUE(elementFloat.GetValueRange(f, 5, min, max));
+   EXPECT_EQ(-2.0, min);
+   EXPECT_EQ(1.5, max);
+   EXPECT_FALSE(elementFloat.GetValueRange(f, 1, min, max));
+
+   // Large 64bit integers cannot be represented exactly, the range must still include them
+   std::uint64_t u64[] = {(std::uint64_t(1) << 60) + 1, 3};
+   ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kInt64>
+      elementU64(nullptr);
+   auto splitElement = elementU64.GenerateSplit();
+   EXPECT_TRUE(splitElement->GetValueRange(u64, 2, min, max));
+   EXPECT_GE(3.0, min);
+   EXPECT_LE(static_cast<long double>(u64[0]), static_cast<long double>(max));
+
+   ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit> elementBit(nullptr);
+   bool b[] = {true, false};
+   EXPECT_FALSE(elementBit.GetValueRange(b, 2, min, max));
+   EXPECT_EQ(nullptr, elementBit.GenerateSplit());
+}
@@ -3,6 +3,10 @@
 #include <ROOT/RPageAllocator.hxx>
 #include <ROOT/RPagePool.hxx>
 
+#include <cstdint>
+#include <thread>
+#include <vector>
+
 using RPage = ROOT::Experimental::Detail::RPage;
 using RPageAllocatorHeap = ROOT::Experimental::Detail::RPageAllocatorHeap;
 using RPageDeleter = ROOT::Experimental::Detail::RPageDeleter;
@@ -22,7 +26,8 @@ TEST(Pages, Allocation)
 
 TEST(Pages, Pool)
 {
-   RPagePool pool;
+   // Without memory budget, pages are freed as soon as they are not used anymore
+   RPagePool pool(0);
 
    auto page = pool.GetPage(0, 0);
    EXPECT_TRUE(page.IsNull());
@@ -63,3 +68,152 @@ TEST(Pages, Pool)
    page = pool.GetPage(1, 55);
    EXPECT_TRUE(page.IsNull());
 }
+
+namespace {
+
+/// Creates a page of nElements bytes that starts at element index rangeFirst of the cluster's first element
+RPage MakeBytePage(ROOT::Experimental::ColumnId_t columnId, std::uint32_t nElements,
+                   ROOT::Experimental::NTupleSize_t rangeFirst, const RPage::RClusterInfo &clusterInfo)
+{
+   auto page = RPage(columnId, new unsigned char[nElements], nElements, 1);
+   page.TryGrow(nElements);
+   page.SetWindow(rangeFirst, clusterInfo);
+   return page;
+}
+
+RPageDeleter MakeCountingDeleter(unsigned int &nCallDeleter)
+{
+   return RPageDeleter([&nCallDeleter](const RPage &page, void * /*userData*/) {
+      delete[] reinterpret_cast<unsigned char *>(page.GetBuffer());
+      nCallDeleter++;
+   });
+}
+
+} // anonymous namespace
+
+TEST(Pages, PoolEviction)
+{
+   RPagePool pool(300);
+   unsigned int nCallDeleter = 0;
+   RPage::RClusterInfo clusterInfo(0, 0);
+
+   auto page0 = pool.RegisterPage(MakeBytePage(1, 100, 0, clusterInfo), MakeCountingDeleter(nCallDeleter));
+   auto page1 = pool.RegisterPage(MakeBytePage(1, 100, 100, clusterInfo), MakeCountingDeleter(nCallDeleter));
+   pool.PreloadPage(MakeBytePage(2, 100, 0, clusterInfo), MakeCountingDeleter(nCallDeleter));
+   EXPECT_EQ(300U, pool.GetMemoryUsage());
+   pool.ReturnPage(page0);
+   pool.ReturnPage(page1);
+   EXPECT_EQ(0U, nCallDeleter);
+
+   // Page 0 of column 1 is the least recently used unpinned page; the new page itself is pinned
+   auto page2 = pool.RegisterPage(MakeBytePage(1, 100, 200, clusterInfo), MakeCountingDeleter(nCallDeleter));
+   EXPECT_EQ(1U, nCallDeleter);
+   EXPECT_EQ(300U, pool.GetMemoryUsage());
+   EXPECT_TRUE(pool.GetPage(1, 50).IsNull());
+   auto page = pool.GetPage(1, 150);
+   EXPECT_EQ(page1, page);
+   page = pool.GetPage(1, ROOT::Experimental::RClusterIndex(0, 250));
+   EXPECT_EQ(page2, page);
+   EXPECT_FALSE(pool.GetPage(2, 99).IsNull());
+
+   // All the pages are pinned now, the budget is exceeded temporarily
+   auto page3 = pool.RegisterPage(MakeBytePage(3, 100, 0, clusterInfo), MakeCountingDeleter(nCallDeleter));
+   EXPECT_EQ(400U, pool.GetMemoryUsage());
+   EXPECT_EQ(1U, nCallDeleter);
+   pool.ReturnPage(page3);
+   EXPECT_EQ(2U, nCallDeleter);
+   EXPECT_EQ(300U, pool.GetMemoryUsage());
+
+   // Registering a page that is already in the pool yields the cached page
+   auto duplicate = pool.RegisterPage(MakeBytePage(1, 100, 100, clusterInfo), MakeCountingDeleter(nCallDeleter));
+   EXPECT_EQ(3U, nCallDeleter);
+   EXPECT_EQ(page1, duplicate);
+   EXPECT_EQ(300U, pool.GetMemoryUsage());
+}
+
+TEST(Pages, PoolEvictPreloaded)
+{
+   RPagePool pool(1000);
+   unsigned int nCallDeleter = 0;
+   RPage::RClusterInfo clusterInfo0(0, 0);
+   RPage::RClusterInfo clusterInfo1(1, 100);
+
+   pool.PreloadPage(MakeBytePage(1, 50, 0, clusterInfo0), MakeCountingDeleter(nCallDeleter));
+   pool.PreloadPage(MakeBytePage(1, 50, 50, clusterInfo0), MakeCountingDeleter(nCallDeleter));
+   pool.PreloadPage(MakeBytePage(2, 100, 0, clusterInfo0), MakeCountingDeleter(nCallDeleter));
+   pool.PreloadPage(MakeBytePage(1, 100, 0, clusterInfo1), MakeCountingDeleter(nCallDeleter));
+   auto registered = pool.RegisterPage(MakeBytePage(3, 100, 0, clusterInfo0), MakeCountingDeleter(nCallDeleter));
+   pool.ReturnPage(registered);
+   auto pinned = pool.GetPage(1, 10);
+   ASSERT_FALSE(pinned.IsNull());
+   EXPECT_EQ(400U, pool.GetMemoryUsage());
+
+   // Only the unpinned preloaded pages of cluster 0 are freed
+   pool.EvictPreloadedPages(0);
+   EXPECT_EQ(2U, nCallDeleter);
+   EXPECT_EQ(250U, pool.GetMemoryUsage());
+   EXPECT_TRUE(pool.GetPage(1, 60).IsNull());
+   EXPECT_TRUE(pool.GetPage(2, 0).IsNull());
+   auto page = pool.GetPage(1, ROOT::Experimental::RClusterIndex(1, 0));
+   EXPECT_FALSE(page.IsNull());
+   pool.ReturnPage(page);
+   page = pool.GetPage(3, 0);
+   EXPECT_EQ(registered, page);
+   pool.ReturnPage(page);
+
+   // The page pinned during the eviction is not preloaded anymore: it is only subject to the LRU eviction
+   pool.ReturnPage(pinned);
+   pool.EvictPreloadedPages(0);
+   EXPECT_EQ(2U, nCallDeleter);
+   EXPECT_EQ(250U, pool.GetMemoryUsage());
+   pool.EvictPreloadedPages(1);
+   EXPECT_EQ(3U, nCallDeleter);
+   EXPECT_EQ(150U, pool.GetMemoryUsage());
+
+   // A page preloaded by two page sources sharing the pool stays until both of them released its cluster
+   RPage::RClusterInfo clusterInfo2(2, 200);
+   pool.PreloadPage(MakeBytePage(4, 100, 0, clusterInfo2), MakeCountingDeleter(nCallDeleter));
+   pool.PreloadPage(MakeBytePage(4, 100, 0, clusterInfo2), MakeCountingDeleter(nCallDeleter));
+   EXPECT_EQ(4U, nCallDeleter);
+   EXPECT_EQ(250U, pool.GetMemoryUsage());
+   pool.EvictPreloadedPages(2);
+   EXPECT_EQ(4U, nCallDeleter);
+   page = pool.GetPage(4, 0);
+   EXPECT_FALSE(page.IsNull());
+   pool.ReturnPage(page);
+   pool.EvictPreloadedPages(2);
+   EXPECT_EQ(5U, nCallDeleter);
+   EXPECT_EQ(150U, pool.GetMemoryUsage());
+}
+
+TEST(Pages, PoolConcurrent)
+{
+   static constexpr unsigned int kNThreads = 4;
+   static constexpr unsigned int kNColumns = 32;
+   static constexpr unsigned int kNPages = 100;
+   RPagePool pool(kNColumns * kNPages * 10 / 2);
+
+   std::vector<std::thread> threads;
+   for (unsigned int t = 0; t < kNThreads; ++t) {
+      threads.emplace_back([&pool]() {
+         RPage::RClusterInfo clusterInfo(0, 0);
+         for (unsigned int i = 0; i < kNPages; ++i) {
+            for (unsigned int c = 0; c < kNColumns; ++c) {
+               auto page = pool.GetPage(c, i * 10);
+               if (page.IsNull()) {
+                  // Pages are freed by whichever thread evicts them
+                  page = pool.RegisterPage(MakeBytePage(c, 10, i * 10, clusterInfo),
+                     RPageDeleter([](const RPage &p, void * /*userData*/) {
+                        delete[] reinterpret_cast<unsigned char *>(p.GetBuffer());
+                     }));
+               }
+               EXPECT_EQ(i * 10, page.GetGlobalRangeFirst());
+               pool.ReturnPage(page);
+            }
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_GE(pool.GetMemoryBudget(), pool.GetMemoryUsage());
+}
@@ -95,3 +95,27 @@ TEST(RNTupleZip, Large)
    decompressor(zipBuffer.get(), szZip, N, unzipBuffer.get());
    EXPECT_EQ(data, std::string(unzipBuffer.get(), N));
 }
+
+
+TEST(RNTupleZip, Static)
+{
+   constexpr unsigned int N = kMAXZIPBUF + 32;
+   auto zipBuffer = std::make_unique<unsigned char[]>(N);
+   auto unzipBuffer = std::make_unique<char[]>(N);
+   std::string data(N, 'x');
+
+   char X = 'x';
+   EXPECT_EQ(0U, RNTupleCompressor::Zip(&X, 0, 101, zipBuffer.get()));
+   EXPECT_EQ(1U, RNTupleCompressor::Zip(&X, 1, 101, zipBuffer.get()));
+   EXPECT_EQ('x', zipBuffer[0]);
+
+   /// Trailing byte cannot be compressed, entire buffer returns uncompressed
+   auto szZip = RNTupleCompressor::Zip(data.data(), kMAXZIPBUF + 1, 101, zipBuffer.get());
+   EXPECT_EQ(static_cast<unsigned int>(kMAXZIPBUF) + 1, szZip);
+   EXPECT_EQ(data.substr(0, kMAXZIPBUF + 1), std::string(reinterpret_cast<char *>(zipBuffer.get()), szZip));
+
+   szZip = RNTupleCompressor::Zip(data.data(), data.length(), 101, zipBuffer.get());
+   EXPECT_LT(szZip, N);
+   RNTupleDecompressor()(zipBuffer.get(), szZip, N, unzipBuffer.get());
+   EXPECT_EQ(data, std::string(unzipBuffer.get(), N));
+}
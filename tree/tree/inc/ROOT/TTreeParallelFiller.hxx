@@ -0,0 +1,150 @@
+// @(#)root/tree:$Id$
+// Author: agent <agent@local>, 2020-06-09
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeParallelFiller
+#define ROOT_TTreeParallelFiller
+
+#include "Rtypes.h"
+
+#include <memory>
+#include <mutex>
+
+class TMemFile;
+class TTree;
+
+namespace ROOT {
+namespace Experimental {
+
+class TTreeFillContext;
+
+/**
+ * \class TTreeParallelFiller TTreeParallelFiller.hxx
+ * \ingroup tree
+ *
+ * TTreeParallelFiller fills a single TTree from multiple threads.
+ * Every thread obtains its own TTreeFillContext, which serializes and
+ * compresses entries into a private set of baskets.  Whenever a context
+ * has collected a full cluster (see TTree::SetAutoFlush()), the cluster is
+ * appended to the tree as a whole by copying the compressed baskets under
+ * a lock.  Entry numbers of the tree are therefore contiguous within a
+ * cluster; clusters of different contexts are ordered by commit time.
+ *
+ * The tree must be attached to a writable file, and its structure must be
+ * complete before the first context is created.  The tree must not be
+ * filled directly while fill contexts exist, and ROOT::EnableThreadSafety()
+ * must have been called.
+ *
+ * ~~~ {.cpp}
+ * ROOT::EnableThreadSafety();
+ * TFile file("out.root", "RECREATE");
+ * TTree tree("T", "T");
+ * float px;
+ * tree.Branch("px", &px);
+ * ROOT::Experimental::TTreeParallelFiller filler(tree);
+ * // In every thread:
+ * auto context = filler.CreateFillContext();
+ * float myPx;
+ * context->GetTree().SetBranchAddress("px", &myPx);
+ * for (...) {
+ *    myPx = ...;
+ *    context->Fill();
+ * }
+ * context.reset(); // commits the last, possibly incomplete cluster
+ * // Once all contexts are gone:
+ * tree.Write();
+ * ~~~
+ */
+
+class TTreeParallelFiller {
+public:
+   /** Constructor
+    * @param tree The tree to fill, attached to a writable file
+    * @param clusterSize Number of entries per cluster committed by the fill contexts;
+    *        if zero, the auto flush setting of the tree is used
+    */
+   TTreeParallelFiller(TTree &tree, Long64_t clusterSize = 0);
+
+   /** Destructor */
+   ~TTreeParallelFiller();
+
+   /** Returns a new fill context with its own set of baskets.  The branch
+    *  addresses of the context's tree are reset and must be set by the caller.
+    */
+   std::unique_ptr<TTreeFillContext> CreateFillContext();
+
+   friend class TTreeFillContext;
+
+private:
+   /** TTreeParallelFiller has no copy constructor */
+   TTreeParallelFiller(const TTreeParallelFiller &) = delete;
+
+   /** TTreeParallelFiller has no copy operator */
+   TTreeParallelFiller &operator=(const TTreeParallelFiller &) = delete;
+
+   Long64_t CommitCluster(TTree &cluster);
+
+   TTree &fTree;              ///< The tree filled by the contexts
+   Long64_t fClusterSize;     ///< Cluster size of the contexts' trees, zero to keep the tree's auto flush setting
+   std::mutex fMutex;         ///< Serializes the creation of contexts and the commit of clusters
+   Int_t fNContexts{0};       ///< Number of fill contexts ever created, used to name their buffers
+   Int_t fNActiveContexts{0}; ///< Number of fill contexts that have not yet been destroyed
+};
+
+/**
+ * \class TTreeFillContext TTreeParallelFiller.hxx
+ * \ingroup tree
+ *
+ * A TTreeFillContext is used by a single thread to fill entries into the tree
+ * of a TTreeParallelFiller.  Entries are filled into a private in-memory tree
+ * with the same structure; complete clusters are committed to the target tree
+ * automatically.
+ */
+
+class TTreeFillContext {
+private:
+   TTreeParallelFiller &fFiller;    ///< The filler this context is attached to
+   std::unique_ptr<TMemFile> fFile; ///< Holds the compressed baskets of the current cluster
+   TTree *fTree{nullptr};           ///< The context's tree, owned by fFile
+
+   /** Constructor. Can only be called by TTreeParallelFiller. */
+   TTreeFillContext(TTreeParallelFiller &filler);
+
+   /** TTreeFillContext has no copy constructor */
+   TTreeFillContext(const TTreeFillContext &) = delete;
+
+   /** TTreeFillContext has no copy operator */
+   TTreeFillContext &operator=(const TTreeFillContext &) = delete;
+
+   friend class TTreeParallelFiller;
+
+public:
+   /** Destructor, commits the remaining entries as a final cluster */
+   ~TTreeFillContext();
+
+   /** The tree whose branch addresses are used by Fill() */
+   TTree &GetTree() const { return *fTree; }
+
+   /** Fill one entry into the context's baskets and commit the cluster once it
+    *  is complete.  Returns the number of bytes filled or a negative number on error.
+    */
+   Int_t Fill();
+
+   /** Commit the entries filled since the last commit as a cluster of the target tree.
+    *  Returns the entry number of the cluster's first entry in the target tree,
+    *  or -1 if there was nothing to commit or the commit failed.
+    */
+   Long64_t FlushCluster();
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
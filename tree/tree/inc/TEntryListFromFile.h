@@ -92,6 +92,7 @@ public:
    virtual void        SetTreeNumber(Int_t index) { fTreeNumber=index;  }
    virtual void        SetNFiles(Int_t nfiles) { fNFiles = nfiles; }
    virtual void        Subtract(const TEntryList * /*elist*/) {};
+   virtual void        Intersect(const TEntryList * /*elist*/) {};
 
    ClassDef(TEntryListFromFile, 1); //Manager for entry lists from different files
 };
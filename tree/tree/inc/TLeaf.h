@@ -106,6 +106,9 @@ public:
    virtual Int_t   *GenerateOffsetArray(Int_t base, Int_t events) { return GenerateOffsetArrayBase(base, events); }
    TBranch         *GetBranch() const { return fBranch; }
    virtual DeserializeType GetDeserializeType() const { return DeserializeType::kDestructive; }
+   ///  If this leaf stores a variable-sized array that can be read in bulk, set the element type and the number of
+   ///  bytes that precede the elements of every entry in the basket and return true. Return false otherwise.
+   virtual bool     GetJaggedLayout(EDataType & /*type*/, Int_t & /*headerSize*/) const { return false; }
    ///  If this leaf stores a variable-sized array or a multi-dimensional array whose last dimension has variable size,
    ///  return a pointer to the TLeaf that stores such size. Return a nullptr otherwise.
    virtual TLeaf   *GetLeafCount() const { return fLeafCount; }
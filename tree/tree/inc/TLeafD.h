@@ -39,6 +39,8 @@ public:
    virtual void    Export(TClonesArray *list, Int_t n);
    virtual void    FillBasket(TBuffer &b);
    virtual DeserializeType GetDeserializeType() const { return DeserializeType::kInPlace; }
+   virtual bool    GetJaggedLayout(EDataType &type, Int_t &headerSize) const
+                   { type = kDouble_t; headerSize = 0; return fLeafCount != nullptr; }
    const char     *GetTypeName() const { return "Double_t"; }
    Double_t        GetValue(Int_t i=0) const;
    virtual void   *GetValuePointer() const { return fValue; }
@@ -40,6 +40,8 @@ public:
    virtual void    Export(TClonesArray *list, Int_t n);
    virtual void    FillBasket(TBuffer &b);
    virtual DeserializeType GetDeserializeType() const { return DeserializeType::kInPlace; }
+   virtual bool    GetJaggedLayout(EDataType &type, Int_t &headerSize) const
+                   { type = fIsUnsigned ? kUInt_t : kInt_t; headerSize = 0; return fLeafCount != nullptr; }
    const char     *GetTypeName() const;
    virtual Int_t   GetMaximum() const { return fMaximum; }
    virtual Int_t   GetMinimum() const { return fMinimum; }
@@ -16,7 +16,11 @@
 #include "Bytes.h"
 #include "TTreeCache.h"
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 class TBasket;
@@ -43,44 +47,50 @@ public:
    enum EUnzipState { kUntouched, kProgress, kFinished };
 
 protected:
-   // Unzipping state for baskets
-   struct UnzipState {
-      // Note: we cannot use std::unique_ptr<std::unique_ptr<char[]>[]> or vector of unique_ptr
-      // for fUnzipChunks since std::unique_ptr is not copy constructable.
-      // However, in future upgrade we cannot use make_vector in C++14.
-      std::unique_ptr<char[]> *fUnzipChunks;     ///<! [fNseek] Individual unzipped chunks. Their summed size is kept under control.
-      std::vector<Int_t>       fUnzipLen;        ///<! [fNseek] Length of the unzipped buffers
-      std::atomic<Byte_t>     *fUnzipStatus;     ///<! [fNSeek] 
-
-      UnzipState() {
-         fUnzipChunks = nullptr;
-         fUnzipStatus = nullptr;
-      }
-      ~UnzipState() {
-         if (fUnzipChunks) delete [] fUnzipChunks;
-         if (fUnzipStatus) delete [] fUnzipStatus;
-      }
-      void   Clear(Int_t size);
+   // Unzipping state of the baskets of one cluster. A cluster owns the compressed bytes of its baskets such that
+   // unzipping tasks never touch the TFileCacheRead buffers and can outlive a refill of the cache.
+   struct UnzipCluster {
+      std::shared_ptr<const char> fData;         ///<! Compressed baskets, sorted by position on file
+      std::vector<Long64_t>       fPos;          ///<! Position on file of the baskets (sorted)
+      std::vector<Int_t>          fLen;          ///<! Compressed length of the baskets
+      std::vector<Int_t>          fOffset;       ///<! Offset of the baskets in fData
+      std::vector<Int_t>          fRawLen;       ///<! Expected length of the unzipped baskets (key included)
+      std::unique_ptr<char[]>    *fUnzipChunks;  ///<! [Size()] Unzipped baskets waiting to be handed over
+      std::vector<Int_t>          fUnzipLen;     ///<! [Size()] Length of the unzipped baskets
+      std::atomic<Byte_t>        *fUnzipStatus;  ///<! [Size()]
+      std::atomic<Long64_t>      *fPendingBytes; ///<! Cache counter of the unzipped bytes not yet handed over
+      Long64_t                    fEntryBegin;   ///<! First entry of the cluster
+      Long64_t                    fEntryEnd;     ///<! One past the last entry of the cluster
+      Bool_t                      fOldFormat;    ///<! Baskets may be stored uncompressed (ROOT <= 3.04/01)
+      Int_t                       fNextTask;     ///<! First basket not yet handed to a task (see fClustersMutex)
+      Bool_t                      fReadAhead;    ///<! True once the following cluster has been requested
+      std::atomic<bool>           fCancelled;    ///<! Set when the cluster is dropped; pending tasks skip it
+      std::mutex                  fDoneMutex;    ///<! Used with fDoneCv
+      std::condition_variable     fDoneCv;       ///<! Notified whenever a basket leaves the kProgress state
+
+      UnzipCluster(std::shared_ptr<const char> data, const Long64_t *pos, const Int_t *len, const Int_t *offset,
+                   Int_t n, std::atomic<Long64_t> *pendingBytes);
+      ~UnzipCluster();
+      Int_t  Find(Long64_t pos) const;
       Bool_t IsUntouched(Int_t index) const;
       Bool_t IsProgress(Int_t index) const;
-      Bool_t IsFinished(Int_t index) const;
       Bool_t IsUnzipped(Int_t index) const;
-      void   Reset(Int_t oldSize, Int_t newSize);
-      void   SetUntouched(Int_t index);
-      void   SetProgress(Int_t index);
-      void   SetFinished(Int_t index);
       void   SetMissed(Int_t index);
-      void   SetUnzipped(Int_t index, char* buf, Int_t len);
+      void   SetUnzipped(Int_t index, char *buf, Int_t len);
+      Int_t  Size() const { return fPos.size(); }
+      Int_t  TakeUnzipped(Int_t index, char **buf, Bool_t *free);
       Bool_t TryUnzipping(Int_t index);
+      void   NotifyDone();
+      void   WaitUntilDone(Int_t index);
    };
 
-   typedef struct UnzipState UnzipState_t;
-   UnzipState_t fUnzipState;
+   std::deque<std::shared_ptr<UnzipCluster>> fClusters; ///<! Clusters being unzipped, oldest first
+   std::mutex fClustersMutex; ///<! Protects fClusters and the scheduling state of its elements
+   Long64_t   fClustersGeneration; ///<! Incremented by ResetCache(); read-ahead clusters of an older one are dropped
+   Bool_t     fClosing;            ///<! Set by the destructor, after which no task can be submitted
+   Bool_t     fWaiting;            ///<! Set while WaitForTasks() waits, during which no task can be submitted
 
    // Members for paral. managing
-   Bool_t      fAsyncReading;
-   Bool_t      fEmpty;
-   Int_t       fCycle;
    Bool_t      fParallel; ///< Indicate if we want to activate the parallelism (for this instance)
 
    std::unique_ptr<TMutex> fIOMutex;
@@ -93,27 +103,39 @@ protected:
 #endif
 
    // Unzipping related members
-   Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
+   std::atomic<Long64_t> fPendingBytes;   ///<! Unzipped bytes waiting to be handed over to a basket
+   std::atomic<Long64_t> fScheduledBytes; ///<! Expected unzipped bytes of the baskets handed to tasks
 
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
-   Int_t       fNFound;           ///<! number of blocks that were found in the cache
-   Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
-   Int_t       fNStalls;          ///<! number of hits which caused a stall
-   Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNFound;    ///<! number of blocks that were found in the cache
+   std::atomic<Int_t> fNMissed;   ///<! number of blocks that were not part of a cluster and were read as usual
+   std::atomic<Int_t> fNStalls;   ///<! number of hits which caused a stall
+   std::atomic<Int_t> fNUnzip;    ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNReadAhead; ///<! number of clusters read ahead of the reader
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
    TTreeCacheUnzip& operator=(const TTreeCacheUnzip &);
 
-   char *fCompBuffer;
-   Int_t fCompBufferSize;
-
    // Private methods
+   std::shared_ptr<UnzipCluster> AddCluster(std::shared_ptr<const char> data, const Long64_t *pos, const Int_t *len,
+                                            const Int_t *offset, Int_t n, Long64_t entryBegin, Long64_t entryEnd,
+                                            Bool_t oldFormat, Long64_t generation);
+   void  CollectBaskets(Long64_t entry, Long64_t entryEnd, std::vector<std::pair<Long64_t, Int_t>> &baskets,
+                        Bool_t skipLoaded = kTRUE);
    void  Init();
+   Bool_t IsOldFormat() const;
+   void  ReadAhead(Long64_t entry);
+   void  ReadAheadCluster(std::vector<Long64_t> pos, std::vector<Int_t> len, Long64_t entryBegin, Long64_t entryEnd,
+                          Bool_t oldFormat, Long64_t generation);
+   void  ScheduleTasks();
+   void  UnzipClusterBasket(UnzipCluster &cluster, Int_t index);
+   Int_t UnzipRecord(char **dest, const char *src, Bool_t oldFormat);
+   void  WaitForTasks();
 
 public:
    TTreeCacheUnzip();
@@ -124,6 +146,7 @@ public:
    virtual Int_t       AddBranch(const char *branch, Bool_t subbranches = kFALSE);
    Bool_t              FillBuffer();
    virtual Int_t       ReadBufferExt(char *buf, Long64_t pos, Int_t len, Int_t &loc);
+   virtual Int_t       ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, Int_t &loc);
    void                SetEntryRange(Long64_t emin,   Long64_t emax);
    virtual void        StopLearningPhase();
    void                UpdateBranches(TTree *tree);
@@ -134,24 +157,24 @@ public:
    static Int_t         SetParallelUnzip(TTreeCacheUnzip::EParUnzipMode option = TTreeCacheUnzip::kEnable);
 
    // Unzipping related methods
-#ifdef R__USE_IMT
-   Int_t          CreateTasks();
-#endif
    Int_t          GetRecordHeader(char *buf, Int_t maxbytes, Int_t &nbytes, Int_t &objlen, Int_t &keylen);
    virtual Int_t  GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_t *free);
    Int_t          GetUnzipGroupSize() { return fUnzipGroupSize; }
    virtual void   ResetCache();
    virtual Int_t  SetBufferSize(Int_t buffersize);
+   virtual void   SetFile(TFile *file, TFile::ECacheAction action = TFile::kDisconnect);
    void           SetUnzipBufferSize(Long64_t bufferSize);
    void           SetUnzipGroupSize(Int_t groupSize) { fUnzipGroupSize = groupSize; }
    static void    SetUnzipRelBufferSize(Float_t relbufferSize);
    Int_t          UnzipBuffer(char **dest, char *src);
-   Int_t          UnzipCache(Int_t index);
 
    // Methods to get stats
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNStalls() { return fNStalls; }
+   Int_t  GetNReadAhead() { return fNReadAhead; }
+   Long64_t GetPendingBytes() const { return fPendingBytes; }
 
    void Print(Option_t* option = "") const;
 
@@ -28,6 +28,7 @@
 #include "RZip.h"
 
 #include <bitset>
+#include <vector>
 
 const UInt_t kDisplacementMask = 0xFF000000;  // In the streamer the two highest bytes of
                                               // the fEntryOffset are used to stored displacement.
@@ -154,6 +155,103 @@ Long64_t TBasket::CopyTo(TFile *to)
    return nBytes>0 ? nBytes : -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Recompress the payload of a basket loaded by LoadBasketBuffers with the
+/// given compression settings (algorithm*100+level), without unstreaming it.
+/// As in WriteBuffer, the payload is stored uncompressed if the level is not
+/// positive or if the compression does not reduce its size.
+/// This function is called by TTreeCloner and can be run concurrently on
+/// different baskets.
+/// The function returns 0 in case of success, 1 in case of error; in the latter
+/// case the basket is left unchanged.
+
+Int_t TBasket::Recompress(Int_t compressionSettings)
+{
+   if (!fBufferRef || fKeylen <= 0 || fObjlen <= 0) {
+      return 1;
+   }
+   Int_t nin = fNbytes - fKeylen;
+   if (fBufferRef->BufferSize() < fNbytes) {
+      return 1;
+   }
+
+   // Uncompress the current payload, if it is compressed.
+   std::vector<char> uncompressed;
+   const char *objbuf = fBufferRef->Buffer() + fKeylen;
+   if (fObjlen > nin) {
+      uncompressed.resize(fObjlen);
+      UChar_t *src = (UChar_t *)fBufferRef->Buffer() + fKeylen;
+      UChar_t *dst = (UChar_t *)uncompressed.data();
+      Int_t nintot = 0, noutot = 0;
+      while (noutot < fObjlen) {
+         Int_t nzip = 0, nbuf = 0, nout = 0;
+         if (nintot >= nin || R__unzip_header(&nzip, src, &nbuf) != 0 || nintot + nzip > nin ||
+             noutot + nbuf > fObjlen) {
+            Error("Recompress", "Inconsistency found in header (nin=%d, nbuf=%d)", nzip, nbuf);
+            return 1;
+         }
+         R__unzip(&nzip, src, &nbuf, dst, &nout);
+         if (!nout) break;
+         src += nzip;
+         dst += nout;
+         nintot += nzip;
+         noutot += nout;
+      }
+      if (noutot != fObjlen) {
+         Error("Recompress", "fNbytes = %d, fKeylen = %d, fObjlen = %d, noutot = %d", fNbytes, fKeylen, fObjlen, noutot);
+         return 1;
+      }
+      objbuf = uncompressed.data();
+   }
+
+   // Compress it again, in chunks of at most kMAXZIPBUF bytes.
+   Int_t cxlevel = (compressionSettings < 0) ? -1 : compressionSettings % 100;
+   ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm =
+      static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compressionSettings < 0 ? 0 : compressionSettings / 100);
+   std::vector<char> compressed;
+   Int_t noutot = 0;
+   if (cxlevel > 0) {
+      Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
+      compressed.resize(fObjlen + 9 * nbuffers + 28);
+      char *bufcur = compressed.data();
+      for (Int_t i = 0, nzip = 0; i < nbuffers; ++i, nzip += kMAXZIPBUF) {
+         Int_t bufmax = (i == nbuffers - 1) ? fObjlen - nzip : kMAXZIPBUF;
+         Int_t tgtmax = compressed.size() - noutot;
+         Int_t nout = 0;
+         R__zipMultipleAlgorithm(cxlevel, &bufmax, const_cast<char *>(objbuf) + nzip, &tgtmax, bufcur, &nout,
+                                 cxAlgorithm);
+         if (nout == 0 || noutot + nout >= fObjlen) {
+            noutot = 0;
+            break;
+         }
+         bufcur += nout;
+         noutot += nout;
+      }
+   }
+   if (noutot == 0) {
+      // Store the payload uncompressed.
+      objbuf = (objbuf == fBufferRef->Buffer() + fKeylen) ? nullptr : objbuf;
+      noutot = fObjlen;
+   } else {
+      objbuf = compressed.data();
+   }
+
+   // Replace the payload, keeping the key in front of it.
+   Bool_t reading = fBufferRef->IsReading();
+   fBufferRef->SetWriteMode();
+   if (fBufferRef->BufferSize() < fKeylen + noutot) {
+      fBufferRef->Expand(fKeylen + noutot);
+   }
+   if (objbuf) {
+      memcpy(fBufferRef->Buffer() + fKeylen, objbuf, noutot);
+   }
+   if (reading) fBufferRef->SetReadMode();
+   fBuffer = fBufferRef->Buffer();
+   fNbytes = fKeylen + noutot;
+
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  Delete fEntryOffset array.
 
@@ -466,6 +564,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
+   // In zero-copy mode, the compressed bytes stay in the cache's block; this keeps the block alive.
+   std::shared_ptr<const char> cacheView;
 
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
@@ -515,7 +615,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       Int_t st = 0;
       {
          R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
-         st = pf->ReadBuffer(readBufferRef->Buffer(),pos,len);
+         if (readBufferRef == fCompressedBufferRef && pf->IsZeroCopy())
+            st = pf->ReadBufferView(pos, len, cacheView);
+         else
+            st = pf->ReadBuffer(readBufferRef->Buffer(),pos,len);
       }
       if (st < 0) {
          return 1;
@@ -546,13 +649,19 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
       else gPerfStats = temp;
    }
-   Streamer(*readBufferRef);
+   if (cacheView) {
+      // Unstream the header straight out of the cache's block.
+      TBufferFile viewBuffer(TBuffer::kRead, len, const_cast<char *>(cacheView.get()), kFALSE);
+      Streamer(viewBuffer);
+      rawCompressedBuffer = const_cast<char *>(cacheView.get());
+   } else {
+      Streamer(*readBufferRef);
+      rawCompressedBuffer = readBufferRef->Buffer();
+   }
    if (IsZombie()) {
       return 1;
    }
 
-   rawCompressedBuffer = readBufferRef->Buffer();
-
    // Are we done?
    if (R__unlikely(readBufferRef == fBufferRef)) // We expect most basket to be compressed.
    {
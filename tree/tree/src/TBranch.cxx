@@ -1398,11 +1398,28 @@ Int_t TBranch::GetBasketAndFirst(TBasket *&basket, Long64_t &first,
 /// This will return true if all the various preconditions necessary hold true
 /// to perform bulk IO (reasonable type, single TLeaf, etc); the bulk IO may
 /// still fail, depending on the contents of the individual TBaskets loaded.
+///
+/// See SupportsJaggedBulkRead() for branches holding variable-sized arrays.
 Bool_t TBranch::SupportsBulkRead() const {
    return (fNleaves == 1) &&
           (static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetDeserializeType() != TLeaf::DeserializeType::kDestructive);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if this branch holds variable-sized arrays that can be read in
+/// bulk, false otherwise.
+///
+/// Such branches, i.e. leaves with a counter leaf and unsplit std::vector's of
+/// fundamental types, can only be read with the GetBulkEntries() overload that
+/// also fills an offset buffer.
+Bool_t TBranch::SupportsJaggedBulkRead() const {
+   if (fNleaves != 1)
+      return kFALSE;
+   EDataType type;
+   Int_t headerSize;
+   return static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetJaggedLayout(type, headerSize);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read as many events as possible into the given buffer, using zero-copy
 /// mechanisms.
@@ -1558,6 +1575,159 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    return N;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read as many events as possible into the given buffer and additionally
+/// fill the offset buffer with the position of every event's first element.
+///
+/// This overload supports branches with a variable number of elements per
+/// event, such as arrays with a counter leaf (`x[n]/F`), the data members of
+/// a split collection, and unsplit `std::vector`'s of fundamental types.  The
+/// elements of all the events in the basket are decoded into a flat array in
+/// place; per-event headers, such as the byte count, version, and size of the
+/// std::vector's, are removed.  For branches with a fixed number of elements
+/// per event, the offsets are generated from the number of elements.
+///
+/// Returns -1 in case of a failure.  On success, returns the (non-zero) number
+/// N of events in the buffer.  The caller can then access the values as
+///
+/// static_cast<T*>(user_buf.GetCurrent())
+///
+/// and the offsets as
+///
+/// reinterpret_cast<Int_t*>(offset_buf.GetCurrent())
+///
+/// The offset buffer holds N + 1 offsets in host byte order; the elements of
+/// the i-th event are in the range [offsets[i], offsets[i + 1]).
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf, TBuffer &offset_buf)
+{
+   // TODO: eventually support multiple leaves.
+   if (R__unlikely(fNleaves != 1)) return -1;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+
+   EDataType type = kOther_t;
+   Int_t headerSize = 0;
+   if (!leaf->GetJaggedLayout(type, headerSize)) {
+      Int_t N = GetBulkEntries(entry, user_buf);
+      if (R__unlikely(N < 0)) return -1;
+      Int_t *offsets = PrepareBulkOffsets(offset_buf, N);
+      const Int_t len = leaf->GetLenStatic();
+      for (Int_t i = 0; i <= N; ++i)
+         offsets[i] = i * len;
+      return N;
+   }
+
+   Int_t elementSize = 0;
+   switch (type) {
+   case kChar_t: case kUChar_t: elementSize = 1; break;
+   case kShort_t: case kUShort_t: elementSize = 2; break;
+   case kInt_t: case kUInt_t: case kFloat_t: elementSize = 4; break;
+   case kLong64_t: case kULong64_t: case kDouble_t: elementSize = 8; break;
+   default:
+      Error("GetBulkEntries", "Unsupported element type %d.\n", type);
+      return -1;
+   }
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   Bool_t enabled = !TestBit(kDoNotProcess);
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result <= 0)) return -1;
+   // Only support reading from full clusters.
+   if (R__unlikely(entry != first)) {
+       Error("GetBulkEntries", "Failed to read from full cluster; first entry is %lld; requested entry is %lld.\n", first, entry);
+       return -1;
+   }
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetBulkEntries", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetBulkEntries", "Basket has displacement.\n");
+      return -1;
+   }
+   const Int_t *entryOffset = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffset)) {
+      Error("GetBulkEntries", "Basket has no entry offsets.\n");
+      return -1;
+   }
+
+   Int_t bufbegin = basket->GetKeylen();
+   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+   Int_t *offsets = PrepareBulkOffsets(offset_buf, N);
+
+   // Move the elements of every entry next to the ones of the previous entry, dropping the per-entry headers.
+   // The destination never lies behind the source, so the data can be compacted in place.
+   char *data = buf->Buffer();
+   Int_t dest = bufbegin;
+   Bool_t success = kTRUE;
+   for (Int_t i = 0; i < N; ++i) {
+      const Int_t begin = entryOffset[i];
+      const Int_t end = (i + 1 < N) ? entryOffset[i + 1] : basket->GetLast();
+      const Int_t nBytes = end - begin - headerSize;
+      if (R__unlikely((nBytes < 0) || (nBytes % elementSize))) {
+         Error("GetBulkEntries", "Entry %lld has an unexpected size of %d bytes.\n", first + i, end - begin);
+         success = kFALSE;
+         break;
+      }
+      const Int_t nElements = nBytes / elementSize;
+      if (headerSize) {
+         // The header ends with the number of elements of the entry
+         Int_t nStored = 0;
+         char *ptr = data + begin + headerSize - sizeof(Int_t);
+         frombuf(ptr, &nStored);
+         if (R__unlikely(nStored != nElements)) {
+            Error("GetBulkEntries", "Entry %lld claims %d elements but holds %d.\n", first + i, nStored, nElements);
+            success = kFALSE;
+            break;
+         }
+         memmove(data + dest, data + begin + headerSize, nBytes);
+      }
+      dest += nBytes;
+      offsets[i + 1] = offsets[i] + nElements;
+   }
+
+   buf->SetBufferOffset(bufbegin);
+   if (success && (elementSize > 1) && R__unlikely(!buf->ByteSwapBuffer(offsets[N], type))) {
+      Error("GetBulkEntries", "Leaf failed to read.\n");
+      success = kFALSE;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   fCurrentBasket = nullptr;
+   fBaskets[fReadBasket] = nullptr;
+   R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
+   fExtraBasket = basket;
+   basket->DisownBuffer();
+
+   return success ? N : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for N + 1 offsets at the beginning of the given buffer and return
+/// the offset array; the first offset is set to zero.
+
+Int_t *TBranch::PrepareBulkOffsets(TBuffer &offset_buf, Int_t N)
+{
+   const Int_t size = (N + 1) * sizeof(Int_t);
+   if (offset_buf.BufferSize() < size)
+      offset_buf.Expand(size, kFALSE);
+   offset_buf.SetBufferOffset(0);
+   Int_t *offsets = reinterpret_cast<Int_t*>(offset_buf.Buffer());
+   offsets[0] = 0;
+   return offsets;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -55,11 +55,18 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - keeps only the entries that are also in the second list; the
+               sub-lists for TTrees that are not in the second list become empty
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
                 for 2 or more indices in a row.
 
+Add(), Subtract() and Intersect() operate block by block (see TEntryListBlock),
+so a list can be filled in parallel: each thread fills its own TEntryList for the
+range of entries it processes, and the partial lists are then combined with
+Add() or Merge().
+
 ## TTree::Draw() and TChain::Draw()
 
 Use option __entrylist__ to write the results of TTree::Draw and TChain::Draw into
@@ -1237,13 +1244,17 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1278,6 +1289,65 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries of this entry list that are also contained in elist.
+/// The entries of the sub-lists for trees that are not in elist are removed.
+/// If elist is null, all the entries are removed.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (!elist) {
+      // nothing is in common with an empty list
+      TEntryList empty;
+      Intersect(&empty);
+      return;
+   }
+   if (!fLists){
+      if (!fBlocks) return;
+      const TEntryList *other = 0;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data()))
+            other = elist;
+      } else {
+         //second list has sublists, try to find one for the same tree as this list
+         TIter next1(elist->GetLists());
+         TEntryList *templist = 0;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               other = templist;
+               break;
+            }
+         }
+      }
+      //intersect block by block, the blocks missing in the other list are emptied
+      Int_t nother = (other && other->fBlocks) ? other->fNBlocks : 0;
+      fN = 0;
+      for (Int_t i=0; i<fNBlocks; i++){
+         TEntryListBlock *block = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+         if (i < nother)
+            fN += block->Intersect((TEntryListBlock*)other->fBlocks->UncheckedAt(i));
+         else
+            block->Clear();
+      }
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      TEntryList *templist = 0;
+      fN = 0;
+      while ((templist = (TEntryList*)next2())){
+         templist->Intersect(elist);
+         fN += templist->GetN();
+      }
+      fCurrent = 0;
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
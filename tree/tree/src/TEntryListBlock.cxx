@@ -14,16 +14,19 @@
 
 Used by TEntryList to store the entry numbers.
 
-There are 2 ways to represent entry numbers in a TEntryListBlock:
+There are 3 ways to represent entry numbers in a TEntryListBlock:
 
  1. as bits, where passing entry numbers are assigned 1, not passing - 0
  2. as a simple array of entry numbers
   - storing the numbers of entries that pass
   - storing the numbers of entries that don't pass
+ 3. as an array of runs, i.e. of (first, last) pairs of consecutive passing entries
 
-In both cases, a UShort_t* is used. The second option is better in case
-less than 1/16 or more than 15/16 of entries pass the selection, and the representation can be
-changed by calling OptimizeStorage() function.
+In all cases, a UShort_t* is used. The second option is better in case
+less than 1/16 or more than 15/16 of entries pass the selection, the third one
+when the passing entries come in long runs, as for skims of sorted data.
+OptimizeStorage() picks the smallest representation. The third one only
+exists in memory: the Streamer writes such a block as bits or as a list.
 When the block is being filled, it's always stored as bits, and the OptimizeStorage()
 function is called by TEntryList when it starts filling the next block. If
 Enter() or Remove() is called after OptimizeStorage(), representation is
@@ -38,16 +41,49 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Intersect__() - keeps only the entries that are also in the other block
+ - __Subtract__()  - removes the entries of the other block
+
+Except for the merge of two short arrays, these operations are done word by
+word on the bits representation.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
 */
 
 #include "TEntryListBlock.h"
+#include "TBuffer.h"
+#include "TMath.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+/// Number of bits set in `word`
+inline Int_t PopCount(UShort_t word)
+{
+   return std::bitset<16>(word).count();
+}
+
+/// Set the bits of the entries first to last (included)
+void SetRange(UShort_t *bits, Int_t first, Int_t last)
+{
+   for (Int_t k = first; k <= last;) {
+      Int_t i = k >> 4;
+      Int_t j = k & 15;
+      Int_t n = TMath::Min(16 - j, last - k + 1);
+      bits[i] |= (UShort_t)(((1 << n) - 1) << j);
+      k += n;
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -149,12 +185,10 @@ Bool_t TEntryListBlock::Enter(Int_t entry)
          return 0;
       }
    }
-   //list
+   //list or runs
    //change to bits
-   UShort_t *bits = new UShort_t[kBlockSize];
-   Transform(1, bits);
-   Enter(entry);
-   return 0;
+   ToBits();
+   return Enter(entry);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -180,12 +214,10 @@ Bool_t TEntryListBlock::Remove(Int_t entry)
          return 0;
       }
    }
-   //list
+   //list or runs
    //change to bits
-   UShort_t *bits = new UShort_t[kBlockSize];
-   Transform(1, bits);
+   ToBits();
    return Remove(entry);
-   //return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -206,34 +238,21 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
-   //list
-   if (entry < fCurrent) fCurrent = 0;
+   if (fType==2){
+      //runs
+      Int_t run = FindRun(entry);
+      return run < fN/2 && fIndices[2*run] <= entry;
+   }
+   //list, sorted
    if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+      return std::binary_search(fIndices, fIndices+fNPassed, (UShort_t)entry);
    } else {
       if (!fIndices || fNPassed==0){
          //all entries pass
          return kTRUE;
       }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+      return !std::binary_search(fIndices, fIndices+fNPassed, (UShort_t)entry);
    }
-   return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,120 +261,47 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
-      fN = block->fN;
-      fIndices = new UShort_t[fN];
-      for (i=0; i<fN; i++)
-         fIndices[i] = block->fIndices[i];
-      fNPassed = block->fNPassed;
-      fType = block->fType;
-      fPassing = block->fPassing;
-      fCurrent = block->fCurrent;
-      fLastIndexReturned = -1;
-      fLastIndexQueried = -1;
-      return fNPassed;
+      *this = *block;
+      return GetNPassed();
    }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
+   if (fType==1 && fPassing && block->fType==1 && block->fPassing &&
+       GetNPassed() + block->GetNPassed() <= kBlockSize){
+      //both stored as lists of passing entries
+      //make a bigger list
+      Int_t en = block->fNPassed;
+      Int_t newsize = fNPassed + en;
+      UShort_t *newlist = new UShort_t[newsize];
+      UShort_t *elst = block->fIndices;
+      Int_t newpos, elpos;
+      newpos = elpos = 0;
+      for (i=0; i<fNPassed; i++) {
+         while (elpos < en && fIndices[i] > elst[elpos]) {
+            newlist[newpos] = elst[elpos];
+            newpos++;
+            elpos++;
          }
+         if (elpos < en && fIndices[i] == elst[elpos]) elpos++;
+         newlist[newpos] = fIndices[i];
+         newpos++;
       }
-   } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(1, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
+      while (elpos < en) {
+         newlist[newpos] = elst[elpos];
+         newpos++;
+         elpos++;
       }
+      delete [] fIndices;
+      fIndices = newlist;
+      fNPassed = newpos;
+      fN = fNPassed;
+   } else {
+      //word by word, in the bits representation
+      ToBits();
+      block->FillBits(fIndices);
+      fNPassed = CountBits(fIndices);
    }
    fLastIndexQueried = -1;
    fLastIndexReturned = -1;
@@ -363,6 +309,69 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries that are also in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   if (block->GetNPassed() == 0){
+      Clear();
+      return 0;
+   }
+   ToBits();
+   UShort_t *bits = new UShort_t[kBlockSize];
+   memset(bits, 0, kBlockSize*sizeof(UShort_t));
+   block->FillBits(bits);
+   for (Int_t i=0; i<kBlockSize; i++)
+      fIndices[i] &= bits[i];
+   delete [] bits;
+   fNPassed = CountBits(fIndices);
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries of the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   ToBits();
+   UShort_t *bits = new UShort_t[kBlockSize];
+   memset(bits, 0, kBlockSize*sizeof(UShort_t));
+   block->FillBits(bits);
+   for (Int_t i=0; i<kBlockSize; i++)
+      fIndices[i] &= (UShort_t)~bits[i];
+   delete [] bits;
+   fNPassed = CountBits(fIndices);
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all the entries of the block
+
+void TEntryListBlock::Clear(Option_t *)
+{
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = 0;
+   fN = kBlockSize;
+   fNPassed = 0;
+   fType = -1;
+   fPassing = 1;
+   fCurrent = 0;
+   fLastIndexReturned = -1;
+   fLastIndexQueried = -1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -382,23 +391,39 @@ Int_t TEntryListBlock::GetNPassed()
 Int_t TEntryListBlock::GetEntry(Int_t entry)
 {
    if (entry > kBlockSize*16) return -1;
-   if (entry > GetNPassed()) return -1;
+   if (entry >= GetNPassed()) return -1;
    if (entry == fLastIndexQueried+1) return Next();
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //skip the words before the one holding the entry
+         Int_t remaining = entry;
+         Int_t nbits;
+         while ((nbits = PopCount(fIndices[i])) <= remaining){
+            remaining -= nbits;
+            i++;
+         }
+         for (j=0; j<16; j++){
+            if ((fIndices[i] & (1<<j))!=0){
+               if (remaining==0) break;
+               remaining--;
+            }
          }
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
       }
+      if (fType==2){
+         Int_t remaining = entry;
+         for (i=0; i<fN/2; i++){
+            Int_t length = fIndices[2*i+1] - fIndices[2*i] + 1;
+            if (remaining < length) break;
+            remaining -= length;
+         }
+         fLastIndexQueried = entry;
+         fLastIndexReturned = fIndices[2*i] + remaining;
+         return fLastIndexReturned;
+      }
       if (fType==1){
          if (fPassing){
             fLastIndexQueried = entry;
@@ -453,23 +478,29 @@ Int_t TEntryListBlock::Next()
    }
 
    if (fType==0) {
-      //bits
-      Int_t i=0;
-      Int_t j=0;
-      fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
+      //bits, skipping the empty words
+      Int_t pos = fLastIndexReturned+1;
+      Int_t i = pos>>4;
+      Int_t j = pos & 15;
+      UShort_t word = fIndices[i] & (0xFFFF << j);
+      while (word==0)
+         word = fIndices[++i];
+      j = 0;
+      while ((word & (1<<j))==0)
+         j++;
       fLastIndexReturned = i*16+j;
       fLastIndexQueried++;
       return fLastIndexReturned;
 
    }
+   if (fType==2) {
+      //runs
+      Int_t pos = fLastIndexReturned+1;
+      Int_t run = FindRun(pos);
+      fLastIndexReturned = TMath::Max(pos, (Int_t)fIndices[2*run]);
+      fLastIndexQueried++;
+      return fLastIndexReturned;
+   }
    if (fType==1) {
       fLastIndexQueried++;
       if (fPassing){
@@ -514,6 +545,11 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
          if (result)
             printf("%d\n", i+shift);
       }
+   } else if (fType==2){
+      for (i=0; i<fN/2; i++){
+         for (Int_t j=fIndices[2*i]; j<=fIndices[2*i+1]; j++)
+            printf("%d\n", j+shift);
+      }
    } else {
       if (fPassing){
          for (i=0; i<fNPassed; i++){
@@ -541,12 +577,29 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// If there are < kBlockSize or >kBlockSize*15 entries, change to an array
+/// If the entries come in few enough runs, change to a runs representation.
+/// Otherwise, if there are < kBlockSize or >kBlockSize*15 entries, change to an array
 /// representation
 
 void TEntryListBlock::OptimizeStorage()
 {
    if (fType!=0) return;
+   Int_t nruns = CountRuns(fIndices);
+   Int_t nlist = TMath::Min(fNPassed, kBlockSize*16-fNPassed);
+   if (2*nruns < TMath::Min(nlist, (Int_t)kBlockSize)){
+      ToRuns(nruns);
+      return;
+   }
+   OptimizeStorageNoRuns();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Same as OptimizeStorage(), but choosing between bits and list only: these
+/// are the representations that were written by all the versions of the class
+
+void TEntryListBlock::OptimizeStorageNoRuns()
+{
+   ToBits();
    if (fNPassed > kBlockSize*15)
       fPassing = 0;
    if (fNPassed<kBlockSize || !fPassing){
@@ -618,3 +671,150 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    fPassing = 1;
    return;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change to the bits representation, whatever the current one
+
+void TEntryListBlock::ToBits()
+{
+   if (fType==0) return;
+   UShort_t *bits = new UShort_t[kBlockSize];
+   if (fType!=2){
+      Transform(1, bits);
+      return;
+   }
+   memset(bits, 0, kBlockSize*sizeof(UShort_t));
+   FillBits(bits);
+   delete [] fIndices;
+   fIndices = bits;
+   fType = 0;
+   fN = kBlockSize;
+   fPassing = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change from the bits to the runs representation; nruns is the number of
+/// runs, see CountRuns()
+
+void TEntryListBlock::ToRuns(Int_t nruns)
+{
+   UShort_t *runs = new UShort_t[2*nruns];
+   Int_t irun = 0;
+   Bool_t inRun = kFALSE;
+   for (Int_t i=0; i<kBlockSize; i++){
+      UShort_t word = fIndices[i];
+      if ((word==0 && !inRun) || (word==0xFFFF && inRun)) continue;
+      for (Int_t j=0; j<16; j++){
+         Bool_t set = (word & (1<<j))!=0;
+         if (set && !inRun){
+            runs[2*irun] = i*16+j;
+            inRun = kTRUE;
+         } else if (!set && inRun){
+            runs[2*irun+1] = i*16+j-1;
+            irun++;
+            inRun = kFALSE;
+         }
+      }
+   }
+   if (inRun){
+      runs[2*irun+1] = kBlockSize*16-1;
+      irun++;
+   }
+   delete [] fIndices;
+   fIndices = runs;
+   fType = 2;
+   fN = 2*irun;
+   fPassing = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the bits of the passing entries of this block in `bits`, an array of
+/// kBlockSize words; the other bits are left untouched
+
+void TEntryListBlock::FillBits(UShort_t *bits) const
+{
+   Int_t i;
+   if (!fIndices) return;
+   if (fType==0){
+      for (i=0; i<kBlockSize; i++)
+         bits[i] |= fIndices[i];
+   } else if (fType==2){
+      for (i=0; i<fN/2; i++)
+         SetRange(bits, fIndices[2*i], fIndices[2*i+1]);
+   } else if (fPassing){
+      for (i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] |= 1<<(fIndices[i] & 15);
+   } else {
+      //all entries but the listed ones
+      Int_t first = 0;
+      for (i=0; i<fNPassed; i++){
+         SetRange(bits, first, fIndices[i]-1);
+         first = fIndices[i]+1;
+      }
+      SetRange(bits, first, kBlockSize*16-1);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the first run ending at or after entry, fN/2 if none
+
+Int_t TEntryListBlock::FindRun(Int_t entry) const
+{
+   Int_t lo = 0;
+   Int_t hi = fN/2;
+   while (lo < hi){
+      Int_t mid = (lo+hi)/2;
+      if (fIndices[2*mid+1] < entry) lo = mid+1;
+      else hi = mid;
+   }
+   return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bits set in an array of kBlockSize words
+
+Int_t TEntryListBlock::CountBits(const UShort_t *bits)
+{
+   Int_t n = 0;
+   for (Int_t i=0; i<kBlockSize; i++)
+      n += PopCount(bits[i]);
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of runs of consecutive bits set in an array of kBlockSize words
+
+Int_t TEntryListBlock::CountRuns(const UShort_t *bits)
+{
+   Int_t nruns = 0;
+   UShort_t previous = 0;
+   for (Int_t i=0; i<kBlockSize; i++){
+      UShort_t word = bits[i];
+      //a run starts at each bit set whose lower neighbour is not
+      UShort_t shifted = (UShort_t)((word << 1) | previous);
+      nruns += PopCount((UShort_t)(word & ~shifted));
+      previous = word >> 15;
+   }
+   return nruns;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Custom streamer for class TEntryListBlock. A block stored as runs is
+/// written as bits or as a list, such that the files can be read by the
+/// versions of ROOT which don't know about runs.
+
+void TEntryListBlock::Streamer(TBuffer &b)
+{
+   if (b.IsReading()) {
+      b.ReadClassBuffer(TEntryListBlock::Class(), this);
+      fCurrent = 0;
+      fLastIndexQueried = -1;
+      fLastIndexReturned = -1;
+   } else if (fType==2) {
+      TEntryListBlock block(*this);
+      block.OptimizeStorageNoRuns();
+      b.WriteClassBuffer(TEntryListBlock::Class(), &block);
+   } else {
+      b.WriteClassBuffer(TEntryListBlock::Class(), this);
+   }
+}
@@ -19,6 +19,8 @@ a TStreamerInfo (i.e. using TBranchElement).
 #include "TLeafElement.h"
 //#include "TMethodCall.h"
 
+#include "TClass.h"
+#include "TVirtualCollectionProxy.h"
 #include "TVirtualStreamerInfo.h"
 #include "Bytes.h"
 
@@ -139,10 +141,63 @@ TLeafElement::GetDeserializeType() const
    return DeserializeType::kDestructive;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Determine if this TLeafElement stores a variable-sized array that supports bulk IO.
+///
+/// Two layouts are supported: the data member of a split collection, whose entries are stored as back-to-back
+/// values, and an unsplit std::vector of a fundamental type, whose entries are preceded by a byte count,
+/// a version and the number of elements (10 bytes in total).
+bool TLeafElement::GetJaggedLayout(EDataType &type, Int_t &headerSize) const
+{
+   auto branch = static_cast<TBranchElement *>(fBranch);
+   const auto streamerType = branch->GetStreamerType();
+   if (fLeafCount) {
+      // Only the members of split collections qualify; arrays behind pointer members carry an extra flag byte
+      if (((branch->GetType() != 31) && (branch->GetType() != 41)) || (streamerType >= TVirtualStreamerInfo::kOffsetP))
+         return false;
+      if (GetDeserializeType() == DeserializeType::kDestructive)
+         return false;
+      type = fDataTypeCache.load(std::memory_order_consume);
+      headerSize = 0;
+      return true;
+   }
+
+   if ((branch->GetType() != 0) || branch->GetListOfBranches()->GetEntriesFast())
+      return false;
+   if ((streamerType != -1) && (streamerType != TVirtualStreamerInfo::kSTL))
+      return false;
+   TClass *clptr = nullptr;
+   EDataType expectedType = EDataType::kOther_t;
+   if (branch->GetExpectedType(clptr, expectedType) || !clptr)
+      return false;
+   auto proxy = clptr->GetCollectionProxy();
+   if (!proxy || (proxy->GetCollectionType() != ROOT::kSTLvector) || proxy->GetValueClass() || proxy->HasPointers())
+      return false;
+   switch (proxy->GetType()) {
+   case EDataType::kChar_t:
+   case EDataType::kUChar_t:
+   case EDataType::kShort_t:
+   case EDataType::kUShort_t:
+   case EDataType::kInt_t:
+   case EDataType::kUInt_t:
+   case EDataType::kFloat_t:
+   case EDataType::kLong64_t:
+   case EDataType::kULong64_t:
+   case EDataType::kDouble_t:
+      type = proxy->GetType();
+      headerSize = 10;
+      return true;
+   default:
+      return false;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Deserialize N events from an input buffer.
 Bool_t TLeafElement::ReadBasketFast(TBuffer &input_buf, Long64_t N)
 {
+   // Variable-sized arrays need an offset array, see TBranch::GetBulkEntries()
+   if (R__unlikely(fLeafCount)) {return false;}
    EDataType type = fDataTypeCache.load(std::memory_order_consume);
    return input_buf.ByteSwapBuffer(fLen*N, type);
 }
@@ -3061,6 +3061,12 @@ Int_t TTree::CheckBranchAddressType(TBranch* branch, TClass* ptrClass, EDataType
 /// the file the baskets will be in the order in which they will be
 /// needed when reading the whole tree sequentially.
 ///
+/// When 'fast' is specified, 'option' can also contain the word
+/// 'recompress': the baskets are then uncompressed and compressed again
+/// with the compression settings of the output file, still without
+/// being unstreamed. With implicit multi-threading enabled, the baskets
+/// are recompressed in parallel.
+///
 /// For examples of CloneTree, see tutorials:
 ///
 /// - copytree.C:
@@ -3445,6 +3451,10 @@ namespace {
 ///
 /// See TTree::CloneTree for a detailed explanation of the semantics of these 3 options.
 ///
+/// When 'fast' is specified, 'option' can also contain 'recompress' to compress the
+/// baskets again with the compression settings of this tree's branches, without
+/// unstreaming them.
+///
 /// If the tree or any of the underlying tree of the chain has an index, that index and any
 /// index in the subsequent underlying TTree objects will be merged.
 ///
@@ -20,6 +20,7 @@
 - [General Description](#description)
 - [Changes in behaviour](#changesbehaviour)
 - [Self-optimization](#cachemisses)
+- [Zero-copy reading and readahead](#zerocopy)
 - [Examples of usage](#examples)
 - [Check performance and stats](#checkPerf)
 
@@ -125,6 +126,23 @@ Additionally, on the first miss of an event, we must iterate through all the
 This can be potentially a CPU-expensive operation compared to, e.g., the
 latency of a SSD.  This is why the miss cache is currently disabled by default.
 
+## <a name="zerocopy"></a>Zero-copy reading and readahead
+
+With SetZeroCopy(), each fill of the cache is read with a single vectored
+request into a pooled memory block aligned to huge pages (see
+ROOT::Internal::RAlignedBlockPool).  Baskets then decompress directly out of
+that block instead of first copying their compressed bytes out of the cache.
+A block stays alive as long as a basket still reads from it, so a refill
+never has to wait for (or invalidate) the consumers of the previous one.
+
+SetReadaheadClusters() requests that each fill covers at least the given
+number of clusters, even if the usual estimate based on the cache size would
+stop earlier; the cache may then use up to four times its nominal size.  This
+amortizes the latency of remote files over larger requests.
+
+Both settings can also be enabled for all caches with the resource variables
+`TTreeCache.ZeroCopy` and `TTreeCache.ReadaheadClusters`.
+
 ## <a name="examples"></a>Example usages of TTreeCache
 
 A few use cases are discussed below. A cache may be created with automatic
@@ -276,6 +294,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 
 */
 
+#include "ROOT/RAlignedBlockPool.hxx"
 #include "TSystem.h"
 #include "TEnv.h"
 #include "TTreeCache.h"
@@ -311,9 +330,12 @@ TTreeCache::TTreeCache() : TFileCacheRead(), fPrefillType(GetConfiguredPrefillTy
 
 TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    : TFileCacheRead(tree->GetCurrentFile(), buffersize, tree), fEntryMax(tree->GetEntriesFast()), fEntryNext(0),
-     fBrNames(new TList), fTree(tree), fPrefillType(GetConfiguredPrefillType())
+     fBrNames(new TList), fTree(tree), fPrefillType(GetConfiguredPrefillType()),
+     fReadaheadClusters(gEnv->GetValue("TTreeCache.ReadaheadClusters", 0))
 {
    fEntryNext = fEntryMin + fgLearnEntries;
+   if (gEnv->GetValue("TTreeCache.ZeroCopy", 0))
+      SetZeroCopy(kTRUE);
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
    fBranches = new TObjArray(nleaves);
 }
@@ -1514,7 +1536,10 @@ Bool_t TTreeCache::FillBuffer()
                   }
                }
 
-               if ((ntotCurrentBuf + len) > fBufferSizeMin) {
+               // When reading ahead, keep collecting whole clusters up to the hard limit used below
+               const Bool_t readahead =
+                  clusterIterations < fReadaheadClusters && (ntotCurrentBuf + len) <= 4 * fBufferSizeMin;
+               if ((ntotCurrentBuf + len) > fBufferSizeMin && !readahead) {
                   // Humm ... we are going to go over the requested size.
                   if (clusterIterations > 0 && cursor[i].fLoadedOnce) {
                      // We already have a full cluster and now we would go over the requested
@@ -1693,7 +1718,10 @@ Bool_t TTreeCache::FillBuffer()
       // be 'large' (i.e. 30Mb * 300 intervals) and can overflow the numerical limit of Int_t (i.e. become
       // artificially negative).   To avoid this issue we promote ntotCurrentBuf to a long long (64 bits rather than 32
       // bits)
-      if (!((fBufferSizeMin > ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations) &&
+      // When reading ahead (see SetReadaheadClusters), the memory estimate does not stop the loop until the requested
+      // number of clusters has been collected.
+      if (!(((clusterIterations < fReadaheadClusters) ||
+             (fBufferSizeMin > ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations)) &&
             (prevNtot < ntotCurrentBuf) && (minEntry < fEntryMax))) {
          if (showMore || gDebug > 6)
             Info("FillBuffer", "Breaking because %d <= %lld || (%d >= %d) || %lld >= %lld", fBufferSizeMin,
@@ -2013,6 +2041,61 @@ Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
       return TTreeCache::ReadBufferNormal(buf, pos, len);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Obtain a view of the basket at position pos without copying it out of the
+/// cache (zero-copy mode only, see TFileCacheRead::SetZeroCopy).
+/// If the basket is not in the cache, try to fill the cache from the list of
+/// selected branches, and recheck if pos is now in the list.
+/// Returns:
+///  - -1 in case of read failure,
+///  - 0 in case not in cache,
+///  - 1 in case the view was set.
+/// This function overloads TFileCacheRead::ReadBufferView.
+
+Int_t TTreeCache::ReadBufferView(Long64_t pos, Int_t len, std::shared_ptr<const char> &view)
+{
+   view.reset();
+   if (!fEnabled || !IsZeroCopy())
+      return 0;
+
+   if (TFileCacheRead::ReadBufferView(pos, len, view) == 1) {
+      fNReadOk++;
+      return 1;
+   }
+
+   if (FillBuffer()) {
+      Int_t res = TFileCacheRead::ReadBufferView(pos, len, view);
+      if (res == 1)
+         fNReadOk++;
+      else if (res == 0)
+         fNReadMiss++;
+      return res;
+   }
+
+   if (fOptimizeMisses) {
+      auto block = ROOT::Internal::RAlignedBlockPool::Instance().Acquire(len);
+      if (block && CheckMissCache(block.get(), pos, len)) {
+         view = block;
+         return 1;
+      }
+   }
+
+   fNReadMiss++;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of clusters that each fill of the cache should cover at least.
+///
+/// Zero (the default) lets the cache size alone decide how many clusters are
+/// read at once.  To bound the memory usage, a fill never exceeds four times
+/// the cache size.
+
+void TTreeCache::SetReadaheadClusters(Int_t nclusters)
+{
+   fReadaheadClusters = nclusters > 0 ? nclusters : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This will simply clear the cache
 
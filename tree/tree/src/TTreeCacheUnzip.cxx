@@ -16,6 +16,33 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+Each time the cache reads a cluster, the compressed baskets of that cluster are
+handed over, without copy, to an UnzipCluster which owns them.  While the reader
+consumes the cluster, groups of baskets are decompressed by tasks of a
+ROOT::Experimental::TTaskGroup, and GetUnzipBuffer() hands the decompressed
+baskets over to TBasket without copying them.
+
+  - The decompressed baskets which have not been handed over yet, plus those
+    being decompressed, never exceed the unzip buffer size (see
+    SetUnzipBufferSize() and SetUnzipRelBufferSize()): tasks are only scheduled
+    when baskets are handed over and memory is released.
+  - As soon as the reader starts consuming a cluster, a task reads the baskets
+    of the following cluster such that the I/O of one cluster overlaps with
+    the decompression of the previous one.  Clusters the reader moved past are
+    dropped; a cluster read ahead is kept when the cache is refilled, and its
+    baskets are not read again.
+  - The cache is only used by the thread reading the tree: while parallel
+    unzipping is enabled, TTree::GetEntry() reads the branches sequentially.
+  - A basket that no task got to yet is decompressed by the reader itself,
+    straight out of the cluster's data; a reader waiting for a task helps with
+    the other baskets of the cluster meanwhile.
+
+In zero-copy mode (see TFileCacheRead::SetZeroCopy()) the clusters share the
+blocks read by the cache, otherwise they take a copy of the compressed
+baskets.  With asynchronous reading or prefetching, the cache does not hold
+the baskets itself: only the clusters read ahead are unzipped in parallel.
+Baskets which are not part of an UnzipCluster (e.g. while the cache is
+learning) are read as with a plain TTreeCache.
 */
 
 #include "TTreeCacheUnzip.h"
@@ -24,15 +51,19 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TEnv.h"
 #include "TEventList.h"
 #include "TFile.h"
-#include "TMath.h"
 #include "TMutex.h"
+#include "TROOT.h"
+#include "TVirtualMutex.h"
+#include "ROOT/RAlignedBlockPool.hxx"
 #include "ROOT/RMakeUnique.hxx"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
+#include <cstring>
+
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
 
@@ -46,125 +77,158 @@ Double_t TTreeCacheUnzip::fgRelBuffSize = .5;
 ClassImp(TTreeCacheUnzip);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Clear all baskets' state arrays.
-
-void TTreeCacheUnzip::UnzipState::Clear(Int_t size) {
-   for (Int_t i = 0; i < size; i++) {
-      if (!fUnzipLen.empty()) fUnzipLen[i] = 0;
-      if (fUnzipChunks) {
-         if (fUnzipChunks[i]) fUnzipChunks[i].reset();
-      }
-      if (fUnzipStatus) fUnzipStatus[i].store(0);
-   }
+/// Take a copy of the layout of `n` baskets whose compressed bytes are in `data`.
+
+TTreeCacheUnzip::UnzipCluster::UnzipCluster(std::shared_ptr<const char> data, const Long64_t *pos, const Int_t *len,
+                                            const Int_t *offset, Int_t n, std::atomic<Long64_t> *pendingBytes)
+   : fData(std::move(data)), fPos(pos, pos + n), fLen(len, len + n), fOffset(offset, offset + n), fRawLen(n, 0),
+     fUnzipChunks(new std::unique_ptr<char[]>[n]), fUnzipLen(n, 0), fUnzipStatus(new std::atomic<Byte_t>[n]),
+     fPendingBytes(pendingBytes), fEntryBegin(0), fEntryEnd(0), fOldFormat(kFALSE), fNextTask(0),
+     fReadAhead(kFALSE), fCancelled(false)
+{
+   for (Int_t i = 0; i < n; ++i)
+      fUnzipStatus[i].store(kUntouched);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// The unzipped baskets never handed over are no longer pending.
 
-Bool_t TTreeCacheUnzip::UnzipState::IsUntouched(Int_t index) const {
-   return fUnzipStatus[index].load() == kUntouched;
+TTreeCacheUnzip::UnzipCluster::~UnzipCluster()
+{
+   for (Int_t i = 0; i < Size(); ++i) {
+      if (fUnzipChunks[i])
+         *fPendingBytes -= fUnzipLen[i];
+   }
+   delete [] fUnzipChunks;
+   delete [] fUnzipStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the basket at position `pos` on file, -1 if it is not part of this cluster.
 
-Bool_t TTreeCacheUnzip::UnzipState::IsProgress(Int_t index) const {
-   return fUnzipStatus[index].load() == kProgress;
+Int_t TTreeCacheUnzip::UnzipCluster::Find(Long64_t pos) const
+{
+   auto itr = std::lower_bound(fPos.begin(), fPos.end(), pos);
+   if (itr == fPos.end() || *itr != pos)
+      return -1;
+   return itr - fPos.begin();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Bool_t TTreeCacheUnzip::UnzipState::IsFinished(Int_t index) const {
-   return fUnzipStatus[index].load() == kFinished;
+Bool_t TTreeCacheUnzip::UnzipCluster::IsUntouched(Int_t index) const {
+   return fUnzipStatus[index].load() == kUntouched;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Check if the basket is unzipped already. We must make sure the length in
-/// fUnzipLen is larger than 0.
 
-Bool_t TTreeCacheUnzip::UnzipState::IsUnzipped(Int_t index) const {
-   return (fUnzipStatus[index].load() == kFinished) && (fUnzipChunks[index].get()) && (fUnzipLen[index] > 0);
+Bool_t TTreeCacheUnzip::UnzipCluster::IsProgress(Int_t index) const {
+   return fUnzipStatus[index].load() == kProgress;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Reset all baskets' state arrays. This function is only called by main
-/// thread and parallel processing from upper layers should be disabled such
-/// as IMT in TTree::GetEntry(). Other threads should not call this function 
-/// since it is not thread-safe.
-
-void TTreeCacheUnzip::UnzipState::Reset(Int_t oldSize, Int_t newSize) {
-   std::vector<Int_t>       aUnzipLen    = std::vector<Int_t>(newSize, 0);
-   std::unique_ptr<char[]> *aUnzipChunks = new std::unique_ptr<char[]>[newSize];
-   std::atomic<Byte_t>     *aUnzipStatus = new std::atomic<Byte_t>[newSize];
-
-   for (Int_t i = 0; i < newSize; ++i)
-      aUnzipStatus[i].store(0);
-
-   for (Int_t i = 0; i < oldSize; i++) {
-      aUnzipLen[i]    = fUnzipLen[i];
-      aUnzipChunks[i] = std::move(fUnzipChunks[i]);
-      aUnzipStatus[i].store(fUnzipStatus[i].load());
-   }
+/// Check if the basket is unzipped and not yet handed over.
 
-   if (fUnzipChunks) delete [] fUnzipChunks;
-   if (fUnzipStatus) delete [] fUnzipStatus;
-
-   fUnzipLen    = aUnzipLen;
-   fUnzipChunks = aUnzipChunks;
-   fUnzipStatus = aUnzipStatus;
+Bool_t TTreeCacheUnzip::UnzipCluster::IsUnzipped(Int_t index) const {
+   return (fUnzipStatus[index].load() == kFinished) && (fUnzipChunks[index].get()) && (fUnzipLen[index] > 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Set cache as finished. 
-/// There are three scenarios that a basket is set as finished:
-///    1. The basket has already been unzipped.
-///    2. The thread is aborted from unzipping process.
-///    3. To avoid other tasks/threads work on this basket,
-///       main thread marks the basket as finished and designates itself
-///       to unzip this basket.
+/// Mark the basket as done without an unzipped chunk: either the unzipping
+/// failed or the basket is taken care of by its reader.
+/// Must be called by the thread which set the basket in progress.
 
-void TTreeCacheUnzip::UnzipState::SetFinished(Int_t index) {
+void TTreeCacheUnzip::UnzipCluster::SetMissed(Int_t index) {
    fUnzipLen[index] = 0;
    fUnzipChunks[index].reset();
    fUnzipStatus[index].store((Byte_t)kFinished);
+   NotifyDone();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Must be called by the thread which set the basket in progress.
 
-void TTreeCacheUnzip::UnzipState::SetMissed(Int_t index) {
-   fUnzipChunks[index].reset();
+void TTreeCacheUnzip::UnzipCluster::SetUnzipped(Int_t index, char* buf, Int_t len) {
+   // Update status array at the very end because we need to be synchronous with the reader.
+   fUnzipLen[index] = len;
+   fUnzipChunks[index].reset(buf);
+   *fPendingBytes += len;
    fUnzipStatus[index].store((Byte_t)kFinished);
+   NotifyDone();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Hand the unzipped basket over to the caller. If `*buf` is null, the caller
+/// becomes the owner of the chunk, otherwise the chunk is copied into `*buf`.
+/// Returns the length of the basket, or -1 if there is no unzipped chunk.
 
-void TTreeCacheUnzip::UnzipState::SetUnzipped(Int_t index, char* buf, Int_t len) {
-   // Update status array at the very end because we need to be synchronous with the main thread.
-   fUnzipLen[index] = len;
-   fUnzipChunks[index].reset(buf);
+Int_t TTreeCacheUnzip::UnzipCluster::TakeUnzipped(Int_t index, char **buf, Bool_t *free) {
+   Byte_t oldValue = kFinished;
+   if (!fUnzipStatus[index].compare_exchange_strong(oldValue, kProgress))
+      return -1;
+   std::unique_ptr<char[]> chunk = std::move(fUnzipChunks[index]);
+   const Int_t len = fUnzipLen[index];
+   fUnzipLen[index] = 0;
    fUnzipStatus[index].store((Byte_t)kFinished);
+   NotifyDone();
+   if (!chunk)
+      return -1;
+   *fPendingBytes -= len;
+
+   if (!(*buf)) {
+      *buf = chunk.release();
+      *free = kTRUE;
+   } else {
+      memcpy(*buf, chunk.get(), len);
+      *free = kFALSE;
+   }
+   return len;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Start unzipping the basket if it is untouched yet.
 
-Bool_t TTreeCacheUnzip::UnzipState::TryUnzipping(Int_t index) {
+Bool_t TTreeCacheUnzip::UnzipCluster::TryUnzipping(Int_t index) {
    Byte_t oldValue = kUntouched;
    Byte_t newValue = kProgress;
-   return fUnzipStatus[index].compare_exchange_weak(oldValue, newValue, std::memory_order_release, std::memory_order_relaxed);
+   return fUnzipStatus[index].compare_exchange_strong(oldValue, newValue, std::memory_order_acquire,
+                                                      std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wake up the readers waiting in WaitUntilDone().  Must be called after the
+/// status of a basket left kProgress.
+
+void TTreeCacheUnzip::UnzipCluster::NotifyDone() {
+   // Taking the lock orders the notification after the check of a waiter which is about to block
+   std::lock_guard<std::mutex> lock(fDoneMutex);
+   fDoneCv.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Block until the basket is not in progress anymore.
+
+void TTreeCacheUnzip::UnzipCluster::WaitUntilDone(Int_t index) {
+   std::unique_lock<std::mutex> lock(fDoneMutex);
+   fDoneCv.wait(lock, [this, index] { return !IsProgress(index); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
-   fAsyncReading(kFALSE),
-   fEmpty(kTRUE),
-   fCycle(0),
-   fNseekMax(0),
+   fClustersGeneration(0),
+   fClosing(kFALSE),
+   fWaiting(kFALSE),
+   fParallel(kFALSE),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fPendingBytes(0),
+   fScheduledBytes(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNReadAhead(0)
 {
    // Default Constructor.
    Init();
@@ -174,16 +238,19 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
 /// Constructor.
 
 TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tree,buffersize),
-   fAsyncReading(kFALSE),
-   fEmpty(kTRUE),
-   fCycle(0),
-   fNseekMax(0),
+   fClustersGeneration(0),
+   fClosing(kFALSE),
+   fWaiting(kFALSE),
+   fParallel(kFALSE),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fPendingBytes(0),
+   fScheduledBytes(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNReadAhead(0)
 {
    Init();
 }
@@ -198,9 +265,6 @@ void TTreeCacheUnzip::Init()
 #endif
    fIOMutex = std::make_unique<TMutex>(kTRUE);
 
-   fCompBuffer = new char[16384];
-   fCompBufferSize = 16384;
-
    fUnzipGroupSize = 102400; // Each task unzips at least 100 KB
 
    if (fgParallel == kDisable) {
@@ -213,18 +277,10 @@ void TTreeCacheUnzip::Init()
          Info("TTreeCacheUnzip", "Enabling Parallel Unzipping");
 
       fParallel = kTRUE;
-
    }
    else {
       Warning("TTreeCacheUnzip", "Parallel Option unknown");
    }
-
-   // Check if asynchronous reading is supported by this TFile specialization
-   if (gEnv->GetValue("TFile.AsyncReading", 1)) {
-      if (fFile && !(fFile->ReadBufferAsync(0, 0)))
-         fAsyncReading = kTRUE;
-   }
-
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -232,8 +288,13 @@ void TTreeCacheUnzip::Init()
 
 TTreeCacheUnzip::~TTreeCacheUnzip()
 {
+   {
+      // From now on the tasks can't submit other tasks
+      std::lock_guard<std::mutex> lock(fClustersMutex);
+      fClosing = kTRUE;
+   }
+   // The tasks refer to this cache: ResetCache() waits for them to be done
    ResetCache();
-   fUnzipState.Clear(fNseekMax);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -290,6 +351,51 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    if (fEntryMax <= 0) fEntryMax = tree->GetEntries();
    if (fEntryNext > fEntryMax) fEntryNext = fEntryMax;
 
+   //clear cache buffer
+   TFileCacheRead::Prefetch(0,0);
+
+   std::vector<std::pair<Long64_t, Int_t>> baskets;
+   CollectBaskets(entry, fEntryNext, baskets);
+   {
+      // The clusters before the new range belong to the entries the reader moved away from. The others were read
+      // ahead: they are kept and their baskets are not read again.
+      std::lock_guard<std::mutex> lock(fClustersMutex);
+      while (!fClusters.empty() && fClusters.front()->fEntryEnd <= fEntryCurrent) {
+         fClusters.front()->fCancelled = true;
+         fClusters.pop_front();
+      }
+      if (!fClusters.empty()) {
+         auto held = [this](const std::pair<Long64_t, Int_t> &basket) {
+            for (const auto &cluster : fClusters) {
+               if (cluster->Find(basket.first) >= 0)
+                  return true;
+            }
+            return false;
+         };
+         baskets.erase(std::remove_if(baskets.begin(), baskets.end(), held), baskets.end());
+      }
+   }
+
+   //store baskets
+   for (const auto &basket : baskets) {
+      fNReadPref++;
+      TFileCacheRead::Prefetch(basket.first, basket.second);
+   }
+
+   fIsLearning = kFALSE;
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect position and length of the baskets of the cached branches which hold
+/// entries from `entry` up to, but excluding, `entryEnd`.  Unless `skipLoaded`
+/// is false, the baskets already loaded by their branch are skipped; the lists
+/// of baskets must not be looked at from a task, as the reader modifies them.
+
+void TTreeCacheUnzip::CollectBaskets(Long64_t entry, Long64_t entryEnd,
+                                     std::vector<std::pair<Long64_t, Int_t>> &baskets, Bool_t skipLoaded)
+{
    // Check if owner has a TEventList set. If yes we optimize for this
    // Special case reading only the baskets containing entries in the
    // list.
@@ -303,10 +409,6 @@ Bool_t TTreeCacheUnzip::FillBuffer()
       }
    }
 
-   //clear cache buffer
-   TFileCacheRead::Prefetch(0,0);
-
-   //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
       TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
       if (b->GetDirectory() == 0) continue;
@@ -316,35 +418,29 @@ Bool_t TTreeCacheUnzip::FillBuffer()
       Long64_t *entries = b->GetBasketEntry();
       if (!lbaskets || !entries) continue;
       //we have found the branch. We now register all its baskets
-      //from the requested offset to the basket below fEntrymax
-      Int_t blistsize = b->GetListOfBaskets()->GetSize();
+      //from the requested offset to the basket below entryEnd
+      Int_t blistsize = skipLoaded ? b->GetListOfBaskets()->GetSize() : 0;
       for (Int_t j=0;j<nb;j++) {
          // This basket has already been read, skip it
-         if (j<blistsize && b->GetListOfBaskets()->UncheckedAt(j)) continue;
+         if (skipLoaded && j<blistsize && b->GetListOfBaskets()->UncheckedAt(j)) continue;
 
          Long64_t pos = b->GetBasketSeek(j);
          Int_t len = lbaskets[j];
          if (pos <= 0 || len <= 0) continue;
-         //important: do not try to read fEntryNext, otherwise you jump to the next autoflush
-         if (entries[j] >= fEntryNext) continue;
+         //important: do not try to read entryEnd, otherwise you jump to the next autoflush
+         if (entries[j] >= entryEnd) continue;
          if (entries[j] < entry && (j < nb - 1 && entries[j+1] <= entry)) continue;
          if (elist) {
             Long64_t emax = fEntryMax;
             if (j < nb - 1) emax = entries[j+1] - 1;
             if (!elist->ContainsRange(entries[j] + chainOffset, emax + chainOffset)) continue;
          }
-         fNReadPref++;
-
-         TFileCacheRead::Prefetch(pos, len);
+         baskets.emplace_back(pos, len);
       }
-      if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
+      if (gDebug > 0)
+         printf("Entry: %lld, registering baskets branch %s, entryEnd=%lld, nbaskets=%d\n", entry, b->GetName(),
+                entryEnd, (Int_t)baskets.size());
    }
-
-   // Now fix the size of the status arrays
-   ResetCache();
-   fIsLearning = kFALSE;
-
-   return kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -361,7 +457,7 @@ Int_t TTreeCacheUnzip::SetBufferSize(Int_t buffersize)
       return res;
    }
    fUnzipBufferSize = Long64_t(fgRelBuffSize * GetBufferSize());
-   ResetCache();
+   // The clusters own their baskets: they do not depend on the cache buffer
    return 1;
 }
 
@@ -389,9 +485,21 @@ void TTreeCacheUnzip::StopLearningPhase()
 
 void TTreeCacheUnzip::UpdateBranches(TTree *tree)
 {
+   // The read-ahead tasks read from the file of the previous tree
+   WaitForTasks();
    TTreeCache::UpdateBranches(tree);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Change the file that is read; the read-ahead tasks reading from the
+/// previous one are waited for first.
+
+void TTreeCacheUnzip::SetFile(TFile *file, TFile::ECacheAction action)
+{
+   WaitForTasks();
+   TTreeCache::SetFile(file, action);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                                                            //
 // From now on we have the methods concerning the threading part of the cache //
@@ -495,329 +603,328 @@ Int_t TTreeCacheUnzip::GetRecordHeader(char *buf, Int_t maxbytes, Int_t &nbytes,
 /// Note: This method is completely different from TTreeCache::ResetCache(),
 /// in that method we were cleaning the prefetching buffer while here we
 /// delete the information about the unzipped buffers
+///
+/// The tasks are waited for, as the caller may change the tree or the file
+/// next (e.g. TChain::LoadTree()): tasks still working on a dropped cluster
+/// stop at their next basket, a cluster being read ahead is dropped once read.
 
 void TTreeCacheUnzip::ResetCache()
 {
-   // Reset all the lists and wipe all the chunks
-   fCycle++;
-   fUnzipState.Clear(fNseekMax);
-
-   if(fNseekMax < fNseek){
-      if (gDebug > 0)
-         Info("ResetCache", "Changing fNseekMax from:%d to:%d", fNseekMax, fNseek);
-
-      fUnzipState.Reset(fNseekMax, fNseek);
-      fNseekMax = fNseek;
+   {
+      std::lock_guard<std::mutex> lock(fClustersMutex);
+      ++fClustersGeneration;
+      for (auto &cluster : fClusters)
+         cluster->fCancelled = true;
+      fClusters.clear();
    }
-   fEmpty = kTRUE;
+   WaitForTasks();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// This inflates a basket in the cache.. passing the data to a new
-/// buffer that will only wait there to be read...
-/// This function is responsible to update corresponding elements in 
-/// fUnzipStatus, fUnzipChunks and fUnzipLen. Since we use atomic variables
-/// in fUnzipStatus to exclusively unzip the basket, we must update 
-/// fUnzipStatus after fUnzipChunks and fUnzipLen and make sure fUnzipChunks
-/// and fUnzipLen are ready before main thread fetch the data.
+/// Wait for the tasks of the cache to be done.  Must be called by the reader
+/// before the tree or the file change: the read-ahead tasks read from the file.
+/// The tasks cannot submit other tasks meanwhile, which would block while we wait.
 
-Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
+void TTreeCacheUnzip::WaitForTasks()
 {
-   Int_t myCycle;
-   const Int_t hlen = 128;
-   Int_t objlen = 0, keylen = 0;
-   Int_t nbytes = 0;
-   Int_t readbuf = 0;
+#ifdef R__USE_IMT
+   {
+      std::lock_guard<std::mutex> lock(fClustersMutex);
+      if (!fUnzipTaskGroup)
+         return;
+      fWaiting = kTRUE;
+   }
+   fUnzipTaskGroup->Wait();
+   std::lock_guard<std::mutex> lock(fClustersMutex);
+   fWaiting = kFALSE;
+#endif
+}
 
-   Long64_t rdoffs = 0;
-   Int_t rdlen = 0;
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the baskets may be stored uncompressed, which is similar to
+/// TBasket::ReadBasketBuffers.  Must be called by the reader.
 
-   // To synchronize with the 'paging'
-   myCycle = fCycle;
-   rdoffs = fSeek[index];
-   rdlen = fSeekLen[index];
+Bool_t TTreeCacheUnzip::IsOldFormat() const
+{
+   return fNbranches > 0 && ((TBranch *)fBranches->UncheckedAt(0))->GetCompressionLevel() != 0 &&
+          fFile->GetVersion() <= 30401;
+}
 
-   Int_t loc = -1;
-   if (!fNseek || fIsLearning) {
-      return 1;
+////////////////////////////////////////////////////////////////////////////////
+/// Make the `n` baskets at positions `pos` (sorted), whose compressed bytes are
+/// at `offset` in `data`, available for unzipping.  The entries of the cluster
+/// go from `entryBegin` up to, but excluding, `entryEnd`.
+/// The cluster is dropped, and nullptr returned, if the cache was reset since
+/// `generation`.  The caller is in charge of scheduling the unzipping tasks.
+
+std::shared_ptr<TTreeCacheUnzip::UnzipCluster>
+TTreeCacheUnzip::AddCluster(std::shared_ptr<const char> data, const Long64_t *pos, const Int_t *len,
+                            const Int_t *offset, Int_t n, Long64_t entryBegin, Long64_t entryEnd, Bool_t oldFormat,
+                            Long64_t generation)
+{
+   if (n <= 0)
+      return nullptr;
+
+   auto cluster = std::make_shared<UnzipCluster>(std::move(data), pos, len, offset, n, &fPendingBytes);
+   cluster->fEntryBegin = entryBegin;
+   cluster->fEntryEnd = entryEnd;
+   cluster->fOldFormat = oldFormat;
+   for (Int_t i = 0; i < n; ++i) {
+      Int_t nbytes = 0, objlen = 0, keylen = 0;
+      GetRecordHeader(const_cast<char *>(cluster->fData.get()) + offset[i], len[i], nbytes, objlen, keylen);
+      cluster->fRawLen[i] = keylen + objlen;
    }
 
-   if ((myCycle != fCycle) || !fIsTransferred)  {
-      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      return 1;
-   }
+   // Keep the clusters ordered by entry, also when the cache is refilled while a later cluster was read ahead
+   std::lock_guard<std::mutex> lock(fClustersMutex);
+   if (generation != fClustersGeneration)
+      return nullptr;
+   auto itr = std::upper_bound(fClusters.begin(), fClusters.end(), entryBegin,
+                               [](Long64_t e, const std::shared_ptr<UnzipCluster> &c) { return e < c->fEntryBegin; });
+   fClusters.insert(itr, cluster);
+   return cluster;
+}
 
-   // Prepare a memory buffer of adequate size
-   char* locbuff = 0;
-   if (rdlen > 16384) {
-      locbuff = new char[rdlen];
-   } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
-   } else {
-      locbuff = new char[16384];
-   }
+////////////////////////////////////////////////////////////////////////////////
+/// Start a task that reads the baskets of the cluster starting at `entry`, such
+/// that the cache reads the next cluster while the reader and the other tasks
+/// work on the current one.  The positions of the baskets are collected here,
+/// by the reader: the task only reads them from the file.
 
-   readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
+void TTreeCacheUnzip::ReadAhead(Long64_t entry)
+{
+#ifdef R__USE_IMT
+   if (fNbranches <= 0 || !fFile)
+      return;
 
-   if (readbuf <= 0) {
-      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
-      return -1;
+   TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
+   const Long64_t entryMax = fEntryMax > 0 ? fEntryMax : tree->GetEntries();
+   if (entry < 0 || entry >= entryMax)
+      return;
+   TTree::TClusterIterator clusterIter = tree->GetClusterIterator(entry);
+   clusterIter();
+   const Long64_t entryEnd = std::min(clusterIter.GetNextEntry(), entryMax);
+
+   std::vector<std::pair<Long64_t, Int_t>> baskets;
+   CollectBaskets(entry, entryEnd, baskets, kFALSE);
+   if (baskets.empty())
+      return;
+   std::sort(baskets.begin(), baskets.end());
+   std::vector<Long64_t> pos(baskets.size());
+   std::vector<Int_t> len(baskets.size());
+   for (std::size_t i = 0; i < baskets.size(); ++i) {
+      pos[i] = baskets[i].first;
+      len[i] = baskets[i].second;
    }
+   const Bool_t oldFormat = IsOldFormat();
+
+   std::lock_guard<std::mutex> lock(fClustersMutex);
+   if (fClosing || fWaiting)
+      return;
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup = std::make_unique<ROOT::Experimental::TTaskGroup>();
+   const Long64_t generation = fClustersGeneration;
+   fUnzipTaskGroup->Run([this, pos, len, entry, entryEnd, oldFormat, generation]() {
+      ReadAheadCluster(pos, len, entry, entryEnd, oldFormat, generation);
+   });
+#else
+   (void)entry;
+#endif
+}
 
-   GetRecordHeader(locbuff, hlen, nbytes, objlen, keylen);
-
-   Int_t len = (objlen > nbytes - keylen) ? keylen + objlen : nbytes;
-   // If the single unzipped chunk is really too big, reset it to not processable
-   // I.e. mark it as done but set the pointer to 0
-   // This block will be unzipped synchronously in the main thread
-   // TODO: ROOT internally breaks zipped buffers into 16MB blocks, we can probably still unzip in parallel.
-   if (len > 4 * fUnzipBufferSize) {
-           if (gDebug > 0)
-                   Info("UnzipCache", "Block %d is too big, skipping.", index);
-
-           fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
-           return 0;
+////////////////////////////////////////////////////////////////////////////////
+/// Read the baskets at positions `pos` (sorted), of lengths `len`, of the
+/// cluster going from `entryBegin` up to, but excluding, `entryEnd` with one
+/// vectored read and make them available for unzipping.  This is run by a
+/// task, which does not look at the tree: the reader waits for the task before
+/// the file changes (see WaitForTasks()).  The cluster is dropped if the cache
+/// was reset since `generation`.
+
+void TTreeCacheUnzip::ReadAheadCluster(std::vector<Long64_t> pos, std::vector<Int_t> len, Long64_t entryBegin,
+                                       Long64_t entryEnd, Bool_t oldFormat, Long64_t generation)
+{
+   const Int_t n = pos.size();
+   std::vector<Int_t> offset(n);
+   Int_t total = 0;
+   for (Int_t i = 0; i < n; ++i) {
+      offset[i] = total;
+      total += len[i];
    }
-
-   // Unzip it into a new blk
-   char *ptr = 0;
-   Int_t loclen = UnzipBuffer(&ptr, locbuff);
-   if ((loclen > 0) && (loclen == objlen + keylen)) {
-      if ((myCycle != fCycle) || !fIsTransferred) {
-         fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
-         return 1;
-      }
-      fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
-      fNUnzip++;
-   } else {
-      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+   std::shared_ptr<char> block = ROOT::Internal::RAlignedBlockPool::Instance().Acquire(total);
+   if (!block)
+      return;
+
+   {
+      R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
+      R__LOCKGUARD(fIOMutex.get());
+      Long64_t fileBytesRead0 = fFile->GetBytesRead();
+      Long64_t fileBytesReadExtra0 = fFile->GetBytesReadExtra();
+      Int_t fileReadCalls0 = fFile->GetReadCalls();
+      // On failure, the baskets are simply read again through the cache
+      if (fFile->ReadBuffers(block.get(), pos.data(), len.data(), n))
+         return;
+      fBytesRead += fFile->GetBytesRead() - fileBytesRead0;
+      fBytesReadExtra += fFile->GetBytesReadExtra() - fileBytesReadExtra0;
+      fReadCalls += fFile->GetReadCalls() - fileReadCalls0;
+      fNReadPref += n;
    }
 
-   if (locbuff) delete [] locbuff;
-   return 0;
+   if (AddCluster(block, pos.data(), len.data(), offset.data(), n, entryBegin, entryEnd, oldFormat, generation)) {
+      fNReadAhead++;
+      ScheduleTasks();
+   }
 }
 
-#ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// Hand the baskets of the clusters over to unzipping tasks, in groups of at
+/// least fUnzipGroupSize compressed bytes, as long as the unzipped baskets
+/// which are waiting for their reader plus those being unzipped fit in
+/// fUnzipBufferSize.  Called whenever a cluster is added and whenever a basket
+/// is handed over; does nothing if the implicit multi-threading is disabled.
 
-Int_t TTreeCacheUnzip::CreateTasks()
+void TTreeCacheUnzip::ScheduleTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled())
+      return;
+
+   std::lock_guard<std::mutex> lock(fClustersMutex);
+   if (fClosing || fWaiting)
+      return;
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup = std::make_unique<ROOT::Experimental::TTaskGroup>();
+   const Int_t groupSize = fUnzipGroupSize > 0 ? fUnzipGroupSize : 102400;
+
+   for (auto &cluster : fClusters) {
+      while (cluster->fNextTask < cluster->Size()) {
+         const Long64_t inFlight = fPendingBytes + fScheduledBytes;
+         const Int_t first = cluster->fNextTask;
+         Int_t last = first;
+         Long64_t zipped = 0;
+         Long64_t expected = 0;
+         while (last < cluster->Size() && zipped < groupSize) {
+            // A single basket larger than the budget is still unzipped, but only when nothing else is in flight
+            if (inFlight + expected > 0 && inFlight + expected + cluster->fRawLen[last] > fUnzipBufferSize)
+               break;
+            zipped += cluster->fLen[last];
+            expected += cluster->fRawLen[last];
+            ++last;
          }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
+         if (last == first)
+            return; // Out of budget: handing over baskets frees some
+
+         cluster->fNextTask = last;
+         fScheduledBytes += expected;
+         fUnzipTaskGroup->Run([this, cluster, first, last, expected]() {
+            for (Int_t i = first; i < last && !cluster->fCancelled; ++i) {
+               if (cluster->TryUnzipping(i))
+                  UnzipClusterBasket(*cluster, i);
+            }
+            fScheduledBytes -= expected;
+         });
       }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
-   };
+   }
+#endif
+}
 
-   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+////////////////////////////////////////////////////////////////////////////////
+/// Unzip the basket `index` of the cluster, which the caller set in progress,
+/// and keep it for its reader.
 
-   return 0;
+void TTreeCacheUnzip::UnzipClusterBasket(UnzipCluster &cluster, Int_t index)
+{
+   char *ptr = nullptr;
+   Int_t len = UnzipRecord(&ptr, cluster.fData.get() + cluster.fOffset[index], cluster.fOldFormat);
+   if (len > 0 && len == cluster.fRawLen[index]) {
+      cluster.SetUnzipped(index, ptr, len);
+      fNUnzip++;
+   } else {
+      // The reader will take charge
+      delete [] ptr;
+      cluster.SetMissed(index);
+   }
 }
-#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 /// We try to read a buffer that has already been unzipped
-/// Returns -1 in case of read failure, 0 in case it's not in the
-/// cache and n>0 in case read from cache (number of bytes copied).
+/// Returns -1 in case the buffer is not part of a cluster known to the cache
+/// (the caller then reads it as usual) and n>0 in case it is (the length of the
+/// unzipped buffer).
 /// pos and len are the original values as were passed to ReadBuffer
 /// but instead we will return the inflated buffer.
-/// Note!! : If *buf == 0 we will allocate the buffer and it will be the
-/// responsability of the caller to free it... it is useful for example
+/// Note!! : If *buf == 0 we will hand over the unzipped buffer, which then
+/// becomes the responsability of the caller (see *free)... it is useful for example
 /// to pass it to the creator of TBuffer
 
-Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_t *free)
+Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t /* len */, Bool_t *free)
 {
-   Int_t res = 0;
-   Int_t loc = -1;
-
-   // We go straight to TTreeCache/TfileCacheRead, in order to get the info we need
-   //  pointer to the original zipped chunk
-   //  its index in the original unsorted offsets lists
-   //
-   // Actually there are situations in which copying the buffer is not
-   // useful. But the choice is among doing once more a small memcpy or a binary search in a large array. I prefer the former.
-   // Also, here we prefer not to trigger the (re)population of the chunks in the TFileCacheRead. That is
-   // better to be done in the main thread.
-
-   Int_t myCycle = fCycle;
-
-   if (fParallel && !fIsLearning) {
-
-      if(fNseekMax < fNseek){
-         if (gDebug > 0)
-            Info("GetUnzipBuffer", "Changing fNseekMax from:%d to:%d", fNseekMax, fNseek);
-
-         fUnzipState.Reset(fNseekMax, fNseek);
-         fNseekMax = fNseek;
-      }
-
-      loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, pos);
-      if ((fCycle == myCycle) && (loc >= 0) && (loc < fNseek) && (pos == fSeekSort[loc])) {
-
-         // The buffer is, at minimum, in the file cache. We must know its index in the requests list
-         // In order to get its info
-         Int_t seekidx = fSeekIndex[loc];
-
-         do {
-
-            // If the block is ready we get it immediately.
-            // And also we don't have to alloc the blks. This is supposed to be
-            // the main thread of the app.
-            if (fUnzipState.IsUnzipped(seekidx)) {
-               if(!(*buf)) {
-                  *buf = fUnzipState.fUnzipChunks[seekidx].get();
-                  fUnzipState.fUnzipChunks[seekidx].release();
-                  *free = kTRUE;
-               } else {
-                  memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), fUnzipState.fUnzipLen[seekidx]);
-                  fUnzipState.fUnzipChunks[seekidx].reset();
-                  *free = kFALSE;
-               }
-
-               fNFound++;
-               return fUnzipState.fUnzipLen[seekidx];
-            }
-
-            // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
-            Int_t reqi = -1;
-            
-            if (fUnzipState.IsProgress(seekidx)) {
-               if (fEmpty) {
-                  for (Int_t ii = 0; ii < fNseek; ++ii) {
-                     Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
-                     }
-                  }
-                  if (reqi < 0) {
-                     fEmpty = kFALSE;
-                  } else {
-                     UnzipCache(reqi);
-                  }
-               }
- 
-               if ( myCycle != fCycle ) {
-                  if (gDebug > 0)
-                     Info("GetUnzipBuffer", "Sudden paging Break!!! fNseek: %d, fIsLearning:%d",
-                          fNseek, fIsLearning);
-
-                  seekidx = -1;
-                  break;
-               }
-            }
-
-         } while (fUnzipState.IsProgress(seekidx));
-
-         // Here the block is not pending. It could be done or aborted or not yet being processed.
-         if ( (seekidx >= 0) && (fUnzipState.IsUnzipped(seekidx)) ) {
-            if(!(*buf)) {
-              *buf = fUnzipState.fUnzipChunks[seekidx].get();
-               fUnzipState.fUnzipChunks[seekidx].release();
-               *free = kTRUE;
-            } else {
-               memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), fUnzipState.fUnzipLen[seekidx]);
-               fUnzipState.fUnzipChunks[seekidx].reset();
-               *free = kFALSE;
-            }
+   if (!fParallel || fIsLearning)
+      return -1;
 
-            fNStalls++;
-            return fUnzipState.fUnzipLen[seekidx];
-         } else {
-            // This is a complete miss. We want to avoid the background tasks
-            // to try unzipping this block in the future.
-            fUnzipState.SetMissed(seekidx);
+   std::shared_ptr<UnzipCluster> cluster;
+   Int_t index = -1;
+   Long64_t readAheadEntry = -1;
+   {
+      std::lock_guard<std::mutex> lock(fClustersMutex);
+      for (std::size_t i = 0; i < fClusters.size(); ++i) {
+         index = fClusters[i]->Find(pos);
+         if (index < 0)
+            continue;
+         cluster = fClusters[i];
+         // The reader moved on to this cluster: the older ones are not needed anymore
+         for (std::size_t j = 0; j < i; ++j)
+            fClusters[j]->fCancelled = true;
+         fClusters.erase(fClusters.begin(), fClusters.begin() + i);
+#ifdef R__USE_IMT
+         // A task reads the next cluster while this one is being unzipped
+         if (fClusters.size() == 1 && !cluster->fReadAhead && ROOT::IsImplicitMTEnabled()) {
+            cluster->fReadAhead = kTRUE;
+            readAheadEntry = cluster->fEntryEnd;
          }
-      } else {
-         loc = -1;
-         fIsTransferred = kFALSE;
+#endif
+         break;
       }
    }
-
-   if (len > fCompBufferSize) {
-      if(fCompBuffer) delete [] fCompBuffer;
-      fCompBuffer = new char[len];
-      fCompBufferSize = len;
-   } else {
-      if (fCompBufferSize > len * 4) {
-         if(fCompBuffer) delete [] fCompBuffer;
-         fCompBuffer = new char[len*2];
-         fCompBufferSize = len * 2;
-      }
+   if (readAheadEntry >= 0)
+      ReadAhead(readAheadEntry);
+   if (!cluster) {
+      fNMissed++;
+      return -1;
    }
 
-   res = 0;
-   if (!ReadBufferExt(fCompBuffer, pos, len, loc)) {
-      // Cache is invalidated and we need to wait for all unzipping tasks to befinished before fill new baskets in cache.
-#ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
-         fUnzipTaskGroup->Cancel();
-         fUnzipTaskGroup.reset();
+   Int_t res = -1;
+   if (cluster->TryUnzipping(index)) {
+      // No task got to this basket: unzip it here, straight out of the cluster's data
+      const Bool_t alloc = !(*buf);
+      res = UnzipRecord(buf, cluster->fData.get() + cluster->fOffset[index], cluster->fOldFormat);
+      cluster->SetMissed(index);
+      *free = alloc;
+      fNStalls++;
+   } else {
+      // If the requested basket is being unzipped by a task, we help with the other baskets of the cluster,
+      // then wait for the task.
+      Bool_t stalled = kFALSE;
+      for (Int_t other = index + 1; cluster->IsProgress(index);) {
+         stalled = kTRUE;
+         if (other < cluster->Size() && fPendingBytes + fScheduledBytes < fUnzipBufferSize) {
+            if (cluster->TryUnzipping(other))
+               UnzipClusterBasket(*cluster, other);
+            ++other;
+         } else {
+            cluster->WaitUntilDone(index);
+         }
       }
-#endif
-      {
-         // Fill new baskets into cache.
-         R__LOCKGUARD(fIOMutex.get());
-	      fFile->Seek(pos);
-	      res = fFile->ReadBuffer(fCompBuffer, len);
-      } // end of lock scope
-#ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled()) {
-         CreateTasks();
+      res = cluster->TakeUnzipped(index, buf, free);
+      if (res > 0) {
+         if (stalled)
+            fNStalls++;
+         else
+            fNFound++;
+         ScheduleTasks();
       }
-#endif
-   }
-
-   if (res) res = -1;
-
-   if (!res) {
-      res = UnzipBuffer(buf, fCompBuffer);
-      *free = kTRUE;
    }
 
-   if (!fIsLearning) {
-      fNMissed++;
-   }
-   
-   return res;
+   return res > 0 ? res : -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -847,6 +954,18 @@ void TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 /// *dest is the inflated buffer (including the header)
 
 Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
+{
+   Bool_t oldFormat = ((TBranch*)fBranches->UncheckedAt(0))->GetCompressionLevel() != 0
+      && fFile->GetVersion() <= 30401;
+   return UnzipRecord(dest, src, oldFormat);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of UnzipBuffer() which only reads its arguments, hence it can
+/// be run by the unzipping tasks.  `oldFormat` tells whether the buffer might
+/// come from a file written by ROOT 3.04/01 or older.
+
+Int_t TTreeCacheUnzip::UnzipRecord(char **dest, const char *src, Bool_t oldFormat)
 {
    Int_t  uzlen = 0;
    Bool_t alloc = kFALSE;
@@ -854,7 +973,7 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
    // Here we read the header of the buffer
    const Int_t hlen = 128;
    Int_t nbytes = 0, objlen = 0, keylen = 0;
-   GetRecordHeader(src, hlen, nbytes, objlen, keylen);
+   GetRecordHeader(const_cast<char *>(src), hlen, nbytes, objlen, keylen);
 
    if (!(*dest)) {
       /* early consistency check */
@@ -875,9 +994,7 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
    // &fBuffer[fSeekPos[ind]]; memory address
 
    // This is similar to TBasket::ReadBasketBuffers
-   Bool_t oldCase = objlen == nbytes - keylen
-      && ((TBranch*)fBranches->UncheckedAt(0))->GetCompressionLevel() != 0
-      && fFile->GetVersion() <= 30401;
+   Bool_t oldCase = objlen == nbytes - keylen && oldFormat;
 
    if (objlen > nbytes-keylen || oldCase) {
 
@@ -944,10 +1061,12 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
-   printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
-   printf("Number of hits: %d\n", fNFound);
-   printf("Number of stalls: %d\n", fNStalls);
-   printf("Number of misses: %d\n", fNMissed);
+   printf("Mem used by pending buffers: %lld\n", fPendingBytes.load());
+   printf("Number of blocks unzipped by threads: %d\n", fNUnzip.load());
+   printf("Number of hits: %d\n", fNFound.load());
+   printf("Number of stalls: %d\n", fNStalls.load());
+   printf("Number of misses: %d\n", fNMissed.load());
+   printf("Number of clusters read ahead: %d\n", fNReadAhead.load());
 
    TTreeCache::Print(option);
 }
@@ -958,3 +1077,38 @@ Int_t TTreeCacheUnzip::ReadBufferExt(char *buf, Long64_t pos, Int_t len, Int_t &
    R__LOCKGUARD(fIOMutex.get());
    return TTreeCache::ReadBufferExt(buf, pos, len, loc);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// As TFileCacheRead::ReadBufferExtNormal(), but every cluster read by the
+/// cache is handed over to the unzipping tasks, except for the basket the
+/// caller is about to unzip itself.  With asynchronous reading the baskets
+/// are not in the cache's memory, hence they are read as usual.
+
+Int_t TTreeCacheUnzip::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, Int_t &loc) {
+   const Bool_t wasTransferred = fIsTransferred;
+   Int_t res = TTreeCache::ReadBufferExtNormal(buf, pos, len, loc);
+   if (fParallel && !fIsLearning && !wasTransferred && fIsTransferred && !fAsyncReading && fNseek > 0) {
+      std::shared_ptr<const char> data;
+      if (IsZeroCopy()) {
+         data = fBlock;
+      } else if (fBuffer) {
+         // fBuffer is overwritten by the next refill: the cluster needs its own copy of the baskets
+         const Int_t size = fSeekPos[fNseek-1] + fSeekSortLen[fNseek-1];
+         std::shared_ptr<char> copy = ROOT::Internal::RAlignedBlockPool::Instance().Acquire(size);
+         if (copy) {
+            memcpy(copy.get(), fBuffer, size);
+            data = copy;
+         }
+      }
+      auto cluster = data ? AddCluster(data, fSeekSort, fSeekSortLen, fSeekPos, fNseek, fEntryCurrent, fEntryNext,
+                                       IsOldFormat(), fClustersGeneration)
+                          : nullptr;
+      if (cluster) {
+         Int_t index = cluster->Find(pos);
+         if (index >= 0 && cluster->TryUnzipping(index))
+            cluster->SetMissed(index);
+         ScheduleTasks();
+      }
+   }
+   return res;
+}
@@ -35,8 +35,15 @@ Class implementing or helping  the various TTree cloning method
 #include "TLeafC.h"
 #include "TFileCacheRead.h"
 #include "TTreeCache.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -100,6 +107,14 @@ Bool_t TTreeCloner::CompareEntry::operator()(UInt_t i1, UInt_t i2)
 /// This means that on the file the baskets will be in the order
 /// in which they will be needed when reading the whole tree
 /// sequentially.
+///
+/// If 'method' contains "Recompress" (or if 'options' contains kRecompress),
+/// the baskets are uncompressed and compressed again with the compression
+/// settings of the output branches, without unstreaming their content.  This
+/// is the way to change the compression algorithm or level of a TTree without
+/// paying for a full (slow) clone.  When implicit multi-threading is enabled
+/// (see ROOT::EnableImplicitMT), the baskets are recompressed in parallel.
+/// The baskets and clusters of the input are kept as they are.
 
 TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t options) :
    fWarningMsg(),
@@ -136,6 +151,9 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
       //::Info("TTreeCloner::TTreeCloner","use: kSortBasketsByOffset");
       fCloneMethod = TTreeCloner::kSortBasketsByOffset;
    }
+   if (opt.Contains("recompress")) {
+      fOptions |= kRecompress;
+   }
    if (fToTree) fToStartEntries = fToTree->GetEntries();
 
    if (fFromTree == nullptr) {
@@ -686,6 +704,10 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 
 void TTreeCloner::WriteBaskets()
 {
+   if (fOptions & kRecompress) {
+      WriteRecompressedBaskets();
+      return;
+   }
    TBasket *basket = new TBasket();
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -722,3 +744,103 @@ void TTreeCloner::WriteBaskets()
    }
    delete basket;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the basket from the input file to the output file, recompressing
+/// them with the compression settings of the output branches.
+///
+/// The baskets are loaded in batches of about 32 MB of compressed data.  The
+/// baskets of a batch are recompressed concurrently when implicit multi-threading
+/// is enabled and then written in the order given by fBasketIndex.
+
+void TTreeCloner::WriteRecompressedBaskets()
+{
+   const Long64_t kBatchSize = 32 * 1024 * 1024;
+
+   std::vector<std::unique_ptr<TBasket>> baskets;
+   std::vector<UInt_t> batch;   // Position in fBasketIndex of the baskets loaded in baskets.
+   std::vector<Int_t> status;
+   Long64_t batchSize = 0;
+
+   auto recompress = [&](UInt_t i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[batch[i]] ] );
+      TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[batch[i]] ] );
+      if (from->GetCompressionSettings() != to->GetCompressionSettings()) {
+         status[i] = baskets[i]->Recompress(to->GetCompressionSettings());
+      }
+   };
+
+   auto flush = [&]() {
+      if (batch.empty()) return;
+      status.assign(batch.size(), 0);
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && batch.size() > 1) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(recompress, ROOT::TSeqU(batch.size()));
+      } else
+#endif
+      {
+         for (UInt_t i = 0; i < batch.size(); ++i) {
+            recompress(i);
+         }
+      }
+      for (UInt_t i = 0; i < batch.size(); ++i) {
+         TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[batch[i]] ] );
+         TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[batch[i]] ] );
+         Int_t index = fBasketNum[ fBasketIndex[batch[i]] ];
+         if (status[i]) {
+            // The basket is copied as is.
+            Warning("TTreeCloner::WriteBaskets", "Basket %d of branch %s could not be recompressed.", index,
+                    from->GetName());
+         }
+         TBasket *basket = baskets[i].get();
+         basket->IncrementPidOffset(fPidOffset);
+         basket->CopyTo(to->GetFile(0));
+         to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
+      }
+      batch.clear();
+      batchSize = 0;
+   };
+
+   for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+      TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+
+      TFile *fromfile = from->GetFile(0);
+
+      Int_t index = fBasketNum[ fBasketIndex[j] ];
+
+      Long64_t pos = from->GetBasketSeek(index);
+      if (pos!=0) {
+         if (fFileCache && j >= notCached) {
+            notCached = FillCache(notCached);
+         }
+         if (baskets.size() == batch.size()) {
+            baskets.emplace_back(new TBasket());
+         }
+         TBasket *basket = baskets[batch.size()].get();
+         if (from->GetBasketBytes()[index] == 0) {
+            from->GetBasketBytes()[index] = basket->ReadBasketBytes(pos, fromfile);
+         }
+         Int_t len = from->GetBasketBytes()[index];
+
+         basket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
+         batch.push_back(j);
+         batchSize += len;
+         if (batchSize >= kBatchSize) {
+            flush();
+         }
+      } else {
+         // The baskets of a branch must be added in order.
+         flush();
+         TBasket *frombasket = from->GetBasket( index );
+         if (frombasket && frombasket->GetNevBuf()>0) {
+            TBasket *tobasket = (TBasket*)frombasket->Clone();
+            tobasket->SetBranch(to);
+            to->AddBasket(*tobasket, kFALSE, fToStartEntries+from->GetBasketEntry()[index]);
+            to->FlushOneBasket(to->GetWriteBasket());
+         }
+      }
+   }
+   flush();
+}
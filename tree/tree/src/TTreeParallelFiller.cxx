@@ -0,0 +1,138 @@
+// @(#)root/tree:$Id$
+// Author: agent <agent@local>, 2020-06-09
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TTreeParallelFiller.hxx"
+
+#include "TError.h"
+#include "TFile.h"
+#include "TList.h"
+#include "TMemFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TVirtualMutex.h"
+
+namespace ROOT {
+namespace Experimental {
+
+TTreeParallelFiller::TTreeParallelFiller(TTree &tree, Long64_t clusterSize) : fTree(tree), fClusterSize(clusterSize)
+{
+   TDirectory *dir = fTree.GetDirectory();
+   TFile *file = dir ? dir->GetFile() : nullptr;
+   if (!file || !file->IsWritable())
+      Error("TTreeParallelFiller", "the tree %s must be attached to a writable file", fTree.GetName());
+}
+
+TTreeParallelFiller::~TTreeParallelFiller()
+{
+   if (fNActiveContexts > 0)
+      Error("TTreeParallelFiller", "TTreeFillContexts must be destroyed before the filler");
+}
+
+std::unique_ptr<TTreeFillContext> TTreeParallelFiller::CreateFillContext()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   std::unique_ptr<TTreeFillContext> context(new TTreeFillContext(*this));
+   if (!context->fTree)
+      return nullptr;
+   ++fNContexts;
+   ++fNActiveContexts;
+   return context;
+}
+
+Long64_t TTreeParallelFiller::CommitCluster(TTree &cluster)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   TDirectory::TContext ctxt;
+   const Long64_t first = fTree.GetEntries();
+   // The baskets of the cluster are already compressed; they are copied as-is into the output file
+   if (fTree.CopyEntries(&cluster, -1, "fast noindex") < 0) {
+      Error("TTreeParallelFiller", "cannot append a cluster of %lld entries to the tree %s", cluster.GetEntries(),
+            fTree.GetName());
+      return -1;
+   }
+   return first;
+}
+
+TTreeFillContext::TTreeFillContext(TTreeParallelFiller &filler) : fFiller(filler)
+{
+   // Creating a fill context should not alter gDirectory's state.
+   TDirectory::TContext ctxt;
+
+   TTree &tree = fFiller.fTree;
+   TDirectory *dir = tree.GetDirectory();
+   TFile *file = dir ? dir->GetFile() : nullptr;
+   if (!file)
+      return;
+
+   {
+      R__LOCKGUARD(gROOTMutex);
+      fFile.reset(new TMemFile(TString::Format("%s_fill_context_%d", tree.GetName(), fFiller.fNContexts), "RECREATE",
+                               "", file->GetCompressionSettings()));
+      gROOT->GetListOfFiles()->Remove(fFile.get());
+   }
+
+   fFile->cd();
+   fTree = tree.CloneTree(0);
+   if (!fTree) {
+      Error("TTreeFillContext", "cannot clone the structure of the tree %s", tree.GetName());
+      return;
+   }
+   // Separate the trees: the context's tree must not follow changes of the target tree's branch addresses.
+   tree.GetListOfClones()->Remove(fTree);
+   fTree->ResetBranchAddresses();
+   fTree->SetDirectory(fFile.get());
+   fTree->SetAutoSave(0);
+   if (fFiller.fClusterSize > 0)
+      fTree->SetAutoFlush(fFiller.fClusterSize);
+}
+
+TTreeFillContext::~TTreeFillContext()
+{
+   if (!fTree)
+      return;
+
+   FlushCluster();
+   // Remove the tree before closing the file, such that it is not written to the in-memory file.
+   delete fTree;
+   fFile.reset();
+
+   std::lock_guard<std::mutex> lock(fFiller.fMutex);
+   --fFiller.fNActiveContexts;
+}
+
+Int_t TTreeFillContext::Fill()
+{
+   const Int_t nbytes = fTree->Fill();
+   if (nbytes < 0)
+      return nbytes;
+
+   // A negative auto flush setting is turned into a number of entries by the first flush of the tree
+   const Long64_t clusterSize = fTree->GetAutoFlush();
+   if (clusterSize > 0 && fTree->GetEntries() >= clusterSize)
+      FlushCluster();
+   return nbytes;
+}
+
+Long64_t TTreeFillContext::FlushCluster()
+{
+   if (fTree->GetEntries() == 0)
+      return -1;
+
+   // Serialize and compress the pending baskets in this thread, outside of the filler's lock
+   fTree->FlushBaskets();
+   const Long64_t first = fFiller.CommitCluster(*fTree);
+   // Forget the committed data but keep the tree's structure and branch addresses
+   fFile->ResetAfterMerge(nullptr);
+   return first;
+}
+
+} // namespace Experimental
+} // namespace ROOT
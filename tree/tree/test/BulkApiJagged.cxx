@@ -0,0 +1,146 @@
+#include "SillyStruct.h"
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "ROOT/TIOFeatures.hxx"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+class BulkApiJaggedTest : public ::testing::Test {
+public:
+   static constexpr Long64_t fClusterSize = 1000;
+   static constexpr Long64_t fEventCount = 10000;
+   const std::string fFileName = "BulkApiJagged.root";
+
+protected:
+   void Write(bool generateOffsetMap)
+   {
+      auto hfile = new TFile(fFileName.c_str(), "RECREATE");
+      auto tree = new TTree("T", "A ROOT tree of variable-length branches.");
+      tree->SetBit(TTree::kOnlyFlushAtCluster);
+      tree->SetAutoFlush(fClusterSize);
+      if (generateOffsetMap) {
+         ROOT::TIOFeatures features;
+         features.Set(ROOT::Experimental::EIOFeatures::kGenerateOffsetMap);
+         tree->SetIOFeatures(features);
+      }
+
+      int n = 0;
+      float f[10];
+      std::vector<double> v;
+      std::vector<SillyStruct> vss;
+      tree->Branch("n", &n, "n/I");
+      tree->Branch("f", f, "f[n]/F");
+      tree->Branch("v", &v);
+      tree->Branch("vss", &vss, 32000, 99);
+
+      float value = 0;
+      for (Long64_t ev = 0; ev < fEventCount; ++ev) {
+         n = ev % 10;
+         v.clear();
+         vss.clear();
+         for (int j = 0; j < n; ++j) {
+            f[j] = value;
+            v.push_back(value + 1);
+            SillyStruct ss;
+            ss.f = value;
+            ss.i = value;
+            ss.d = value;
+            vss.push_back(ss);
+            value++;
+         }
+         tree->Fill();
+      }
+      hfile->Write();
+      delete hfile;
+   }
+
+   void TearDown() override { gSystem->Unlink(fFileName.c_str()); }
+
+   /// Reads the branch cluster by cluster and checks the number of elements per entry and the values.
+   /// All the test branches hold the values 0, 1, 2, ... (plus the given shift) in entries of size entry % 10.
+   template <typename T>
+   void CheckJagged(TTree *tree, const char *branchName, T shift)
+   {
+      auto branch = tree->GetBranch(branchName);
+      ASSERT_NE(nullptr, branch);
+      EXPECT_TRUE(branch->GetBulkRead().SupportsJaggedBulkRead());
+
+      TBufferFile valueBuf(TBuffer::kWrite, 32 * 1024);
+      TBufferFile offsetBuf(TBuffer::kWrite, 1024);
+      Long64_t evt = 0;
+      T expected = shift;
+      while (evt < fEventCount) {
+         auto count = branch->GetBulkRead().GetBulkEntries(evt, valueBuf, offsetBuf);
+         ASSERT_EQ(fClusterSize, count) << branchName;
+         auto values = reinterpret_cast<T *>(valueBuf.GetCurrent());
+         auto offsets = reinterpret_cast<Int_t *>(offsetBuf.GetCurrent());
+         EXPECT_EQ(0, offsets[0]);
+         for (Int_t i = 0; i < count; ++i) {
+            ASSERT_EQ((evt + i) % 10, offsets[i + 1] - offsets[i]) << branchName << " entry " << evt + i;
+            for (Int_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+               ASSERT_EQ(expected, values[j]) << branchName << " entry " << evt + i;
+               expected++;
+            }
+         }
+         evt += count;
+      }
+   }
+};
+
+constexpr Long64_t BulkApiJaggedTest::fClusterSize;
+constexpr Long64_t BulkApiJaggedTest::fEventCount;
+
+TEST_F(BulkApiJaggedTest, jaggedRead)
+{
+   Write(false);
+   auto hfile = TFile::Open(fFileName.c_str());
+   auto tree = hfile->Get<TTree>("T");
+   ASSERT_NE(nullptr, tree);
+
+   CheckJagged<float>(tree, "f", 0);
+   CheckJagged<double>(tree, "v", 1);
+   CheckJagged<float>(tree, "vss.f", 0);
+   CheckJagged<Int_t>(tree, "vss.i", 0);
+   CheckJagged<double>(tree, "vss.d", 0);
+
+   // The flat-only bulk API still refuses the unsplit std::vector, while the fixed size branch has no jagged layout
+   EXPECT_FALSE(tree->GetBranch("v")->SupportsBulkRead());
+   EXPECT_TRUE(tree->GetBranch("n")->SupportsBulkRead());
+   EXPECT_FALSE(tree->GetBranch("n")->SupportsJaggedBulkRead());
+
+   // Without a variable number of elements, the offsets follow the entry numbers
+   auto branchN = tree->GetBranch("n");
+   TBufferFile valueBuf(TBuffer::kWrite, 32 * 1024);
+   TBufferFile offsetBuf(TBuffer::kWrite, 1024);
+   auto count = branchN->GetBulkRead().GetBulkEntries(0, valueBuf, offsetBuf);
+   ASSERT_EQ(fClusterSize, count);
+   auto offsets = reinterpret_cast<Int_t *>(offsetBuf.GetCurrent());
+   auto values = reinterpret_cast<Int_t *>(valueBuf.GetCurrent());
+   for (Int_t i = 0; i < count; ++i) {
+      EXPECT_EQ(i, offsets[i]);
+      EXPECT_EQ(i % 10, values[i]);
+   }
+   EXPECT_EQ(count, offsets[count]);
+
+   // Jagged branches cannot be read without an offset buffer
+   EXPECT_EQ(-1, tree->GetBranch("f")->GetBulkRead().GetBulkEntries(0, valueBuf));
+   delete hfile;
+}
+
+TEST_F(BulkApiJaggedTest, generatedOffsets)
+{
+   Write(true);
+   auto hfile = TFile::Open(fFileName.c_str());
+   auto tree = hfile->Get<TTree>("T");
+   ASSERT_NE(nullptr, tree);
+
+   CheckJagged<float>(tree, "f", 0);
+   CheckJagged<double>(tree, "v", 1);
+   delete hfile;
+}
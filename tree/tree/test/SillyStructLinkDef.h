@@ -5,5 +5,6 @@
 #pragma link off all functions;
 
 #pragma link C++ class SillyStruct+;
+#pragma link C++ class std::vector<SillyStruct>+;
 
 #endif
@@ -0,0 +1,203 @@
+#include "TEntryList.h"
+#include "TEntryListBlock.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr Long64_t kEntries = 500000;
+
+/// Entries of a few selections with different densities: sparse, dense, in runs and almost all
+bool Selected(int kind, Long64_t entry)
+{
+   switch (kind) {
+   case 0: return (entry * 7919) % 101 == 0;
+   case 1: return (entry * 7919) % 3 != 0;
+   case 2: return (entry / 1000) % 3 == 0;
+   default: return (entry * 7919) % 997 != 0;
+   }
+}
+
+std::set<Long64_t> MakeSet(int kind)
+{
+   std::set<Long64_t> entries;
+   for (Long64_t i = 0; i < kEntries; ++i)
+      if (Selected(kind, i))
+         entries.insert(i);
+   return entries;
+}
+
+void Fill(TEntryList &elist, int kind, Long64_t first = 0, Long64_t last = kEntries)
+{
+   for (Long64_t i = first; i < last; ++i)
+      if (Selected(kind, i))
+         elist.Enter(i);
+   elist.OptimizeStorage();
+}
+
+void Compare(const std::set<Long64_t> &expected, TEntryList &elist)
+{
+   ASSERT_EQ(static_cast<Long64_t>(expected.size()), elist.GetN());
+   Long64_t index = 0;
+   for (auto entry : expected) {
+      EXPECT_EQ(entry, elist.GetEntry(index));
+      ++index;
+   }
+   EXPECT_EQ(-1, elist.GetEntry(index));
+   for (Long64_t i = 0; i < kEntries; i += 37)
+      EXPECT_EQ(expected.count(i) != 0, elist.Contains(i) != 0);
+   // Random access
+   const std::vector<Long64_t> entries(expected.begin(), expected.end());
+   for (std::size_t i = 0; i < entries.size(); i += 1013)
+      EXPECT_EQ(entries[i], elist.GetEntry(i));
+}
+
+} // anonymous namespace
+
+TEST(TEntryListBlock, Runs)
+{
+   TEntryListBlock block;
+   for (Int_t i = 1000; i < 20000; ++i)
+      block.Enter(i);
+   for (Int_t i = 30000; i < 30010; ++i)
+      block.Enter(i);
+   block.OptimizeStorage();
+   EXPECT_EQ(2, block.GetType());
+   EXPECT_EQ(19010, block.GetNPassed());
+   EXPECT_FALSE(block.Contains(999));
+   EXPECT_TRUE(block.Contains(1000));
+   EXPECT_TRUE(block.Contains(19999));
+   EXPECT_FALSE(block.Contains(20000));
+   EXPECT_TRUE(block.Contains(30009));
+   EXPECT_EQ(30000, block.GetEntry(19000));
+   block.ResetIndices();
+   EXPECT_EQ(1000, block.Next());
+   EXPECT_EQ(1001, block.Next());
+
+   // Modifying the block goes back to bits
+   EXPECT_TRUE(block.Enter(25000));
+   EXPECT_EQ(0, block.GetType());
+   EXPECT_EQ(19011, block.GetNPassed());
+}
+
+TEST(TEntryList, Operations)
+{
+   for (int kind1 = 0; kind1 < 4; ++kind1) {
+      for (int kind2 = 0; kind2 < 4; ++kind2) {
+         const auto set1 = MakeSet(kind1);
+         const auto set2 = MakeSet(kind2);
+         std::set<Long64_t> expected;
+
+         TEntryList sum;
+         Fill(sum, kind1);
+         TEntryList other;
+         Fill(other, kind2);
+         sum.Add(&other);
+         std::set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), std::inserter(expected, expected.end()));
+         Compare(expected, sum);
+
+         TEntryList intersection;
+         Fill(intersection, kind1);
+         intersection.Intersect(&other);
+         expected.clear();
+         std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(),
+                               std::inserter(expected, expected.end()));
+         Compare(expected, intersection);
+
+         TEntryList difference;
+         Fill(difference, kind1);
+         difference.Subtract(&other);
+         expected.clear();
+         std::set_difference(set1.begin(), set1.end(), set2.begin(), set2.end(),
+                             std::inserter(expected, expected.end()));
+         Compare(expected, difference);
+      }
+   }
+}
+
+TEST(TEntryList, IntersectOtherTree)
+{
+   TEntryList elist;
+   Fill(elist, 0);
+   TEntryList other;
+   other.SetTree("T", "other.root");
+   other.Enter(0);
+   elist.Intersect(&other);
+   EXPECT_EQ(0, elist.GetN());
+   EXPECT_EQ(-1, elist.GetEntry(0));
+}
+
+TEST(TEntryList, ParallelFill)
+{
+   ROOT::EnableThreadSafety();
+   constexpr int kThreads = 4;
+   std::vector<TEntryList> partial(kThreads);
+   std::vector<std::thread> threads;
+   // The ranges are not aligned on the blocks of the entry lists
+   for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back(
+         [&partial, t]() { Fill(partial[t], 1, t * kEntries / kThreads, (t + 1) * kEntries / kThreads); });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   TEntryList merged;
+   for (auto &elist : partial)
+      merged.Add(&elist);
+   Compare(MakeSet(1), merged);
+}
+
+TEST(TEntryList, IO)
+{
+   const char *fileName = "TEntryListIO.root";
+   {
+      TFile file(fileName, "RECREATE");
+      TEntryList elist("elist", "runs");
+      Fill(elist, 2);
+      file.WriteObject(&elist, "elist");
+   }
+   TFile file(fileName);
+   auto elist = file.Get<TEntryList>("elist");
+   ASSERT_NE(nullptr, elist);
+   Compare(MakeSet(2), *elist);
+   file.Close();
+   gSystem->Unlink(fileName);
+}
+
+TEST(TEntryListBlock, IO)
+{
+   const char *fileName = "TEntryListBlockIO.root";
+   {
+      TFile file(fileName, "RECREATE");
+      TEntryListBlock block;
+      for (Int_t i = 1000; i < 20000; ++i)
+         block.Enter(i);
+      block.OptimizeStorage();
+      ASSERT_EQ(2, block.GetType());
+      file.WriteObject(&block, "block");
+      // Writing does not change the block in memory
+      EXPECT_EQ(2, block.GetType());
+   }
+   TFile file(fileName);
+   auto block = file.Get<TEntryListBlock>("block");
+   ASSERT_NE(nullptr, block);
+   // The runs are written with a representation that all versions of the class can read
+   EXPECT_NE(2, block->GetType());
+   EXPECT_EQ(19000, block->GetNPassed());
+   EXPECT_FALSE(block->Contains(999));
+   EXPECT_TRUE(block->Contains(1000));
+   EXPECT_TRUE(block->Contains(19999));
+   EXPECT_FALSE(block->Contains(20000));
+   EXPECT_EQ(1500, block->GetEntry(500));
+   file.Close();
+   gSystem->Unlink(fileName);
+}
@@ -0,0 +1,134 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCacheUnzip.h"
+
+#include "TestTreeFile.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr Long64_t kEntries = 20000;
+
+class TTreeCacheUnzipTest : public ::testing::Test {
+protected:
+   const char *fFileName = "TTreeCacheUnzip.root";
+
+   void SetUp() override
+   {
+      TestTreeFile::Write(fFileName, kEntries, 1000);
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   }
+
+   void TearDown() override
+   {
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+      gSystem->Unlink(fFileName);
+   }
+
+   /// Read all entries and check their values; the unzip buffer holds about `unzipBufferSize` bytes.
+   /// If `resizeAt` is not negative, the cache is resized when reading that entry.
+   void ReadAll(Long64_t unzipBufferSize, Bool_t zeroCopy, Long64_t resizeAt = -1)
+   {
+      TFile file(fFileName);
+      auto tree = file.Get<TTree>("T");
+      ASSERT_NE(nullptr, tree);
+      tree->SetCacheSize(200000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(file.GetCacheRead(tree));
+      ASSERT_NE(nullptr, cache);
+      // The parallel unzipping works with the configuration of the cache, it does not impose its own
+      EXPECT_FALSE(cache->IsZeroCopy());
+      cache->SetZeroCopy(zeroCopy);
+      cache->SetUnzipBufferSize(unzipBufferSize);
+      tree->AddBranchToCache("*", kTRUE);
+      tree->StopCacheLearningPhase();
+
+      {
+         TestTreeFile::Reader reader(tree);
+         for (Long64_t i = 0; i < kEntries; ++i) {
+            if (i == resizeAt) {
+               cache->SetBufferSize(300000);
+               cache->SetUnzipBufferSize(unzipBufferSize);
+            }
+            reader.Check(i);
+            // A basket larger than the budget is still unzipped, one at a time
+            EXPECT_LE(cache->GetPendingBytes(), unzipBufferSize + 64000);
+         }
+      }
+      // Most baskets were handed over by the cache rather than read as usual
+      EXPECT_GT(cache->GetNFound() + cache->GetNStalls(), cache->GetNMissed());
+      EXPECT_EQ(0, cache->GetNoCacheBytesRead());
+      if (ROOT::IsImplicitMTEnabled()) {
+         // The clusters after the first one are read by tasks, ahead of the reader
+         EXPECT_GT(cache->GetNReadAhead(), 0);
+      }
+   }
+};
+
+} // anonymous namespace
+
+TEST_F(TTreeCacheUnzipTest, Sequential)
+{
+   ReadAll(100000, kFALSE);
+   ReadAll(100000, kTRUE);
+}
+
+TEST_F(TTreeCacheUnzipTest, ImplicitMT)
+{
+   ROOT::EnableImplicitMT(4);
+   ReadAll(100000, kFALSE);
+   ReadAll(100000, kTRUE);
+   // Baskets are only unzipped when they fit in the budget
+   ReadAll(1000, kTRUE);
+   ROOT::DisableImplicitMT();
+}
+
+TEST_F(TTreeCacheUnzipTest, ImplicitMTBranchReading)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      // The tree would read its branches in parallel: with parallel unzipping, it reads them sequentially instead
+      TFile file(fFileName);
+      auto tree = file.Get<TTree>("T");
+      ASSERT_NE(nullptr, tree);
+      EXPECT_TRUE(tree->GetImplicitMT());
+      tree->SetCacheSize(200000);
+      tree->AddBranchToCache("*", kTRUE);
+      TestTreeFile::Reader reader(tree);
+      for (Long64_t i = 0; i < kEntries; ++i)
+         reader.Check(i);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(file.GetCacheRead(tree));
+      ASSERT_NE(nullptr, cache);
+      EXPECT_GT(cache->GetNFound() + cache->GetNStalls(), 0);
+   }
+   ROOT::DisableImplicitMT();
+}
+
+TEST_F(TTreeCacheUnzipTest, ChainFileSwitch)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      // Every file switch resets the cache and deletes the previous file while clusters may still be read ahead
+      TChain chain("T");
+      for (int i = 0; i < 3; ++i)
+         chain.Add(fFileName);
+      chain.SetCacheSize(200000);
+      chain.AddBranchToCache("*", kTRUE);
+      TestTreeFile::Reader reader(&chain);
+      for (Long64_t i = 0; i < 3 * kEntries; ++i)
+         reader.Check(i, i % kEntries);
+   }
+   ROOT::DisableImplicitMT();
+}
+
+TEST_F(TTreeCacheUnzipTest, ResizeKeepsReadAhead)
+{
+   ROOT::EnableImplicitMT(4);
+   // The clusters read ahead own their baskets: resizing the cache buffer does not drop them
+   ReadAll(100000, kFALSE, kEntries / 2 + 10);
+   ReadAll(100000, kTRUE, kEntries / 2 + 10);
+   ROOT::DisableImplicitMT();
+}
@@ -0,0 +1,107 @@
+#include "ROOT/RAlignedBlockPool.hxx"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "TestTreeFile.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+namespace {
+
+constexpr Long64_t kEntries = 20000;
+
+class TTreeCacheZeroCopyTest : public ::testing::Test {
+protected:
+   const char *fFileName = "TTreeCacheZeroCopy.root";
+
+   void SetUp() override { TestTreeFile::Write(fFileName, kEntries, 1000); }
+
+   void TearDown() override { gSystem->Unlink(fFileName); }
+
+   /// Read all entries through a cache of the given configuration and return the number of read calls on the file
+   Int_t ReadAll(Bool_t zeroCopy, Int_t readaheadClusters)
+   {
+      TFile file(fFileName);
+      auto tree = file.Get<TTree>("T");
+      EXPECT_NE(nullptr, tree);
+      if (!tree)
+         return -1;
+      tree->SetCacheSize(100000);
+      auto cache = dynamic_cast<TTreeCache *>(file.GetCacheRead(tree));
+      EXPECT_NE(nullptr, cache);
+      if (!cache)
+         return -1;
+      cache->SetZeroCopy(zeroCopy);
+      cache->SetReadaheadClusters(readaheadClusters);
+      EXPECT_EQ(zeroCopy, cache->IsZeroCopy());
+      tree->AddBranchToCache("*", kTRUE);
+      tree->StopCacheLearningPhase();
+
+      {
+         TestTreeFile::Reader reader(tree);
+         for (Long64_t i = 0; i < kEntries; ++i)
+            reader.Check(i);
+      }
+      // Every basket was served by the cache
+      EXPECT_EQ(0, cache->GetNoCacheBytesRead());
+      EXPECT_GT(cache->GetEfficiency(), 0.);
+      return file.GetReadCalls();
+   }
+};
+
+} // anonymous namespace
+
+TEST(RAlignedBlockPool, Acquire)
+{
+   auto &pool = ROOT::Internal::RAlignedBlockPool::Instance();
+   const auto hugePage = ROOT::Internal::RAlignedBlockPool::kHugePageSize;
+
+   auto small = pool.Acquire(100);
+   ASSERT_NE(nullptr, small);
+   EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(small.get()) % ROOT::Internal::RAlignedBlockPool::kPageSize);
+
+   auto large = pool.Acquire(hugePage + 1);
+   ASSERT_NE(nullptr, large);
+   EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(large.get()) % hugePage);
+   EXPECT_EQ(2 * hugePage, ROOT::Internal::RAlignedBlockPool::RoundUp(hugePage + 1));
+
+   // Released blocks are recycled
+   const char *address = large.get();
+   const auto cached = pool.GetCachedBytes();
+   large.reset();
+   EXPECT_EQ(cached + 2 * hugePage, pool.GetCachedBytes());
+   auto again = pool.Acquire(2 * hugePage);
+   EXPECT_EQ(address, again.get());
+   EXPECT_EQ(cached, pool.GetCachedBytes());
+
+   // An aliasing view keeps the whole block alive
+   std::shared_ptr<const char> view(again, again.get() + 10);
+   again.reset();
+   EXPECT_EQ(cached, pool.GetCachedBytes());
+   view.reset();
+   EXPECT_EQ(cached + 2 * hugePage, pool.GetCachedBytes());
+
+   const auto maxCached = pool.GetMaxCachedBytes();
+   pool.SetMaxCachedBytes(0);
+   EXPECT_EQ(0u, pool.GetCachedBytes());
+   pool.SetMaxCachedBytes(maxCached);
+}
+
+TEST_F(TTreeCacheZeroCopyTest, Read)
+{
+   ReadAll(kTRUE, 0);
+}
+
+TEST_F(TTreeCacheZeroCopyTest, Readahead)
+{
+   const auto readCalls = ReadAll(kFALSE, 0);
+   const auto readCallsZeroCopy = ReadAll(kTRUE, 0);
+   const auto readCallsReadahead = ReadAll(kTRUE, 8);
+   EXPECT_EQ(readCalls, readCallsZeroCopy);
+   // Fewer, larger requests
+   EXPECT_LT(readCallsReadahead, readCalls);
+}
@@ -0,0 +1,135 @@
+#include "TBranch.h"
+#include "TFile.h"
+#include "TFileMerger.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "TestTreeFile.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr Long64_t kEntries = 20000;
+constexpr Int_t kInputCompression = 101;  // zlib
+constexpr Int_t kOutputCompression = 505; // zstd
+
+std::vector<std::string> BranchNames()
+{
+   std::vector<std::string> names;
+   for (int b = 0; b < TestTreeFile::kBranches; ++b)
+      names.emplace_back("x" + std::to_string(b));
+   names.emplace_back("vec");
+   return names;
+}
+
+class TTreeClonerRecompressTest : public ::testing::Test {
+protected:
+   const char *fInputName = "TTreeClonerRecompress_in.root";
+   const char *fOutputName = "TTreeClonerRecompress_out.root";
+
+   void SetUp() override { TestTreeFile::Write(fInputName, kEntries, 1000, kInputCompression); }
+
+   void TearDown() override
+   {
+      gSystem->Unlink(fInputName);
+      gSystem->Unlink(fOutputName);
+   }
+
+   /// Check that the output tree has the content and the baskets of the input one, with other compression settings
+   void Check(Int_t nInputs)
+   {
+      TFile input(fInputName);
+      auto inTree = input.Get<TTree>("T");
+      ASSERT_NE(nullptr, inTree);
+      TFile output(fOutputName);
+      auto outTree = output.Get<TTree>("T");
+      ASSERT_NE(nullptr, outTree);
+      ASSERT_EQ(nInputs * kEntries, outTree->GetEntries());
+
+      for (const auto &name : BranchNames()) {
+         auto inBranch = inTree->GetBranch(name.c_str());
+         auto outBranch = outTree->GetBranch(name.c_str());
+         ASSERT_NE(nullptr, outBranch);
+         EXPECT_EQ(kOutputCompression, outBranch->GetCompressionSettings());
+         // The baskets were not rebuilt
+         ASSERT_EQ(nInputs * inBranch->GetWriteBasket(), outBranch->GetWriteBasket());
+         for (Int_t i = 0; i < inBranch->GetWriteBasket(); ++i) {
+            EXPECT_EQ(inBranch->GetBasketEntry()[i], outBranch->GetBasketEntry()[i]);
+         }
+         EXPECT_NE(nInputs * inBranch->GetZipBytes(), outBranch->GetZipBytes());
+      }
+
+      TestTreeFile::Reader reader(outTree);
+      for (Long64_t i = 0; i < outTree->GetEntries(); ++i)
+         reader.Check(i, i % kEntries);
+   }
+
+   void CloneTree()
+   {
+      TFile input(fInputName);
+      auto inTree = input.Get<TTree>("T");
+      ASSERT_NE(nullptr, inTree);
+      TFile output(fOutputName, "RECREATE", "", kOutputCompression);
+      auto outTree = inTree->CloneTree(-1, "fast recompress");
+      ASSERT_NE(nullptr, outTree);
+      output.Write();
+   }
+};
+
+} // anonymous namespace
+
+TEST_F(TTreeClonerRecompressTest, CloneTree)
+{
+   CloneTree();
+   Check(1);
+}
+
+TEST_F(TTreeClonerRecompressTest, Uncompressed)
+{
+   {
+      TFile input(fInputName);
+      auto inTree = input.Get<TTree>("T");
+      ASSERT_NE(nullptr, inTree);
+      TFile output(fOutputName, "RECREATE", "", 0);
+      ASSERT_NE(nullptr, inTree->CloneTree(-1, "fast recompress"));
+      output.Write();
+   }
+   TFile output(fOutputName);
+   auto outTree = output.Get<TTree>("T");
+   ASSERT_NE(nullptr, outTree);
+   for (const auto &name : BranchNames()) {
+      auto branch = outTree->GetBranch(name.c_str());
+      ASSERT_NE(nullptr, branch);
+      EXPECT_EQ(branch->GetTotBytes(), branch->GetZipBytes());
+   }
+   TestTreeFile::Reader reader(outTree);
+   for (Long64_t i = 0; i < kEntries; i += 7)
+      reader.Check(i);
+}
+
+TEST_F(TTreeClonerRecompressTest, FileMerger)
+{
+   // With the fast recompression, a change of compression settings does not require the slow, unstreaming, merge
+   TFileMerger merger(kFALSE, kFALSE);
+   merger.SetFastRecompress();
+   ASSERT_TRUE(merger.OutputFile(fOutputName, "RECREATE", kOutputCompression));
+   merger.AddFile(fInputName);
+   merger.AddFile(fInputName);
+   ASSERT_TRUE(merger.Merge());
+   Check(2);
+}
+
+#ifdef R__USE_IMT
+TEST_F(TTreeClonerRecompressTest, ImplicitMT)
+{
+   ROOT::EnableImplicitMT(4);
+   CloneTree();
+   Check(1);
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,98 @@
+#include "ROOT/TTreeParallelFiller.hxx"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+TEST(TTreeParallelFiller, Threads)
+{
+   ROOT::EnableThreadSafety();
+
+   const auto fileName = "TTreeParallelFiller.root";
+   constexpr int nThreads = 4;
+   constexpr Int_t nEntriesPerThread = 2500;
+   constexpr Long64_t clusterSize = 200;
+
+   {
+      TFile file(fileName, "RECREATE");
+      auto tree = new TTree("T", "Filled in parallel");
+      Int_t thread = 0;
+      Int_t counter = 0;
+      std::vector<float> values;
+      tree->Branch("thread", &thread);
+      tree->Branch("counter", &counter);
+      tree->Branch("values", &values);
+
+      ROOT::Experimental::TTreeParallelFiller filler(*tree, clusterSize);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < nThreads; ++t) {
+         threads.emplace_back([&filler, t]() {
+            auto context = filler.CreateFillContext();
+            ASSERT_NE(nullptr, context);
+            Int_t myThread = t;
+            Int_t myCounter = 0;
+            std::vector<float> myValues;
+            auto myValuesPtr = &myValues;
+            context->GetTree().SetBranchAddress("thread", &myThread);
+            context->GetTree().SetBranchAddress("counter", &myCounter);
+            context->GetTree().SetBranchAddress("values", &myValuesPtr);
+            for (myCounter = 0; myCounter < nEntriesPerThread; ++myCounter) {
+               myValues.assign(myCounter % 5, myCounter);
+               EXPECT_GT(context->Fill(), 0);
+            }
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+
+      EXPECT_EQ(nThreads * nEntriesPerThread, tree->GetEntries());
+      tree->Write();
+   }
+
+   {
+      TFile file(fileName);
+      auto tree = file.Get<TTree>("T");
+      ASSERT_NE(nullptr, tree);
+      ASSERT_EQ(nThreads * nEntriesPerThread, tree->GetEntries());
+
+      Int_t thread = -1;
+      Int_t counter = -1;
+      std::vector<float> *values = nullptr;
+      tree->SetBranchAddress("thread", &thread);
+      tree->SetBranchAddress("counter", &counter);
+      tree->SetBranchAddress("values", &values);
+
+      // Every thread filled all of its entries, in order, as whole clusters
+      std::vector<Int_t> nextCounter(nThreads, 0);
+      Int_t previousThread = -1;
+      for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+         ASSERT_GT(tree->GetEntry(i), 0);
+         ASSERT_GE(thread, 0);
+         ASSERT_LT(thread, nThreads);
+         EXPECT_EQ(nextCounter[thread], counter);
+         nextCounter[thread] = counter + 1;
+         if (counter % clusterSize != 0) {
+            EXPECT_EQ(previousThread, thread);
+         }
+         previousThread = thread;
+         ASSERT_EQ(static_cast<std::size_t>(counter % 5), values->size());
+         for (auto v : *values)
+            EXPECT_FLOAT_EQ(counter, v);
+      }
+      for (auto n : nextCounter)
+         EXPECT_EQ(nEntriesPerThread, n);
+
+      auto clusters = tree->GetClusterIterator(0);
+      Long64_t nClusters = 0;
+      while (clusters.Next() < tree->GetEntries())
+         ++nClusters;
+      EXPECT_EQ(nThreads * ((nEntriesPerThread + clusterSize - 1) / clusterSize), nClusters);
+   }
+
+   gSystem->Unlink(fileName);
+}
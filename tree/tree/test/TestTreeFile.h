@@ -0,0 +1,84 @@
+#ifndef ROOT_TREE_TEST_TESTTREEFILE
+#define ROOT_TREE_TEST_TESTTREEFILE
+
+#include "Compression.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+/// Tree shared by the tests of the caches and of the fast cloning: kBranches double branches "x0", "x1"... and a
+/// std::vector<int> branch "vec" holding `entry % 7` copies of the entry number.
+namespace TestTreeFile {
+
+constexpr int kBranches = 5;
+
+/// Value of the branch "x<branch>" at `entry`
+inline double ExpectedValue(Long64_t entry, int branch)
+{
+   return std::sin(entry * (branch + 1) + 0.5);
+}
+
+/// Write the tree "T" with `nEntries` entries and a cluster every `clusterSize` entries into `fileName`
+inline void Write(const char *fileName, Long64_t nEntries, Long64_t clusterSize,
+                  Int_t compression = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault)
+{
+   TFile file(fileName, "RECREATE", "", compression);
+   auto tree = new TTree("T", "Test tree");
+   tree->SetAutoFlush(clusterSize);
+   double values[kBranches];
+   std::vector<int> vec;
+   for (int b = 0; b < kBranches; ++b)
+      tree->Branch(TString::Format("x%d", b), &values[b]);
+   tree->Branch("vec", &vec);
+   for (Long64_t i = 0; i < nEntries; ++i) {
+      for (int b = 0; b < kBranches; ++b)
+         values[b] = ExpectedValue(i, b);
+      vec.assign(i % 7, i);
+      tree->Fill();
+   }
+   file.Write();
+}
+
+/// Set the branch addresses of a tree written by Write() and check its entries. Must be destroyed before the tree.
+class Reader {
+   TTree *fTree;
+   double fValues[kBranches];
+   std::vector<int> *fVec = nullptr;
+
+public:
+   explicit Reader(TTree *tree) : fTree(tree)
+   {
+      for (int b = 0; b < kBranches; ++b)
+         fTree->SetBranchAddress(TString::Format("x%d", b), &fValues[b]);
+      fTree->SetBranchAddress("vec", &fVec);
+   }
+   Reader(const Reader &) = delete;
+   Reader &operator=(const Reader &) = delete;
+   ~Reader()
+   {
+      fTree->ResetBranchAddresses();
+      delete fVec;
+   }
+
+   /// Read `entry` and check that it holds the values written for the entry `written`
+   void Check(Long64_t entry, Long64_t written)
+   {
+      EXPECT_GT(fTree->GetEntry(entry), 0);
+      for (int b = 0; b < kBranches; ++b)
+         EXPECT_DOUBLE_EQ(ExpectedValue(written, b), fValues[b]);
+      ASSERT_NE(nullptr, fVec);
+      EXPECT_EQ(static_cast<std::size_t>(written % 7), fVec->size());
+      for (auto v : *fVec)
+         EXPECT_EQ(written, v);
+   }
+   void Check(Long64_t entry) { Check(entry, entry); }
+};
+
+} // namespace TestTreeFile
+
+#endif
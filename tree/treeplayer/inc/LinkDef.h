@@ -19,6 +19,7 @@
 #pragma link C++ class TSelectorEntries;
 #pragma link C++ class TFileDrawMap+;
 #pragma link C++ class TTreeIndex-;
+#pragma link C++ class TTreeMappedIndex-;
 #pragma link C++ class TChainIndex+;
 #pragma link C++ class TChainIndex::TChainIndexEntry+;
 #pragma link C++ class TTreeFormulaManager;
@@ -105,6 +106,7 @@
 
 #pragma link C++ class ROOT::Internal::TTreeReaderValueBase+;
 #pragma link C++ class ROOT::Experimental::Internal::TTreeReaderValueFastBase+;
+#pragma link C++ class ROOT::Experimental::Internal::TTreeReaderBulkBase+;
 #pragma link C++ class ROOT::Internal::TTreeReaderArrayBase+;
 #pragma link C++ class ROOT::Internal::TNamedBranchProxy+;
 #pragma link C++ class TNotifyLink<ROOT::Detail::TBranchProxy>;
@@ -83,6 +83,17 @@ public:
 } // End of namespace Internal
 
 class TTreeProcessorMT {
+public:
+   /// Timing information about one task, i.e. one invocation of the user function on a range of entries
+   struct TaskTiming {
+      std::size_t fFileIdx;   ///< Index of the file the entries belong to
+      Long64_t fStart;        ///< First entry of the range (global if friends or an entry list are used)
+      Long64_t fEnd;          ///< One past the last entry of the range
+      unsigned int fWorker;   ///< Index of the thread that ran the task, in order of first appearance
+      bool fStolen;           ///< True if the range was stolen from another worker's share
+      double fSeconds;        ///< Wall-clock time spent in the user function
+   };
+
 private:
    const std::vector<std::string> fFileNames; ///< Names of the files
    const std::vector<std::string> fTreeNames; ///< TTree names (always same size and ordering as fFileNames)
@@ -94,6 +105,9 @@ private:
    // Must be declared after fPool, for IMT to be initialized first!
    ROOT::TThreadedObject<ROOT::Internal::TTreeView> fTreeView{ROOT::kIMTPoolSize}; ///<! Thread-local TreeViews
 
+   bool fWorkStealing = false;           ///< Whether Process() uses the work-stealing scheduler
+   std::vector<TaskTiming> fTaskTimings; ///< Timings of the tasks run by the last call to Process()
+
    Internal::FriendInfo GetFriendInfo(TTree &tree);
    std::vector<std::string> FindTreeNames();
    static unsigned int fgMaxTasksPerFilePerWorker;
@@ -106,6 +120,10 @@ public:
    TTreeProcessorMT(TTree &tree, UInt_t nThreads = 0u);
 
    void Process(std::function<void(TTreeReader &)> func);
+   void SetWorkStealing(bool enable) { fWorkStealing = enable; }
+   bool GetWorkStealing() const { return fWorkStealing; }
+   const std::vector<TaskTiming> &GetTaskTimings() const { return fTaskTimings; }
+   void PrintTaskTimings() const;
    static void SetMaxTasksPerFilePerWorker(unsigned int m);
    static unsigned int GetMaxTasksPerFilePerWorker();
 };
@@ -0,0 +1,179 @@
+// @(#)root/treeplayer:$Id$
+// Author: agent <agent@local>, 2020-06-02
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeReaderBulk
+#define ROOT_TTreeReaderBulk
+
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TTreeReaderBulkValue, TTreeReaderBulkArray                             //
+//                                                                        //
+// Columnar access to ranges of entries of a tree or chain.               //
+//                                                                        //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include "TBufferFile.h"
+#include "TDataType.h"
+
+#include <ROOT/RSpan.hxx>
+#include <ROOT/RStringView.hxx>
+
+#include <string>
+#include <typeinfo>
+
+class TBranch;
+
+namespace ROOT {
+namespace Experimental {
+namespace Internal {
+
+/* All the common code shared by the bulk reader templates.
+ *
+ * A bulk reader decodes whole baskets of its branch into a private buffer using the
+ * TBranch bulk API.  Values are kept as flat arrays in host byte order; for every entry
+ * of the basket, an offset array holds the index of the entry's first value.  The
+ * TTreeReader selects the entry range that is available in the decoded baskets of all
+ * of its bulk readers (see TTreeReader::NextBulk()).
+ */
+class TTreeReaderBulkBase {
+public:
+   using ESetupStatus = ROOT::Internal::TTreeReaderValueBase::ESetupStatus;
+   using EReadStatus = ROOT::Internal::TTreeReaderValueBase::EReadStatus;
+
+   TTreeReaderBulkBase(const TTreeReaderBulkBase &) = delete;
+   TTreeReaderBulkBase &operator=(const TTreeReaderBulkBase &) = delete;
+
+   ESetupStatus GetSetupStatus() const { return fSetupStatus; }
+   EReadStatus GetReadStatus() const { return fReadStatus; }
+   const std::string &GetBranchName() const { return fBranchName; }
+
+   /// Number of entries in the current range
+   Long64_t GetSize() const { return fRangeSize; }
+
+protected:
+   TTreeReaderBulkBase(TTreeReader &reader, std::string_view branchName, EDataType type, Bool_t isCollection);
+   virtual ~TTreeReaderBulkBase();
+
+   /// The offsets of the entries of the current range, GetSize() + 1 elements.  Offsets are relative
+   /// to the decoded basket; subtract the first offset to index into the values of the range.
+   const Int_t *GetOffsets() const { return reinterpret_cast<const Int_t *>(fOffsetBuffer.Buffer()) + fRangeBegin; }
+   /// The values of the current range
+   const char *GetValues() const { return fBuffer.GetCurrent() + GetOffsets()[0] * fElementSize; }
+   /// The number of values of the current range
+   std::size_t GetNValues() const { return GetOffsets()[fRangeSize] - GetOffsets()[0]; }
+
+private:
+   Bool_t SetupBranch(TTree *tree);
+   Int_t LoadEntry(TTree *tree, Long64_t entry);
+   void SetRange(Long64_t entry, Long64_t size);
+   void NotifyNewTree();
+   void MarkTreeReaderUnavailable() { fTreeReader = nullptr; }
+
+   std::string fBranchName;                  ///< Name of the branch we should read from
+   TTreeReader *fTreeReader;                 ///< Reader we belong to
+   TBranch *fBranch = nullptr;               ///< Branch of the current tree, set up lazily
+   EDataType fType;                          ///< The type of the values expected by the derived template
+   Int_t fElementSize;                       ///< Size in bytes of a single value
+   Bool_t fIsCollection;                     ///< Whether entries may hold more or less than one value
+   TBufferFile fBuffer;                      ///< Decoded values of the current basket
+   TBufferFile fOffsetBuffer;                ///< Entry offsets of the current basket
+   Long64_t fBasketFirst = -1;               ///< Tree-local entry number of the first entry of the current basket
+   Int_t fBasketSize = 0;                    ///< Number of entries in the current basket
+   Long64_t fRangeBegin = 0;                 ///< Index of the first entry of the current range in the basket
+   Long64_t fRangeSize = 0;                  ///< Number of entries in the current range
+
+   ESetupStatus fSetupStatus = ROOT::Internal::TTreeReaderValueBase::kSetupNotSetup; ///< Setup status of this reader
+   EReadStatus fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadNothingYet;  ///< Read status of this reader
+
+   friend class ::TTreeReader;
+};
+
+} // namespace Internal
+
+/** \class ROOT::Experimental::TTreeReaderBulkValue
+Provides the values of a branch with exactly one fundamental value per entry for the entry range
+of the last TTreeReader::NextBulk() call.
+
+~~~ {.cpp}
+TTreeReader reader(tree);
+TTreeReaderBulkValue<float> pt(reader, "pt");
+while (reader.NextBulk()) {
+   for (auto v : pt.GetValues())
+      sum += v;
+}
+~~~
+*/
+template <typename T>
+class TTreeReaderBulkValue final : public Internal::TTreeReaderBulkBase {
+public:
+   TTreeReaderBulkValue(TTreeReader &reader, std::string_view branchName)
+      : TTreeReaderBulkBase(reader, branchName, TDataType::GetType(typeid(T)), kFALSE)
+   {
+   }
+
+   std::span<const T> GetValues() const
+   {
+      return std::span<const T>(reinterpret_cast<const T *>(TTreeReaderBulkBase::GetValues()), GetSize());
+   }
+   const T &operator[](std::size_t i) const { return GetValues()[i]; }
+};
+
+/** \class ROOT::Experimental::TTreeReaderBulkArray
+Provides the values of a branch with variable (or fixed) size arrays of fundamental type for the entry
+range of the last TTreeReader::NextBulk() call.  The values of all entries of the range are given as a
+single flat array together with GetSize() + 1 offsets that delimit the entries.
+
+~~~ {.cpp}
+TTreeReader reader(tree);
+TTreeReaderBulkArray<float> jetPt(reader, "jet_pt");
+while (reader.NextBulk()) {
+   for (Long64_t i = 0; i < jetPt.GetSize(); ++i)
+      for (auto pt : jetPt.GetEntry(i))
+         sum += pt;
+}
+~~~
+*/
+template <typename T>
+class TTreeReaderBulkArray final : public Internal::TTreeReaderBulkBase {
+public:
+   TTreeReaderBulkArray(TTreeReader &reader, std::string_view branchName)
+      : TTreeReaderBulkBase(reader, branchName, TDataType::GetType(typeid(T)), kTRUE)
+   {
+   }
+
+   /// The values of all entries of the current range
+   std::span<const T> GetValues() const
+   {
+      return std::span<const T>(reinterpret_cast<const T *>(TTreeReaderBulkBase::GetValues()), GetNValues());
+   }
+   /// The offsets of the entries of the current range into the basket, GetSize() + 1 elements
+   std::span<const Int_t> GetOffsets() const
+   {
+      return std::span<const Int_t>(TTreeReaderBulkBase::GetOffsets(), GetSize() + 1);
+   }
+   /// The values of the i-th entry of the current range
+   std::span<const T> GetEntry(std::size_t i) const
+   {
+      const Int_t *offsets = TTreeReaderBulkBase::GetOffsets();
+      return std::span<const T>(GetValues().data() + (offsets[i] - offsets[0]), offsets[i + 1] - offsets[i]);
+   }
+   std::span<const T> operator[](std::size_t i) const { return GetEntry(i); }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif // ROOT_TTreeReaderBulk
@@ -0,0 +1,76 @@
+// @(#)root/treeplayer:$Id$
+// Author: agent <agent@local>, 2020-07-02
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeMappedIndex
+#define ROOT_TTreeMappedIndex
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeMappedIndex                                                     //
+//                                                                      //
+// A Tree Index stored in a sidecar file and memory mapped on use.      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "TTreeIndex.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+class RRawFile;
+}
+}
+
+class TTreeMappedIndex : public TTreeIndex {
+
+protected:
+   TString         fFileName;        // Name of the sidecar file holding the index
+   std::unique_ptr<ROOT::Internal::RRawFile> fRawFile; //! Sidecar file
+   void           *fMapping;         //! Memory mapping of the sidecar file
+   std::size_t     fMappingSize;     //! Length of fMapping
+   std::vector<Long64_t> fContent;   //! Content of the sidecar file if it cannot be mapped
+   const Long64_t *fKeys;            //! [2*(fN+1)] (major,minor) pairs in Eytzinger order, slot 0 unused
+   const Long64_t *fEntries;         //! [fN+1] Entry numbers of the keys, same order
+
+   Bool_t         Map(Long64_t expectedEntries);
+   void           Unmap();
+   Long64_t       Floor(Long64_t major, Long64_t minor) const;
+   Long64_t       LowerBound(Long64_t major, Long64_t minor) const;
+
+private:
+   TTreeMappedIndex(const TTreeMappedIndex&) = delete;            // Not implemented.
+   TTreeMappedIndex &operator=(const TTreeMappedIndex&) = delete; // Not implemented.
+
+public:
+   TTreeMappedIndex();
+   TTreeMappedIndex(const TTree *T, const char *filename);
+   virtual               ~TTreeMappedIndex();
+
+   static Long64_t        Build(TTree *T, const char *majorname, const char *minorname, const char *filename);
+   static TTreeMappedIndex *Open(TTree *T, const char *filename);
+   static Long64_t        WriteIndex(const TTreeIndex &index, Long64_t treeEntries, const char *filename);
+
+   virtual void           Append(const TVirtualIndex *,Bool_t delaySort = kFALSE);
+   virtual Long64_t       GetEntryNumberWithIndex(Long64_t major, Long64_t minor) const;
+   virtual Long64_t       GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const;
+   const char            *GetFileName() const {return fFileName.Data();}
+   Bool_t                 IsMapped() const {return fMapping != nullptr;}
+   virtual void           Print(Option_t *option="") const;
+
+   ClassDef(TTreeMappedIndex,1);  //A Tree Index stored in a memory mapped sidecar file
+};
+
+#endif
@@ -38,6 +38,11 @@ namespace ROOT {
 namespace Internal {
    class TBranchProxyDirector;
 }
+namespace Experimental {
+namespace Internal {
+   class TTreeReaderBulkBase;
+}
+}
 }
 
 class TTreeReader: public TObject {
@@ -215,6 +220,13 @@ public:
    /// Restart a Next() loop from entry 0 (of TEntryList index 0 of fEntryList is set).
    void Restart();
 
+   Bool_t NextBulk();
+
+   /// Returns the first (global) entry of the range loaded by the last `NextBulk()`.
+   Long64_t GetBulkBegin() const { return fBulkBegin; }
+   /// Returns the number of entries of the range loaded by the last `NextBulk()`.
+   Long64_t GetBulkSize() const { return fBulkSize; }
+
    ///\}
 
    EEntryStatus GetEntryStatus() const { return fEntryStatus; }
@@ -264,6 +276,8 @@ protected:
 
    Bool_t RegisterValueReader(ROOT::Internal::TTreeReaderValueBase* reader);
    void DeregisterValueReader(ROOT::Internal::TTreeReaderValueBase* reader);
+   void RegisterBulkReader(ROOT::Experimental::Internal::TTreeReaderBulkBase* reader);
+   void DeregisterBulkReader(ROOT::Experimental::Internal::TTreeReaderBulkBase* reader);
 
    EEntryStatus SetEntryBase(Long64_t entry, Bool_t local);
 
@@ -293,6 +307,7 @@ private:
    std::deque<ROOT::Internal::TFriendProxy*> fFriendProxies; ///< proxying for friend TTrees, owned
    std::deque<ROOT::Internal::TTreeReaderValueBase*> fValues; ///< readers that use our director
    NamedProxies_t fProxies; ///< attached ROOT::TNamedBranchProxies; owned
+   std::deque<ROOT::Experimental::Internal::TTreeReaderBulkBase*> fBulkReaders; ///<! readers loaded by NextBulk()
 
    Long64_t fEntry = -1; ///< Current (non-local) entry of fTree or of fEntryList if set.
 
@@ -303,9 +318,12 @@ private:
    Long64_t fBeginEntry = 0LL; ///< This allows us to propagate the range to the TTreeCache
    Bool_t fProxiesSet = kFALSE; ///< True if the proxies have been set, false otherwise
    Bool_t fSetEntryBaseCallingLoadTree = kFALSE; ///< True if during the LoadTree execution triggered by SetEntryBase.
+   Long64_t fBulkBegin = -1; ///< First (non-local) entry of the range loaded by NextBulk()
+   Long64_t fBulkSize = 0; ///< Number of entries of the range loaded by NextBulk()
 
    friend class ROOT::Internal::TTreeReaderValueBase;
    friend class ROOT::Internal::TTreeReaderArrayBase;
+   friend class ROOT::Experimental::Internal::TTreeReaderBulkBase;
 
    ClassDef(TTreeReader, 0); // A simple interface to read trees
 };
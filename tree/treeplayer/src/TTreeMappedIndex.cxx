@@ -0,0 +1,551 @@
+// @(#)root/treeplayer:$Id$
+// Author: agent <agent@local>, 2020-07-02
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeMappedIndex
+A Tree Index stored in a sidecar file and memory mapped on use.
+
+A TTreeIndex is rebuilt by evaluating its major and minor expressions over
+all the entries of the tree.  A TTreeMappedIndex is built once, written to a
+separate (sidecar) file, and then opened in constant time: the file is
+memory mapped and the lookups read the keys straight from the mapping.
+~~~{.cpp}
+   // Once, e.g. at the end of the production of the tree
+   TTreeMappedIndex::Build(tree, "Run", "Event", "events.idx");
+
+   // For every analysis job
+   TTreeMappedIndex::Open(friendTree, "events.idx");
+   tree->AddFriend(friendTree);
+   tree->GetEntryWithIndex(1234, 56789);
+~~~
+The keys are stored in Eytzinger (breadth-first) order: the first levels of
+the search are packed at the beginning of the file and a search touches
+consecutive cache lines, which are prefetched one level ahead.
+
+Compared to TTreeIndex, among entries with the same (major, minor) pair the
+lookups return the one with the smallest entry number.
+
+Both a TTree and a TChain can be indexed; the entry numbers of a TChain
+index are global, hence no per-file index is built as with TChainIndex.
+The index can also be used through friend trees, exactly like a
+TTreeIndex.  Writing a tree holding a TTreeMappedIndex stores the name of
+the sidecar file, which is mapped again when the tree is read back.  If the
+sidecar file is in the directory of the ROOT file or below, its name is
+stored relative to that directory: the ROOT file and its index can be moved
+together and read from any working directory.
+
+The sidecar file is written in the byte order of the machine building it;
+opening it on a machine with a different byte order fails.
+*/
+
+#include "TTreeMappedIndex.h"
+
+#include "TBuffer.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TUrl.h"
+
+#include "ROOT/RRawFile.hxx"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+ClassImp(TTreeMappedIndex);
+
+namespace {
+
+/// Layout of the beginning of the sidecar file, followed by the major and minor names and, at 64 bytes boundaries,
+/// by the keys and the entry numbers
+struct RSidecarHeader {
+   char fMagic[8];             ///< kMagic
+   std::uint32_t fVersion;     ///< Version of the file format
+   std::uint32_t fByteOrder;   ///< kByteOrder in the byte order of the writer
+   std::uint64_t fN;           ///< Number of keys
+   std::uint64_t fTreeEntries; ///< Number of entries of the indexed tree
+   std::uint32_t fMajorNameLen;
+   std::uint32_t fMinorNameLen;
+   std::uint64_t fKeysOffset;    ///< Offset of the 2*(fN+1) key values
+   std::uint64_t fEntriesOffset; ///< Offset of the fN+1 entry numbers
+   std::uint64_t fReserved;
+};
+static_assert(sizeof(RSidecarHeader) == 64, "unexpected padding in the sidecar header");
+
+constexpr char kMagic[8] = {'R', 'O', 'O', 'T', 'T', 'I', 'D', 'X'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kByteOrder = 0x01020304;
+constexpr std::uint64_t kAlignment = 64;
+
+std::uint64_t AlignUp(std::uint64_t offset)
+{
+   return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/// Compare the key stored at `key` with (major, minor)
+inline bool KeyLess(const Long64_t *key, Long64_t major, Long64_t minor)
+{
+   return key[0] < major || (key[0] == major && key[1] < minor);
+}
+
+inline void PrefetchSlot(const Long64_t *slot)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   __builtin_prefetch(slot);
+#else
+   (void)slot;
+#endif
+}
+
+/// Slot of the smallest key, fN+1 if there is none
+Long64_t FirstSlot(Long64_t n)
+{
+   if (n <= 0)
+      return n + 1;
+   Long64_t k = 1;
+   while (2 * k <= n)
+      k = 2 * k;
+   return k;
+}
+
+/// Slot following `k` in the order of the keys, fN+1 after the last one
+Long64_t NextSlot(Long64_t k, Long64_t n)
+{
+   if (2 * k + 1 <= n) {
+      k = 2 * k + 1;
+      while (2 * k <= n)
+         k = 2 * k;
+      return k;
+   }
+   while (k & 1)
+      k >>= 1;
+   k >>= 1;
+   return k ? k : n + 1;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor for TTreeMappedIndex
+
+TTreeMappedIndex::TTreeMappedIndex() : TTreeIndex()
+{
+   fMapping     = nullptr;
+   fMappingSize = 0;
+   fKeys        = nullptr;
+   fEntries     = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for TTreeMappedIndex
+///
+/// Map the index stored in the sidecar file `filename` for the tree T.
+/// The object is a zombie if the file cannot be read, is not a valid index
+/// file, or was built for a tree with a different number of entries.
+///
+/// See TTreeMappedIndex::Open to open the index and attach it to T in one go.
+
+TTreeMappedIndex::TTreeMappedIndex(const TTree *T, const char *filename) : TTreeIndex()
+{
+   fTree        = (TTree*)T;
+   fFileName    = filename;
+   fMapping     = nullptr;
+   fMappingSize = 0;
+   fKeys        = nullptr;
+   fEntries     = nullptr;
+   if (!Map(T ? T->GetEntries() : -1))
+      MakeZombie();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TTreeMappedIndex::~TTreeMappedIndex()
+{
+   Unmap();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the index of the tree T with the expressions majorname and minorname
+/// (see TTreeIndex::TTreeIndex) and write it to the sidecar file `filename`.
+///
+/// The return value is the number of entries in the Index (< 0 indicates failure)
+
+Long64_t TTreeMappedIndex::Build(TTree *T, const char *majorname, const char *minorname, const char *filename)
+{
+   if (!T)
+      return -1;
+   TTreeIndex index(T, majorname, minorname);
+   if (index.IsZombie())
+      return -1;
+   return WriteIndex(index, T->GetEntries(), filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the index stored in `filename` and make it the index of the tree T.
+/// As with TTree::SetTreeIndex, a previous index of T is not deleted.
+///
+/// Returns the index, owned by T, or nullptr in case of failure.
+
+TTreeMappedIndex *TTreeMappedIndex::Open(TTree *T, const char *filename)
+{
+   if (!T)
+      return nullptr;
+   auto index = new TTreeMappedIndex(T, filename);
+   if (index->IsZombie()) {
+      delete index;
+      return nullptr;
+   }
+   T->SetTreeIndex(index);
+   return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the content of `index`, built on a tree with `treeEntries` entries, to
+/// the sidecar file `filename`.
+///
+/// The return value is the number of entries in the Index (< 0 indicates failure)
+
+Long64_t TTreeMappedIndex::WriteIndex(const TTreeIndex &index, Long64_t treeEntries, const char *filename)
+{
+   const Long64_t n = index.GetN();
+   const Long64_t *major = index.GetIndexValues();
+   const Long64_t *minor = index.GetIndexValuesMinor();
+   const Long64_t *entry = index.GetIndex();
+   if (n < 0 || (n > 0 && (!major || !minor || !entry))) {
+      ::Error("TTreeMappedIndex::WriteIndex", "The index has no values");
+      return -1;
+   }
+
+   // Entries with the same (major,minor) pair are ordered by entry number
+   std::vector<Long64_t> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   std::sort(order.begin(), order.end(), [&](Long64_t i, Long64_t j) {
+      if (major[i] != major[j])
+         return major[i] < major[j];
+      if (minor[i] != minor[j])
+         return minor[i] < minor[j];
+      return entry[i] < entry[j];
+   });
+
+   // An in-order traversal of the implicit tree visits the slots in the order of the keys
+   std::vector<Long64_t> keys(2 * (n + 1), 0);
+   std::vector<Long64_t> entries(n + 1, -1);
+   Long64_t next = 0;
+   for (Long64_t k = FirstSlot(n); k <= n; k = NextSlot(k, n)) {
+      const Long64_t i = order[next++];
+      keys[2 * k] = major[i];
+      keys[2 * k + 1] = minor[i];
+      entries[k] = entry[i];
+   }
+
+   const TString majorName = index.GetMajorName();
+   const TString minorName = index.GetMinorName();
+   RSidecarHeader header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.fMagic, kMagic, sizeof(kMagic));
+   header.fVersion = kVersion;
+   header.fByteOrder = kByteOrder;
+   header.fN = n;
+   header.fTreeEntries = treeEntries;
+   header.fMajorNameLen = majorName.Length();
+   header.fMinorNameLen = minorName.Length();
+   header.fKeysOffset = AlignUp(sizeof(header) + header.fMajorNameLen + header.fMinorNameLen);
+   header.fEntriesOffset = AlignUp(header.fKeysOffset + keys.size() * sizeof(Long64_t));
+
+   std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+   const char padding[kAlignment] = {};
+   out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+   out.write(majorName.Data(), header.fMajorNameLen);
+   out.write(minorName.Data(), header.fMinorNameLen);
+   out.write(padding, header.fKeysOffset - sizeof(header) - header.fMajorNameLen - header.fMinorNameLen);
+   out.write(reinterpret_cast<const char *>(keys.data()), keys.size() * sizeof(Long64_t));
+   out.write(padding, header.fEntriesOffset - header.fKeysOffset - keys.size() * sizeof(Long64_t));
+   out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(Long64_t));
+   out.close();
+   if (!out) {
+      ::Error("TTreeMappedIndex::WriteIndex", "Cannot write the index to %s", filename);
+      return -1;
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the sidecar file and check its content. If expectedEntries is not
+/// negative, it must match the number of entries of the indexed tree.
+/// Returns kFALSE in case of error.
+
+Bool_t TTreeMappedIndex::Map(Long64_t expectedEntries)
+{
+   Unmap();
+   std::uint64_t size = 0;
+   try {
+      fRawFile = ROOT::Internal::RRawFile::Create(fFileName.Data());
+      size = fRawFile->GetSize();
+   } catch (const std::runtime_error &err) {
+      Error("Map", "Cannot open %s: %s", fFileName.Data(), err.what());
+      Unmap();
+      return kFALSE;
+   }
+   if (size < sizeof(RSidecarHeader)) {
+      Error("Map", "%s is not a tree index file", fFileName.Data());
+      Unmap();
+      return kFALSE;
+   }
+
+   const char *base = nullptr;
+   if (fRawFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap) {
+      try {
+         std::uint64_t mapdOffset = 0;
+         fMapping = fRawFile->Map(size, 0, mapdOffset);
+         fMappingSize = size;
+         base = static_cast<const char *>(fMapping);
+      } catch (const std::runtime_error &) {
+         // Not an error: fall back to reading the file into memory
+         fMapping = nullptr;
+      }
+   }
+   if (!base) {
+      fContent.resize((size + sizeof(Long64_t) - 1) / sizeof(Long64_t));
+      if (fRawFile->ReadAt(fContent.data(), size, 0) != size) {
+         Error("Map", "Cannot read %s", fFileName.Data());
+         Unmap();
+         return kFALSE;
+      }
+      base = reinterpret_cast<const char *>(fContent.data());
+   }
+
+   RSidecarHeader header;
+   memcpy(&header, base, sizeof(header));
+   if (memcmp(header.fMagic, kMagic, sizeof(kMagic)) != 0 || header.fVersion != kVersion) {
+      Error("Map", "%s is not a tree index file", fFileName.Data());
+      Unmap();
+      return kFALSE;
+   }
+   if (header.fByteOrder != kByteOrder) {
+      Error("Map", "%s was written on a machine with a different byte order", fFileName.Data());
+      Unmap();
+      return kFALSE;
+   }
+   const std::uint64_t nslots = header.fN + 1;
+   if (sizeof(header) + header.fMajorNameLen + header.fMinorNameLen > header.fKeysOffset ||
+       header.fKeysOffset + 2 * nslots * sizeof(Long64_t) > size ||
+       header.fEntriesOffset + nslots * sizeof(Long64_t) > size) {
+      Error("Map", "%s is truncated", fFileName.Data());
+      Unmap();
+      return kFALSE;
+   }
+   if (expectedEntries >= 0 && header.fTreeEntries != static_cast<std::uint64_t>(expectedEntries)) {
+      Error("Map", "%s indexes a tree with %llu entries, not %lld", fFileName.Data(),
+            (unsigned long long)header.fTreeEntries, expectedEntries);
+      Unmap();
+      return kFALSE;
+   }
+
+   fMajorName = TString(base + sizeof(header), header.fMajorNameLen);
+   fMinorName = TString(base + sizeof(header) + header.fMajorNameLen, header.fMinorNameLen);
+   fN = header.fN;
+   fKeys = reinterpret_cast<const Long64_t *>(base + header.fKeysOffset);
+   fEntries = reinterpret_cast<const Long64_t *>(base + header.fEntriesOffset);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the mapping (or the copy) of the sidecar file.
+
+void TTreeMappedIndex::Unmap()
+{
+   if (fMapping)
+      fRawFile->Unmap(fMapping, fMappingSize);
+   fMapping     = nullptr;
+   fMappingSize = 0;
+   fContent.clear();
+   fContent.shrink_to_fit();
+   fKeys        = nullptr;
+   fEntries     = nullptr;
+   fRawFile.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the slot of the first key not lower than (major,minor), 0 if there is none.
+///
+/// The descent does not branch on the comparisons; the four grand-children of
+/// the current slot share a cache line and are prefetched.
+
+Long64_t TTreeMappedIndex::LowerBound(Long64_t major, Long64_t minor) const
+{
+   Long64_t k = 1;
+   while (k <= fN) {
+      PrefetchSlot(fKeys + 8 * k);
+      k = 2 * k + KeyLess(fKeys + 2 * k, major, minor);
+   }
+   // Undo the right turns taken after the last left turn, and the left turn itself
+   while (k & 1)
+      k >>= 1;
+   return k >> 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the slot of the last key not greater than (major,minor), 0 if there is none.
+
+Long64_t TTreeMappedIndex::Floor(Long64_t major, Long64_t minor) const
+{
+   Long64_t k = 1;
+   Long64_t floor = 0;
+   while (k <= fN) {
+      PrefetchSlot(fKeys + 8 * k);
+      const Long64_t *key = fKeys + 2 * k;
+      const bool notGreater = KeyLess(key, major, minor) || (key[0] == major && key[1] == minor);
+      floor = notGreater ? k : floor;
+      k = 2 * k + notGreater;
+   }
+   return floor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A TTreeMappedIndex cannot be extended: build a new one instead.
+
+void TTreeMappedIndex::Append(const TVirtualIndex *, Bool_t)
+{
+   Error("Append", "A TTreeMappedIndex cannot be extended, build a new one with TTreeMappedIndex::Build");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return entry number corresponding to major and minor number.
+/// If an entry corresponding to major and minor is not found, the function
+/// returns the entry of the major,minor pair immediately lower than the
+/// requested value, ie it will return -1 if the pair is lower than
+/// the first entry in the index.
+///
+/// See also GetEntryNumberWithIndex
+
+Long64_t TTreeMappedIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const
+{
+   if (!fKeys || fN == 0) return -1;
+
+   Long64_t k = LowerBound(major, minor);
+   if (k && fKeys[2 * k] == major && fKeys[2 * k + 1] == minor)
+      return fEntries[k];
+   k = Floor(major, minor);
+   return k ? fEntries[k] : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return entry number corresponding to major and minor number, -1 if the
+/// pair is not in the index.
+///
+/// See also GetEntryNumberWithBestIndex
+
+Long64_t TTreeMappedIndex::GetEntryNumberWithIndex(Long64_t major, Long64_t minor) const
+{
+   if (!fKeys || fN == 0) return -1;
+
+   const Long64_t k = LowerBound(major, minor);
+   if (k && fKeys[2 * k] == major && fKeys[2 * k + 1] == minor)
+      return fEntries[k];
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the table with : serial number, majorname, minorname.
+/// -  if option = "10" print only the first 10 entries
+/// -  if option = "100" print only the first 100 entries
+/// -  if option = "1000" print only the first 1000 entries
+/// -  if option contains "all" also print the entry numbers
+
+void TTreeMappedIndex::Print(Option_t * option) const
+{
+   TString opt = option;
+   Bool_t printEntry = opt.Contains("all");
+   Long64_t n = fKeys ? fN : 0;
+   if (opt.Contains("10"))   n = 10;
+   if (opt.Contains("100"))  n = 100;
+   if (opt.Contains("1000")) n = 1000;
+   n = std::min(n, fKeys ? fN : 0);
+
+   Printf("\n**********************************************");
+   Printf("*    Index of Tree: %s/%s",fTree ? fTree->GetName() : "", fTree ? fTree->GetTitle() : "");
+   Printf("*    Mapped from: %s%s", fFileName.Data(), fMapping ? "" : (fKeys ? " (read into memory)" : " (not open)"));
+   Printf("**********************************************");
+   if (printEntry)
+      Printf("%8s : %16s : %16s : %16s","serial",fMajorName.Data(),fMinorName.Data(),"entry number");
+   else
+      Printf("%8s : %16s : %16s","serial",fMajorName.Data(),fMinorName.Data());
+   Printf("**********************************************");
+   Long64_t k = FirstSlot(fN);
+   for (Long64_t i = 0; i < n; ++i, k = NextSlot(k, fN)) {
+      if (printEntry)
+         Printf("%8lld :         %8lld :         %8lld :         %8lld",
+                i, fKeys[2 * k], fKeys[2 * k + 1], fEntries[k]);
+      else
+         Printf("%8lld :         %8lld :         %8lld", i, fKeys[2 * k], fKeys[2 * k + 1]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the directory of the local file read or written by the buffer, with
+/// a trailing slash, or an empty string if the file is not a local file.
+
+static TString GetLocalFileDir(TBuffer &b)
+{
+   auto file = dynamic_cast<TFile *>(b.GetParent());
+   if (!file || strcmp(file->GetEndpointUrl()->GetProtocol(), "file") != 0)
+      return "";
+   TString path = file->GetEndpointUrl()->GetFile();
+   if (!gSystem->IsAbsoluteFileName(path))
+      gSystem->PrependPathName(gSystem->WorkingDirectory(), path);
+   return gSystem->GetDirName(path) + "/";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream an object of class TTreeMappedIndex.
+/// Only the name of the sidecar file is stored; it is mapped again on reading.
+/// A relative name is relative to the directory of the ROOT file holding the
+/// tree, not to the working directory.
+
+void TTreeMappedIndex::Streamer(TBuffer &R__b)
+{
+   UInt_t R__s, R__c;
+   if (R__b.IsReading()) {
+      Version_t R__v = R__b.ReadVersion(&R__s, &R__c); if (R__v) { }
+      TVirtualIndex::Streamer(R__b);
+      fMajorName.Streamer(R__b);
+      fMinorName.Streamer(R__b);
+      fFileName.Streamer(R__b);
+      const TString dir = GetLocalFileDir(R__b);
+      if (!dir.IsNull() && !gSystem->IsAbsoluteFileName(fFileName))
+         fFileName.Prepend(dir);
+      R__b >> fN;
+      R__b.CheckByteCount(R__s, R__c, TTreeMappedIndex::IsA());
+      Long64_t entries = fN;
+      if (Map(-1) && fN != entries)
+         Warning("Streamer", "%s holds %lld keys instead of %lld", fFileName.Data(), fN, entries);
+   } else {
+      R__c = R__b.WriteVersion(TTreeMappedIndex::IsA(), kTRUE);
+      TVirtualIndex::Streamer(R__b);
+      fMajorName.Streamer(R__b);
+      fMinorName.Streamer(R__b);
+      TString fileName = fFileName;
+      const TString dir = GetLocalFileDir(R__b);
+      if (!dir.IsNull()) {
+         if (!gSystem->IsAbsoluteFileName(fileName))
+            gSystem->PrependPathName(gSystem->WorkingDirectory(), fileName);
+         if (fileName.BeginsWith(dir))
+            fileName.Remove(0, dir.Length());
+      }
+      fileName.Streamer(R__b);
+      R__b << fN;
+      R__b.SetByteCount(R__c, kTRUE);
+   }
+}
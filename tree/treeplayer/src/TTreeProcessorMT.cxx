@@ -22,11 +22,32 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+By default, one task per file is created, which in turn creates one task per
+cluster of that file. For chains that mix large and small files this can leave
+workers idle while the tasks of the largest file complete. With
+SetWorkStealing(true), Process() instead runs one worker per thread on a single,
+global queue of cluster ranges: the metadata of the files is read by idle workers
+while the others already process clusters, and once the queue is empty an idle
+worker steals half of the remaining clusters of the largest range still in progress.
+
+After Process() returns, GetTaskTimings() and PrintTaskTimings() describe how
+long each task took and on which worker it ran, to diagnose load imbalance.
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
 using namespace ROOT;
 
 namespace {
@@ -195,6 +216,83 @@ static std::vector<std::string> GetTreeFullPaths(const TTree &tree)
    return {tree.GetName()};
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Collects the timings of the tasks run by TTreeProcessorMT::Process from any thread
+class TaskTimingRecorder {
+   std::mutex fMutex;
+   std::map<std::thread::id, unsigned int> fWorkers;
+   std::vector<TTreeProcessorMT::TaskTiming> fTimings;
+
+public:
+   void Record(std::size_t fileIdx, const EntryCluster &c, bool stolen, double seconds)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      const auto worker = fWorkers.emplace(std::this_thread::get_id(), fWorkers.size()).first->second;
+      fTimings.emplace_back(TTreeProcessorMT::TaskTiming{fileIdx, c.start, c.end, worker, stolen, seconds});
+   }
+
+   std::vector<TTreeProcessorMT::TaskTiming> Release() { return std::move(fTimings); }
+};
+
+/// A range of consecutive clusters of one file, used by the work-stealing scheduler
+struct ClusterRange {
+   std::size_t fileIdx;
+   std::size_t first; ///< First cluster that has not been handed out yet
+   std::size_t end;   ///< One past the last cluster of the range
+   bool stolen;       ///< Whether the range was split off another worker's range
+};
+
+////////////////////////////////////////////////////////////////////////
+/// Hands out clusters to the workers of the work-stealing scheduler.
+/// Ranges of clusters (one per file) are taken from a global queue, then the worker processes
+/// the clusters of its range one at a time. Once the global queue is empty, an idle worker steals
+/// the second half of the largest range another worker still has to process.
+class ClusterQueue {
+   std::mutex fMutex;
+   std::deque<ClusterRange> fQueue;
+   std::vector<ClusterRange> fWorkerRanges;
+
+public:
+   explicit ClusterQueue(unsigned int nWorkers) : fWorkerRanges(nWorkers, ClusterRange{0, 0, 0, false}) {}
+
+   void Push(std::size_t fileIdx, std::size_t nClusters)
+   {
+      if (nClusters == 0)
+         return;
+      std::lock_guard<std::mutex> lock(fMutex);
+      fQueue.emplace_back(ClusterRange{fileIdx, 0, nClusters, false});
+   }
+
+   /// Get the next cluster for the given worker; return false if no cluster is left to hand out
+   bool Next(unsigned int worker, std::size_t &fileIdx, std::size_t &cluster, bool &stolen)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto &range = fWorkerRanges[worker];
+      if (range.first == range.end) {
+         if (!fQueue.empty()) {
+            range = fQueue.front();
+            fQueue.pop_front();
+         } else {
+            auto victim = std::max_element(fWorkerRanges.begin(), fWorkerRanges.end(),
+                                           [](const ClusterRange &a, const ClusterRange &b) {
+                                              return a.end - a.first < b.end - b.first;
+                                           });
+            const auto remaining = victim->end - victim->first;
+            if (remaining == 0)
+               return false;
+            // The victim keeps the first half, which follows the clusters it has been reading
+            const auto nStolen = remaining - remaining / 2;
+            range = ClusterRange{victim->fileIdx, victim->end - nStolen, victim->end, true};
+            victim->end -= nStolen;
+         }
+      }
+      fileIdx = range.fileIdx;
+      cluster = range.first++;
+      stolen = range.stolen;
+      return true;
+   }
+};
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -519,9 +617,14 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads) : TTreeProcesso
 /// be processed in parallel. This means that the code of the user function
 /// should be thread safe.
 ///
+/// The timing of every invocation of the user function is available afterwards
+/// through GetTaskTimings().
+///
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
+   fTaskTimings.clear();
+
    const std::vector<Internal::NameAlias> &friendNames = fFriendInfo.fFriendNames;
    const std::vector<std::vector<std::string>> &friendFileNames = fFriendInfo.fFriendFileNames;
 
@@ -539,6 +642,116 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const auto friendEntries =
       hasFriends ? GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
+   TaskTimingRecorder timings;
+   auto processCluster = [&](std::size_t fileIdx, const EntryCluster &c, const std::vector<std::string> &theseTrees,
+                             const std::vector<std::string> &theseFiles, const std::vector<Long64_t> &theseEntries,
+                             bool stolen) {
+      std::unique_ptr<TTreeReader> reader;
+      std::unique_ptr<TEntryList> elist;
+      std::tie(reader, elist) = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo,
+                                                         fEntryList, theseEntries, friendEntries);
+      const auto start = std::chrono::steady_clock::now();
+      func(*reader);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      timings.Record(fileIdx, c, stolen, elapsed.count());
+   };
+
+   // Enable this IMT use case (activate its locks)
+   Internal::TParTreeProcessingRAII ptpRAII;
+
+   if (fWorkStealing) {
+      const auto nFiles = fFileNames.size();
+      // Clusters (local to their file unless shouldRetrieveAllClusters) and entries of each file, filled as the
+      // metadata of the files is read
+      std::vector<std::vector<EntryCluster>> clustersPerFile(nFiles);
+      std::vector<Long64_t> entriesPerFile(nFiles);
+      const auto nWorkers = std::max(1u, fPool.GetPoolSize());
+      ClusterQueue queue(nWorkers);
+      std::atomic<std::size_t> nextFileToLoad{0u};
+      // Workers that find nothing to process while other workers read the metadata of files wait on loadingCv.
+      // nLoading, the number of workers reading or about to read metadata, is guarded by loadingMutex; nLoaded
+      // counts the files whose metadata has been read.
+      std::mutex loadingMutex;
+      std::condition_variable loadingCv;
+      unsigned int nLoading = 0u;
+      std::atomic<std::size_t> nLoaded{0u};
+      auto endLoading = [&]() {
+         {
+            std::lock_guard<std::mutex> lock(loadingMutex);
+            --nLoading;
+            ++nLoaded;
+         }
+         loadingCv.notify_all();
+      };
+      if (shouldRetrieveAllClusters) {
+         for (auto i = 0u; i < nFiles; ++i) {
+            clustersPerFile[i] = clusters[i];
+            queue.Push(i, clusters[i].size());
+         }
+         nextFileToLoad = nFiles;
+      }
+
+      auto loadFile = [&](std::size_t fileIdx) {
+         struct LoadingRAII {
+            decltype(endLoading) &fEndLoading;
+            ~LoadingRAII() { fEndLoading(); }
+         } loading{endLoading};
+         auto clustersAndEntries = MakeClusters({fTreeNames[fileIdx]}, {fFileNames[fileIdx]});
+         clustersPerFile[fileIdx] = std::move(clustersAndEntries.first[0]);
+         entriesPerFile[fileIdx] = clustersAndEntries.second[0];
+         // Publishes clustersPerFile[fileIdx] to the other workers through the queue's lock
+         queue.Push(fileIdx, clustersPerFile[fileIdx].size());
+      };
+
+      auto worker = [&](unsigned int workerIdx) {
+         std::size_t fileIdx = 0;
+         std::size_t cluster = 0;
+         bool stolen = false;
+         while (true) {
+            const std::size_t nLoadedBefore = nLoaded;
+            if (!queue.Next(workerIdx, fileIdx, cluster, stolen)) {
+               // Nothing to process: read the metadata of the next file, making more clusters available.
+               // nLoading is incremented first such that workers finding no file left know to wait.
+               {
+                  std::lock_guard<std::mutex> lock(loadingMutex);
+                  ++nLoading;
+               }
+               const auto nextFile = nextFileToLoad++;
+               if (nextFile < nFiles) {
+                  loadFile(nextFile);
+                  continue;
+               }
+               {
+                  std::unique_lock<std::mutex> lock(loadingMutex);
+                  --nLoading;
+                  // Files still being loaded by other workers will bring clusters that can be stolen
+                  if (nLoading > 0) {
+                     loadingCv.wait(lock, [&] { return nLoading == 0 || nLoaded != nLoadedBefore; });
+                     continue;
+                  }
+               }
+               loadingCv.notify_all();
+               if (!queue.Next(workerIdx, fileIdx, cluster, stolen))
+                  break;
+            }
+
+            const auto &c = clustersPerFile[fileIdx][cluster];
+            if (shouldRetrieveAllClusters)
+               processCluster(fileIdx, c, fTreeNames, fFileNames, entries, stolen);
+            else
+               processCluster(fileIdx, c, {fTreeNames[fileIdx]}, {fFileNames[fileIdx]}, {entriesPerFile[fileIdx]},
+                              stolen);
+         }
+      };
+
+      std::vector<unsigned int> workerIdxs(nWorkers);
+      std::iota(workerIdxs.begin(), workerIdxs.end(), 0u);
+      fPool.Foreach(worker, workerIdxs);
+
+      fTaskTimings = timings.Release();
+      return;
+   }
+
    // Parent task, spawns tasks that process each of the entry clusters for each input file
    auto processFile = [&](std::size_t fileIdx) {
       // theseFiles contains either all files or just the single file to process
@@ -556,24 +769,63 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       const auto &theseEntries =
          shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
 
-      auto processCluster = [&](const EntryCluster &c) {
-         std::unique_ptr<TTreeReader> reader;
-         std::unique_ptr<TEntryList> elist;
-         std::tie(reader, elist) = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo,
-                                                            fEntryList, theseEntries, friendEntries);
-         func(*reader);
+      auto processFileCluster = [&](const EntryCluster &c) {
+         processCluster(fileIdx, c, theseTrees, theseFiles, theseEntries, false);
       };
 
-      fPool.Foreach(processCluster, thisFileClusters);
+      fPool.Foreach(processFileCluster, thisFileClusters);
    };
 
    std::vector<std::size_t> fileIdxs(fFileNames.size());
    std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
 
-   // Enable this IMT use case (activate its locks)
-   Internal::TParTreeProcessingRAII ptpRAII;
-
    fPool.Foreach(processFile, fileIdxs);
+
+   fTaskTimings = timings.Release();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Print a summary of the task timings of the last call to Process().
+///
+/// For each worker, the number of tasks, of stolen tasks and the total busy time
+/// are printed, followed by the slowest tasks. A large spread of the busy times
+/// indicates that the work is not evenly distributed among the workers.
+void TTreeProcessorMT::PrintTaskTimings() const
+{
+   if (fTaskTimings.empty()) {
+      std::cout << "TTreeProcessorMT: no task has been run\n";
+      return;
+   }
+
+   struct WorkerSummary {
+      unsigned int nTasks = 0;
+      unsigned int nStolen = 0;
+      double seconds = 0.;
+   };
+   std::map<unsigned int, WorkerSummary> workers;
+   for (const auto &t : fTaskTimings) {
+      auto &w = workers[t.fWorker];
+      ++w.nTasks;
+      w.nStolen += t.fStolen;
+      w.seconds += t.fSeconds;
+   }
+
+   std::cout << "TTreeProcessorMT: " << fTaskTimings.size() << " tasks on " << workers.size() << " workers\n";
+   for (const auto &w : workers) {
+      std::cout << "  worker " << w.first << ": " << w.second.nTasks << " tasks (" << w.second.nStolen
+                << " stolen), busy for " << w.second.seconds << " s\n";
+   }
+
+   auto slowest = fTaskTimings;
+   const auto nSlowest = std::min<std::size_t>(5u, slowest.size());
+   std::partial_sort(slowest.begin(), slowest.begin() + nSlowest, slowest.end(),
+                     [](const TaskTiming &a, const TaskTiming &b) { return a.fSeconds > b.fSeconds; });
+   std::cout << "  slowest tasks:\n";
+   for (auto i = 0u; i < nSlowest; ++i) {
+      const auto &t = slowest[i];
+      std::cout << "    " << fFileNames[t.fFileIdx] << " entries [" << t.fStart << ", " << t.fEnd << "): " << t.fSeconds
+                << " s on worker " << t.fWorker << (t.fStolen ? " (stolen)" : "") << "\n";
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -17,6 +17,9 @@
 #include "TTreeCache.h"
 #include "TTreeReaderValue.h"
 #include "TFriendProxy.h"
+#include "ROOT/TTreeReaderBulk.hxx"
+
+#include <algorithm>
 
 
 // clang-format off
@@ -233,6 +236,9 @@ TTreeReader::~TTreeReader()
            i = fValues.begin(), e = fValues.end(); i != e; ++i) {
       (*i)->MarkTreeReaderUnavailable();
    }
+   for (auto bulk: fBulkReaders) {
+      bulk->MarkTreeReaderUnavailable();
+   }
    if (fTree && fNotify.IsLinked())
       fNotify.RemoveLink(*fTree);
 
@@ -319,6 +325,9 @@ Bool_t TTreeReader::Notify()
          value->NotifyNewTree(fTree->GetTree());
       }
    }
+   for (auto bulk: fBulkReaders) {
+      bulk->NotifyNewTree();
+   }
 
    return kTRUE;
 }
@@ -417,6 +426,8 @@ void TTreeReader::Restart() {
    fDirector->SetReadEntry(-1);
    fProxiesSet = false; // we might get more value readers, meaning new proxies.
    fEntry = -1;
+   fBulkBegin = -1;
+   fBulkSize = 0;
    if (const auto curFile = fTree->GetCurrentFile()) {
       if (auto tc = fTree->GetTree()->GetReadCache(curFile, true)) {
          tc->DropBranch("*", true);
@@ -425,6 +436,75 @@ void TTreeReader::Restart() {
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Move to the next range of entries and load it into the bulk readers
+/// (TTreeReaderBulkValue, TTreeReaderBulkArray).
+///
+/// The range starts after the current entry, i.e. after the end of the previous
+/// range, and extends as far as the baskets of all bulk readers allow; it never
+/// crosses the boundary of a chain's tree or the end set by SetEntriesRange().
+/// After the call, the current entry is the last entry of the range.
+/// Regular TTreeReaderValue and TTreeReaderArray objects are not loaded;
+/// bulk reading is not supported with a TEntryList.
+///
+/// \return false if there are no more entries or if a bulk reader failed to read
+///   its branch, such that the function can be used in `while (reader.NextBulk()) { ... }`
+
+Bool_t TTreeReader::NextBulk()
+{
+   fBulkSize = 0;
+   if (IsInvalid()) {
+      fEntryStatus = kEntryNoTree;
+      return kFALSE;
+   }
+   if (fEntryList) {
+      Error("NextBulk()", "Bulk reading does not support TEntryLists.");
+      fEntryStatus = kEntryUnknownError;
+      return kFALSE;
+   }
+   if (fBulkReaders.empty()) {
+      Error("NextBulk()", "No TTreeReaderBulkValue or TTreeReaderBulkArray is attached to this reader.");
+      fEntryStatus = kEntryBadReader;
+      return kFALSE;
+   }
+
+   const Long64_t entry = fEntry + 1;
+   if (fEndEntry >= 0 && entry >= fEndEntry) {
+      fEntryStatus = kEntryBeyondEnd;
+      return kFALSE;
+   }
+
+   fSetEntryBaseCallingLoadTree = kTRUE;
+   const Long64_t localEntry = fTree->LoadTree(entry);
+   fSetEntryBaseCallingLoadTree = kFALSE;
+   if (localEntry < 0) {
+      fEntryStatus = (localEntry == -3) ? kEntryChainFileError : kEntryNotFound;
+      return kFALSE;
+   }
+
+   TTree *tree = fTree->GetTree();
+   Long64_t size = tree->GetEntriesFast() - localEntry;
+   if (fEndEntry >= 0)
+      size = std::min(size, fEndEntry - entry);
+   for (auto bulk: fBulkReaders) {
+      const Int_t available = bulk->LoadEntry(tree, localEntry);
+      if (available <= 0) {
+         fEntryStatus = kEntryBadReader;
+         return kFALSE;
+      }
+      size = std::min<Long64_t>(size, available);
+   }
+   for (auto bulk: fBulkReaders) {
+      bulk->SetRange(localEntry, size);
+   }
+
+   fBulkBegin = entry;
+   fBulkSize = size;
+   fEntry = entry + size - 1;
+   fEntryStatus = kEntryValid;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries of the TEntryList if one is provided, else
 /// of the TTree / TChain, independent of a range set by SetEntriesRange()
@@ -651,3 +731,24 @@ void TTreeReader::DeregisterValueReader(ROOT::Internal::TTreeReaderValueBase* re
    }
    fValues.erase(iReader);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a bulk reader for this tree.
+
+void TTreeReader::RegisterBulkReader(ROOT::Experimental::Internal::TTreeReaderBulkBase* reader)
+{
+   fBulkReaders.push_back(reader);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove a bulk reader for this tree.
+
+void TTreeReader::DeregisterBulkReader(ROOT::Experimental::Internal::TTreeReaderBulkBase* reader)
+{
+   auto iReader = std::find(fBulkReaders.begin(), fBulkReaders.end(), reader);
+   if (iReader == fBulkReaders.end()) {
+      Error("DeregisterBulkReader", "Cannot find bulk reader for branch %s", reader->GetBranchName().c_str());
+      return;
+   }
+   fBulkReaders.erase(iReader);
+}
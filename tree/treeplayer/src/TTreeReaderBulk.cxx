@@ -0,0 +1,147 @@
+// @(#)root/treeplayer:$Id$
+// Author: agent <agent@local>, 2020-06-02
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TTreeReaderBulk.hxx"
+
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TMathBase.h"
+#include "TTree.h"
+
+/** \class ROOT::Experimental::Internal::TTreeReaderBulkBase
+
+Base class of the bulk readers, which provide whole entry ranges of a branch as flat arrays.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a bulk reader and register it with the tree reader.
+
+ROOT::Experimental::Internal::TTreeReaderBulkBase::TTreeReaderBulkBase(TTreeReader &reader, std::string_view branchName,
+                                                                       EDataType type, Bool_t isCollection)
+   : fBranchName(branchName), fTreeReader(&reader), fType(type),
+     fElementSize(TDataType::GetDataType(type) ? TDataType::GetDataType(type)->Size() : 0),
+     fIsCollection(isCollection), fBuffer(TBuffer::kWrite, 32 * 1024), fOffsetBuffer(TBuffer::kWrite, 1024)
+{
+   *reinterpret_cast<Int_t *>(fOffsetBuffer.Buffer()) = 0;
+   fTreeReader->RegisterBulkReader(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister from tree reader.
+
+ROOT::Experimental::Internal::TTreeReaderBulkBase::~TTreeReaderBulkBase()
+{
+   if (fTreeReader)
+      fTreeReader->DeregisterBulkReader(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the branch in the given (tree-local) tree and check that its values can be
+/// decoded in bulk into the type requested by the reader.
+
+Bool_t ROOT::Experimental::Internal::TTreeReaderBulkBase::SetupBranch(TTree *tree)
+{
+   fBranch = nullptr;
+   fBasketFirst = -1;
+   fBasketSize = 0;
+
+   TBranch *branch = tree->GetBranch(fBranchName.c_str());
+   if (!branch) {
+      Error("TTreeReaderBulkBase::SetupBranch()", "The tree does not have a branch called %s.", fBranchName.c_str());
+      fSetupStatus = ROOT::Internal::TTreeReaderValueBase::kSetupMissingBranch;
+      return kFALSE;
+   }
+   if (!branch->SupportsBulkRead() && !branch->SupportsJaggedBulkRead()) {
+      Error("TTreeReaderBulkBase::SetupBranch()", "The branch %s cannot be read in bulk.", fBranchName.c_str());
+      fSetupStatus = ROOT::Internal::TTreeReaderValueBase::kSetupMismatch;
+      return kFALSE;
+   }
+
+   TLeaf *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   EDataType type = kOther_t;
+   Int_t headerSize = 0;
+   const Bool_t isJagged = leaf->GetJaggedLayout(type, headerSize);
+   if (!isJagged) {
+      auto dataType = dynamic_cast<TDataType *>(TDictionary::GetDictionary(leaf->GetTypeName()));
+      type = dataType ? static_cast<EDataType>(dataType->GetType()) : kOther_t;
+   }
+   if (type != fType) {
+      Error("TTreeReaderBulkBase::SetupBranch()", "The branch %s contains data of type %s, which does not match %s.",
+            fBranchName.c_str(), leaf->GetTypeName(), TDataType::GetTypeName(fType));
+      fSetupStatus = ROOT::Internal::TTreeReaderValueBase::kSetupMismatch;
+      return kFALSE;
+   }
+   if (!fIsCollection && (isJagged || leaf->GetLenStatic() != 1)) {
+      Error("TTreeReaderBulkBase::SetupBranch()",
+            "The branch %s contains arrays; read it through a TTreeReaderBulkArray.", fBranchName.c_str());
+      fSetupStatus = ROOT::Internal::TTreeReaderValueBase::kSetupMismatch;
+      return kFALSE;
+   }
+
+   fBranch = branch;
+   fSetupStatus = ROOT::Internal::TTreeReaderValueBase::kSetupMatch;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure that the basket containing the given tree-local entry is decoded.
+/// Returns the number of entries available from `entry` up to the end of the
+/// basket or -1 on error.
+
+Int_t ROOT::Experimental::Internal::TTreeReaderBulkBase::LoadEntry(TTree *tree, Long64_t entry)
+{
+   if (!fBranch && !SetupBranch(tree)) {
+      fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadError;
+      return -1;
+   }
+
+   if (fBasketFirst < 0 || entry < fBasketFirst || entry >= fBasketFirst + fBasketSize) {
+      // The bulk API only decodes entire baskets, so we need to start at the basket's first entry
+      const Long64_t *basketEntry = fBranch->GetBasketEntry();
+      const Long64_t basket = TMath::BinarySearch(fBranch->GetWriteBasket() + 1, basketEntry, entry);
+      const Long64_t first = basketEntry[basket];
+      const Int_t size = fBranch->GetBulkRead().GetBulkEntries(first, fBuffer, fOffsetBuffer);
+      if (size <= 0 || entry >= first + size) {
+         fBasketFirst = -1;
+         fBasketSize = 0;
+         fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadError;
+         return -1;
+      }
+      fBasketFirst = first;
+      fBasketSize = size;
+   }
+
+   fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadSuccess;
+   return fBasketFirst + fBasketSize - entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Expose `size` entries starting at the tree-local `entry`; the entries must
+/// have been loaded by LoadEntry().
+
+void ROOT::Experimental::Internal::TTreeReaderBulkBase::SetRange(Long64_t entry, Long64_t size)
+{
+   R__ASSERT(entry >= fBasketFirst && entry + size <= fBasketFirst + fBasketSize);
+   fRangeBegin = entry - fBasketFirst;
+   fRangeSize = size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The chain moved to a new tree: drop the branch and the decoded basket.
+
+void ROOT::Experimental::Internal::TTreeReaderBulkBase::NotifyNewTree()
+{
+   fBranch = nullptr;
+   fBasketFirst = -1;
+   fBasketSize = 0;
+   fRangeBegin = 0;
+   fRangeSize = 0;
+}
@@ -0,0 +1,234 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+#include "TTreeMappedIndex.h"
+
+#include "gtest/gtest.h"
+
+#include "RErrorIgnoreRAII.hxx"
+
+#include <fstream>
+#include <string>
+
+namespace {
+
+constexpr Long64_t kEntries = 1000;
+
+Long64_t RunOf(Long64_t serial)
+{
+   return (serial * 7) % 5;
+}
+
+Long64_t EventOf(Long64_t serial)
+{
+   return (serial * 31) % 97;
+}
+
+/// Write a tree whose (run,event) pairs are not sorted and hold duplicates
+void WriteTree(const char *filename, bool reversed)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "Indexed tree");
+   Long64_t run, event, serial;
+   tree.Branch("run", &run);
+   tree.Branch("event", &event);
+   tree.Branch("serial", &serial);
+   for (Long64_t i = 0; i < kEntries; ++i) {
+      serial = reversed ? kEntries - 1 - i : i;
+      run = RunOf(serial);
+      event = EventOf(serial);
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+class TTreeMappedIndexTest : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      WriteTree("mappedindex_0.root", false);
+      WriteTree("mappedindex_1.root", true);
+   }
+
+   void TearDown() override
+   {
+      gSystem->Unlink("mappedindex_0.root");
+      gSystem->Unlink("mappedindex_1.root");
+      gSystem->Unlink("mappedindex.idx");
+   }
+
+   /// Compare the lookups of the two indices of "mappedindex_0.root", over a range of keys including missing ones
+   void Compare(const TTreeIndex &reference, const TTreeMappedIndex &mapped)
+   {
+      for (Long64_t run = -1; run < 7; ++run) {
+         for (Long64_t event = -1; event < 99; ++event) {
+            const auto entry = reference.GetEntryNumberWithIndex(run, event);
+            const auto mappedEntry = mapped.GetEntryNumberWithIndex(run, event);
+            EXPECT_EQ(entry < 0, mappedEntry < 0);
+            if (mappedEntry >= 0) {
+               // With duplicates, the mapped index returns the smallest entry number
+               EXPECT_LE(mappedEntry, entry);
+               EXPECT_EQ(run, RunOf(mappedEntry));
+               EXPECT_EQ(event, EventOf(mappedEntry));
+            }
+            const auto best = reference.GetEntryNumberWithBestIndex(run, event);
+            const auto mappedBest = mapped.GetEntryNumberWithBestIndex(run, event);
+            EXPECT_EQ(best < 0, mappedBest < 0);
+            if (best >= 0 && mappedBest >= 0) {
+               EXPECT_EQ(RunOf(best), RunOf(mappedBest));
+               EXPECT_EQ(EventOf(best), EventOf(mappedBest));
+            }
+         }
+      }
+   }
+};
+
+} // anonymous namespace
+
+TEST_F(TTreeMappedIndexTest, Lookup)
+{
+   TFile file("mappedindex_0.root");
+   auto tree = file.Get<TTree>("T");
+   ASSERT_NE(nullptr, tree);
+   EXPECT_EQ(kEntries, TTreeMappedIndex::Build(tree, "run", "event", "mappedindex.idx"));
+
+   TTreeIndex reference(tree, "run", "event");
+   auto mapped = TTreeMappedIndex::Open(tree, "mappedindex.idx");
+   ASSERT_NE(nullptr, mapped);
+   EXPECT_EQ(mapped, tree->GetTreeIndex());
+   EXPECT_EQ(kEntries, mapped->GetN());
+   EXPECT_STREQ("run", mapped->GetMajorName());
+   EXPECT_STREQ("event", mapped->GetMinorName());
+   Compare(reference, *mapped);
+
+   // The entries found are the ones holding the keys
+   Long64_t run, event, serial;
+   tree->SetBranchAddress("run", &run);
+   tree->SetBranchAddress("event", &event);
+   tree->SetBranchAddress("serial", &serial);
+   for (Long64_t i = 0; i < kEntries; ++i) {
+      ASSERT_GT(tree->GetEntryWithIndex(RunOf(i), EventOf(i)), 0);
+      EXPECT_EQ(RunOf(i), run);
+      EXPECT_EQ(EventOf(i), event);
+      EXPECT_EQ(i % 485, serial);
+   }
+   tree->ResetBranchAddresses();
+}
+
+TEST_F(TTreeMappedIndexTest, Friend)
+{
+   TFile file("mappedindex_0.root");
+   auto tree = file.Get<TTree>("T");
+   ASSERT_NE(nullptr, tree);
+   TFile friendFile("mappedindex_1.root");
+   auto friendTree = friendFile.Get<TTree>("T");
+   ASSERT_NE(nullptr, friendTree);
+   ASSERT_EQ(kEntries, TTreeMappedIndex::Build(friendTree, "run", "event", "mappedindex.idx"));
+   ASSERT_NE(nullptr, TTreeMappedIndex::Open(friendTree, "mappedindex.idx"));
+   tree->AddFriend(friendTree, "F");
+
+   // The friend holds the same entries in reverse order
+   Long64_t run, event, friendRun, friendEvent;
+   tree->SetBranchAddress("run", &run);
+   tree->SetBranchAddress("event", &event);
+   tree->SetBranchAddress("F.run", &friendRun);
+   tree->SetBranchAddress("F.event", &friendEvent);
+   for (Long64_t i = 0; i < kEntries; i += 17) {
+      tree->GetEntry(i);
+      EXPECT_EQ(RunOf(i), run);
+      EXPECT_EQ(run, friendRun);
+      EXPECT_EQ(event, friendEvent);
+   }
+   tree->ResetBranchAddresses();
+}
+
+TEST_F(TTreeMappedIndexTest, Chain)
+{
+   TChain chain("T");
+   chain.Add("mappedindex_0.root");
+   chain.Add("mappedindex_1.root");
+   ASSERT_EQ(2 * kEntries, TTreeMappedIndex::Build(&chain, "run", "event", "mappedindex.idx"));
+   auto mapped = TTreeMappedIndex::Open(&chain, "mappedindex.idx");
+   ASSERT_NE(nullptr, mapped);
+
+   Long64_t run, event;
+   chain.SetBranchAddress("run", &run);
+   chain.SetBranchAddress("event", &event);
+   for (Long64_t i = 0; i < kEntries; i += 13) {
+      ASSERT_GT(chain.GetEntryWithIndex(RunOf(i), EventOf(i)), 0);
+      EXPECT_EQ(RunOf(i), run);
+      EXPECT_EQ(EventOf(i), event);
+   }
+   // Entries of the second file have the same keys as the first one, in reverse order
+   EXPECT_EQ(0, chain.GetEntryNumberWithIndex(RunOf(0), EventOf(0)));
+   EXPECT_EQ(-1, chain.GetEntryNumberWithIndex(5, 0));
+   chain.ResetBranchAddresses();
+}
+
+TEST_F(TTreeMappedIndexTest, Persistence)
+{
+   // The tree and its index are written in a subdirectory of the working directory
+   ASSERT_EQ(0, gSystem->mkdir("mappedindex_dir"));
+   {
+      TFile input("mappedindex_0.root");
+      auto tree = input.Get<TTree>("T");
+      ASSERT_NE(nullptr, tree);
+      ASSERT_EQ(kEntries, TTreeMappedIndex::Build(tree, "run", "event", "mappedindex_dir/mappedindex.idx"));
+      TFile output("mappedindex_dir/mappedindex.root", "RECREATE");
+      auto clone = tree->CloneTree();
+      ASSERT_NE(nullptr, TTreeMappedIndex::Open(clone, "mappedindex_dir/mappedindex.idx"));
+      clone->Write();
+   }
+
+   auto check = [](const char *filename) {
+      TFile file(filename);
+      auto tree = file.Get<TTree>("T");
+      ASSERT_NE(nullptr, tree);
+      auto mapped = dynamic_cast<TTreeMappedIndex *>(tree->GetTreeIndex());
+      ASSERT_NE(nullptr, mapped);
+      EXPECT_EQ(kEntries, mapped->GetN());
+      const auto entry = mapped->GetEntryNumberWithIndex(RunOf(42), EventOf(42));
+      EXPECT_EQ(RunOf(42), RunOf(entry));
+      EXPECT_EQ(EventOf(42), EventOf(entry));
+   };
+   // The sidecar file is found relative to the directory of the ROOT file, whatever the working directory
+   check("mappedindex_dir/mappedindex.root");
+   const std::string cwd = gSystem->WorkingDirectory();
+   ASSERT_TRUE(gSystem->ChangeDirectory("mappedindex_dir"));
+   check("mappedindex.root");
+   gSystem->ChangeDirectory(cwd.c_str());
+
+   gSystem->Unlink("mappedindex_dir/mappedindex.root");
+   gSystem->Unlink("mappedindex_dir/mappedindex.idx");
+   gSystem->Unlink("mappedindex_dir");
+}
+
+TEST_F(TTreeMappedIndexTest, Errors)
+{
+   TFile file("mappedindex_0.root");
+   auto tree = file.Get<TTree>("T");
+   ASSERT_NE(nullptr, tree);
+   RErrorIgnoreRAII ignore;
+
+   EXPECT_EQ(nullptr, TTreeMappedIndex::Open(tree, "mappedindex_missing.idx"));
+
+   // Not an index file
+   EXPECT_EQ(nullptr, TTreeMappedIndex::Open(tree, "mappedindex_1.root"));
+
+   // Built for another tree
+   TChain chain("T");
+   chain.Add("mappedindex_0.root");
+   chain.Add("mappedindex_1.root");
+   ASSERT_EQ(2 * kEntries, TTreeMappedIndex::Build(&chain, "run", "event", "mappedindex.idx"));
+   EXPECT_EQ(nullptr, TTreeMappedIndex::Open(tree, "mappedindex.idx"));
+   EXPECT_EQ(nullptr, tree->GetTreeIndex());
+
+   // Truncated
+   {
+      std::ofstream out("mappedindex.idx", std::ios::binary | std::ios::trunc);
+      out << "ROOTTIDX";
+   }
+   EXPECT_EQ(nullptr, TTreeMappedIndex::Open(tree, "mappedindex.idx"));
+}
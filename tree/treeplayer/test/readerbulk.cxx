@@ -0,0 +1,156 @@
+#include "ROOT/TTreeReaderBulk.hxx"
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using ROOT::Experimental::TTreeReaderBulkArray;
+using ROOT::Experimental::TTreeReaderBulkValue;
+
+class TTreeReaderBulkTest : public ::testing::Test {
+public:
+   static constexpr Long64_t kClusterSize = 100;
+   static constexpr Long64_t kEntriesPerFile = 1000;
+   const std::vector<std::string> fFileNames{"readerbulk_0.root", "readerbulk_1.root"};
+
+protected:
+   void SetUp() override
+   {
+      Long64_t entry = 0;
+      for (const auto &fileName : fFileNames) {
+         TFile file(fileName.c_str(), "RECREATE");
+         auto tree = new TTree("T", "Bulk reader test tree");
+         tree->SetBit(TTree::kOnlyFlushAtCluster);
+         tree->SetAutoFlush(kClusterSize);
+
+         float x = 0;
+         int n = 0;
+         float f[10];
+         std::vector<double> v;
+         tree->Branch("x", &x, "x/F");
+         tree->Branch("n", &n, "n/I");
+         tree->Branch("f", f, "f[n]/F");
+         tree->Branch("v", &v);
+         for (Long64_t i = 0; i < kEntriesPerFile; ++i, ++entry) {
+            x = entry;
+            n = entry % 10;
+            v.clear();
+            for (int j = 0; j < n; ++j) {
+               f[j] = entry + j;
+               v.push_back(entry - j);
+            }
+            tree->Fill();
+         }
+         file.Write();
+      }
+   }
+
+   void TearDown() override
+   {
+      for (const auto &fileName : fFileNames)
+         gSystem->Unlink(fileName.c_str());
+   }
+};
+
+TEST_F(TTreeReaderBulkTest, Chain)
+{
+   TChain chain("T");
+   for (const auto &fileName : fFileNames)
+      chain.Add(fileName.c_str());
+
+   TTreeReader reader(&chain);
+   TTreeReaderBulkValue<float> x(reader, "x");
+   TTreeReaderBulkArray<float> f(reader, "f");
+   TTreeReaderBulkArray<double> v(reader, "v");
+
+   Long64_t nEntries = 0;
+   while (reader.NextBulk()) {
+      const auto begin = reader.GetBulkBegin();
+      const auto size = reader.GetBulkSize();
+      EXPECT_EQ(nEntries, begin);
+      EXPECT_EQ(begin + size - 1, reader.GetCurrentEntry());
+      // Ranges never cross the boundary of a chain's tree
+      EXPECT_EQ(begin / kEntriesPerFile, (begin + size - 1) / kEntriesPerFile);
+      ASSERT_EQ(size, x.GetSize());
+      ASSERT_EQ(size, f.GetSize());
+      ASSERT_EQ(size, v.GetSize());
+
+      auto xValues = x.GetValues();
+      ASSERT_EQ(static_cast<std::size_t>(size), xValues.size());
+      for (Long64_t i = 0; i < size; ++i) {
+         const Long64_t entry = begin + i;
+         EXPECT_FLOAT_EQ(entry, xValues[i]);
+
+         auto fEntry = f.GetEntry(i);
+         auto vEntry = v[i];
+         ASSERT_EQ(static_cast<std::size_t>(entry % 10), fEntry.size());
+         ASSERT_EQ(static_cast<std::size_t>(entry % 10), vEntry.size());
+         for (std::size_t j = 0; j < fEntry.size(); ++j) {
+            EXPECT_FLOAT_EQ(entry + j, fEntry[j]);
+            EXPECT_DOUBLE_EQ(entry - j, vEntry[j]);
+         }
+      }
+
+      auto offsets = f.GetOffsets();
+      EXPECT_EQ(static_cast<std::size_t>(size + 1), offsets.size());
+      EXPECT_EQ(f.GetValues().size(), static_cast<std::size_t>(offsets[size] - offsets[0]));
+      nEntries += size;
+   }
+   EXPECT_EQ(2 * kEntriesPerFile, nEntries);
+   EXPECT_EQ(TTreeReader::kEntryNotFound, reader.GetEntryStatus());
+
+   reader.Restart();
+   EXPECT_TRUE(reader.NextBulk());
+   EXPECT_EQ(0, reader.GetBulkBegin());
+}
+
+TEST_F(TTreeReaderBulkTest, EntriesRange)
+{
+   TFile file(fFileNames[0].c_str());
+   auto tree = file.Get<TTree>("T");
+   TTreeReader reader(tree);
+   TTreeReaderBulkValue<float> x(reader, "x");
+
+   // Start in the middle of a basket, end in the middle of a later one
+   reader.SetEntriesRange(150, 420);
+   Long64_t expected = 150;
+   while (reader.NextBulk()) {
+      EXPECT_EQ(expected, reader.GetBulkBegin());
+      for (auto value : x.GetValues())
+         EXPECT_FLOAT_EQ(expected++, value);
+   }
+   EXPECT_EQ(420, expected);
+   EXPECT_EQ(TTreeReader::kEntryBeyondEnd, reader.GetEntryStatus());
+}
+
+TEST_F(TTreeReaderBulkTest, Mismatch)
+{
+   TFile file(fFileNames[0].c_str());
+   auto tree = file.Get<TTree>("T");
+
+   {
+      TTreeReader reader(tree);
+      TTreeReaderBulkValue<double> x(reader, "x");
+      EXPECT_FALSE(reader.NextBulk());
+      EXPECT_EQ(TTreeReader::kEntryBadReader, reader.GetEntryStatus());
+      EXPECT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMismatch, x.GetSetupStatus());
+   }
+   {
+      TTreeReader reader(tree);
+      TTreeReaderBulkValue<float> f(reader, "f");
+      EXPECT_FALSE(reader.NextBulk());
+      EXPECT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMismatch, f.GetSetupStatus());
+   }
+   {
+      TTreeReader reader(tree);
+      TTreeReaderBulkValue<float> missing(reader, "missing");
+      EXPECT_FALSE(reader.NextBulk());
+      EXPECT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMissingBranch, missing.GetSetupStatus());
+   }
+}
@@ -427,3 +427,63 @@ TEST(TreeProcessorMT, SetNThreads)
       gSystem->Unlink("treeprocmt_setnthreads.root");
    }
 }
+
+TEST(TreeProcessorMT, WorkStealing)
+{
+   // One large file with many clusters and several tiny ones
+   const std::string treename = "t";
+   std::vector<std::string> filenames{"treeprocmt_workstealing_large.root"};
+   WriteFileManyClusters(500, treename.c_str(), filenames[0].c_str());
+   for (auto i = 0u; i < 5u; ++i)
+      filenames.emplace_back("treeprocmt_workstealing_small" + std::to_string(i) + ".root");
+   WriteFiles(std::vector<std::string>(5, treename), {filenames.begin() + 1, filenames.end()});
+
+   std::vector<std::string_view> fnames;
+   for (const auto &f : filenames)
+      fnames.emplace_back(f);
+
+   ROOT::DisableImplicitMT();
+   ROOT::EnableImplicitMT(4);
+
+   std::atomic_int count(0);
+   auto countEntries = [&count](TTreeReader &r) {
+      while (r.Next()) {
+         std::this_thread::sleep_for(std::chrono::microseconds(10));
+         ++count;
+      }
+   };
+
+   ROOT::TTreeProcessorMT proc(fnames, treename);
+   EXPECT_FALSE(proc.GetWorkStealing());
+   proc.SetWorkStealing(true);
+   proc.Process(countEntries);
+   EXPECT_EQ(count.load(), 500 + 5 * 10);
+
+   // Every entry was processed by exactly one task
+   const auto &timings = proc.GetTaskTimings();
+   ASSERT_FALSE(timings.empty());
+   std::vector<std::vector<std::pair<Long64_t, Long64_t>>> rangesPerFile(filenames.size());
+   for (const auto &t : timings) {
+      ASSERT_LT(t.fFileIdx, filenames.size());
+      EXPECT_GE(t.fSeconds, 0.);
+      rangesPerFile[t.fFileIdx].emplace_back(t.fStart, t.fEnd);
+   }
+   CheckClusters(rangesPerFile[0], 500);
+   for (auto i = 1u; i < filenames.size(); ++i)
+      CheckClusters(rangesPerFile[i], 10);
+
+   // Which worker processes which cluster, and whether clusters are stolen at all, is up to the scheduling of the
+   // workers: only the results are checked
+
+   // The per-file scheduler reports its tasks as well
+   proc.SetWorkStealing(false);
+   count = 0;
+   proc.Process(countEntries);
+   EXPECT_EQ(count.load(), 500 + 5 * 10);
+   EXPECT_FALSE(proc.GetTaskTimings().empty());
+   for (const auto &t : proc.GetTaskTimings())
+      EXPECT_FALSE(t.fStolen);
+
+   DeleteFiles(filenames);
+   ROOT::DisableImplicitMT();
+}